@@ -0,0 +1,126 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cmath>
+#include <algorithm>
+#include <type_traits>
+
+namespace cnn
+{
+  namespace engine
+  {
+    namespace common
+    {
+      // ActivationType is the activation function of neurons of a layer, which is kept by the topology of the layer.
+      enum class ActivationType : uint32_t
+      {
+        // 1 / (1 + exp(-x)).
+        Sigmoid = 0,
+        Tanh = 1,
+        // max(x, 0).
+        ReLU = 2,
+        // max(x, LEAKY_RELU_SLOPE * x).
+        LeakyReLU = 3,
+        Identity = 4
+      };
+
+      // Activation holds activation functions, which are compiled into computational kernels:
+      // the type is dispatched once per row of outputs (or once per kernel), and the loop over values has no branches.
+      class Activation
+      {
+      public:
+
+        constexpr static long double LEAKY_RELU_SLOPE = 0.01L;
+
+        static bool IsValid(const ActivationType type) noexcept;
+
+        template <ActivationType TYPE, typename T>
+        static T Activate(const T value) noexcept;
+
+        // It activates count values in place.
+        template <typename T>
+        static void Activate(const ActivationType type, T* const values, const size_t count) noexcept;
+
+        // It calls kernel(std::integral_constant<ActivationType, type>{}), so the kernel is instantiated for every type.
+        template <typename K>
+        static void Dispatch(const ActivationType type, K&& kernel);
+
+      private:
+
+        ~Activation() = delete;
+
+      };
+
+      inline bool Activation::IsValid(const ActivationType type) noexcept
+      {
+        return static_cast<uint32_t>(type) <= static_cast<uint32_t>(ActivationType::Identity);
+      }
+
+      template <ActivationType TYPE, typename T>
+      T Activation::Activate(const T value) noexcept
+      {
+        static_assert(std::is_floating_point<T>::value);
+        if constexpr (TYPE == ActivationType::Sigmoid)
+        {
+          return 1 / (1 + std::exp(-value));
+        }
+        else if constexpr (TYPE == ActivationType::Tanh)
+        {
+          return std::tanh(value);
+        }
+        else if constexpr (TYPE == ActivationType::ReLU)
+        {
+          return std::max(value, static_cast<T>(0.L));
+        }
+        else if constexpr (TYPE == ActivationType::LeakyReLU)
+        {
+          return std::max(value, value * static_cast<T>(LEAKY_RELU_SLOPE));
+        }
+        else
+        {
+          return value;
+        }
+      }
+
+      template <typename T>
+      void Activation::Activate(const ActivationType type, T* const values, const size_t count) noexcept
+      {
+        if (type == ActivationType::Identity)
+        {
+          return;
+        }
+        Dispatch(type, [values, count](auto activation)
+        {
+          for (size_t i = 0; i < count; ++i)
+          {
+            values[i] = Activate<decltype(activation)::value>(values[i]);
+          }
+        });
+      }
+
+      template <typename K>
+      void Activation::Dispatch(const ActivationType type, K&& kernel)
+      {
+        switch (type)
+        {
+        case ActivationType::Tanh:
+          kernel(std::integral_constant<ActivationType, ActivationType::Tanh>{});
+          break;
+        case ActivationType::ReLU:
+          kernel(std::integral_constant<ActivationType, ActivationType::ReLU>{});
+          break;
+        case ActivationType::LeakyReLU:
+          kernel(std::integral_constant<ActivationType, ActivationType::LeakyReLU>{});
+          break;
+        case ActivationType::Identity:
+          kernel(std::integral_constant<ActivationType, ActivationType::Identity>{});
+          break;
+        default:
+          kernel(std::integral_constant<ActivationType, ActivationType::Sigmoid>{});
+          break;
+        }
+      }
+    }
+  }
+}
@@ -0,0 +1,175 @@
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+#include <new>
+#include <memory>
+#include <memory_resource>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+#include "MemoryResource.hpp"
+
+namespace cnn
+{
+  namespace engine
+  {
+    namespace common
+    {
+      // AlignedBuffer owns Count zero-initialized values, which start at a cache line boundary.
+      // It is a storage for tensors, which are scanned by computational kernels.
+      template <typename T>
+      class AlignedBuffer
+      {
+
+        static_assert(std::is_trivially_copyable<T>::value);
+
+      public:
+
+        constexpr static size_t ALIGNMENT = BUFFER_ALIGNMENT;
+
+        // Exception guarantee: strong for this.
+        // The values are allocated by the resource.
+        AlignedBuffer(const size_t count = 0, std::pmr::memory_resource* const resource = std::pmr::get_default_resource());
+
+        // Exception guarantee: strong for this.
+        AlignedBuffer(const AlignedBuffer& buffer);
+
+        AlignedBuffer(AlignedBuffer&& buffer) noexcept;
+
+        // Exception guarantee: strong for this.
+        AlignedBuffer& operator=(const AlignedBuffer& buffer);
+
+        AlignedBuffer& operator=(AlignedBuffer&& buffer) noexcept;
+
+        std::pmr::memory_resource* GetResource() const noexcept;
+
+        size_t GetCount() const noexcept;
+
+        const T* GetData() const noexcept;
+
+        T* GetData() noexcept;
+
+        // It clears the state without changing of the count.
+        void Clear() noexcept;
+
+        // It releases the values, so the count is zero.
+        void Reset() noexcept;
+
+      private:
+
+        size_t Count;
+        ResourceArray<T> Data;
+
+        static ResourceArray<T> Allocate(const size_t count, std::pmr::memory_resource* const resource);
+
+      };
+
+      template <typename T>
+      AlignedBuffer<T>::AlignedBuffer(const size_t count, std::pmr::memory_resource* const resource)
+        :
+        Count{ count },
+        Data{ Allocate(count, resource) }
+      {
+        Clear();
+      }
+
+      template <typename T>
+      AlignedBuffer<T>::AlignedBuffer(const AlignedBuffer& buffer)
+        :
+        Count{ buffer.Count },
+        Data{ Allocate(buffer.Count, buffer.GetResource()) }
+      {
+        if (Count != 0)
+        {
+          std::memcpy(Data.get(), buffer.Data.get(), sizeof(T) * Count);
+        }
+      }
+
+      template <typename T>
+      AlignedBuffer<T>::AlignedBuffer(AlignedBuffer&& buffer) noexcept
+        :
+        Count{ buffer.Count },
+        Data{ std::move(buffer.Data) }
+      {
+        buffer.Reset();
+      }
+
+      template <typename T>
+      AlignedBuffer<T>& AlignedBuffer<T>::operator=(const AlignedBuffer& buffer)
+      {
+        if (this != &buffer)
+        {
+          AlignedBuffer<T> tmpBuffer{ buffer };
+          // Beware, it is very intimate place for strong exception guarantee.
+          std::swap(*this, tmpBuffer);
+        }
+        return *this;
+      }
+
+      template <typename T>
+      AlignedBuffer<T>& AlignedBuffer<T>::operator=(AlignedBuffer&& buffer) noexcept
+      {
+        if (this != &buffer)
+        {
+          Count = buffer.Count;
+          Data = std::move(buffer.Data);
+
+          buffer.Reset();
+        }
+        return *this;
+      }
+
+      template <typename T>
+      std::pmr::memory_resource* AlignedBuffer<T>::GetResource() const noexcept
+      {
+        return Data.get_deleter().GetResource();
+      }
+
+      template <typename T>
+      size_t AlignedBuffer<T>::GetCount() const noexcept
+      {
+        return Count;
+      }
+
+      template <typename T>
+      const T* AlignedBuffer<T>::GetData() const noexcept
+      {
+        return Data.get();
+      }
+
+      template <typename T>
+      T* AlignedBuffer<T>::GetData() noexcept
+      {
+        return Data.get();
+      }
+
+      template <typename T>
+      void AlignedBuffer<T>::Clear() noexcept
+      {
+        if (Count != 0)
+        {
+          std::memset(Data.get(), 0, sizeof(T) * Count);
+        }
+      }
+
+      template <typename T>
+      void AlignedBuffer<T>::Reset() noexcept
+      {
+        Count = 0;
+        Data.reset(nullptr);
+      }
+
+      template <typename T>
+      ResourceArray<T> AlignedBuffer<T>::Allocate(const size_t count, std::pmr::memory_resource* const resource)
+      {
+        if (count == 0)
+        {
+          return ResourceArray<T>{ nullptr, ResourceArrayDeleter<T>{ resource } };
+        }
+        return ResourceArray<T>{ AllocateResourceArray<T>(count, resource, ALIGNMENT), ResourceArrayDeleter<T>{ resource, count, ALIGNMENT } };
+      }
+    }
+  }
+}
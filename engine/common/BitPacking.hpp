@@ -0,0 +1,114 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace cnn
+{
+  namespace engine
+  {
+    namespace common
+    {
+      // BitPacking keeps binary maps as rows of 64-bit words: bit (x % 64) of word (x / 64) is the value at x.
+      // Every row starts from a new word, so a map of width x height takes GetWordCount(width) * height words.
+      class BitPacking
+      {
+      public:
+
+        constexpr static size_t WORD_BIT_COUNT = 64;
+
+        static size_t GetWordCount(const size_t bitCount) noexcept;
+
+        // It returns count (<= 64) bits of the row, which start at offset.
+        static uint64_t GetBits(const uint64_t* const row, const size_t offset, const size_t count) noexcept;
+
+        // It returns count (<= 64) bits of the row at offset + i * step, which are gathered to bits i.
+        static uint64_t GetBits(const uint64_t* const row, const size_t offset, const size_t count, const size_t step) noexcept;
+
+        static bool GetBit(const uint64_t* const row, const size_t offset) noexcept;
+
+        static void SetBit(uint64_t* const row, const size_t offset, const bool value) noexcept;
+
+        // The word must not be zero.
+        static size_t CountTrailingZeros(const uint64_t word) noexcept;
+
+      private:
+
+        ~BitPacking() = delete;
+
+      };
+
+      inline size_t BitPacking::GetWordCount(const size_t bitCount) noexcept
+      {
+        return (bitCount + WORD_BIT_COUNT - 1) / WORD_BIT_COUNT;
+      }
+
+      inline uint64_t BitPacking::GetBits(const uint64_t* const row, const size_t offset, const size_t count) noexcept
+      {
+        const size_t word = offset / WORD_BIT_COUNT;
+        const size_t shift = offset % WORD_BIT_COUNT;
+        uint64_t bits = row[word] >> shift;
+        if ((shift != 0) && (shift + count > WORD_BIT_COUNT))
+        {
+          bits |= row[word + 1] << (WORD_BIT_COUNT - shift);
+        }
+        return (count < WORD_BIT_COUNT) ? (bits & ((uint64_t{ 1 } << count) - 1)) : bits;
+      }
+
+      inline uint64_t BitPacking::GetBits(const uint64_t* const row, const size_t offset, const size_t count, const size_t step) noexcept
+      {
+        if (step == 1)
+        {
+          return GetBits(row, offset, count);
+        }
+        uint64_t bits{};
+        for (size_t i = 0; i < count; ++i)
+        {
+          bits |= static_cast<uint64_t>(GetBit(row, offset + i * step)) << i;
+        }
+        return bits;
+      }
+
+      inline bool BitPacking::GetBit(const uint64_t* const row, const size_t offset) noexcept
+      {
+        return ((row[offset / WORD_BIT_COUNT] >> (offset % WORD_BIT_COUNT)) & 1) != 0;
+      }
+
+      inline void BitPacking::SetBit(uint64_t* const row, const size_t offset, const bool value) noexcept
+      {
+        const uint64_t mask = uint64_t{ 1 } << (offset % WORD_BIT_COUNT);
+        if (value)
+        {
+          row[offset / WORD_BIT_COUNT] |= mask;
+        }
+        else
+        {
+          row[offset / WORD_BIT_COUNT] &= ~mask;
+        }
+      }
+
+      inline size_t BitPacking::CountTrailingZeros(const uint64_t word) noexcept
+      {
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_ARM64))
+        unsigned long index{};
+        _BitScanForward64(&index, word);
+        return index;
+#elif defined(_MSC_VER)
+        unsigned long index{};
+        if (_BitScanForward(&index, static_cast<unsigned long>(word)))
+        {
+          return index;
+        }
+        _BitScanForward(&index, static_cast<unsigned long>(word >> 32));
+        return index + 32;
+#else
+        return static_cast<size_t>(__builtin_ctzll(word));
+#endif
+      }
+    }
+  }
+}
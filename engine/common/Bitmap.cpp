@@ -0,0 +1,205 @@
+#include "Bitmap.hpp"
+
+#include <stdexcept>
+
+namespace cnn
+{
+  namespace engine
+  {
+    namespace common
+    {
+      namespace
+      {
+        // BMP fields are little-endian, so they are assembled byte by byte.
+        uint32_t ReadUint32(const uint8_t* bytes) noexcept
+        {
+          return uint32_t{ bytes[0] } | (uint32_t{ bytes[1] } << 8) | (uint32_t{ bytes[2] } << 16) | (uint32_t{ bytes[3] } << 24);
+        }
+
+        uint16_t ReadUint16(const uint8_t* bytes) noexcept
+        {
+          return static_cast<uint16_t>(bytes[0] | (bytes[1] << 8));
+        }
+      }
+
+      Bitmap::Bitmap() noexcept
+        :
+        Width{ 0 },
+        Height{ 0 }
+      {
+      }
+
+      size_t Bitmap::GetWidth() const noexcept
+      {
+        return Width;
+      }
+
+      size_t Bitmap::GetHeight() const noexcept
+      {
+        return Height;
+      }
+
+      uint32_t Bitmap::GetPixel(const size_t x, const size_t y) const
+      {
+        if (x >= Width)
+        {
+          throw std::range_error("cnn::engine::common::Bitmap::GetPixel(), x >= Width.");
+        }
+        if (y >= Height)
+        {
+          throw std::range_error("cnn::engine::common::Bitmap::GetPixel(), y >= Height.");
+        }
+        return Pixels[x + y * Width];
+      }
+
+      const uint32_t* Bitmap::GetPixels() const noexcept
+      {
+        return Pixels.data();
+      }
+
+      float Bitmap::GetIntensity(const uint32_t pixel) noexcept
+      {
+        const uint32_t sum = ((pixel >> 16) & 0xFF) + ((pixel >> 8) & 0xFF) + (pixel & 0xFF);
+        return sum / (3.0f * 255.0f);
+      }
+
+      void Bitmap::Load(std::istream& istream)
+      {
+        if (istream.good() == false)
+        {
+          throw std::invalid_argument("cnn::engine::common::Bitmap::Load(), istream.good() == false.");
+        }
+
+        uint8_t fileHeader[FILE_HEADER_SIZE];
+        istream.read(reinterpret_cast<char*>(fileHeader), sizeof(fileHeader));
+        uint8_t infoHeader[MIN_INFO_HEADER_SIZE];
+        istream.read(reinterpret_cast<char*>(infoHeader), sizeof(infoHeader));
+        if (istream.good() == false)
+        {
+          throw std::runtime_error("cnn::engine::common::Bitmap::Load(), istream.good() == false.");
+        }
+
+        if ((fileHeader[0] != 'B') || (fileHeader[1] != 'M'))
+        {
+          throw std::runtime_error("cnn::engine::common::Bitmap::Load(), the signature is not BM.");
+        }
+        const uint32_t pixelOffset = ReadUint32(fileHeader + 10);
+        const uint32_t infoHeaderSize = ReadUint32(infoHeader);
+        const int32_t width = static_cast<int32_t>(ReadUint32(infoHeader + 4));
+        const int32_t height = static_cast<int32_t>(ReadUint32(infoHeader + 8));
+        const uint16_t bitCount = ReadUint16(infoHeader + 14);
+        const uint32_t compression = ReadUint32(infoHeader + 16);
+        uint32_t paletteSize = ReadUint32(infoHeader + 32);
+
+        if (infoHeaderSize < MIN_INFO_HEADER_SIZE)
+        {
+          throw std::runtime_error("cnn::engine::common::Bitmap::Load(), infoHeaderSize < MIN_INFO_HEADER_SIZE.");
+        }
+        // BI_RGB only, 32-bit images may declare BI_BITFIELDS with the default masks.
+        if ((compression != 0) && ((compression != 3) || (bitCount != 32)))
+        {
+          throw std::runtime_error("cnn::engine::common::Bitmap::Load(), compressed bitmaps are not supported.");
+        }
+        if ((bitCount != 1) && (bitCount != 4) && (bitCount != 8) && (bitCount != 24) && (bitCount != 32))
+        {
+          throw std::runtime_error("cnn::engine::common::Bitmap::Load(), bitCount is not supported.");
+        }
+        if ((width <= 0) || (height == 0) || (static_cast<size_t>(width) > MAX_SIDE) || (static_cast<size_t>(height < 0 ? -int64_t{ height } : height) > MAX_SIDE))
+        {
+          throw std::runtime_error("cnn::engine::common::Bitmap::Load(), the size is out of range.");
+        }
+
+        const bool topDown = height < 0;
+        const size_t imageWidth = static_cast<size_t>(width);
+        const size_t imageHeight = static_cast<size_t>(topDown ? -int64_t{ height } : height);
+
+        // The palette follows the info header; each entry is BGRX.
+        std::vector<uint32_t> palette;
+        if (bitCount <= 8)
+        {
+          const uint32_t maxPaletteSize = uint32_t{ 1 } << bitCount;
+          if ((paletteSize == 0) || (paletteSize > maxPaletteSize))
+          {
+            paletteSize = maxPaletteSize;
+          }
+          std::vector<uint8_t> infoHeaderTail(infoHeaderSize - MIN_INFO_HEADER_SIZE);
+          istream.read(reinterpret_cast<char*>(infoHeaderTail.data()), infoHeaderTail.size());
+          std::vector<uint8_t> paletteBytes(size_t{ paletteSize } * 4);
+          istream.read(reinterpret_cast<char*>(paletteBytes.data()), paletteBytes.size());
+          if (istream.good() == false)
+          {
+            throw std::runtime_error("cnn::engine::common::Bitmap::Load(), istream.good() == false.");
+          }
+          // Out-of-palette indices of broken files give black instead of undefined behaviour.
+          palette.resize(maxPaletteSize, 0);
+          for (size_t i = 0; i < paletteSize; ++i)
+          {
+            palette[i] = ReadUint32(paletteBytes.data() + i * 4) & 0x00FFFFFF;
+          }
+        }
+
+        // Everything between the headers and the pixels (masks, color profiles and so on) is skipped.
+        const size_t readSize = FILE_HEADER_SIZE + ((bitCount <= 8) ? infoHeaderSize + size_t{ paletteSize } * 4 : MIN_INFO_HEADER_SIZE);
+        if (pixelOffset < readSize)
+        {
+          throw std::runtime_error("cnn::engine::common::Bitmap::Load(), pixelOffset < readSize.");
+        }
+        istream.ignore(static_cast<std::streamsize>(pixelOffset - readSize));
+
+        // Rows are aligned to 4 bytes.
+        const size_t rowSize = ((imageWidth * bitCount + 31) / 32) * 4;
+        std::vector<uint8_t> rows(rowSize * imageHeight);
+        istream.read(reinterpret_cast<char*>(rows.data()), rows.size());
+        if (istream.good() == false)
+        {
+          throw std::runtime_error("cnn::engine::common::Bitmap::Load(), istream.good() == false.");
+        }
+
+        std::vector<uint32_t> pixels(imageWidth * imageHeight);
+        for (size_t y = 0; y < imageHeight; ++y)
+        {
+          const uint8_t* row = rows.data() + (topDown ? y : imageHeight - 1 - y) * rowSize;
+          uint32_t* pixel = pixels.data() + y * imageWidth;
+          switch (bitCount)
+          {
+          case 1:
+            for (size_t x = 0; x < imageWidth; ++x)
+            {
+              pixel[x] = palette[(row[x >> 3] >> (7 - (x & 7))) & 0x01];
+            }
+            break;
+          case 4:
+            for (size_t x = 0; x < imageWidth; ++x)
+            {
+              pixel[x] = palette[(row[x >> 1] >> ((x & 1) ? 0 : 4)) & 0x0F];
+            }
+            break;
+          case 8:
+            for (size_t x = 0; x < imageWidth; ++x)
+            {
+              pixel[x] = palette[row[x]];
+            }
+            break;
+          case 24:
+            for (size_t x = 0; x < imageWidth; ++x)
+            {
+              const uint8_t* bgr = row + x * 3;
+              pixel[x] = uint32_t{ bgr[0] } | (uint32_t{ bgr[1] } << 8) | (uint32_t{ bgr[2] } << 16);
+            }
+            break;
+          case 32:
+            for (size_t x = 0; x < imageWidth; ++x)
+            {
+              pixel[x] = ReadUint32(row + x * 4) & 0x00FFFFFF;
+            }
+            break;
+          }
+        }
+
+        Width = imageWidth;
+        Height = imageHeight;
+        Pixels = std::move(pixels);
+      }
+    }
+  }
+}
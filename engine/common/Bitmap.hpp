@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <istream>
+
+namespace cnn
+{
+  namespace engine
+  {
+    namespace common
+    {
+      // Bitmap is a decoder of uncompressed BMP images: 1, 4 and 8 bits per pixel with a palette
+      // and 24 or 32 bits per pixel without one. Both bottom-up and top-down row orders are supported.
+      // Pixels are stored row by row from the top left corner (x + y * width) as 0x00RRGGBB.
+      class Bitmap
+      {
+      public:
+
+        Bitmap() noexcept;
+
+        size_t GetWidth() const noexcept;
+
+        size_t GetHeight() const noexcept;
+
+        uint32_t GetPixel(const size_t x, const size_t y) const;
+
+        const uint32_t* GetPixels() const noexcept;
+
+        // It returns the intensity of the pixel in [0, 1], where black is 0 and white is 1.
+        static float GetIntensity(const uint32_t pixel) noexcept;
+
+        // Exception guarantee: strong for this and base for istream.
+        void Load(std::istream& istream);
+
+      private:
+
+        constexpr static size_t FILE_HEADER_SIZE = 14;
+        constexpr static size_t MIN_INFO_HEADER_SIZE = 40;
+        constexpr static size_t MAX_SIDE = 1 << 16;
+
+        size_t Width;
+        size_t Height;
+        std::vector<uint32_t> Pixels;
+
+      };
+    }
+  }
+}
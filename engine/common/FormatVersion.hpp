@@ -0,0 +1,74 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <istream>
+#include <ostream>
+#include <stdexcept>
+
+namespace cnn
+{
+  namespace engine
+  {
+    namespace common
+    {
+      // FormatVersion marks saved topologies, which have gained fields since the first format.
+      // A marked stream starts with MARKER and the version. A legacy stream has no mark, so it starts with its first field,
+      // which is a count or a width and never equals MARKER.
+      class FormatVersion
+      {
+      public:
+
+        constexpr static size_t MARKER = std::numeric_limits<size_t>::max();
+
+        // The version of unmarked streams.
+        constexpr static uint32_t LEGACY = 0;
+
+        // Exception guarantee: base for ostream.
+        // It writes the mark of the version.
+        static void Save(std::ostream& ostream, const uint32_t version);
+
+        // Exception guarantee: base for istream.
+        // It reads the first value of the stream. If it is the mark, then it reads the version and the value after the mark.
+        // Otherwise it returns LEGACY, and the value is the first field of the legacy stream.
+        static uint32_t Load(std::istream& istream, const uint32_t maxVersion, size_t& firstValue);
+
+      private:
+
+        ~FormatVersion() = delete;
+
+      };
+
+      inline void FormatVersion::Save(std::ostream& ostream, const uint32_t version)
+      {
+        ostream.write(reinterpret_cast<const char* const>(&MARKER), sizeof(MARKER));
+        ostream.write(reinterpret_cast<const char* const>(&version), sizeof(version));
+      }
+
+      inline uint32_t FormatVersion::Load(std::istream& istream, const uint32_t maxVersion, size_t& firstValue)
+      {
+        size_t value{};
+        istream.read(reinterpret_cast<char* const>(&value), sizeof(value));
+        if (value != MARKER)
+        {
+          firstValue = value;
+          return LEGACY;
+        }
+
+        uint32_t version{};
+        istream.read(reinterpret_cast<char* const>(&version), sizeof(version));
+        if (istream.good() == false)
+        {
+          throw std::runtime_error("cnn::engine::common::FormatVersion::Load(), istream.good() == false.");
+        }
+        if ((version == LEGACY) || (version > maxVersion))
+        {
+          throw std::runtime_error("cnn::engine::common::FormatVersion::Load(), version is not supported.");
+        }
+        istream.read(reinterpret_cast<char* const>(&firstValue), sizeof(firstValue));
+        return version;
+      }
+    }
+  }
+}
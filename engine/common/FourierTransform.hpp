@@ -0,0 +1,162 @@
+#pragma once
+
+#include <cstddef>
+#include <cmath>
+#include <utility>
+#include <stdexcept>
+#include <type_traits>
+#include <memory_resource>
+
+#include "AlignedBuffer.hpp"
+
+namespace cnn
+{
+  namespace engine
+  {
+    namespace common
+    {
+      // FourierTransform computes the discrete Fourier transform of Count complex values in place
+      // by the iterative radix-2 algorithm (Count is a power of 2).
+      // Complex values are split into arrays of real and imaginary parts, which are placed with a stride,
+      // so the same transform is applied to rows and columns of a plane.
+      template <typename T>
+      class FourierTransform
+      {
+
+        static_assert(std::is_floating_point<T>::value);
+
+      public:
+
+        // Exception guarantee: strong for this.
+        // The twiddle factors are allocated by the resource.
+        FourierTransform(const size_t count = 1, std::pmr::memory_resource* const resource = std::pmr::get_default_resource());
+
+        std::pmr::memory_resource* GetResource() const noexcept;
+
+        size_t GetCount() const noexcept;
+
+        // It computes X[k] = sum(x[n] * exp(-2 * pi * i * k * n / Count)).
+        void Transform(T* const real, T* const imaginary, const size_t stride = 1) const noexcept;
+
+        // It computes the inverse transform, which is multiplied by Count.
+        void InverseTransform(T* const real, T* const imaginary, const size_t stride = 1) const noexcept;
+
+        // It releases the twiddle factors, so the transform is of 1 value.
+        void Reset() noexcept;
+
+        // It returns the least power of 2, which is not less than count.
+        static size_t GetTransformCount(const size_t count) noexcept;
+
+      private:
+
+        size_t Count;
+
+        // cos(2 * pi * k / Count) and -sin(2 * pi * k / Count) for k < Count / 2.
+        AlignedBuffer<T> Twiddles;
+
+      };
+
+      template <typename T>
+      FourierTransform<T>::FourierTransform(const size_t count, std::pmr::memory_resource* const resource)
+        :
+        Count{ count },
+        Twiddles{ count, resource }
+      {
+        if ((count == 0) || ((count & (count - 1)) != 0))
+        {
+          throw std::invalid_argument("cnn::engine::common::FourierTransform::FourierTransform(), count is not a power of 2.");
+        }
+
+        const long double pi = std::acos(-1.L);
+        const size_t halfCount = Count / 2;
+        for (size_t k = 0; k < halfCount; ++k)
+        {
+          const long double angle = 2 * pi * k / Count;
+          Twiddles.GetData()[k] = static_cast<T>(std::cos(angle));
+          Twiddles.GetData()[halfCount + k] = static_cast<T>(-std::sin(angle));
+        }
+      }
+
+      template <typename T>
+      std::pmr::memory_resource* FourierTransform<T>::GetResource() const noexcept
+      {
+        return Twiddles.GetResource();
+      }
+
+      template <typename T>
+      size_t FourierTransform<T>::GetCount() const noexcept
+      {
+        return Count;
+      }
+
+      template <typename T>
+      void FourierTransform<T>::Transform(T* const real, T* const imaginary, const size_t stride) const noexcept
+      {
+        // Bit reversal permutation.
+        for (size_t i = 1, j = 0; i < Count; ++i)
+        {
+          size_t bit = Count >> 1;
+          for (; (j & bit) != 0; bit >>= 1)
+          {
+            j ^= bit;
+          }
+          j ^= bit;
+          if (i < j)
+          {
+            std::swap(real[i * stride], real[j * stride]);
+            std::swap(imaginary[i * stride], imaginary[j * stride]);
+          }
+        }
+
+        const T* const cosines = Twiddles.GetData();
+        const T* const sines = Twiddles.GetData() + Count / 2;
+        for (size_t length = 2; length <= Count; length <<= 1)
+        {
+          const size_t halfLength = length / 2;
+          const size_t twiddleStep = Count / length;
+          for (size_t begin = 0; begin < Count; begin += length)
+          {
+            for (size_t k = 0; k < halfLength; ++k)
+            {
+              const T twiddleReal = cosines[k * twiddleStep];
+              const T twiddleImaginary = sines[k * twiddleStep];
+              const size_t a = (begin + k) * stride;
+              const size_t b = (begin + k + halfLength) * stride;
+              const T productReal = real[b] * twiddleReal - imaginary[b] * twiddleImaginary;
+              const T productImaginary = real[b] * twiddleImaginary + imaginary[b] * twiddleReal;
+              real[b] = real[a] - productReal;
+              imaginary[b] = imaginary[a] - productImaginary;
+              real[a] += productReal;
+              imaginary[a] += productImaginary;
+            }
+          }
+        }
+      }
+
+      template <typename T>
+      void FourierTransform<T>::InverseTransform(T* const real, T* const imaginary, const size_t stride) const noexcept
+      {
+        // The inverse transform is the forward one of values with swapped real and imaginary parts.
+        Transform(imaginary, real, stride);
+      }
+
+      template <typename T>
+      void FourierTransform<T>::Reset() noexcept
+      {
+        Count = 1;
+        Twiddles.Reset();
+      }
+
+      template <typename T>
+      size_t FourierTransform<T>::GetTransformCount(const size_t count) noexcept
+      {
+        size_t transformCount = 1;
+        while (transformCount < count)
+        {
+          transformCount <<= 1;
+        }
+        return transformCount;
+      }
+    }
+  }
+}
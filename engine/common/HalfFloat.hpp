@@ -0,0 +1,255 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <cmath>
+#include <type_traits>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace cnn
+{
+  namespace engine
+  {
+    namespace common
+    {
+      // WeightFormat is the format of weights, which are streamed by computational kernels.
+      // Weights are computed and accumulated in T anyway.
+      enum class WeightFormat : uint32_t
+      {
+        Native = 0,
+        // IEEE 754 binary16: 10 bits of mantissa, the range is up to 65504.
+        Float16 = 1,
+        // The upper half of binary32: 7 bits of mantissa, the range of float.
+        BFloat16 = 2
+      };
+
+      // Float16 stores a value in IEEE 754 binary16 format. It is a storage type only, so values are converted to float for arithmetic.
+      class Float16
+      {
+      public:
+
+        Float16() noexcept = default;
+
+        // The value is rounded to nearest even, and values out of the range become infinities.
+        explicit Float16(const float value) noexcept;
+
+        explicit operator float() const noexcept;
+
+        uint16_t GetBits() const noexcept;
+
+      private:
+
+        uint16_t Bits;
+
+      };
+
+      // BFloat16 stores a value in bfloat16 format. It is a storage type only, so values are converted to float for arithmetic.
+      class BFloat16
+      {
+      public:
+
+        BFloat16() noexcept = default;
+
+        // The value is rounded to nearest even.
+        explicit BFloat16(const float value) noexcept;
+
+        explicit operator float() const noexcept;
+
+        uint16_t GetBits() const noexcept;
+
+      private:
+
+        uint16_t Bits;
+
+      };
+
+      // HalfFloat holds kernels, which read 16-bit values and convert them in registers.
+      // The kernels are compiled for AVX2 (with F16C), if it is available, otherwise they are scalar.
+      // Scalar conversions of Float16 cost more than the memory traffic they save, but BFloat16 values are converted by a shift.
+      class HalfFloat
+      {
+      public:
+
+        // It converts count values to the storage format.
+        template <typename T, typename S>
+        static void Convert(const T* const values, S* const halves, const size_t count) noexcept;
+
+        // It returns sum(values[i] * weights[i]), which is accumulated in T.
+        // Weights of T are read as they are, so the native format is measured by the same kernel as 16-bit formats.
+        template <typename T, typename S>
+        static T DotProduct(const T* const values, const S* const weights, const size_t count) noexcept;
+
+      private:
+
+        ~HalfFloat() = delete;
+
+      };
+
+      inline Float16::Float16(const float value) noexcept
+      {
+        uint32_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        const uint32_t sign = (bits >> 16) & 0x8000u;
+        uint32_t absBits = bits & 0x7FFFFFFFu;
+
+        if (absBits >= 0x7F800000u)
+        {
+          // Infinity or NaN, which becomes quiet and keeps the upper bits of the payload.
+          Bits = static_cast<uint16_t>(sign | 0x7C00u | (absBits > 0x7F800000u ? 0x0200u | ((absBits >> 13) & 0x03FFu) : 0u));
+        }
+        else if (absBits >= 0x477FF000u)
+        {
+          // Values from 65520 are rounded to infinity.
+          Bits = static_cast<uint16_t>(sign | 0x7C00u);
+        }
+        else if (absBits < 0x38800000u)
+        {
+          // Subnormal values are rounded by the addition of 0.5, which aligns the mantissa.
+          float absValue;
+          std::memcpy(&absValue, &absBits, sizeof(absValue));
+          absValue += 0.5f;
+          std::memcpy(&absBits, &absValue, sizeof(absBits));
+          Bits = static_cast<uint16_t>(sign | (absBits - 0x3F000000u));
+        }
+        else
+        {
+          // The exponent is rebiased, and the mantissa is rounded to nearest even.
+          const uint32_t odd = (absBits >> 13) & 1u;
+          absBits += 0xC8000FFFu + odd;
+          Bits = static_cast<uint16_t>(sign | (absBits >> 13));
+        }
+      }
+
+      inline Float16::operator float() const noexcept
+      {
+        // The exponent is rebiased, so only infinities, NaNs and subnormal values need fixes.
+        uint32_t bits = static_cast<uint32_t>(Bits & 0x7FFFu) << 13;
+        const uint32_t exponent = bits & 0x0F800000u;
+        bits += 0x38000000u;
+        if (exponent == 0x0F800000u)
+        {
+          // Infinity or NaN, which becomes quiet.
+          bits += 0x38000000u;
+          bits |= (bits & 0x007FFFFFu) != 0 ? 0x00400000u : 0u;
+        }
+        else if (exponent == 0)
+        {
+          // A subnormal value is normalized by the subtraction of 2^-14.
+          bits += 0x00800000u;
+          float value;
+          std::memcpy(&value, &bits, sizeof(value));
+          value -= 6.103515625e-05f;
+          std::memcpy(&bits, &value, sizeof(bits));
+        }
+        bits |= static_cast<uint32_t>(Bits & 0x8000u) << 16;
+
+        float value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+      }
+
+      inline uint16_t Float16::GetBits() const noexcept
+      {
+        return Bits;
+      }
+
+      inline BFloat16::BFloat16(const float value) noexcept
+      {
+        uint32_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        if ((bits & 0x7FFFFFFFu) > 0x7F800000u)
+        {
+          // NaN stays quiet, because truncation could make it infinity.
+          Bits = static_cast<uint16_t>((bits >> 16) | 0x0040u);
+        }
+        else
+        {
+          Bits = static_cast<uint16_t>((bits + 0x7FFFu + ((bits >> 16) & 1u)) >> 16);
+        }
+      }
+
+      inline BFloat16::operator float() const noexcept
+      {
+        const uint32_t bits = static_cast<uint32_t>(Bits) << 16;
+        float value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+      }
+
+      inline uint16_t BFloat16::GetBits() const noexcept
+      {
+        return Bits;
+      }
+
+      template <typename T, typename S>
+      void HalfFloat::Convert(const T* const values, S* const halves, const size_t count) noexcept
+      {
+        static_assert(std::is_floating_point<T>::value);
+        static_assert(std::is_same<S, Float16>::value || std::is_same<S, BFloat16>::value);
+        for (size_t i = 0; i < count; ++i)
+        {
+          halves[i] = S{ static_cast<float>(values[i]) };
+        }
+      }
+
+      template <typename T, typename S>
+      T HalfFloat::DotProduct(const T* const values, const S* const weights, const size_t count) noexcept
+      {
+        static_assert(std::is_floating_point<T>::value);
+        static_assert(std::is_same<S, T>::value || std::is_same<S, Float16>::value || std::is_same<S, BFloat16>::value);
+
+        size_t i = 0;
+        T sum{};
+#if defined(__AVX2__) && (defined(__F16C__) || defined(_MSC_VER))
+        if constexpr (std::is_same<T, float>::value)
+        {
+          // Two accumulators hide the latency of additions.
+          __m256 sums[2] = { _mm256_setzero_ps(), _mm256_setzero_ps() };
+          for (; i + 16 <= count; i += 16)
+          {
+            for (size_t k = 0; k < 2; ++k)
+            {
+              __m256 weightValues;
+              if constexpr (std::is_same<S, T>::value)
+              {
+                weightValues = _mm256_loadu_ps(weights + i + 8 * k);
+              }
+              else if constexpr (std::is_same<S, Float16>::value)
+              {
+                weightValues = _mm256_cvtph_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(weights + i + 8 * k)));
+              }
+              else
+              {
+                const __m128i halves = _mm_loadu_si128(reinterpret_cast<const __m128i*>(weights + i + 8 * k));
+                weightValues = _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_cvtepu16_epi32(halves), 16));
+              }
+              sums[k] = _mm256_add_ps(sums[k], _mm256_mul_ps(_mm256_loadu_ps(values + i + 8 * k), weightValues));
+            }
+          }
+          const __m256 sum8 = _mm256_add_ps(sums[0], sums[1]);
+          __m128 sum4 = _mm_add_ps(_mm256_castps256_ps128(sum8), _mm256_extractf128_ps(sum8, 1));
+          sum4 = _mm_add_ps(sum4, _mm_movehl_ps(sum4, sum4));
+          sum4 = _mm_add_ss(sum4, _mm_movehdup_ps(sum4));
+          sum = _mm_cvtss_f32(sum4);
+        }
+#endif
+        for (; i < count; ++i)
+        {
+          if constexpr (std::is_same<S, T>::value)
+          {
+            sum += values[i] * weights[i];
+          }
+          else
+          {
+            sum += values[i] * static_cast<T>(static_cast<float>(weights[i]));
+          }
+        }
+        return sum;
+      }
+    }
+  }
+}
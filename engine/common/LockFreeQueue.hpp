@@ -0,0 +1,167 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <atomic>
+#include <memory>
+#include <type_traits>
+#include <stdexcept>
+
+namespace cnn
+{
+  namespace engine
+  {
+    namespace common
+    {
+      // LockFreeQueue is a bounded multi-producer multi-consumer queue.
+      // Every cell has a sequence number, so producers and consumers are synchronized without locks
+      // and each operation costs one CAS in the common case.
+      template <typename T>
+      class LockFreeQueue
+      {
+
+        static_assert(std::is_nothrow_copy_assignable<T>::value);
+
+      public:
+
+        // The capacity is rounded up to a power of two.
+        LockFreeQueue(const size_t capacity);
+
+        LockFreeQueue(const LockFreeQueue& queue) = delete;
+
+        LockFreeQueue(LockFreeQueue&& queue) noexcept = delete;
+
+        LockFreeQueue& operator=(const LockFreeQueue& queue) = delete;
+
+        LockFreeQueue& operator=(LockFreeQueue&& queue) noexcept = delete;
+
+        size_t GetCapacity() const noexcept;
+
+        // It returns false, if the queue is full.
+        bool TryPush(const T& value) noexcept;
+
+        // It returns false, if the queue is empty.
+        bool TryPop(T& value) noexcept;
+
+        // The result is approximate, if other threads use the queue at the same time.
+        bool IsEmpty() const noexcept;
+
+      private:
+
+        constexpr static size_t CACHE_LINE_SIZE = 64;
+
+        struct Cell
+        {
+          std::atomic<size_t> Sequence;
+          T Value;
+        };
+
+        size_t Mask;
+        std::unique_ptr<Cell[]> Cells;
+
+        alignas(CACHE_LINE_SIZE) std::atomic<size_t> PushPosition;
+        alignas(CACHE_LINE_SIZE) std::atomic<size_t> PopPosition;
+
+      };
+
+      template <typename T>
+      LockFreeQueue<T>::LockFreeQueue(const size_t capacity)
+        :
+        PushPosition{ 0 },
+        PopPosition{ 0 }
+      {
+        if (capacity == 0)
+        {
+          throw std::invalid_argument("cnn::engine::common::LockFreeQueue::LockFreeQueue(), capacity == 0.");
+        }
+
+        size_t roundedCapacity = 1;
+        while (roundedCapacity < capacity)
+        {
+          roundedCapacity <<= 1;
+          if (roundedCapacity == 0)
+          {
+            throw std::overflow_error("cnn::engine::common::LockFreeQueue::LockFreeQueue(), roundedCapacity has been overflowed.");
+          }
+        }
+
+        Mask = roundedCapacity - 1;
+        Cells = std::make_unique<Cell[]>(roundedCapacity);
+        for (size_t i = 0; i < roundedCapacity; ++i)
+        {
+          Cells[i].Sequence.store(i, std::memory_order_relaxed);
+        }
+      }
+
+      template <typename T>
+      size_t LockFreeQueue<T>::GetCapacity() const noexcept
+      {
+        return Mask + 1;
+      }
+
+      template <typename T>
+      bool LockFreeQueue<T>::TryPush(const T& value) noexcept
+      {
+        size_t position = PushPosition.load(std::memory_order_relaxed);
+        while (true)
+        {
+          Cell& cell = Cells[position & Mask];
+          const size_t sequence = cell.Sequence.load(std::memory_order_acquire);
+          const intptr_t difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+          if (difference == 0)
+          {
+            if (PushPosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+            {
+              cell.Value = value;
+              cell.Sequence.store(position + 1, std::memory_order_release);
+              return true;
+            }
+          }
+          else if (difference < 0)
+          {
+            return false;
+          }
+          else
+          {
+            position = PushPosition.load(std::memory_order_relaxed);
+          }
+        }
+      }
+
+      template <typename T>
+      bool LockFreeQueue<T>::TryPop(T& value) noexcept
+      {
+        size_t position = PopPosition.load(std::memory_order_relaxed);
+        while (true)
+        {
+          Cell& cell = Cells[position & Mask];
+          const size_t sequence = cell.Sequence.load(std::memory_order_acquire);
+          const intptr_t difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position + 1);
+          if (difference == 0)
+          {
+            if (PopPosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+            {
+              value = cell.Value;
+              cell.Sequence.store(position + Mask + 1, std::memory_order_release);
+              return true;
+            }
+          }
+          else if (difference < 0)
+          {
+            return false;
+          }
+          else
+          {
+            position = PopPosition.load(std::memory_order_relaxed);
+          }
+        }
+      }
+
+      template <typename T>
+      bool LockFreeQueue<T>::IsEmpty() const noexcept
+      {
+        return PopPosition.load(std::memory_order_acquire) >= PushPosition.load(std::memory_order_acquire);
+      }
+    }
+  }
+}
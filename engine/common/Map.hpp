@@ -8,6 +8,9 @@
 #include <istream>
 #include <ostream>
 #include <cstring>
+#include <memory_resource>
+
+#include "MemoryResource.hpp"
 
 namespace cnn
 {
@@ -15,6 +18,7 @@ namespace cnn
   {
     namespace common
     {
+      // Values start at a cache line boundary and are padded with zeros to whole cache lines (see MemoryResource.hpp).
       template <typename T>
       class Map
       {
@@ -23,7 +27,8 @@ namespace cnn
 
       public:
 
-        Map(const size_t valueCount = 0);
+        // Values are allocated by the resource (see MemoryResource.hpp).
+        Map(const size_t valueCount = 0, std::pmr::memory_resource* const resource = std::pmr::get_default_resource());
 
         Map(const Map& map);
 
@@ -34,6 +39,8 @@ namespace cnn
 
         Map& operator=(Map&& map) noexcept;
 
+        std::pmr::memory_resource* GetResource() const noexcept;
+
         size_t GetValueCount() const noexcept;
 
         // Exception guarantee: strong for this.
@@ -45,6 +52,12 @@ namespace cnn
         // Exception guarantee: strong for this.
         void SetValue(const size_t index, const T value);
 
+        // It gives direct access to GetValueCount() contiguous values (for computational kernels).
+        const T* GetValues() const noexcept;
+
+        // It gives direct access to GetValueCount() contiguous values (for computational kernels).
+        T* GetValues() noexcept;
+
         // It clears the state without changing of the topology.
         void Clear() noexcept;
 
@@ -66,26 +79,28 @@ namespace cnn
       private:
 
         size_t ValueCount;
-        std::unique_ptr<T[]> Values;
+        ResourceArray<T> Values;
+
+        // It allocates count zero values and zero padding.
+        static ResourceArray<T> Allocate(const size_t count, std::pmr::memory_resource* const resource);
 
       };
 
       template <typename T>
-      Map<T>::Map(const size_t valueCount)
+      Map<T>::Map(const size_t valueCount, std::pmr::memory_resource* const resource)
         :
-        ValueCount{ valueCount }
+        ValueCount{ valueCount },
+        Values{ Allocate(valueCount, resource) }
       {
-        Values = std::make_unique<T[]>(ValueCount);
-        Clear();
       }
 
       template <typename T>
       Map<T>::Map(const Map& map)
         :
-        ValueCount{ map.ValueCount }
+        ValueCount{ map.ValueCount },
+        Values{ Allocate(map.ValueCount, map.GetResource()) }
       {
-        Values = std::make_unique<T[]>(ValueCount);
-        std::memcpy(Values.get(), map.Values.get(), sizeof(T) * ValueCount);
+        std::memcpy(Values.get(), map.Values.get(), sizeof(T) * GetPaddedCount<T>(ValueCount));
       }
 
       template <typename T>
@@ -123,6 +138,12 @@ namespace cnn
         return *this;
       }
 
+      template <typename T>
+      std::pmr::memory_resource* Map<T>::GetResource() const noexcept
+      {
+        return Values.get_deleter().GetResource();
+      }
+
       template <typename T>
       size_t Map<T>::GetValueCount() const noexcept
       {
@@ -132,7 +153,7 @@ namespace cnn
       template <typename T>
       void Map<T>::SetValueCount(const size_t valueCount)
       {
-        Map tmpMap{ valueCount };
+        Map tmpMap{ valueCount, GetResource() };
         // Beware, it is very intimate place for strong exception guarantee.
         std::swap(*this, tmpMap);
       }
@@ -161,6 +182,18 @@ namespace cnn
         Values[index] = value;
       }
 
+      template <typename T>
+      const T* Map<T>::GetValues() const noexcept
+      {
+        return Values.get();
+      }
+
+      template <typename T>
+      T* Map<T>::GetValues() noexcept
+      {
+        return Values.get();
+      }
+
       template <typename T>
       void Map<T>::Clear() noexcept
       {
@@ -173,8 +206,9 @@ namespace cnn
       template <typename T>
       void Map<T>::Reset() noexcept
       {
+        // The resource is kept, so the map can be refilled.
         ValueCount = 0;
-        Values.reset(nullptr);
+        Values.reset();
       }
 
       template <typename T>
@@ -210,7 +244,7 @@ namespace cnn
 
         istream.read(reinterpret_cast<char* const>(&valueCount), sizeof(valueCount));
 
-        values = std::make_unique<T[]>(valueCount);
+        values = Allocate(valueCount, GetResource());
         for (size_t i = 0; i < valueCount; ++i)
         {
           istream.read(reinterpret_cast<char* const>(&(values[i])), sizeof(values[i]));
@@ -237,6 +271,19 @@ namespace cnn
           std::memcpy(Values.get(), map.Values.get(), sizeof(T) * ValueCount);
         }
       }
+
+      template <typename T>
+      ResourceArray<T> Map<T>::Allocate(const size_t count, std::pmr::memory_resource* const resource)
+      {
+        const size_t paddedCount = GetPaddedCount<T>(count);
+        ResourceArray<T> values{ AllocateResourceArray<T>(paddedCount, resource, BUFFER_ALIGNMENT),
+                                 ResourceArrayDeleter<T>{ resource, paddedCount, BUFFER_ALIGNMENT } };
+        if (paddedCount != 0)
+        {
+          std::memset(values.get(), 0, sizeof(T) * paddedCount);
+        }
+        return values;
+      }
     }
   }
 }
@@ -38,6 +38,9 @@ namespace cnn
         // Exception guarantee: strong for the map.
         void SetValue(const size_t index, const T value) const;
 
+        // It gives direct access to GetValueCount() contiguous values (for computational kernels).
+        T* GetValues() const noexcept;
+
         // It clears the state without changing of the topology of the map.
         void Clear() const noexcept;
 
@@ -87,6 +90,12 @@ namespace cnn
         Map_.SetValue(index, value);
       }
 
+      template <typename T>
+      T* MapProtectingReference<T>::GetValues() const noexcept
+      {
+        return Map_.GetValues();
+      }
+
       template <typename T>
       void MapProtectingReference<T>::Clear() const noexcept
       {
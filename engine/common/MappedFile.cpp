@@ -0,0 +1,187 @@
+#include "MappedFile.hpp"
+
+#include <utility>
+#include <stdexcept>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace cnn
+{
+  namespace engine
+  {
+    namespace common
+    {
+      MappedFile::MappedFile() noexcept
+        :
+#ifdef _WIN32
+        File{ INVALID_HANDLE_VALUE },
+        Mapping{ nullptr },
+#else
+        Descriptor{ -1 },
+#endif
+        Data{ nullptr },
+        Size{ 0 }
+      {
+      }
+
+      MappedFile::MappedFile(const std::filesystem::path& path)
+        :
+        MappedFile{}
+      {
+#ifdef _WIN32
+        File = ::CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (File == INVALID_HANDLE_VALUE)
+        {
+          throw std::runtime_error("cnn::engine::common::MappedFile::MappedFile(), File == INVALID_HANDLE_VALUE.");
+        }
+
+        LARGE_INTEGER size{};
+        if (::GetFileSizeEx(File, &size) == FALSE)
+        {
+          Close();
+          throw std::runtime_error("cnn::engine::common::MappedFile::MappedFile(), GetFileSizeEx() == FALSE.");
+        }
+        Size = static_cast<size_t>(size.QuadPart);
+        if (Size == 0)
+        {
+          return;
+        }
+
+        Mapping = ::CreateFileMappingW(File, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (Mapping == nullptr)
+        {
+          Close();
+          throw std::runtime_error("cnn::engine::common::MappedFile::MappedFile(), Mapping == nullptr.");
+        }
+
+        Data = static_cast<const uint8_t*>(::MapViewOfFile(Mapping, FILE_MAP_READ, 0, 0, 0));
+        if (Data == nullptr)
+        {
+          Close();
+          throw std::runtime_error("cnn::engine::common::MappedFile::MappedFile(), Data == nullptr.");
+        }
+#else
+        Descriptor = ::open(path.c_str(), O_RDONLY);
+        if (Descriptor == -1)
+        {
+          throw std::runtime_error("cnn::engine::common::MappedFile::MappedFile(), Descriptor == -1.");
+        }
+
+        struct stat status{};
+        if (::fstat(Descriptor, &status) != 0)
+        {
+          Close();
+          throw std::runtime_error("cnn::engine::common::MappedFile::MappedFile(), fstat() != 0.");
+        }
+        Size = static_cast<size_t>(status.st_size);
+        if (Size == 0)
+        {
+          return;
+        }
+
+        void* data = ::mmap(nullptr, Size, PROT_READ, MAP_PRIVATE, Descriptor, 0);
+        if (data == MAP_FAILED)
+        {
+          Close();
+          throw std::runtime_error("cnn::engine::common::MappedFile::MappedFile(), data == MAP_FAILED.");
+        }
+        Data = static_cast<const uint8_t*>(data);
+#endif
+      }
+
+      MappedFile::MappedFile(MappedFile&& file) noexcept
+        :
+        MappedFile{}
+      {
+        Swap(file);
+      }
+
+      MappedFile& MappedFile::operator=(MappedFile&& file) noexcept
+      {
+        if (this != &file)
+        {
+          Close();
+          Swap(file);
+        }
+        return *this;
+      }
+
+      MappedFile::~MappedFile()
+      {
+        Close();
+      }
+
+      bool MappedFile::IsOpen() const noexcept
+      {
+#ifdef _WIN32
+        return File != INVALID_HANDLE_VALUE;
+#else
+        return Descriptor != -1;
+#endif
+      }
+
+      const uint8_t* MappedFile::GetData() const noexcept
+      {
+        return Data;
+      }
+
+      size_t MappedFile::GetSize() const noexcept
+      {
+        return Size;
+      }
+
+      void MappedFile::Close() noexcept
+      {
+#ifdef _WIN32
+        if (Data != nullptr)
+        {
+          ::UnmapViewOfFile(Data);
+        }
+        if (Mapping != nullptr)
+        {
+          ::CloseHandle(Mapping);
+        }
+        if (File != INVALID_HANDLE_VALUE)
+        {
+          ::CloseHandle(File);
+        }
+        File = INVALID_HANDLE_VALUE;
+        Mapping = nullptr;
+#else
+        if (Data != nullptr)
+        {
+          ::munmap(const_cast<uint8_t*>(Data), Size);
+        }
+        if (Descriptor != -1)
+        {
+          ::close(Descriptor);
+        }
+        Descriptor = -1;
+#endif
+        Data = nullptr;
+        Size = 0;
+      }
+
+      void MappedFile::Swap(MappedFile& file) noexcept
+      {
+#ifdef _WIN32
+        std::swap(File, file.File);
+        std::swap(Mapping, file.Mapping);
+#else
+        std::swap(Descriptor, file.Descriptor);
+#endif
+        std::swap(Data, file.Data);
+        std::swap(Size, file.Size);
+      }
+    }
+  }
+}
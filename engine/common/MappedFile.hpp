@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+
+namespace cnn
+{
+  namespace engine
+  {
+    namespace common
+    {
+      // MappedFile maps a whole file into memory for reading.
+      // The pages are loaded by the operating system on demand and shared with its file cache.
+      class MappedFile
+      {
+      public:
+
+        MappedFile() noexcept;
+
+        MappedFile(const std::filesystem::path& path);
+
+        MappedFile(const MappedFile& file) = delete;
+
+        MappedFile(MappedFile&& file) noexcept;
+
+        MappedFile& operator=(const MappedFile& file) = delete;
+
+        MappedFile& operator=(MappedFile&& file) noexcept;
+
+        ~MappedFile();
+
+        bool IsOpen() const noexcept;
+
+        // It returns nullptr for an empty file.
+        const uint8_t* GetData() const noexcept;
+
+        size_t GetSize() const noexcept;
+
+        void Close() noexcept;
+
+      private:
+
+#ifdef _WIN32
+        void* File;
+        void* Mapping;
+#else
+        int Descriptor;
+#endif
+        const uint8_t* Data;
+        size_t Size;
+
+        void Swap(MappedFile& file) noexcept;
+
+      };
+    }
+  }
+}
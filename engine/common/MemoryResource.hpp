@@ -0,0 +1,163 @@
+#pragma once
+
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <memory_resource>
+#include <new>
+
+namespace cnn
+{
+  namespace engine
+  {
+    namespace common
+    {
+      // Containers of the engine take a std::pmr::memory_resource, so networks and lessons can be placed in arenas,
+      // huge pages, NUMA-local or shared memory. The resource must outlive the container and all its copies.
+      // A copy is allocated by the resource of the source, so a whole network stays in one resource.
+      // A resource, which is used by several threads at once, must be synchronized
+      // (std::pmr::monotonic_buffer_resource and std::pmr::unsynchronized_pool_resource fit per-thread scratch).
+
+      // Value buffers of the engine start at a cache line boundary and are padded with zeros to whole cache lines,
+      // which are as wide as the widest SIMD registers, so vector code needs neither peeling nor masked tails.
+      constexpr size_t BUFFER_ALIGNMENT = 64;
+
+      // It returns count rounded up to whole cache lines of values.
+      template <typename U>
+      constexpr size_t GetPaddedCount(const size_t count) noexcept;
+
+      // ResourceArrayDeleter destroys the objects of the array and returns the memory to the resource.
+      template <typename U>
+      class ResourceArrayDeleter
+      {
+      public:
+
+        ResourceArrayDeleter(std::pmr::memory_resource* const resource = std::pmr::get_default_resource(),
+                             const size_t count = 0,
+                             const size_t alignment = alignof(U)) noexcept;
+
+        std::pmr::memory_resource* GetResource() const noexcept;
+
+        void operator()(U* const values) const noexcept;
+
+      private:
+
+        std::pmr::memory_resource* Resource;
+        size_t Count;
+        size_t Alignment;
+
+      };
+
+      // ResourceArray owns an array of objects, which is allocated by a memory resource.
+      template <typename U>
+      using ResourceArray = std::unique_ptr<U[], ResourceArrayDeleter<U>>;
+
+      // Exception guarantee: strong.
+      // It allocates the memory for count objects of the alignment, which are not constructed.
+      template <typename U>
+      U* AllocateResourceArray(const size_t count, std::pmr::memory_resource* const resource, const size_t alignment = alignof(U));
+
+      // Exception guarantee: strong.
+      // It constructs count objects U(arguments..., resource) in the memory of the resource.
+      template <typename U, typename... Arguments>
+      ResourceArray<U> MakeResourceArray(const size_t count, std::pmr::memory_resource* const resource, const Arguments&... arguments);
+
+      // Exception guarantee: strong.
+      // It copies count objects of the source in the memory of the resource.
+      template <typename U>
+      ResourceArray<U> CopyResourceArray(const U* const source, const size_t count, std::pmr::memory_resource* const resource);
+
+      template <typename U>
+      constexpr size_t GetPaddedCount(const size_t count) noexcept
+      {
+        constexpr size_t laneCount = BUFFER_ALIGNMENT / sizeof(U);
+        return (count + laneCount - 1) / laneCount * laneCount;
+      }
+
+      template <typename U>
+      ResourceArrayDeleter<U>::ResourceArrayDeleter(std::pmr::memory_resource* const resource,
+                                                    const size_t count,
+                                                    const size_t alignment) noexcept
+        :
+        Resource{ resource },
+        Count{ count },
+        Alignment{ alignment }
+      {
+      }
+
+      template <typename U>
+      std::pmr::memory_resource* ResourceArrayDeleter<U>::GetResource() const noexcept
+      {
+        return Resource;
+      }
+
+      template <typename U>
+      void ResourceArrayDeleter<U>::operator()(U* const values) const noexcept
+      {
+        for (size_t i = Count; i > 0; --i)
+        {
+          values[i - 1].~U();
+        }
+        Resource->deallocate(values, sizeof(U) * Count, Alignment);
+      }
+
+      template <typename U>
+      U* AllocateResourceArray(const size_t count, std::pmr::memory_resource* const resource, const size_t alignment)
+      {
+        if (count > std::numeric_limits<size_t>::max() / sizeof(U))
+        {
+          throw std::bad_array_new_length();
+        }
+        return static_cast<U*>(resource->allocate(sizeof(U) * count, alignment));
+      }
+
+      template <typename U, typename... Arguments>
+      ResourceArray<U> MakeResourceArray(const size_t count, std::pmr::memory_resource* const resource, const Arguments&... arguments)
+      {
+        U* const values = AllocateResourceArray<U>(count, resource);
+        size_t i = 0;
+        try
+        {
+          for (; i < count; ++i)
+          {
+            new (values + i) U(arguments..., resource);
+          }
+        }
+        catch (...)
+        {
+          for (; i > 0; --i)
+          {
+            values[i - 1].~U();
+          }
+          resource->deallocate(values, sizeof(U) * count, alignof(U));
+          throw;
+        }
+        return ResourceArray<U>{ values, ResourceArrayDeleter<U>{ resource, count } };
+      }
+
+      template <typename U>
+      ResourceArray<U> CopyResourceArray(const U* const source, const size_t count, std::pmr::memory_resource* const resource)
+      {
+        U* const values = AllocateResourceArray<U>(count, resource);
+        size_t i = 0;
+        try
+        {
+          for (; i < count; ++i)
+          {
+            new (values + i) U(source[i]);
+          }
+        }
+        catch (...)
+        {
+          for (; i > 0; --i)
+          {
+            values[i - 1].~U();
+          }
+          resource->deallocate(values, sizeof(U) * count, alignof(U));
+          throw;
+        }
+        return ResourceArray<U>{ values, ResourceArrayDeleter<U>{ resource, count } };
+      }
+    }
+  }
+}
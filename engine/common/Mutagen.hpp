@@ -1,10 +1,11 @@
 #pragma once
 
-#include <random>
 #include <stdexcept>
 #include <cstddef>
 #include <cstdint>
-#include <chrono>
+#include <algorithm>
+
+#include "Philox.hpp"
 
 namespace cnn
 {
@@ -12,6 +13,9 @@ namespace cnn
   {
     namespace common
     {
+      // Mutagen draws random numbers from the counter-based generator (see common::Philox),
+      // so mutagens with the same seed and different streams give independent reproducible sequences,
+      // for example, one stream per thread.
       template <typename T>
       class Mutagen
       {
@@ -46,14 +50,29 @@ namespace cnn
         void SetVariabilityForce(const T variabilityForce);
 
         // We expect that the method never throws any exception.
+        // It restarts the sequence of the stream.
         void SetSeed(const unsigned int seed) noexcept;
 
+        uint64_t GetStream() const noexcept;
+
+        // We expect that the method never throws any exception.
+        // It restarts the sequence of the new stream.
+        void SetStream(const uint64_t stream) noexcept;
+
         // We expect that the method never throws any exception.
         void Clear() noexcept;
 
         // We expect that the method never throws any exception.
         T Mutate(const T value) noexcept;
 
+        // We expect that the method never throws any exception.
+        // It mutates count values in place: one block of the generator gives variability of 4 values.
+        void Mutate(T* const values, const size_t count) noexcept;
+
+        // We expect that the method never throws any exception.
+        // It returns a random index in [0, count), if count != 0.
+        size_t GenerateIndex(const size_t count) noexcept;
+
       private:
 
         T MinResult;
@@ -62,7 +81,19 @@ namespace cnn
 
         T VariabilityForce;
 
-        std::default_random_engine DRE;
+        Philox Generator;
+
+        uint64_t Counter;
+
+        // Unused values of the last block for the mutation of single values.
+        Philox::Block Block;
+
+        size_t BlockPosition;
+
+        // It maps a random word to [-VariabilityForce, +VariabilityForce).
+        T GetVariability(const uint32_t word) const noexcept;
+
+        T Restrict(const T value) const noexcept;
 
       };
 
@@ -78,7 +109,10 @@ namespace cnn
         MinResult{ mutagen.MinResult },
         MaxResult{ mutagen.MaxResult },
         VariabilityForce{ mutagen.VariabilityForce },
-        DRE{ std::move(mutagen.DRE) }
+        Generator{ mutagen.Generator },
+        Counter{ mutagen.Counter },
+        Block{ mutagen.Block },
+        BlockPosition{ mutagen.BlockPosition }
       {
         mutagen.Clear();
       }
@@ -91,7 +125,10 @@ namespace cnn
           MinResult = mutagen.MinResult;
           MaxResult = mutagen.MaxResult;
           VariabilityForce = mutagen.VariabilityForce;
-          DRE = std::move(mutagen.DRE);
+          Generator = mutagen.Generator;
+          Counter = mutagen.Counter;
+          Block = mutagen.Block;
+          BlockPosition = mutagen.BlockPosition;
 
           mutagen.Clear();
         }
@@ -149,7 +186,23 @@ namespace cnn
       template <typename T>
       void Mutagen<T>::SetSeed(const unsigned int seed) noexcept
       {
-        DRE.seed(seed);
+        Generator.SetKey(seed);
+        Counter = 0;
+        BlockPosition = Philox::BLOCK_SIZE;
+      }
+
+      template <typename T>
+      uint64_t Mutagen<T>::GetStream() const noexcept
+      {
+        return Generator.GetStream();
+      }
+
+      template <typename T>
+      void Mutagen<T>::SetStream(const uint64_t stream) noexcept
+      {
+        Generator.SetStream(stream);
+        Counter = 0;
+        BlockPosition = Philox::BLOCK_SIZE;
       }
 
       template <typename T>
@@ -158,32 +211,86 @@ namespace cnn
         MinResult = static_cast<T>(0.L);
         MaxResult = static_cast<T>(0.L);
         VariabilityForce = static_cast<T>(0.L);
-        DRE.seed(0);
+        Generator = Philox{};
+        Counter = 0;
+        Block = {};
+        BlockPosition = Philox::BLOCK_SIZE;
       }
 
       template <typename T>
       T Mutagen<T>::Mutate(const T value) noexcept
       {
-        T result{ value };
-
-        // Variability.
+        if (BlockPosition == Philox::BLOCK_SIZE)
         {
-          std::uniform_real_distribution<T> urd{ -VariabilityForce, +VariabilityForce };
-          result += urd(DRE);
+          Block = Generator.Generate(Counter++);
+          BlockPosition = 0;
         }
+        return Restrict(value + GetVariability(Block[BlockPosition++]));
+      }
 
-        // Range control.
+      template <typename T>
+      void Mutagen<T>::Mutate(T* const values, const size_t count) noexcept
+      {
+        // Blocks are independent, so batches of blocks are generated at once.
+        // The w-th word of the l-th block of a batch mutates the value (w * LANE_COUNT + l) of the batch.
+        constexpr size_t batchSize = Philox::BLOCK_SIZE * Philox::LANE_COUNT;
+        size_t i = 0;
+        for (; i + batchSize <= count; i += batchSize)
         {
-          if (result < MinResult)
+          const Philox::Batch batch = Generator.GenerateBatch(Counter);
+          Counter += Philox::LANE_COUNT;
+          for (size_t w = 0; w < Philox::BLOCK_SIZE; ++w)
           {
-            return MinResult;
+            T* const batchValues = values + i + w * Philox::LANE_COUNT;
+            for (size_t l = 0; l < Philox::LANE_COUNT; ++l)
+            {
+              batchValues[l] = Restrict(batchValues[l] + GetVariability(batch[w][l]));
+            }
           }
-          if (result > MaxResult)
+        }
+        for (; i + Philox::BLOCK_SIZE <= count; i += Philox::BLOCK_SIZE)
+        {
+          const Philox::Block block = Generator.Generate(Counter++);
+          for (size_t j = 0; j < Philox::BLOCK_SIZE; ++j)
           {
-            return MaxResult;
+            values[i + j] = Restrict(values[i + j] + GetVariability(block[j]));
           }
-          return result;
         }
+        if (i != count)
+        {
+          const Philox::Block block = Generator.Generate(Counter++);
+          for (size_t j = 0; i + j < count; ++j)
+          {
+            values[i + j] = Restrict(values[i + j] + GetVariability(block[j]));
+          }
+        }
+      }
+
+      template <typename T>
+      size_t Mutagen<T>::GenerateIndex(const size_t count) noexcept
+      {
+        if (count == 0)
+        {
+          return 0;
+        }
+        // The index takes two words of one block, so the modulo bias is negligible.
+        const Philox::Block block = Generator.Generate(Counter++);
+        const uint64_t word = (static_cast<uint64_t>(block[1]) << 32) | block[0];
+        return static_cast<size_t>(word % count);
+      }
+
+      template <typename T>
+      T Mutagen<T>::GetVariability(const uint32_t word) const noexcept
+      {
+        // 24 high bits are exact in float, and a signed conversion is cheap for vectorized loops.
+        constexpr T scale = static_cast<T>(2.L / 16777216.L);
+        return (static_cast<T>(static_cast<int32_t>(word >> 8)) * scale - 1) * VariabilityForce;
+      }
+
+      template <typename T>
+      T Mutagen<T>::Restrict(const T value) const noexcept
+      {
+        return std::min(std::max(value, MinResult), MaxResult);
       }
     }
   }
@@ -4,11 +4,17 @@
 #include <cstddef>
 #include <type_traits>
 #include <cstring>
+#include <cmath>
+#include <memory>
+#include <memory_resource>
+#include <stdexcept>
 #include <istream>
 #include <ostream>
 
+#include "Activation.hpp"
 #include "ValueGenerator.hpp"
 #include "Mutagen.hpp"
+#include "MemoryResource.hpp"
 
 namespace cnn
 {
@@ -16,6 +22,9 @@ namespace cnn
   {
     namespace common
     {
+      // Inputs and weights are copy-on-write blocks: copies of a neuron share them,
+      // and a block is duplicated only when it is written through a shared neuron.
+      // Blocks are aligned and padded with zeros to whole cache lines (see MemoryResource.hpp).
       template <typename T>
       class Neuron
       {
@@ -24,7 +33,8 @@ namespace cnn
 
       public:
 
-        Neuron(const size_t inputCount = 0);
+        // Inputs and weights are allocated by the resource.
+        Neuron(const size_t inputCount = 0, std::pmr::memory_resource* const resource = std::pmr::get_default_resource());
 
         Neuron(const Neuron& neuron);
 
@@ -35,6 +45,8 @@ namespace cnn
 
         Neuron& operator=(Neuron&& neuron) noexcept;
 
+        std::pmr::memory_resource* GetResource() const noexcept;
+
         size_t GetInputCount() const noexcept;
 
         // Exception guarantee: strong for this.
@@ -50,21 +62,27 @@ namespace cnn
         // Exception guarantee: strong for this.
         void SetWeight(const size_t index, const T value);
 
+        // It gives direct access to GetInputCount() contiguous weights (for computational kernels).
+        const T* GetWeights() const noexcept;
+
         T GetOutput() const noexcept;
 
         // Exception guarantee: strong for this.
         void SetOutput(const T value);
 
-        void GenerateOutput() noexcept;
+        void GenerateOutput(const ActivationType activationType = ActivationType::Sigmoid) noexcept;
 
+        // Exception guarantee: base for this.
         // It clears the state without changing of the topology.
-        void Clear() noexcept;
+        void Clear();
 
+        // Exception guarantee: base for this.
         // It clears the state without changing of the topology.
-        void ClearInputs() noexcept;
+        void ClearInputs();
 
+        // Exception guarantee: base for this.
         // It clears the state without changing of the topology.
-        void ClearWeights() noexcept;
+        void ClearWeights();
 
         // It clears the state without changing of the topology.
         void ClearOutput() noexcept;
@@ -80,50 +98,67 @@ namespace cnn
         // It loads full state.
         void Load(std::istream& istream);
 
-        // We expect that the method never throws any exception.
-        void FillWeights(ValueGenerator<T>& valueGenerator) noexcept;
+        // Exception guarantee: base for this.
+        void FillWeights(ValueGenerator<T>& valueGenerator);
 
-        // We expect that the method never throws any exception.
-        void Mutate(Mutagen<T>& mutagen) noexcept;
+        // Exception guarantee: base for this.
+        void Mutate(Mutagen<T>& mutagen);
+
+        // Exception guarantee: strong for this.
+        // It shares the weights of the neuron with the same input count, so they are duplicated only when one of the sides writes them.
+        void ShareWeights(const Neuron& neuron);
+
+        // Exception guarantee: strong for this.
+        // It copies the weights of the neuron with the same input count, so no memory is allocated, if own weights aren't shared.
+        void CopyWeights(const Neuron& neuron);
 
       private:
 
+        std::pmr::memory_resource* Resource;
+
         size_t InputCount;
         
-        std::unique_ptr<T[]> Inputs;
+        std::shared_ptr<T[]> Inputs;
         
-        std::unique_ptr<T[]> Weights;
+        std::shared_ptr<T[]> Weights;
         
         T Output;
 
+        // It allocates count zero values.
+        std::shared_ptr<T[]> Allocate(const size_t count) const;
+
+        // Exception guarantee: strong for values.
+        // It makes the values owned only by this neuron, so they can be written.
+        void Detach(std::shared_ptr<T[]>& values) const;
+
       };
 
       template <typename T>
-      Neuron<T>::Neuron(const size_t inputCount)
+      Neuron<T>::Neuron(const size_t inputCount, std::pmr::memory_resource* const resource)
       {
+        Resource = resource;
         InputCount = inputCount;
 
-        Inputs = std::make_unique<T[]>(InputCount);
-        Weights = std::make_unique<T[]>(InputCount);
-        Clear();
+        Inputs = Allocate(InputCount);
+        Weights = Allocate(InputCount);
+        Output = static_cast<T>(0.L);
       }
 
       template <typename T>
       Neuron<T>::Neuron(const Neuron& neuron)
         :
+        Resource{ neuron.Resource },
         InputCount{ neuron.InputCount },
+        Inputs{ neuron.Inputs },
+        Weights{ neuron.Weights },
         Output{ neuron.Output }
       {
-        Inputs = std::make_unique<T[]>(InputCount);
-        std::memcpy(Inputs.get(), neuron.Inputs.get(), sizeof(T)* InputCount);
-
-        Weights = std::make_unique<T[]>(InputCount);
-        std::memcpy(Weights.get(), neuron.Weights.get(), sizeof(T)* InputCount);
       }
 
       template <typename T>
       Neuron<T>::Neuron(Neuron&& neuron) noexcept
         :
+        Resource{ neuron.Resource },
         InputCount{ neuron.InputCount },
         Inputs{ std::move(neuron.Inputs) },
         Weights{ std::move(neuron.Weights) },
@@ -149,6 +184,7 @@ namespace cnn
       {
         if (this != &neuron)
         {
+          Resource = neuron.Resource;
           InputCount = neuron.InputCount;
           Inputs = std::move(neuron.Inputs);
           Weights = std::move(neuron.Weights);
@@ -159,6 +195,12 @@ namespace cnn
         return *this;
       }
 
+      template <typename T>
+      std::pmr::memory_resource* Neuron<T>::GetResource() const noexcept
+      {
+        return Resource;
+      }
+
       template <typename T>
       size_t Neuron<T>::GetInputCount() const noexcept
       {
@@ -170,7 +212,7 @@ namespace cnn
       {
         if (InputCount != inputCount)
         {
-          Neuron neuron{ inputCount };
+          Neuron neuron{ inputCount, Resource };
           // Beware, it is very intimate place for strong exception guarantee.
           std::swap(neuron, *this);
         }
@@ -193,6 +235,7 @@ namespace cnn
         {
           throw std::range_error("cnn::engine::common::Neuron::SetInput(), index >= InputCount.");
         }
+        Detach(Inputs);
         Inputs[index] = value;
       }
 
@@ -213,9 +256,16 @@ namespace cnn
         {
           throw std::range_error("cnn::engine::common::Neuron::SetWeight(), index >= InputCount.");
         }
+        Detach(Weights);
         Weights[index] = value;
       }
 
+      template <typename T>
+      const T* Neuron<T>::GetWeights() const noexcept
+      {
+        return Weights.get();
+      }
+
       template <typename T>
       T Neuron<T>::GetOutput() const noexcept
       {
@@ -229,18 +279,18 @@ namespace cnn
       }
 
       template <typename T>
-      void Neuron<T>::GenerateOutput() noexcept
+      void Neuron<T>::GenerateOutput(const ActivationType activationType) noexcept
       {
         Output = static_cast<T>(0.L);
         for (size_t i = 0; i < InputCount; ++i)
         {
           Output += Inputs[i] * Weights[i];
         }
-        Output = 1 / (1 + exp(-Output));
+        Activation::Activate(activationType, &Output, 1);
       }
 
       template <typename T>
-      void Neuron<T>::Clear() noexcept
+      void Neuron<T>::Clear()
       {
         ClearInputs();
         ClearWeights();
@@ -248,8 +298,14 @@ namespace cnn
       }
 
       template <typename T>
-      void Neuron<T>::ClearInputs() noexcept
+      void Neuron<T>::ClearInputs()
       {
+        // A shared block is not copied, because all values are overwritten.
+        if (Inputs.use_count() > 1)
+        {
+          Inputs = Allocate(InputCount);
+          return;
+        }
         for (size_t i = 0; i < InputCount; ++i)
         {
           Inputs[i] = static_cast<T>(0.L);
@@ -257,8 +313,14 @@ namespace cnn
       }
 
       template <typename T>
-      void Neuron<T>::ClearWeights() noexcept
+      void Neuron<T>::ClearWeights()
       {
+        // A shared block is not copied, because all values are overwritten.
+        if (Weights.use_count() > 1)
+        {
+          Weights = Allocate(InputCount);
+          return;
+        }
         for (size_t i = 0; i < InputCount; ++i)
         {
           Weights[i] = static_cast<T>(0.L);
@@ -275,8 +337,8 @@ namespace cnn
       void Neuron<T>::Reset() noexcept
       {
         InputCount = 0;
-        Inputs.reset(nullptr);
-        Weights.reset(nullptr);
+        Inputs.reset();
+        Weights.reset();
         Output = static_cast<T>(0.L);
       }
 
@@ -319,8 +381,8 @@ namespace cnn
         decltype(Weights) weights;
         decltype(Output) output{};
 
-        inputs = std::make_unique<T[]>(inputCount);
-        weights = std::make_unique<T[]>(inputCount);
+        inputs = Allocate(inputCount);
+        weights = Allocate(inputCount);
         for (size_t i = 0; i < inputCount; ++i)
         {
           istream.read(reinterpret_cast<char* const>(&(inputs[i])), sizeof(inputs[i]));
@@ -341,8 +403,9 @@ namespace cnn
       }
 
       template <typename T>
-      void Neuron<T>::FillWeights(ValueGenerator<T>& valueGenerator) noexcept
+      void Neuron<T>::FillWeights(ValueGenerator<T>& valueGenerator)
       {
+        Detach(Weights);
         for (size_t i = 0; i < InputCount; ++i)
         {
           Weights[i] = valueGenerator.Generate();
@@ -350,14 +413,66 @@ namespace cnn
       }
 
       template <typename T>
-      void Neuron<T>::Mutate(Mutagen<T>& mutagen) noexcept
+      void Neuron<T>::Mutate(Mutagen<T>& mutagen)
       {
-        for (size_t i = 0; i < InputCount; ++i)
+        Detach(Weights);
+        mutagen.Mutate(Weights.get(), InputCount);
+      }
+
+      template <typename T>
+      void Neuron<T>::ShareWeights(const Neuron& neuron)
+      {
+        if (InputCount != neuron.InputCount)
         {
-          Weights[i] = mutagen.Mutate(Weights[i]);
+          throw std::invalid_argument("cnn::engine::common::Neuron::ShareWeights(), InputCount != neuron.InputCount.");
+        }
+        Weights = neuron.Weights;
+      }
+
+      template <typename T>
+      void Neuron<T>::CopyWeights(const Neuron& neuron)
+      {
+        if (InputCount != neuron.InputCount)
+        {
+          throw std::invalid_argument("cnn::engine::common::Neuron::CopyWeights(), InputCount != neuron.InputCount.");
+        }
+        if (Weights == neuron.Weights)
+        {
+          return;
+        }
+        if (Weights.use_count() > 1)
+        {
+          Weights = Allocate(InputCount);
+        }
+        std::memcpy(Weights.get(), neuron.Weights.get(), sizeof(T) * InputCount);
+      }
+
+      template <typename T>
+      std::shared_ptr<T[]> Neuron<T>::Allocate(const size_t count) const
+      {
+        const size_t paddedCount = GetPaddedCount<T>(count);
+        T* const values = AllocateResourceArray<T>(paddedCount, Resource, BUFFER_ALIGNMENT);
+        if (paddedCount != 0)
+        {
+          std::memset(values, 0, sizeof(T) * paddedCount);
+        }
+        // The control block is placed in the resource too. If it can't be allocated, the values are deleted.
+        return std::shared_ptr<T[]>{ values,
+                                     ResourceArrayDeleter<T>{ Resource, paddedCount, BUFFER_ALIGNMENT },
+                                     std::pmr::polymorphic_allocator<T>{ Resource } };
+      }
+
+      template <typename T>
+      void Neuron<T>::Detach(std::shared_ptr<T[]>& values) const
+      {
+        // Other owners can only release the block meanwhile, so the worst case is an extra copy.
+        if (values.use_count() > 1)
+        {
+          std::shared_ptr<T[]> ownValues = Allocate(InputCount);
+          std::memcpy(ownValues.get(), values.get(), sizeof(T) * InputCount);
+          values = std::move(ownValues);
         }
       }
     }
   }
 }
-
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Neuron.hpp"
+#include "WeightStamp.hpp"
 
 namespace cnn
 {
@@ -12,6 +13,8 @@ namespace cnn
       // The protecting reference proxies all methods of Neuron and doesn't allow to use methods, which change
       // the topology of the target neuron.
       // It allow to protect consistency of complex objects, which contain the target neuron as its part.
+      // If the owner gives its weight stamp, then every write of weights through the reference renews the stamp,
+      // so caches of the owner, which are derived from weights, are rebuilt (see WeightStamp).
       template <typename T>
       class NeuronProtectingReference
       {
@@ -20,7 +23,7 @@ namespace cnn
 
       public:
 
-        NeuronProtectingReference(Neuron<T>& neuron);
+        NeuronProtectingReference(Neuron<T>& neuron, uint64_t* const weightStamp = nullptr);
 
         NeuronProtectingReference(const NeuronProtectingReference& NeuronProtectingReference) noexcept;
 
@@ -47,16 +50,19 @@ namespace cnn
         // Exception guarantee: strong for the neuron.
         void SetOutput(const T value) const;
 
-        void GenerateOutput() const noexcept;
+        void GenerateOutput(const ActivationType activationType = ActivationType::Sigmoid) const noexcept;
 
+        // Exception guarantee: base for the neuron.
         // It clears the state without changing of the topology of the neuron.
-        void Clear() const noexcept;
+        void Clear() const;
 
+        // Exception guarantee: base for the neuron.
         // It clears the state without changing of the topology of the neuron.
-        void ClearInputs() const noexcept;
+        void ClearInputs() const;
 
+        // Exception guarantee: base for the neuron.
         // It clears the state without changing of the topology of the neuron.
-        void ClearWeights() const noexcept;
+        void ClearWeights() const;
 
         // It clears the state without changing of the topology of the neuron.
         void ClearOutput() const noexcept;
@@ -65,29 +71,34 @@ namespace cnn
         // It saves full state.
         void Save(std::ostream& ostream) const;
 
-        // We expect that the method never throws any exception.
-        void FillWeights(ValueGenerator<T>& valueGenerator) const noexcept;
+        // Exception guarantee: base for the neuron.
+        void FillWeights(ValueGenerator<T>& valueGenerator) const;
 
-        // We expect that the method never throws any exception.
-        void Mutate(Mutagen<T>& mutagen) const noexcept;
+        // Exception guarantee: base for the neuron.
+        void Mutate(Mutagen<T>& mutagen) const;
 
       private:
 
         Neuron<T>& Neuron_;
+        uint64_t* const WeightStamp_;
+
+        void RenewWeightStamp() const noexcept;
 
       };
 
       template <typename T>
-      NeuronProtectingReference<T>::NeuronProtectingReference(Neuron<T>& neuron)
+      NeuronProtectingReference<T>::NeuronProtectingReference(Neuron<T>& neuron, uint64_t* const weightStamp)
         :
-        Neuron_{ neuron }
+        Neuron_{ neuron },
+        WeightStamp_{ weightStamp }
       {
       }
 
       template <typename T>
       NeuronProtectingReference<T>::NeuronProtectingReference(const NeuronProtectingReference& NeuronProtectingReference) noexcept
         :
-        Neuron_{ NeuronProtectingReference.Neuron_ }
+        Neuron_{ NeuronProtectingReference.Neuron_ },
+        WeightStamp_{ NeuronProtectingReference.WeightStamp_ }
       {
       }
 
@@ -118,6 +129,7 @@ namespace cnn
       template <typename T>
       void NeuronProtectingReference<T>::SetWeight(const size_t index, const T value) const
       {
+        RenewWeightStamp();
         Neuron_.SetWeight(index, value);
       }
 
@@ -134,26 +146,28 @@ namespace cnn
       }
 
       template <typename T>
-      void NeuronProtectingReference<T>::GenerateOutput() const noexcept
+      void NeuronProtectingReference<T>::GenerateOutput(const ActivationType activationType) const noexcept
       {
-        Neuron_.GenerateOutput();
+        Neuron_.GenerateOutput(activationType);
       }
 
       template <typename T>
-      void NeuronProtectingReference<T>::Clear() const noexcept
+      void NeuronProtectingReference<T>::Clear() const
       {
+        RenewWeightStamp();
         Neuron_.Clear();
       }
 
       template <typename T>
-      void NeuronProtectingReference<T>::ClearInputs() const noexcept
+      void NeuronProtectingReference<T>::ClearInputs() const
       {
         Neuron_.ClearInputs();
       }
 
       template <typename T>
-      void NeuronProtectingReference<T>::ClearWeights() const noexcept
+      void NeuronProtectingReference<T>::ClearWeights() const
       {
+        RenewWeightStamp();
         Neuron_.ClearWeights();
       }
 
@@ -170,16 +184,27 @@ namespace cnn
       }
 
       template <typename T>
-      void NeuronProtectingReference<T>::FillWeights(ValueGenerator<T>& valueGenerator) const noexcept
+      void NeuronProtectingReference<T>::FillWeights(ValueGenerator<T>& valueGenerator) const
       {
+        RenewWeightStamp();
         Neuron_.FillWeights(valueGenerator);
       }
 
       template <typename T>
-      void NeuronProtectingReference<T>::Mutate(Mutagen<T>& mutagen) const noexcept
+      void NeuronProtectingReference<T>::Mutate(Mutagen<T>& mutagen) const
       {
+        RenewWeightStamp();
         Neuron_.Mutate(mutagen);
       }
+
+      template <typename T>
+      void NeuronProtectingReference<T>::RenewWeightStamp() const noexcept
+      {
+        if (WeightStamp_ != nullptr)
+        {
+          *WeightStamp_ = WeightStamp::Generate();
+        }
+      }
     }
   }
 }
\ No newline at end of file
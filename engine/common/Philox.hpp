@@ -0,0 +1,146 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <array>
+
+namespace cnn
+{
+  namespace engine
+  {
+    namespace common
+    {
+      // Philox is the counter-based generator Philox4x32-10 (Salmon et al., "Parallel random numbers: as easy as 1, 2, 3").
+      // A block of 4 random words is a pure function of the key and the counter, so blocks can be generated
+      // in any order and in parallel, and every stream (the high half of the counter) is independent and reproducible.
+      class Philox
+      {
+      public:
+
+        constexpr static size_t BLOCK_SIZE = 4;
+
+        // Blocks of a batch are generated together, so the rounds are vectorized over lanes.
+        constexpr static size_t LANE_COUNT = 8;
+
+        using Block = std::array<uint32_t, BLOCK_SIZE>;
+
+        // Words of LANE_COUNT blocks: Batch[w][l] is the w-th word of the block of (counter + l).
+        using Batch = std::array<std::array<uint32_t, LANE_COUNT>, BLOCK_SIZE>;
+
+        Philox(const uint64_t key = 0, const uint64_t stream = 0) noexcept;
+
+        uint64_t GetKey() const noexcept;
+
+        void SetKey(const uint64_t key) noexcept;
+
+        uint64_t GetStream() const noexcept;
+
+        void SetStream(const uint64_t stream) noexcept;
+
+        // It returns the block of the counter in the stream.
+        Block Generate(const uint64_t counter) const noexcept;
+
+        // It returns the blocks of counters [counter, counter + LANE_COUNT) in the stream.
+        Batch GenerateBatch(const uint64_t counter) const noexcept;
+
+      private:
+
+        constexpr static uint32_t MULTIPLIER_0 = 0xD2511F53;
+        constexpr static uint32_t MULTIPLIER_1 = 0xCD9E8D57;
+        constexpr static uint32_t WEYL_0 = 0x9E3779B9;
+        constexpr static uint32_t WEYL_1 = 0xBB67AE85;
+        constexpr static size_t ROUND_COUNT = 10;
+
+        uint64_t Key;
+        uint64_t Stream;
+
+      };
+
+      inline Philox::Philox(const uint64_t key, const uint64_t stream) noexcept
+        :
+        Key{ key },
+        Stream{ stream }
+      {
+      }
+
+      inline uint64_t Philox::GetKey() const noexcept
+      {
+        return Key;
+      }
+
+      inline void Philox::SetKey(const uint64_t key) noexcept
+      {
+        Key = key;
+      }
+
+      inline uint64_t Philox::GetStream() const noexcept
+      {
+        return Stream;
+      }
+
+      inline void Philox::SetStream(const uint64_t stream) noexcept
+      {
+        Stream = stream;
+      }
+
+      inline Philox::Block Philox::Generate(const uint64_t counter) const noexcept
+      {
+        uint32_t c0 = static_cast<uint32_t>(counter);
+        uint32_t c1 = static_cast<uint32_t>(counter >> 32);
+        uint32_t c2 = static_cast<uint32_t>(Stream);
+        uint32_t c3 = static_cast<uint32_t>(Stream >> 32);
+        uint32_t k0 = static_cast<uint32_t>(Key);
+        uint32_t k1 = static_cast<uint32_t>(Key >> 32);
+
+        for (size_t r = 0; r < ROUND_COUNT; ++r)
+        {
+          const uint64_t product0 = static_cast<uint64_t>(MULTIPLIER_0) * c0;
+          const uint64_t product1 = static_cast<uint64_t>(MULTIPLIER_1) * c2;
+          const uint32_t n0 = static_cast<uint32_t>(product1 >> 32) ^ c1 ^ k0;
+          const uint32_t n2 = static_cast<uint32_t>(product0 >> 32) ^ c3 ^ k1;
+          c1 = static_cast<uint32_t>(product1);
+          c3 = static_cast<uint32_t>(product0);
+          c0 = n0;
+          c2 = n2;
+          k0 += WEYL_0;
+          k1 += WEYL_1;
+        }
+
+        return { c0, c1, c2, c3 };
+      }
+
+      inline Philox::Batch Philox::GenerateBatch(const uint64_t counter) const noexcept
+      {
+        Batch c;
+        for (size_t l = 0; l < LANE_COUNT; ++l)
+        {
+          c[0][l] = static_cast<uint32_t>(counter + l);
+          c[1][l] = static_cast<uint32_t>((counter + l) >> 32);
+          c[2][l] = static_cast<uint32_t>(Stream);
+          c[3][l] = static_cast<uint32_t>(Stream >> 32);
+        }
+        uint32_t k0 = static_cast<uint32_t>(Key);
+        uint32_t k1 = static_cast<uint32_t>(Key >> 32);
+
+        for (size_t r = 0; r < ROUND_COUNT; ++r)
+        {
+          for (size_t l = 0; l < LANE_COUNT; ++l)
+          {
+            const uint64_t product0 = static_cast<uint64_t>(MULTIPLIER_0) * c[0][l];
+            const uint64_t product1 = static_cast<uint64_t>(MULTIPLIER_1) * c[2][l];
+            const uint32_t n0 = static_cast<uint32_t>(product1 >> 32) ^ c[1][l] ^ k0;
+            const uint32_t n2 = static_cast<uint32_t>(product0 >> 32) ^ c[3][l] ^ k1;
+            c[1][l] = static_cast<uint32_t>(product1);
+            c[3][l] = static_cast<uint32_t>(product0);
+            c[0][l] = n0;
+            c[2][l] = n2;
+          }
+          k0 += WEYL_0;
+          k1 += WEYL_1;
+        }
+
+        return c;
+      }
+    }
+  }
+}
@@ -0,0 +1,124 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cmath>
+#include <algorithm>
+#include <type_traits>
+
+#if defined(__AVX2__) || defined(__AVXVNNI__) || defined(__AVX512VNNI__)
+#include <immintrin.h>
+#endif
+
+#include "MemoryResource.hpp"
+
+namespace cnn
+{
+  namespace engine
+  {
+    namespace common
+    {
+      // Quantization maps values to uint8_t asymmetrically (value = scale * (q - zeroPoint))
+      // and weights to int8_t symmetrically (weight = scale * q), so products are accumulated in int32_t.
+      // The dot product is compiled for the widest available instruction set: AVX-512 VNNI, AVX-VNNI, AVX2 or scalar code.
+      class Quantization
+      {
+      public:
+
+        constexpr static int32_t MAX_VALUE = 255;
+
+        constexpr static int32_t MAX_WEIGHT = 127;
+
+        // It returns sum(values[i] * weights[i]), where count is a multiple of BUFFER_ALIGNMENT.
+        static int32_t DotProduct(const uint8_t* const values, const int8_t* const weights, const size_t count) noexcept;
+
+        template <typename T>
+        static uint8_t QuantizeValue(const T value, const T scale, const int32_t zeroPoint) noexcept;
+
+        template <typename T>
+        static int8_t QuantizeWeight(const T weight, const T scale) noexcept;
+
+        // It returns the name of the instruction set of the dot product.
+        static const char* GetKernelName() noexcept;
+
+      private:
+
+        ~Quantization() = delete;
+
+      };
+
+      inline int32_t Quantization::DotProduct(const uint8_t* const values, const int8_t* const weights, const size_t count) noexcept
+      {
+#if defined(__AVX512VNNI__) && defined(__AVX512VL__)
+        __m256i sums = _mm256_setzero_si256();
+        for (size_t i = 0; i < count; i += 32)
+        {
+          const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values + i));
+          const __m256i w = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(weights + i));
+          sums = _mm256_dpbusd_epi32(sums, v, w);
+        }
+#elif defined(__AVXVNNI__)
+        __m256i sums = _mm256_setzero_si256();
+        for (size_t i = 0; i < count; i += 32)
+        {
+          const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values + i));
+          const __m256i w = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(weights + i));
+          sums = _mm256_dpbusd_avx_epi32(sums, v, w);
+        }
+#elif defined(__AVX2__)
+        // Bytes are widened to 16 bits, because _mm256_maddubs_epi16() saturates sums of pairs of products.
+        __m256i sums = _mm256_setzero_si256();
+        for (size_t i = 0; i < count; i += 16)
+        {
+          const __m256i v = _mm256_cvtepu8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(values + i)));
+          const __m256i w = _mm256_cvtepi8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(weights + i)));
+          sums = _mm256_add_epi32(sums, _mm256_madd_epi16(v, w));
+        }
+#endif
+
+#if defined(__AVX2__) || defined(__AVXVNNI__) || defined(__AVX512VNNI__)
+        __m128i sum = _mm_add_epi32(_mm256_castsi256_si128(sums), _mm256_extracti128_si256(sums, 1));
+        sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(1, 0, 3, 2)));
+        sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(2, 3, 0, 1)));
+        return _mm_cvtsi128_si32(sum);
+#else
+        int32_t sum = 0;
+        for (size_t i = 0; i < count; ++i)
+        {
+          sum += static_cast<int32_t>(values[i]) * static_cast<int32_t>(weights[i]);
+        }
+        return sum;
+#endif
+      }
+
+      template <typename T>
+      uint8_t Quantization::QuantizeValue(const T value, const T scale, const int32_t zeroPoint) noexcept
+      {
+        static_assert(std::is_floating_point<T>::value);
+        const T q = std::round(value / scale) + static_cast<T>(zeroPoint);
+        return static_cast<uint8_t>(std::clamp(q, static_cast<T>(0), static_cast<T>(MAX_VALUE)));
+      }
+
+      template <typename T>
+      int8_t Quantization::QuantizeWeight(const T weight, const T scale) noexcept
+      {
+        static_assert(std::is_floating_point<T>::value);
+        const T q = std::round(weight / scale);
+        return static_cast<int8_t>(std::clamp(q, static_cast<T>(-MAX_WEIGHT), static_cast<T>(MAX_WEIGHT)));
+      }
+
+      inline const char* Quantization::GetKernelName() noexcept
+      {
+#if defined(__AVX512VNNI__) && defined(__AVX512VL__)
+        return "AVX-512 VNNI";
+#elif defined(__AVXVNNI__)
+        return "AVX-VNNI";
+#elif defined(__AVX2__)
+        return "AVX2";
+#else
+        return "scalar";
+#endif
+      }
+    }
+  }
+}
@@ -0,0 +1,165 @@
+#include "ThreadPool.hpp"
+
+namespace cnn
+{
+  namespace engine
+  {
+    namespace common
+    {
+      ThreadPool::ThreadPool(const size_t threadCount)
+        :
+        Running{ false },
+        Stop{ false },
+        Generation{ 0 },
+        BusyWorkerCount{ 0 },
+        TaskInvoker{ nullptr },
+        TaskFunction{ nullptr },
+        TaskCount{ 0 },
+        NextTask{ 0 }
+      {
+        size_t threadCount_ = threadCount ? threadCount : std::thread::hardware_concurrency();
+        if (threadCount_ == 0)
+        {
+          threadCount_ = 1;
+        }
+
+        Workers.reserve(threadCount_ - 1);
+        try
+        {
+          for (size_t i = 1; i < threadCount_; ++i)
+          {
+            Workers.emplace_back(&ThreadPool::WorkerLoop, this);
+          }
+        }
+        catch (...)
+        {
+          {
+            std::lock_guard<std::mutex> lock{ Mutex };
+            Stop = true;
+          }
+          WorkCondition.notify_all();
+          for (auto& worker : Workers)
+          {
+            worker.join();
+          }
+          throw;
+        }
+      }
+
+      ThreadPool::~ThreadPool()
+      {
+        {
+          std::lock_guard<std::mutex> lock{ Mutex };
+          Stop = true;
+        }
+        WorkCondition.notify_all();
+        for (auto& worker : Workers)
+        {
+          worker.join();
+        }
+      }
+
+      size_t ThreadPool::GetThreadCount() const noexcept
+      {
+        return Workers.size() + 1;
+      }
+
+      void ThreadPool::Run(const size_t taskCount, const Invoker invoker, void* const function)
+      {
+        if (taskCount == 0)
+        {
+          return;
+        }
+
+        // The pool is already used by another caller (or by a task of this pool), so we work alone.
+        if ((Workers.size() == 0) || (taskCount == 1) || Running.exchange(true))
+        {
+          for (size_t taskIndex = 0; taskIndex < taskCount; ++taskIndex)
+          {
+            invoker(function, taskIndex);
+          }
+          return;
+        }
+
+        {
+          std::lock_guard<std::mutex> lock{ Mutex };
+          TaskInvoker = invoker;
+          TaskFunction = function;
+          TaskCount = taskCount;
+          NextTask.store(0);
+          TaskException = nullptr;
+          BusyWorkerCount = Workers.size();
+          ++Generation;
+        }
+        WorkCondition.notify_all();
+
+        RunTasks();
+
+        std::exception_ptr exception;
+        {
+          std::unique_lock<std::mutex> lock{ Mutex };
+          DoneCondition.wait(lock, [this]() { return BusyWorkerCount == 0; });
+          TaskInvoker = nullptr;
+          TaskFunction = nullptr;
+          TaskCount = 0;
+          std::swap(exception, TaskException);
+        }
+        Running.store(false);
+
+        if (exception)
+        {
+          std::rethrow_exception(exception);
+        }
+      }
+
+      void ThreadPool::RunTasks() noexcept
+      {
+        for (size_t taskIndex = NextTask.fetch_add(1); taskIndex < TaskCount; taskIndex = NextTask.fetch_add(1))
+        {
+          try
+          {
+            TaskInvoker(TaskFunction, taskIndex);
+          }
+          catch (...)
+          {
+            std::lock_guard<std::mutex> lock{ Mutex };
+            if (!TaskException)
+            {
+              TaskException = std::current_exception();
+            }
+            // The rest of tasks are skipped.
+            NextTask.store(TaskCount);
+          }
+        }
+      }
+
+      void ThreadPool::WorkerLoop() noexcept
+      {
+        size_t generation{};
+        while (true)
+        {
+          {
+            std::unique_lock<std::mutex> lock{ Mutex };
+            WorkCondition.wait(lock, [this, generation]() { return Stop || (Generation != generation); });
+            if (Stop)
+            {
+              return;
+            }
+            generation = Generation;
+          }
+
+          RunTasks();
+
+          {
+            std::lock_guard<std::mutex> lock{ Mutex };
+            --BusyWorkerCount;
+            if (BusyWorkerCount == 0)
+            {
+              DoneCondition.notify_one();
+            }
+          }
+        }
+      }
+    }
+  }
+}
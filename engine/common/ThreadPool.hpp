@@ -0,0 +1,89 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <vector>
+#include <exception>
+
+namespace cnn
+{
+  namespace engine
+  {
+    namespace common
+    {
+      // ThreadPool is a fork/join pool, which is shared by layers and networks for intra-layer parallelism.
+      // The calling thread takes part in the work, so the pool starts (threadCount - 1) workers.
+      // If the pool is busy (for example, ParallelFor() is called from a task), the work is done by the caller.
+      class ThreadPool
+      {
+      public:
+
+        // If threadCount == 0, then std::thread::hardware_concurrency() is used.
+        ThreadPool(const size_t threadCount = 0);
+
+        ThreadPool(const ThreadPool& threadPool) = delete;
+
+        ThreadPool(ThreadPool&& threadPool) noexcept = delete;
+
+        ThreadPool& operator=(const ThreadPool& threadPool) = delete;
+
+        ThreadPool& operator=(ThreadPool&& threadPool) noexcept = delete;
+
+        ~ThreadPool();
+
+        // It returns the count of threads including the calling thread.
+        size_t GetThreadCount() const noexcept;
+
+        // Exception guarantee: base for this.
+        // It calls function(taskIndex) for each taskIndex in [0, taskCount) and waits for all of them.
+        // If several tasks throw, only the first exception is rethrown.
+        // The method doesn't allocate memory.
+        template <typename Function>
+        void ParallelFor(const size_t taskCount, Function& function);
+
+      private:
+
+        using Invoker = void(*)(void* const function, const size_t taskIndex);
+
+        std::vector<std::thread> Workers;
+
+        std::atomic<bool> Running;
+
+        std::mutex Mutex;
+        std::condition_variable WorkCondition;
+        std::condition_variable DoneCondition;
+
+        bool Stop;
+        size_t Generation;
+        size_t BusyWorkerCount;
+
+        Invoker TaskInvoker;
+        void* TaskFunction;
+        size_t TaskCount;
+        std::atomic<size_t> NextTask;
+        std::exception_ptr TaskException;
+
+        void Run(const size_t taskCount, const Invoker invoker, void* const function);
+
+        void RunTasks() noexcept;
+
+        void WorkerLoop() noexcept;
+
+      };
+
+      template <typename Function>
+      void ThreadPool::ParallelFor(const size_t taskCount, Function& function)
+      {
+        const Invoker invoker = [](void* const f, const size_t taskIndex)
+        {
+          (*static_cast<Function*>(f))(taskIndex);
+        };
+        Run(taskCount, invoker, &function);
+      }
+    }
+  }
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstdint>
+#include <atomic>
+
+namespace cnn
+{
+  namespace engine
+  {
+    namespace common
+    {
+      // WeightStamp identifies a state of weights of a layer: a layer takes a new stamp, when its weights are written,
+      // and the stamp of the source, when it shares or copies weights. Caches, which are derived from weights, keep the stamp
+      // they were built for, so a layer, which shares weights of different networks in turn, rebuilds only the caches of changed weights.
+      class WeightStamp
+      {
+      public:
+
+        // Zero is never generated, so it marks caches, which were never built.
+        constexpr static uint64_t NONE = 0;
+
+        // It returns a stamp, which was never returned before.
+        static uint64_t Generate() noexcept;
+
+      private:
+
+        ~WeightStamp() = delete;
+
+      };
+
+      inline uint64_t WeightStamp::Generate() noexcept
+      {
+        static std::atomic<uint64_t> lastStamp{ NONE };
+        return lastStamp.fetch_add(1, std::memory_order_relaxed) + 1;
+      }
+    }
+  }
+}
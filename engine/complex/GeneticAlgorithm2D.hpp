@@ -2,14 +2,19 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <cmath>
 #include <limits>
+#include <utility>
+#include <vector>
 
 #include "../complex/Network2D.hpp"
 #include "../complex/Lesson2DLibrary.hpp"
 #include "../common/ValueGenerator.hpp"
 #include "../common/Mutagen.hpp"
+#include "../common/ThreadPool.hpp"
 
 #include "GeneticTest2D.hpp"
+#include "GeneticTester2D.hpp"
 
 namespace cnn
 {
@@ -46,6 +51,15 @@ namespace cnn
         const common::Mutagen<T>& GetMutagen() const noexcept;
         void SetMutagen(const common::Mutagen<T>& mutagen);
 
+        // If the count or the rate is not zero, then every iteration mutates only that many weights in place
+        // and restores them, if the mutant is not better. The count is used before the rate.
+        size_t GetSparseMutationCount() const noexcept;
+        void SetSparseMutationCount(const size_t sparseMutationCount);
+
+        // The fraction of weights, which are mutated by every iteration.
+        T GetSparseMutationRate() const noexcept;
+        void SetSparseMutationRate(const T sparseMutationRate);
+
         void Clear() noexcept;
 
         Network2D<T> Run(const Lesson2DLibrary<T>& lessonLibrary, const Network2D<T>& sourceNetwork);
@@ -60,6 +74,16 @@ namespace cnn
         common::ValueGenerator<T> ValueGenerator;
         common::Mutagen<T> Mutagen;
 
+        size_t SparseMutationCount;
+        T SparseMutationRate;
+
+        // It returns 0 for the dense mutation.
+        size_t GetMutatedWeightCount(const Network2D<T>& network) const noexcept;
+
+        Network2D<T> RunDense(const Lesson2DLibrary<T>& lessonLibrary, const Network2D<T>& sourceNetwork);
+
+        Network2D<T> RunSparse(const Lesson2DLibrary<T>& lessonLibrary, const Network2D<T>& sourceNetwork, const size_t sparseMutationCount);
+
         void CheckTopologies(const Lesson2DLibrary<T>& lessonLibrary, const Network2D<T>& sourceNetwork) const;
 
       };
@@ -69,7 +93,9 @@ namespace cnn
                                                 const size_t iterationCount)
         :
         ThreadCount{ threadCount },
-        IterationCount{ iterationCount }
+        IterationCount{ iterationCount },
+        SparseMutationCount{ 0 },
+        SparseMutationRate{ 0 }
       {
       }
 
@@ -79,7 +105,9 @@ namespace cnn
         ThreadCount{ algorithm.ThreadCount },
         IterationCount{ algorithm.IterationCount },
         ValueGenerator{ std::move(algorithm.ValueGenerator) },
-        Mutagen{ std::move(algorithm.Mutagen) }
+        Mutagen{ std::move(algorithm.Mutagen) },
+        SparseMutationCount{ algorithm.SparseMutationCount },
+        SparseMutationRate{ algorithm.SparseMutationRate }
       {
         algorithm.Reset();
       }
@@ -105,6 +133,8 @@ namespace cnn
           IterationCount = algorithm.IterationCount;
           ValueGenerator = std::move(algorithm.ValueGenerator);
           Mutagen = std::move(algorithm.Mutagen);
+          SparseMutationCount = algorithm.SparseMutationCount;
+          SparseMutationRate = algorithm.SparseMutationRate;
 
           algorithm.Reset();
         }
@@ -159,6 +189,34 @@ namespace cnn
         Mutagen = mutagen;
       }
 
+      template <typename T>
+      size_t GeneticAlgorithm2D<T>::GetSparseMutationCount() const noexcept
+      {
+        return SparseMutationCount;
+      }
+
+      template <typename T>
+      void GeneticAlgorithm2D<T>::SetSparseMutationCount(const size_t sparseMutationCount)
+      {
+        SparseMutationCount = sparseMutationCount;
+      }
+
+      template <typename T>
+      T GeneticAlgorithm2D<T>::GetSparseMutationRate() const noexcept
+      {
+        return SparseMutationRate;
+      }
+
+      template <typename T>
+      void GeneticAlgorithm2D<T>::SetSparseMutationRate(const T sparseMutationRate)
+      {
+        if ((sparseMutationRate < 0) || (sparseMutationRate > 1))
+        {
+          throw std::invalid_argument("cnn::engine::complex::GeneticAlgorithm2D::SetSparseMutationRate(), (sparseMutationRate < 0) || (sparseMutationRate > 1).");
+        }
+        SparseMutationRate = sparseMutationRate;
+      }
+
       template <typename T>
       void GeneticAlgorithm2D<T>::Clear() noexcept
       {
@@ -166,6 +224,8 @@ namespace cnn
         IterationCount = MIN_ITERATION_COUNT;
         ValueGenerator.Clear();
         Mutagen.Clear();
+        SparseMutationCount = 0;
+        SparseMutationRate = 0;
       }
 
       template <typename T>
@@ -174,26 +234,87 @@ namespace cnn
       {
         CheckTopologies(lessonLibrary, sourceNetwork);
 
+        const size_t sparseMutationCount = GetMutatedWeightCount(sourceNetwork);
+        if (sparseMutationCount != 0)
+        {
+          return RunSparse(lessonLibrary, sourceNetwork, sparseMutationCount);
+        }
+        return RunDense(lessonLibrary, sourceNetwork);
+      }
+
+      template <typename T>
+      size_t GeneticAlgorithm2D<T>::GetMutatedWeightCount(const Network2D<T>& network) const noexcept
+      {
+        if (SparseMutationCount != 0)
+        {
+          return SparseMutationCount;
+        }
+        return static_cast<size_t>(std::ceil(SparseMutationRate * static_cast<T>(network.GetWeightCount())));
+      }
+
+      template <typename T>
+      Network2D<T> GeneticAlgorithm2D<T>::RunDense(const Lesson2DLibrary<T>& lessonLibrary, const Network2D<T>& sourceNetwork)
+      {
+        common::ThreadPool threadPool{ ThreadCount };
+        GeneticTester2D<T> tester{ lessonLibrary, threadPool };
+
+        // Networks own their weights, so after the first iteration an iteration doesn't allocate memory.
         T bestError = std::numeric_limits<T>::max();
-        Network2D<T> bestNetwork = sourceNetwork;
+        Network2D<T> bestNetwork{ sourceNetwork.GetTopology(), sourceNetwork.GetResource() };
+        Network2D<T> newNetwork{ sourceNetwork.GetTopology(), sourceNetwork.GetResource() };
+        bestNetwork.CopyWeights(sourceNetwork);
+        bestNetwork.CopyExecutionOptions(sourceNetwork);
+        newNetwork.CopyExecutionOptions(sourceNetwork);
 
         for (size_t i = 0; i < IterationCount; ++i)
         {
-          Network2D<T> newNetwork = bestNetwork;
+          newNetwork.CopyWeights(bestNetwork);
           newNetwork.Mutate(Mutagen);
 
-          GeneticTest2D<T> test(lessonLibrary,
-                                newNetwork,
-                                ThreadCount);
-
-          if (test.GetTotalError() < bestError)
+          const T error = tester.Test(newNetwork);
+          if (error < bestError)
           {
             std::swap(bestNetwork, newNetwork);
-            bestError = test.GetTotalError();
+            bestError = error;
+          }
+        }
+
+        return bestNetwork;
+      }
+
+      template <typename T>
+      Network2D<T> GeneticAlgorithm2D<T>::RunSparse(const Lesson2DLibrary<T>& lessonLibrary,
+                                                    const Network2D<T>& sourceNetwork,
+                                                    const size_t sparseMutationCount)
+      {
+        common::ThreadPool threadPool{ ThreadCount };
+        GeneticTester2D<T> tester{ lessonLibrary, threadPool };
+
+        // The network owns its weights, so after the first iteration an iteration doesn't allocate memory.
+        T bestError = std::numeric_limits<T>::max();
+        Network2D<T> network{ sourceNetwork.GetTopology(), sourceNetwork.GetResource() };
+        network.CopyWeights(sourceNetwork);
+        network.CopyExecutionOptions(sourceNetwork);
+        std::vector<std::pair<size_t, T>> oldWeights;
+        oldWeights.reserve(sparseMutationCount);
+
+        for (size_t i = 0; i < IterationCount; ++i)
+        {
+          oldWeights.clear();
+          network.Mutate(Mutagen, sparseMutationCount, oldWeights);
+
+          const T error = tester.Test(network);
+          if (error < bestError)
+          {
+            bestError = error;
+          }
+          else
+          {
+            network.RestoreWeights(oldWeights);
           }
         }
 
-        return std::move(bestNetwork);
+        return network;
       }
 
       template <typename T>
@@ -3,10 +3,15 @@
 #include "Lesson2DLibrary.hpp"
 #include "Network2D.hpp"
 #include "GroupErrorFlag.hpp"
+#include "GeneticTester2D.hpp"
 
+#include <cmath>
+#include <algorithm>
 #include <thread>
 #include <functional>
 #include <future>
+#include <list>
+#include <memory_resource>
 
 namespace cnn
 {
@@ -93,64 +98,17 @@ namespace cnn
         T totalError{};
         try
         {
-          // If we use "auto", then code analiser of Visual Studio dies.
-          Network2D<T> copiedNetwork{ network };
-          convolution::Network2DProtectingReference<T> convolutionNetwork = copiedNetwork.GetConvolutionNetwork();
-          perceptron::NetworkProtectingReference<T> perceptronNetwork = copiedNetwork.GetPerceptronNetwork();
+          // Weights are shared with the network, so only the state of the network is allocated
+          // and all of it is released at once after the test.
+          std::pmr::monotonic_buffer_resource scratch;
+          Network2D<T> copiedNetwork{ network.GetTopology(), &scratch };
+          copiedNetwork.ShareWeights(network);
+          copiedNetwork.CopyExecutionOptions(network);
           for (size_t lessonId = threadId;
                (lessonId < lessonLibrary.GetLessonCount()) && (groupErrorFlag.IsError() == false);
                lessonId += threadCount)
           {
-            const complex::Lesson2D<T>& lesson = lessonLibrary.GetLesson(lessonId);
-            convolution::Layer2DProtectingReference<T> firstLayer = convolutionNetwork.GetFirstLayer();
-            // Convolution.
-            {
-              convolutionNetwork.Clear();
-              for (size_t inputIndex = 0; inputIndex < lesson.GetTopology().GetInputCount(); ++inputIndex)
-              {
-                convolution::Map2DProtectingReference<T> input = firstLayer.GetInput(inputIndex);
-                for (size_t x = 0; x < lesson.GetTopology().GetInputSize().GetWidth(); ++x)
-                {
-                  for (size_t y = 0; y < lesson.GetTopology().GetInputSize().GetHeight(); ++y)
-                  {
-                    input.FillFrom(lesson.GetInput(inputIndex));
-                  }
-                }
-              }
-              convolutionNetwork.GenerateOutput();
-            }
-            // Perceptron.
-            {
-              convolution::Layer2DProtectingReference<T> lastConvolutionLayer = convolutionNetwork.GetLastLayer();
-              perceptron::LayerProtectingReference<T> firstPerceptronLayer = perceptronNetwork.GetFirstLayer();
-              common::MapProtectingReference<T> firstPerceptronLayerInput = firstPerceptronLayer.GetInput();
-              perceptronNetwork.Clear();
-              size_t index{};
-              for (size_t outputIndex = 0; outputIndex < lastConvolutionLayer.GetTopology().GetOutputCount(); ++outputIndex)
-              {
-                convolution::Map2DProtectingReference<T> convolutionOutput = lastConvolutionLayer.GetOutput(outputIndex);
-                for (size_t x = 0; x < convolutionOutput.GetSize().GetWidth(); ++x)
-                {
-                  for (size_t y = 0; y < convolutionOutput.GetSize().GetHeight(); ++y)
-                  {
-                    const T value = convolutionOutput.GetValue(x, y);
-                    firstPerceptronLayerInput.SetValue(index++, value);
-                  }
-                }
-              }
-              perceptronNetwork.GenerateOutput();
-            }
-            // Total error.
-            {
-              common::MapProtectingReference<T> perceptronOutput = perceptronNetwork.GetLastLayer().GetOutput();
-              const common::Map<T>& lessonOutput = lesson.GetOutput();
-              for (size_t o = 0; o < perceptronOutput.GetValueCount(); ++o)
-              {
-                const T perceptronOutputValue = perceptronOutput.GetValue(o);
-                const T lessonOutputValue = lessonOutput.GetValue(o);
-                totalError += abs(perceptronOutputValue - lessonOutputValue);
-              }
-            }
+            totalError += GeneticTester2D<T>::GetError(lessonLibrary.GetLesson(lessonId), copiedNetwork);
           }
         }
         catch (...)
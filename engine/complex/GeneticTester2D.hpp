@@ -0,0 +1,199 @@
+#pragma once
+
+#include <cstddef>
+#include <cmath>
+#include <algorithm>
+#include <vector>
+#include <stdexcept>
+
+#include "Lesson2DLibrary.hpp"
+#include "Lesson2DView.hpp"
+#include "Network2D.hpp"
+
+#include "../common/ThreadPool.hpp"
+
+namespace cnn
+{
+  namespace engine
+  {
+    namespace complex
+    {
+      // GeneticTester2D computes the total error of networks on a lesson library again and again.
+      // It keeps one network per thread of the pool, which shares the weights of the tested network,
+      // so after the first test of a topology a test doesn't allocate memory.
+      // Layers keep the transforms of the weights they shared last (see common::WeightStamp),
+      // so a test rebuilds only the transforms of layers, which weights were changed since the previous test.
+      template <typename T>
+      class GeneticTester2D
+      {
+
+        static_assert(std::is_floating_point<T>::value);
+
+      public:
+
+        // The library and the pool must outlive the tester.
+        GeneticTester2D(const Lesson2DLibrary<T>& lessonLibrary, common::ThreadPool& threadPool);
+
+        GeneticTester2D(const GeneticTester2D& tester) = delete;
+
+        GeneticTester2D& operator=(const GeneticTester2D& tester) = delete;
+
+        // Exception guarantee: base for this.
+        // It returns the sum of absolute errors of outputs of the network over all lessons.
+        T Test(const Network2D<T>& network);
+
+        // Exception guarantee: base for network.
+        // It returns the error of the network on the lesson, which is evaluated by the network in place.
+        static T GetError(const Lesson2DView<T>& lesson, Network2D<T>& network);
+
+        // It returns the error of GetOutputCount() outputs of a model on the lesson.
+        static T GetError(const Lesson2DView<T>& lesson, const T* const outputs);
+
+      private:
+
+        const Lesson2DLibrary<T>& LessonLibrary;
+        common::ThreadPool& ThreadPool;
+
+        // Idle networks share zero weights of Reference, so the tested network is never shared between tests.
+        Network2D<T> Reference;
+        std::vector<Network2D<T>> Networks;
+        std::vector<T> Errors;
+
+        void CheckTopologies(const Network2D<T>& network) const;
+
+      };
+
+      template <typename T>
+      GeneticTester2D<T>::GeneticTester2D(const Lesson2DLibrary<T>& lessonLibrary, common::ThreadPool& threadPool)
+        :
+        LessonLibrary{ lessonLibrary },
+        ThreadPool{ threadPool },
+        Errors(threadPool.GetThreadCount())
+      {
+      }
+
+      template <typename T>
+      T GeneticTester2D<T>::Test(const Network2D<T>& network)
+      {
+        CheckTopologies(network);
+
+        if ((Networks.empty()) ||
+            (Reference.GetTopology().GetConvolutionTopology() != network.GetTopology().GetConvolutionTopology()) ||
+            (Reference.GetTopology().GetPerceptronTopology() != network.GetTopology().GetPerceptronTopology()))
+        {
+          Networks.clear();
+          Reference = network;
+          Reference.Clear();
+          Networks.resize(Errors.size(), Reference);
+        }
+
+        for (auto& threadNetwork : Networks)
+        {
+          threadNetwork.ShareWeights(network);
+        }
+
+        auto task = [this](const size_t taskIndex)
+        {
+          T error{};
+          Network2D<T>& threadNetwork = Networks[taskIndex];
+          for (size_t lessonIndex = taskIndex; lessonIndex < LessonLibrary.GetLessonCount(); lessonIndex += Networks.size())
+          {
+            error += GetError(LessonLibrary.GetLesson(lessonIndex), threadNetwork);
+          }
+          Errors[taskIndex] = error;
+        };
+
+        try
+        {
+          ThreadPool.ParallelFor(Networks.size(), task);
+        }
+        catch (...)
+        {
+          for (auto& threadNetwork : Networks)
+          {
+            threadNetwork.ShareWeights(Reference);
+          }
+          throw;
+        }
+
+        T totalError{};
+        for (size_t i = 0; i < Networks.size(); ++i)
+        {
+          Networks[i].ShareWeights(Reference);
+          totalError += Errors[i];
+        }
+        return totalError;
+      }
+
+      template <typename T>
+      T GeneticTester2D<T>::GetError(const Lesson2DView<T>& lesson, Network2D<T>& network)
+      {
+        // Input, convolution and perceptron.
+        if (lesson.GetTopology().GetBinaryInputs())
+        {
+          // The first layer reads bit-packed inputs directly.
+          network.GenerateOutputFromBinary(lesson.GetBinaryInput(0));
+        }
+        else
+        {
+          convolution::Layer2DProtectingReference<T> firstLayer = network.GetConvolutionNetwork().GetFirstLayer();
+          for (size_t inputIndex = 0; inputIndex < lesson.GetTopology().GetInputCount(); ++inputIndex)
+          {
+            firstLayer.GetInput(inputIndex).CopyFrom(lesson.GetInput(inputIndex));
+          }
+          network.GenerateOutput();
+        }
+
+        // Total error.
+        return GetError(lesson, network.GetPerceptronNetwork().GetLastLayer().GetOutput().GetValues());
+      }
+
+      template <typename T>
+      T GeneticTester2D<T>::GetError(const Lesson2DView<T>& lesson, const T* const outputs)
+      {
+        T error{};
+        const size_t outputCount = lesson.GetTopology().GetOutputCount();
+        if (lesson.GetTopology().GetClassLabels())
+        {
+          // The expected output is 1 for the label and 0 for the rest, so zeros are not read at all.
+          const size_t label = lesson.GetLabel();
+          for (size_t o = 0; o < outputCount; ++o)
+          {
+            error += std::abs(outputs[o]);
+          }
+          error += std::abs(outputs[label] - 1) - std::abs(outputs[label]);
+        }
+        else
+        {
+          const T* lessonOutput = lesson.GetOutput();
+          for (size_t o = 0; o < outputCount; ++o)
+          {
+            error += std::abs(outputs[o] - lessonOutput[o]);
+          }
+        }
+        return error;
+      }
+
+      template <typename T>
+      void GeneticTester2D<T>::CheckTopologies(const Network2D<T>& network) const
+      {
+        if (LessonLibrary.GetLessonCount() == 0)
+        {
+          throw std::invalid_argument("cnn::engine::complex::GeneticTester2D::CheckTopologies(), LessonLibrary.GetLessonCount() == 0.");
+        }
+        if (LessonLibrary.GetTopology().GetInputSize() != network.GetConvolutionNetwork().GetTopology().GetFirstLayerTopology().GetInputSize())
+        {
+          throw std::invalid_argument("cnn::engine::complex::GeneticTester2D::CheckTopologies(), LessonLibrary.GetTopology().GetInputSize() != network.GetConvolutionNetwork().GetTopology().GetFirstLayerTopology().GetInputSize().");
+        }
+        if (LessonLibrary.GetTopology().GetInputCount() != network.GetConvolutionNetwork().GetTopology().GetFirstLayerTopology().GetInputCount())
+        {
+          throw std::invalid_argument("cnn::engine::complex::GeneticTester2D::CheckTopologies(), LessonLibrary.GetTopology().GetInputCount() != network.GetConvolutionNetwork().GetTopology().GetFirstLayerTopology().GetInputCount().");
+        }
+        if (LessonLibrary.GetTopology().GetOutputCount() != network.GetPerceptronNetwork().GetTopology().GetLastLayerTopology().GetNeuronCount())
+        {
+          throw std::invalid_argument("cnn::engine::complex::GeneticTester2D::CheckTopologies(), LessonLibrary.GetTopology().GetOutputCount() != network.GetPerceptronNetwork().GetTopology().GetLastLayerTopology().GetNeuronCount().");
+        }
+      }
+    }
+  }
+}
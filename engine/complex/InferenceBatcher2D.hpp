@@ -0,0 +1,462 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <algorithm>
+#include <stdexcept>
+
+#include "Network2D.hpp"
+
+#include "../common/LockFreeQueue.hpp"
+#include "../common/ThreadPool.hpp"
+
+namespace cnn
+{
+  namespace engine
+  {
+    namespace complex
+    {
+      // InferenceBatcher2D serves inference requests from many threads with dynamic batching.
+      // Requests are collected in a lock-free queue; a batch is closed when it reaches MaxBatchSize
+      // or when the oldest request has waited MaxWait. The batch is evaluated across a thread pool,
+      // where every thread owns a copy of the current network.
+      // The network can be replaced at any time; requests, which are already batched, finish with the old one.
+      template <typename T>
+      class InferenceBatcher2D
+      {
+
+        static_assert(std::is_floating_point<T>::value);
+
+      public:
+
+        InferenceBatcher2D(const Network2D<T>& network,
+                           const size_t maxBatchSize = DEFAULT_MAX_BATCH_SIZE,
+                           const std::chrono::microseconds maxWait = std::chrono::microseconds{ DEFAULT_MAX_WAIT },
+                           const size_t threadCount = 0,
+                           const size_t queueCapacity = DEFAULT_QUEUE_CAPACITY);
+
+        InferenceBatcher2D(const InferenceBatcher2D& batcher) = delete;
+
+        InferenceBatcher2D(InferenceBatcher2D&& batcher) noexcept = delete;
+
+        InferenceBatcher2D& operator=(const InferenceBatcher2D& batcher) = delete;
+
+        InferenceBatcher2D& operator=(InferenceBatcher2D&& batcher) noexcept = delete;
+
+        ~InferenceBatcher2D();
+
+        size_t GetMaxBatchSize() const noexcept;
+
+        // Exception guarantee: strong for this.
+        void SetMaxBatchSize(const size_t maxBatchSize);
+
+        std::chrono::microseconds GetMaxWait() const noexcept;
+
+        void SetMaxWait(const std::chrono::microseconds maxWait) noexcept;
+
+        std::shared_ptr<const Network2D<T>> GetNetwork() const;
+
+        // Exception guarantee: strong for this.
+        // It hot-swaps the network; it is safe to call it while requests are served.
+        void SetNetwork(const Network2D<T>& network);
+
+        // Exception guarantee: strong for this.
+        // It blocks until the request has been evaluated as a part of a batch and returns the output of the network.
+        common::Map<T> Infer(const std::vector<convolution::Map2D<T>>& inputs);
+
+        size_t GetRequestCount() const noexcept;
+
+        size_t GetBatchCount() const noexcept;
+
+        // It returns served requests per second since the construction (or the last ResetStatistics()).
+        double GetThroughput() const;
+
+        // It returns the latency percentile (0..100) in microseconds over the last LATENCY_SAMPLE_COUNT requests.
+        double GetLatency(const double percentile) const;
+
+        void ResetStatistics();
+
+      private:
+
+        constexpr static size_t DEFAULT_MAX_BATCH_SIZE = 16;
+        constexpr static int64_t DEFAULT_MAX_WAIT = 1000;
+        constexpr static size_t DEFAULT_QUEUE_CAPACITY = 1024;
+        constexpr static size_t LATENCY_SAMPLE_COUNT = 4096;
+
+        using Clock = std::chrono::steady_clock;
+
+        struct Request
+        {
+          const std::vector<convolution::Map2D<T>>* Inputs;
+          common::Map<T> Output;
+          Clock::time_point ArrivalTime;
+          std::exception_ptr Exception;
+          std::promise<void> Promise;
+        };
+
+        std::atomic<size_t> MaxBatchSize;
+        std::atomic<int64_t> MaxWait;
+
+        std::shared_ptr<const Network2D<T>> Network;
+
+        common::LockFreeQueue<Request*> Queue;
+        std::mutex WakeMutex;
+        std::condition_variable WakeCondition;
+        std::atomic<bool> Stop;
+
+        common::ThreadPool ThreadPool;
+        std::vector<Network2D<T>> WorkerNetworks;
+        std::shared_ptr<const Network2D<T>> WorkerSource;
+
+        std::atomic<size_t> RequestCount;
+        std::atomic<size_t> BatchCount;
+        mutable std::mutex StatisticsMutex;
+        Clock::time_point StatisticsStart;
+        std::vector<double> Latencies;
+        size_t LatencyIndex;
+
+        std::thread BatchThread;
+
+        void BatchLoop() noexcept;
+
+        void ProcessBatch(std::vector<Request*>& batch) noexcept;
+
+        static void Evaluate(Network2D<T>& network, Request& request);
+
+        void CheckInputs(const Network2D<T>& network, const std::vector<convolution::Map2D<T>>& inputs) const;
+
+      };
+
+      template <typename T>
+      InferenceBatcher2D<T>::InferenceBatcher2D(const Network2D<T>& network,
+                                                const size_t maxBatchSize,
+                                                const std::chrono::microseconds maxWait,
+                                                const size_t threadCount,
+                                                const size_t queueCapacity)
+        :
+        MaxBatchSize{ maxBatchSize },
+        MaxWait{ maxWait.count() },
+        Network{ std::make_shared<const Network2D<T>>(network) },
+        Queue{ queueCapacity },
+        Stop{ false },
+        ThreadPool{ threadCount },
+        RequestCount{ 0 },
+        BatchCount{ 0 },
+        StatisticsStart{ Clock::now() },
+        LatencyIndex{ 0 }
+      {
+        if (maxBatchSize == 0)
+        {
+          throw std::invalid_argument("cnn::engine::complex::InferenceBatcher2D::InferenceBatcher2D(), maxBatchSize == 0.");
+        }
+        if (maxWait.count() < 0)
+        {
+          throw std::invalid_argument("cnn::engine::complex::InferenceBatcher2D::InferenceBatcher2D(), maxWait.count() < 0.");
+        }
+
+        WorkerNetworks.resize(ThreadPool.GetThreadCount());
+        Latencies.reserve(LATENCY_SAMPLE_COUNT);
+
+        BatchThread = std::thread{ &InferenceBatcher2D::BatchLoop, this };
+      }
+
+      template <typename T>
+      InferenceBatcher2D<T>::~InferenceBatcher2D()
+      {
+        {
+          std::lock_guard<std::mutex> lock{ WakeMutex };
+          Stop.store(true);
+        }
+        WakeCondition.notify_all();
+        BatchThread.join();
+      }
+
+      template <typename T>
+      size_t InferenceBatcher2D<T>::GetMaxBatchSize() const noexcept
+      {
+        return MaxBatchSize.load();
+      }
+
+      template <typename T>
+      void InferenceBatcher2D<T>::SetMaxBatchSize(const size_t maxBatchSize)
+      {
+        if (maxBatchSize == 0)
+        {
+          throw std::invalid_argument("cnn::engine::complex::InferenceBatcher2D::SetMaxBatchSize(), maxBatchSize == 0.");
+        }
+        MaxBatchSize.store(maxBatchSize);
+      }
+
+      template <typename T>
+      std::chrono::microseconds InferenceBatcher2D<T>::GetMaxWait() const noexcept
+      {
+        return std::chrono::microseconds{ MaxWait.load() };
+      }
+
+      template <typename T>
+      void InferenceBatcher2D<T>::SetMaxWait(const std::chrono::microseconds maxWait) noexcept
+      {
+        MaxWait.store(std::max<int64_t>(maxWait.count(), 0));
+      }
+
+      template <typename T>
+      std::shared_ptr<const Network2D<T>> InferenceBatcher2D<T>::GetNetwork() const
+      {
+        return std::atomic_load(&Network);
+      }
+
+      template <typename T>
+      void InferenceBatcher2D<T>::SetNetwork(const Network2D<T>& network)
+      {
+        std::shared_ptr<const Network2D<T>> newNetwork = std::make_shared<const Network2D<T>>(network);
+        std::atomic_store(&Network, newNetwork);
+      }
+
+      template <typename T>
+      common::Map<T> InferenceBatcher2D<T>::Infer(const std::vector<convolution::Map2D<T>>& inputs)
+      {
+        CheckInputs(*GetNetwork(), inputs);
+
+        Request request;
+        request.Inputs = &inputs;
+        request.ArrivalTime = Clock::now();
+        std::future<void> future = request.Promise.get_future();
+
+        // The queue is bounded, so we give the batch thread time to drain it.
+        while (Queue.TryPush(&request) == false)
+        {
+          if (Stop.load())
+          {
+            throw std::runtime_error("cnn::engine::complex::InferenceBatcher2D::Infer(), Stop.load() == true.");
+          }
+          std::this_thread::yield();
+        }
+        {
+          std::lock_guard<std::mutex> lock{ WakeMutex };
+        }
+        WakeCondition.notify_one();
+
+        future.get();
+        return std::move(request.Output);
+      }
+
+      template <typename T>
+      size_t InferenceBatcher2D<T>::GetRequestCount() const noexcept
+      {
+        return RequestCount.load();
+      }
+
+      template <typename T>
+      size_t InferenceBatcher2D<T>::GetBatchCount() const noexcept
+      {
+        return BatchCount.load();
+      }
+
+      template <typename T>
+      double InferenceBatcher2D<T>::GetThroughput() const
+      {
+        std::lock_guard<std::mutex> lock{ StatisticsMutex };
+        const double seconds = std::chrono::duration<double>(Clock::now() - StatisticsStart).count();
+        if (seconds <= 0)
+        {
+          return 0;
+        }
+        return RequestCount.load() / seconds;
+      }
+
+      template <typename T>
+      double InferenceBatcher2D<T>::GetLatency(const double percentile) const
+      {
+        if ((percentile < 0) || (percentile > 100))
+        {
+          throw std::invalid_argument("cnn::engine::complex::InferenceBatcher2D::GetLatency(), (percentile < 0) || (percentile > 100).");
+        }
+
+        std::vector<double> latencies;
+        {
+          std::lock_guard<std::mutex> lock{ StatisticsMutex };
+          latencies = Latencies;
+        }
+        if (latencies.size() == 0)
+        {
+          return 0;
+        }
+
+        const size_t rank = static_cast<size_t>(percentile / 100 * (latencies.size() - 1) + 0.5);
+        std::nth_element(latencies.begin(), latencies.begin() + rank, latencies.end());
+        return latencies[rank];
+      }
+
+      template <typename T>
+      void InferenceBatcher2D<T>::ResetStatistics()
+      {
+        std::lock_guard<std::mutex> lock{ StatisticsMutex };
+        RequestCount.store(0);
+        BatchCount.store(0);
+        StatisticsStart = Clock::now();
+        Latencies.clear();
+        LatencyIndex = 0;
+      }
+
+      template <typename T>
+      void InferenceBatcher2D<T>::BatchLoop() noexcept
+      {
+        std::vector<Request*> batch;
+        while (true)
+        {
+          Request* request{};
+          if (Queue.TryPop(request) == false)
+          {
+            if (Stop.load())
+            {
+              break;
+            }
+            std::unique_lock<std::mutex> lock{ WakeMutex };
+            WakeCondition.wait(lock, [this]() { return Stop.load() || (Queue.IsEmpty() == false); });
+            continue;
+          }
+
+          const size_t maxBatchSize = MaxBatchSize.load();
+          const Clock::time_point deadline = request->ArrivalTime + std::chrono::microseconds{ MaxWait.load() };
+
+          batch.clear();
+          batch.reserve(maxBatchSize);
+          batch.push_back(request);
+          while (batch.size() < maxBatchSize)
+          {
+            if (Queue.TryPop(request))
+            {
+              batch.push_back(request);
+              continue;
+            }
+            std::unique_lock<std::mutex> lock{ WakeMutex };
+            const bool woken = WakeCondition.wait_until(lock, deadline, [this]() { return Stop.load() || (Queue.IsEmpty() == false); });
+            if ((woken == false) || Stop.load())
+            {
+              break;
+            }
+          }
+
+          ProcessBatch(batch);
+        }
+      }
+
+      template <typename T>
+      void InferenceBatcher2D<T>::ProcessBatch(std::vector<Request*>& batch) noexcept
+      {
+        try
+        {
+          const std::shared_ptr<const Network2D<T>> network = GetNetwork();
+          if (network != WorkerSource)
+          {
+            for (auto& workerNetwork : WorkerNetworks)
+            {
+              workerNetwork = *network;
+            }
+            WorkerSource = network;
+          }
+
+          const size_t workerCount = std::min(WorkerNetworks.size(), batch.size());
+          auto task = [this, &batch, workerCount](const size_t workerIndex)
+          {
+            for (size_t r = workerIndex; r < batch.size(); r += workerCount)
+            {
+              try
+              {
+                Evaluate(WorkerNetworks[workerIndex], *batch[r]);
+              }
+              catch (...)
+              {
+                batch[r]->Exception = std::current_exception();
+              }
+            }
+          };
+          ThreadPool.ParallelFor(workerCount, task);
+        }
+        catch (...)
+        {
+          for (auto request : batch)
+          {
+            request->Exception = std::current_exception();
+          }
+        }
+
+        const Clock::time_point now = Clock::now();
+        {
+          std::lock_guard<std::mutex> lock{ StatisticsMutex };
+          for (auto request : batch)
+          {
+            const double latency = std::chrono::duration<double, std::micro>(now - request->ArrivalTime).count();
+            if (Latencies.size() < LATENCY_SAMPLE_COUNT)
+            {
+              Latencies.push_back(latency);
+            }
+            else
+            {
+              Latencies[LatencyIndex] = latency;
+            }
+            LatencyIndex = (LatencyIndex + 1) % LATENCY_SAMPLE_COUNT;
+          }
+          RequestCount += batch.size();
+          ++BatchCount;
+        }
+
+        // The request belongs to the waiting thread, so it must not be touched after the promise is satisfied.
+        for (auto request : batch)
+        {
+          if (request->Exception)
+          {
+            request->Promise.set_exception(request->Exception);
+          }
+          else
+          {
+            request->Promise.set_value();
+          }
+        }
+      }
+
+      template <typename T>
+      void InferenceBatcher2D<T>::Evaluate(Network2D<T>& network, Request& request)
+      {
+        {
+          convolution::Network2DProtectingReference<T> convolutionNetwork = network.GetConvolutionNetwork();
+          convolution::Layer2DProtectingReference<T> firstLayer = convolutionNetwork.GetFirstLayer();
+          for (size_t i = 0; i < request.Inputs->size(); ++i)
+          {
+            firstLayer.GetInput(i).FillFrom((*request.Inputs)[i]);
+          }
+        }
+        network.GenerateOutput();
+
+        const Network2D<T>& constNetwork = network;
+        request.Output = constNetwork.GetPerceptronNetwork().GetLastLayer().GetOutput();
+      }
+
+      template <typename T>
+      void InferenceBatcher2D<T>::CheckInputs(const Network2D<T>& network,
+                                              const std::vector<convolution::Map2D<T>>& inputs) const
+      {
+        const auto& firstLayerTopology = network.GetConvolutionNetwork().GetTopology().GetFirstLayerTopology();
+        if (inputs.size() != firstLayerTopology.GetInputCount())
+        {
+          throw std::invalid_argument("cnn::engine::complex::InferenceBatcher2D::CheckInputs(), inputs.size() != firstLayerTopology.GetInputCount().");
+        }
+        for (const auto& input : inputs)
+        {
+          if (input.GetSize() != firstLayerTopology.GetInputSize())
+          {
+            throw std::invalid_argument("cnn::engine::complex::InferenceBatcher2D::CheckInputs(), input.GetSize() != firstLayerTopology.GetInputSize().");
+          }
+        }
+      }
+    }
+  }
+}
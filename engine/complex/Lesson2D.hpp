@@ -97,7 +97,7 @@ namespace cnn
         {
           Inputs[i] = lesson.Inputs[i];
         }
-        Output.SetValueCount(Topology.GetOutputCount());
+        Output = lesson.Output;
       }
 
       template <typename T>
@@ -1,9 +1,18 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include <limits>
 #include <vector>
+#include <memory_resource>
 
 #include "Lesson2D.hpp"
-#include "Lesson2DProtectingReference.hpp"
+#include "Lesson2DView.hpp"
+
+#include "../common/AlignedBuffer.hpp"
+#include "../common/BitPacking.hpp"
 
 namespace cnn
 {
@@ -11,6 +20,11 @@ namespace cnn
   {
     namespace complex
     {
+      // Lesson2DLibrary stores all lessons in one allocation of two tensors:
+      // inputs [lesson][input][y][x] and outputs [lesson][output].
+      // Lessons are contiguous, so GetInputs(first) and GetOutputs(first) also address a mini-batch starting at first.
+      // If the topology declares binary inputs, the inputs are bit-packed (see common::BitPacking) into a separate tensor.
+      // If the topology declares class labels, the outputs are replaced by one class index per lesson.
       template <typename T>
       class Lesson2DLibrary
       {
@@ -19,26 +33,67 @@ namespace cnn
 
       public:
 
-        Lesson2DLibrary() = default;
+        // Lessons are allocated by the resource.
+        Lesson2DLibrary(std::pmr::memory_resource* const resource = std::pmr::get_default_resource()) noexcept;
+
+        // It preallocates lessonCount zero lessons of the topology, which can be filled in place.
+        Lesson2DLibrary(const size_t lessonCount,
+                        const Lesson2DTopology& topology,
+                        std::pmr::memory_resource* const resource = std::pmr::get_default_resource());
 
         Lesson2DLibrary(const Lesson2DLibrary& library) = default;
 
         Lesson2DLibrary(Lesson2DLibrary&& library) noexcept = default;
 
+        // Exception guarantee: strong for this.
         Lesson2DLibrary& operator=(const Lesson2DLibrary& library);
 
         Lesson2DLibrary& operator=(Lesson2DLibrary&& library) noexcept = default;
 
+        std::pmr::memory_resource* GetResource() const noexcept;
+
+        // The topology of all lessons.
+        const Lesson2DTopology& GetTopology() const noexcept;
+
         size_t GetLessonCount() const noexcept;
 
         // Exception guarantee: strong for this.
-        void PushBack(const Lesson2D<T>& lesson);
+        // It allocates the memory for lessonCount lessons.
+        void Reserve(const size_t lessonCount);
 
         // Exception guarantee: strong for this.
-        const Lesson2D<T>& GetLesson(const size_t index) const;
+        // The topology of the first lesson becomes the topology of the library.
+        void PushBack(const Lesson2D<T>& lesson);
 
         // Exception guarantee: strong for this.
-        const Lesson2DProtectingReference<T> GetLesson(const size_t index);
+        Lesson2DView<T> GetLesson(const size_t index) const;
+
+        // It returns the inputs of the lesson (and all next lessons).
+        const T* GetInputs(const size_t index) const;
+
+        // It returns the inputs of the lesson (and all next lessons).
+        T* GetInputs(const size_t index);
+
+        // It returns the count of words of bit-packed inputs of one lesson.
+        size_t GetBinaryInputWordCount() const noexcept;
+
+        // It returns the bit-packed inputs of the lesson (and all next lessons).
+        const uint64_t* GetBinaryInputs(const size_t index) const;
+
+        // It returns the bit-packed inputs of the lesson (and all next lessons).
+        uint64_t* GetBinaryInputs(const size_t index);
+
+        // It returns the outputs of the lesson (and all next lessons).
+        const T* GetOutputs(const size_t index) const;
+
+        // It returns the outputs of the lesson (and all next lessons).
+        T* GetOutputs(const size_t index);
+
+        // It returns the class labels of the lesson (and all next lessons).
+        const uint32_t* GetLabels(const size_t index) const;
+
+        // It returns the class labels of the lesson (and all next lessons).
+        uint32_t* GetLabels(const size_t index);
 
         // Clear the library from all lessons.
         void Clear() noexcept;
@@ -53,10 +108,59 @@ namespace cnn
 
       private:
 
-        std::vector<Lesson2D<T>> Lessons;
+        Lesson2DTopology Topology;
+        size_t LessonCount;
+        size_t Capacity;
+        // Inputs of Capacity lessons, then outputs of Capacity lessons from GetOutputOffset().
+        common::AlignedBuffer<T> Values;
+        // Bit-packed inputs of Capacity lessons, if the topology declares binary inputs.
+        common::AlignedBuffer<uint64_t> BinaryInputs;
+        // Class labels of Capacity lessons, if the topology declares class labels.
+        common::AlignedBuffer<uint32_t> Labels;
+
+        size_t GetInputValueCount() const noexcept;
+
+        size_t GetOutputValueCount() const noexcept;
+
+        size_t GetOutputOffset() const noexcept;
+
+        static common::AlignedBuffer<T> Allocate(const Lesson2DTopology& topology, const size_t capacity, std::pmr::memory_resource* const resource);
+
+        static size_t GetOutputOffset(const Lesson2DTopology& topology, const size_t capacity) noexcept;
+
+        static size_t GetInputValueCount(const Lesson2DTopology& topology) noexcept;
+
+        static size_t GetBinaryInputWordCount(const Lesson2DTopology& topology) noexcept;
+
+        static size_t GetOutputValueCount(const Lesson2DTopology& topology) noexcept;
 
       };
 
+      template <typename T>
+      Lesson2DLibrary<T>::Lesson2DLibrary(std::pmr::memory_resource* const resource) noexcept
+        :
+        LessonCount{ 0 },
+        Capacity{ 0 },
+        Values{ 0, resource },
+        BinaryInputs{ 0, resource },
+        Labels{ 0, resource }
+      {
+      }
+
+      template <typename T>
+      Lesson2DLibrary<T>::Lesson2DLibrary(const size_t lessonCount,
+                                          const Lesson2DTopology& topology,
+                                          std::pmr::memory_resource* const resource)
+        :
+        Topology{ topology },
+        LessonCount{ lessonCount },
+        Capacity{ lessonCount },
+        Values{ Allocate(topology, lessonCount, resource) },
+        BinaryInputs{ lessonCount * GetBinaryInputWordCount(topology), resource },
+        Labels{ topology.GetClassLabels() ? lessonCount : 0, resource }
+      {
+      }
+
       template <typename T>
       Lesson2DLibrary<T>& Lesson2DLibrary<T>::operator=(const Lesson2DLibrary& library)
       {
@@ -64,54 +168,306 @@ namespace cnn
         {
           Lesson2DLibrary<T> tmpLibrary{ library };
           // Beware, it is very intimate place for strong exception guarantee.
-          std::swap(*this, library);
+          std::swap(*this, tmpLibrary);
         }
         return *this;
       }
 
+      template <typename T>
+      std::pmr::memory_resource* Lesson2DLibrary<T>::GetResource() const noexcept
+      {
+        return Values.GetResource();
+      }
+
+      template <typename T>
+      const Lesson2DTopology& Lesson2DLibrary<T>::GetTopology() const noexcept
+      {
+        return Topology;
+      }
+
       template <typename T>
       size_t Lesson2DLibrary<T>::GetLessonCount() const noexcept
       {
-        return Lessons.size();
+        return LessonCount;
+      }
+
+      template <typename T>
+      void Lesson2DLibrary<T>::Reserve(const size_t lessonCount)
+      {
+        if (lessonCount <= Capacity)
+        {
+          return;
+        }
+
+        common::AlignedBuffer<T> values = Allocate(Topology, lessonCount, GetResource());
+        common::AlignedBuffer<uint64_t> binaryInputs{ lessonCount * GetBinaryInputWordCount(), GetResource() };
+        common::AlignedBuffer<uint32_t> labels{ Topology.GetClassLabels() ? lessonCount : 0, GetResource() };
+        if (LessonCount != 0)
+        {
+          std::memcpy(values.GetData(), Values.GetData(), sizeof(T) * LessonCount * GetInputValueCount());
+          std::memcpy(values.GetData() + GetOutputOffset(Topology, lessonCount),
+                      Values.GetData() + GetOutputOffset(),
+                      sizeof(T) * LessonCount * GetOutputValueCount());
+          std::memcpy(binaryInputs.GetData(), BinaryInputs.GetData(), sizeof(uint64_t) * LessonCount * GetBinaryInputWordCount());
+          if (Topology.GetClassLabels())
+          {
+            std::memcpy(labels.GetData(), Labels.GetData(), sizeof(uint32_t) * LessonCount);
+          }
+        }
+
+        Values = std::move(values);
+        BinaryInputs = std::move(binaryInputs);
+        Labels = std::move(labels);
+        Capacity = lessonCount;
       }
 
       template <typename T>
       void Lesson2DLibrary<T>::PushBack(const Lesson2D<T>& lesson)
       {
-        if (Lessons.size() != 0)
+        if (LessonCount != 0)
+        {
+          if (lesson.GetTopology() != Topology)
+          {
+            throw std::invalid_argument("cnn::engine::complex::Lesson2DLibrary::PushBack(), lesson.GetTopology() != Topology.");
+          }
+        }
+        else if (lesson.GetTopology() != Topology)
+        {
+          Lesson2DLibrary<T> tmpLibrary{ 0, lesson.GetTopology() };
+          tmpLibrary.PushBack(lesson);
+          // Beware, it is very intimate place for strong exception guarantee.
+          std::swap(*this, tmpLibrary);
+          return;
+        }
+
+        const size_t width = Topology.GetInputSize().GetWidth();
+        const size_t height = Topology.GetInputSize().GetHeight();
+        const size_t area = Topology.GetInputSize().GetArea();
+        if (Topology.GetBinaryInputs())
         {
-          if (lesson.GetTopology() != Lessons.front().GetTopology())
+          for (size_t i = 0; i < Topology.GetInputCount(); ++i)
           {
-            throw std::invalid_argument("cnn::engine::complex::Lesson2DLibrary::PushBack(), lesson.GetTopology() != Lessons.front().GetTopology().");
+            const T* const values = lesson.GetInput(i).GetValues();
+            const size_t stride = lesson.GetInput(i).GetStride();
+            for (size_t y = 0; y < height; ++y)
+            {
+              for (size_t x = 0; x < width; ++x)
+              {
+                const T value = values[x + y * stride];
+                if ((value != static_cast<T>(0)) && (value != static_cast<T>(1)))
+                {
+                  throw std::invalid_argument("cnn::engine::complex::Lesson2DLibrary::PushBack(), value of binary input is not 0 or 1.");
+                }
+              }
+            }
           }
         }
-        Lessons.push_back(lesson);
+
+        size_t label{};
+        if (Topology.GetClassLabels())
+        {
+          const T* const values = lesson.GetOutput().GetValues();
+          size_t oneCount{};
+          for (size_t o = 0; o < Topology.GetOutputCount(); ++o)
+          {
+            if (values[o] == static_cast<T>(1))
+            {
+              label = o;
+              ++oneCount;
+            }
+            else if (values[o] != static_cast<T>(0))
+            {
+              oneCount = 0;
+              break;
+            }
+          }
+          if ((oneCount != 1) || (label > std::numeric_limits<uint32_t>::max()))
+          {
+            throw std::invalid_argument("cnn::engine::complex::Lesson2DLibrary::PushBack(), output of class labels is not one-hot.");
+          }
+        }
+
+        if (LessonCount == Capacity)
+        {
+          Reserve(std::max<size_t>(Capacity * 2, 1));
+        }
+
+        if (Topology.GetBinaryInputs())
+        {
+          const size_t rowWordCount = common::BitPacking::GetWordCount(width);
+          uint64_t* const binaryInputs = BinaryInputs.GetData() + LessonCount * GetBinaryInputWordCount();
+          std::memset(binaryInputs, 0, sizeof(uint64_t) * GetBinaryInputWordCount());
+          for (size_t i = 0; i < Topology.GetInputCount(); ++i)
+          {
+            const T* const values = lesson.GetInput(i).GetValues();
+            const size_t stride = lesson.GetInput(i).GetStride();
+            uint64_t* const binaryInput = binaryInputs + i * rowWordCount * height;
+            for (size_t y = 0; y < height; ++y)
+            {
+              for (size_t x = 0; x < width; ++x)
+              {
+                common::BitPacking::SetBit(binaryInput + y * rowWordCount, x, values[x + y * stride] != static_cast<T>(0));
+              }
+            }
+          }
+        }
+        else
+        {
+          T* inputs = Values.GetData() + LessonCount * GetInputValueCount();
+          for (size_t i = 0; i < Topology.GetInputCount(); ++i)
+          {
+            lesson.GetInput(i).CopyTo(inputs + i * area);
+          }
+        }
+        if (Topology.GetClassLabels())
+        {
+          Labels.GetData()[LessonCount] = static_cast<uint32_t>(label);
+        }
+        else
+        {
+          std::memcpy(Values.GetData() + GetOutputOffset() + LessonCount * GetOutputValueCount(),
+                      lesson.GetOutput().GetValues(),
+                      sizeof(T) * GetOutputValueCount());
+        }
+        ++LessonCount;
       }
 
       template <typename T>
-      const Lesson2D<T>& Lesson2DLibrary<T>::GetLesson(const size_t index) const
+      Lesson2DView<T> Lesson2DLibrary<T>::GetLesson(const size_t index) const
       {
-        if (index >= Lessons.size())
+        if (index >= LessonCount)
         {
-          throw std::range_error("cnn::engine::complex::Lesson2DLibrary::GetLesson() const, index >= Lessons.size().");
+          throw std::range_error("cnn::engine::complex::Lesson2DLibrary::GetLesson() const, index >= LessonCount.");
         }
-        return Lessons[index];
+        return { Topology,
+                 Values.GetData() + index * GetInputValueCount(),
+                 BinaryInputs.GetData() + index * GetBinaryInputWordCount(),
+                 Values.GetData() + GetOutputOffset() + index * GetOutputValueCount(),
+                 Labels.GetData() + (Topology.GetClassLabels() ? index : 0) };
       }
 
       template <typename T>
-      const Lesson2DProtectingReference<T> Lesson2DLibrary<T>::GetLesson(const size_t index)
+      const T* Lesson2DLibrary<T>::GetInputs(const size_t index) const
       {
-        if (index >= Lessons.size())
+        if (index >= LessonCount)
+        {
+          throw std::range_error("cnn::engine::complex::Lesson2DLibrary::GetInputs() const, index >= LessonCount.");
+        }
+        if (Topology.GetBinaryInputs())
         {
-          throw std::range_error("cnn::engine::complex::Lesson2DLibrary::GetLesson(), index >= Lessons.size().");
+          throw std::logic_error("cnn::engine::complex::Lesson2DLibrary::GetInputs() const, Topology.GetBinaryInputs() == true.");
         }
-        return Lessons[index];
+        return Values.GetData() + index * GetInputValueCount();
+      }
+
+      template <typename T>
+      T* Lesson2DLibrary<T>::GetInputs(const size_t index)
+      {
+        if (index >= LessonCount)
+        {
+          throw std::range_error("cnn::engine::complex::Lesson2DLibrary::GetInputs(), index >= LessonCount.");
+        }
+        if (Topology.GetBinaryInputs())
+        {
+          throw std::logic_error("cnn::engine::complex::Lesson2DLibrary::GetInputs(), Topology.GetBinaryInputs() == true.");
+        }
+        return Values.GetData() + index * GetInputValueCount();
+      }
+
+      template <typename T>
+      size_t Lesson2DLibrary<T>::GetBinaryInputWordCount() const noexcept
+      {
+        return GetBinaryInputWordCount(Topology);
+      }
+
+      template <typename T>
+      const uint64_t* Lesson2DLibrary<T>::GetBinaryInputs(const size_t index) const
+      {
+        if (index >= LessonCount)
+        {
+          throw std::range_error("cnn::engine::complex::Lesson2DLibrary::GetBinaryInputs() const, index >= LessonCount.");
+        }
+        if (Topology.GetBinaryInputs() == false)
+        {
+          throw std::logic_error("cnn::engine::complex::Lesson2DLibrary::GetBinaryInputs() const, Topology.GetBinaryInputs() == false.");
+        }
+        return BinaryInputs.GetData() + index * GetBinaryInputWordCount();
+      }
+
+      template <typename T>
+      uint64_t* Lesson2DLibrary<T>::GetBinaryInputs(const size_t index)
+      {
+        if (index >= LessonCount)
+        {
+          throw std::range_error("cnn::engine::complex::Lesson2DLibrary::GetBinaryInputs(), index >= LessonCount.");
+        }
+        if (Topology.GetBinaryInputs() == false)
+        {
+          throw std::logic_error("cnn::engine::complex::Lesson2DLibrary::GetBinaryInputs(), Topology.GetBinaryInputs() == false.");
+        }
+        return BinaryInputs.GetData() + index * GetBinaryInputWordCount();
+      }
+
+      template <typename T>
+      const T* Lesson2DLibrary<T>::GetOutputs(const size_t index) const
+      {
+        if (index >= LessonCount)
+        {
+          throw std::range_error("cnn::engine::complex::Lesson2DLibrary::GetOutputs() const, index >= LessonCount.");
+        }
+        if (Topology.GetClassLabels())
+        {
+          throw std::logic_error("cnn::engine::complex::Lesson2DLibrary::GetOutputs() const, Topology.GetClassLabels() == true.");
+        }
+        return Values.GetData() + GetOutputOffset() + index * GetOutputValueCount();
+      }
+
+      template <typename T>
+      T* Lesson2DLibrary<T>::GetOutputs(const size_t index)
+      {
+        if (index >= LessonCount)
+        {
+          throw std::range_error("cnn::engine::complex::Lesson2DLibrary::GetOutputs(), index >= LessonCount.");
+        }
+        if (Topology.GetClassLabels())
+        {
+          throw std::logic_error("cnn::engine::complex::Lesson2DLibrary::GetOutputs(), Topology.GetClassLabels() == true.");
+        }
+        return Values.GetData() + GetOutputOffset() + index * GetOutputValueCount();
+      }
+
+      template <typename T>
+      const uint32_t* Lesson2DLibrary<T>::GetLabels(const size_t index) const
+      {
+        if (index >= LessonCount)
+        {
+          throw std::range_error("cnn::engine::complex::Lesson2DLibrary::GetLabels() const, index >= LessonCount.");
+        }
+        if (Topology.GetClassLabels() == false)
+        {
+          throw std::logic_error("cnn::engine::complex::Lesson2DLibrary::GetLabels() const, Topology.GetClassLabels() == false.");
+        }
+        return Labels.GetData() + index;
+      }
+
+      template <typename T>
+      uint32_t* Lesson2DLibrary<T>::GetLabels(const size_t index)
+      {
+        if (index >= LessonCount)
+        {
+          throw std::range_error("cnn::engine::complex::Lesson2DLibrary::GetLabels(), index >= LessonCount.");
+        }
+        if (Topology.GetClassLabels() == false)
+        {
+          throw std::logic_error("cnn::engine::complex::Lesson2DLibrary::GetLabels(), Topology.GetClassLabels() == false.");
+        }
+        return Labels.GetData() + index;
       }
 
       template <typename T>
       void Lesson2DLibrary<T>::Clear() noexcept
       {
-        Lessons.clear();
+        LessonCount = 0;
       }
 
       template <typename T>
@@ -122,12 +478,13 @@ namespace cnn
           throw std::invalid_argument("cnn::engine:::complex::Lesson2DLibrary::Save(), ostream.good() == false.");
         }
 
-        const size_t count = Lessons.size();
+        // The format is the same as for the library of separate lessons.
+        const size_t count = LessonCount;
         ostream.write(reinterpret_cast<const char *const>(&count), sizeof(count));
 
-        for (const auto& lesson : Lessons)
+        for (size_t i = 0; i < LessonCount; ++i)
         {
-          lesson.Save(ostream);
+          GetLesson(i).GetLesson().Save(ostream);
         }
 
         if (ostream.good() == false)
@@ -145,7 +502,7 @@ namespace cnn
         }
 
         size_t count{};
-        decltype(Lessons) lessons;
+        Lesson2DLibrary<T> library{ GetResource() };
 
         istream.read(reinterpret_cast<char* const>(&count), sizeof(count));
 
@@ -155,12 +512,17 @@ namespace cnn
           lesson.Load(istream);
           if (i != 0)
           {
-            if (lesson.GetTopology() != lessons.front().GetTopology())
+            if (lesson.GetTopology() != library.GetTopology())
             {
-              throw std::logic_error("cnn::engine::complex::Lesson2DLibrary::Load(), lesson.GetTopology() != lessons.front().GetTopology().");
+              throw std::logic_error("cnn::engine::complex::Lesson2DLibrary::Load(), lesson.GetTopology() != library.GetTopology().");
             }
           }
-          lessons.push_back(std::move(lesson));
+          else
+          {
+            library = Lesson2DLibrary<T>{ 0, lesson.GetTopology(), GetResource() };
+            library.Reserve(count);
+          }
+          library.PushBack(lesson);
         }
 
         if (istream.good() == false)
@@ -168,8 +530,66 @@ namespace cnn
           throw std::runtime_error("cnn::engine::complex::Lesson2DLibrary::Load(), istream.good() == false.");
         }
 
-        Lessons = std::move(lessons);
+        *this = std::move(library);
+      }
+
+      template <typename T>
+      size_t Lesson2DLibrary<T>::GetInputValueCount() const noexcept
+      {
+        return GetInputValueCount(Topology);
+      }
+
+      template <typename T>
+      size_t Lesson2DLibrary<T>::GetOutputValueCount() const noexcept
+      {
+        return GetOutputValueCount(Topology);
+      }
+
+      template <typename T>
+      size_t Lesson2DLibrary<T>::GetOutputOffset() const noexcept
+      {
+        return GetOutputOffset(Topology, Capacity);
+      }
+
+      template <typename T>
+      common::AlignedBuffer<T> Lesson2DLibrary<T>::Allocate(const Lesson2DTopology& topology, const size_t capacity, std::pmr::memory_resource* const resource)
+      {
+        return common::AlignedBuffer<T>{ GetOutputOffset(topology, capacity) + capacity * GetOutputValueCount(topology), resource };
+      }
+
+      template <typename T>
+      size_t Lesson2DLibrary<T>::GetOutputOffset(const Lesson2DTopology& topology, const size_t capacity) noexcept
+      {
+        // The outputs tensor starts at a cache line boundary too.
+        constexpr size_t alignment = common::AlignedBuffer<T>::ALIGNMENT / sizeof(T);
+        const size_t inputValueCount = capacity * GetInputValueCount(topology);
+        return (inputValueCount + alignment - 1) / alignment * alignment;
+      }
+
+      template <typename T>
+      size_t Lesson2DLibrary<T>::GetInputValueCount(const Lesson2DTopology& topology) noexcept
+      {
+        // Binary inputs are kept only in the bit-packed tensor.
+        return topology.GetBinaryInputs() ? 0 : topology.GetInputCount() * topology.GetInputSize().GetArea();
+      }
+
+      template <typename T>
+      size_t Lesson2DLibrary<T>::GetBinaryInputWordCount(const Lesson2DTopology& topology) noexcept
+      {
+        if (topology.GetBinaryInputs() == false)
+        {
+          return 0;
+        }
+        const size_t rowWordCount = common::BitPacking::GetWordCount(topology.GetInputSize().GetWidth());
+        return topology.GetInputCount() * topology.GetInputSize().GetHeight() * rowWordCount;
+      }
+
+      template <typename T>
+      size_t Lesson2DLibrary<T>::GetOutputValueCount(const Lesson2DTopology& topology) noexcept
+      {
+        // Class labels are kept only in the labels tensor.
+        return topology.GetClassLabels() ? 0 : topology.GetOutputCount();
       }
     }
   }
-}
\ No newline at end of file
+}
@@ -0,0 +1,328 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <iterator>
+#include <string>
+#include <vector>
+#include <memory_resource>
+#include <stdexcept>
+
+#include "Lesson2DTopology.hpp"
+#include "Lesson2DLibrary.hpp"
+#include "Lesson2DLibraryLoader.hpp"
+
+#include "../common/BitPacking.hpp"
+#include "../common/MappedFile.hpp"
+#include "../common/ThreadPool.hpp"
+
+namespace cnn
+{
+  namespace engine
+  {
+    namespace complex
+    {
+      // Lesson2DLibraryCache keeps a preprocessed lesson library on disk, so bitmaps are decoded only when they change.
+      // The cache consists of two files: the packed library (Path) and the manifest of its sources (Path + ".manifest"),
+      // which lists paths, sizes and modification times of all bitmaps.
+      template <typename T>
+      class Lesson2DLibraryCache
+      {
+
+        static_assert(std::is_floating_point<T>::value);
+
+      public:
+
+        Lesson2DLibraryCache(const std::filesystem::path& path);
+
+        const std::filesystem::path& GetPath() const noexcept;
+
+        // Exception guarantee: strong.
+        // If the manifest matches the sources, the library is read from the memory-mapped cache.
+        // Otherwise the library is rebuilt by the loader and the cache is rewritten.
+        // The library is allocated by the resource.
+        Lesson2DLibrary<T> Load(const Lesson2DLibraryLoader<T>& loader,
+                                const std::vector<std::filesystem::path>& directories,
+                                common::ThreadPool& threadPool,
+                                std::pmr::memory_resource* const resource = std::pmr::get_default_resource()) const;
+
+      private:
+
+        // "CNNL2DC\0" in little-endian.
+        constexpr static uint64_t MAGIC = 0x004344324C4E4E43;
+        constexpr static uint64_t VERSION = 3;
+        constexpr static size_t HEADER_VALUE_COUNT = 10;
+
+        std::filesystem::path Path;
+
+        std::filesystem::path GetManifestPath() const;
+
+        static std::string GetManifest(const Lesson2DTopology& topology,
+                                       const std::vector<std::filesystem::path>& directories,
+                                       common::ThreadPool& threadPool);
+
+        bool TryRead(const std::string& manifest, const Lesson2DTopology& topology, Lesson2DLibrary<T>& library) const;
+
+        void Write(const std::string& manifest, const Lesson2DTopology& topology, const Lesson2DLibrary<T>& library) const;
+
+        static void WriteString(std::ostream& ostream, const std::string& value);
+
+        // Binary inputs are kept bit-packed, as in the library.
+        static size_t GetInputByteCount(const Lesson2DTopology& topology) noexcept;
+
+        // Class labels are kept as one index per lesson, as in the library.
+        static size_t GetOutputByteCount(const Lesson2DTopology& topology) noexcept;
+
+      };
+
+      template <typename T>
+      Lesson2DLibraryCache<T>::Lesson2DLibraryCache(const std::filesystem::path& path)
+        :
+        Path{ path }
+      {
+        if (path.empty())
+        {
+          throw std::invalid_argument("cnn::engine::complex::Lesson2DLibraryCache::Lesson2DLibraryCache(), path.empty() == true.");
+        }
+      }
+
+      template <typename T>
+      const std::filesystem::path& Lesson2DLibraryCache<T>::GetPath() const noexcept
+      {
+        return Path;
+      }
+
+      template <typename T>
+      Lesson2DLibrary<T> Lesson2DLibraryCache<T>::Load(const Lesson2DLibraryLoader<T>& loader,
+                                                       const std::vector<std::filesystem::path>& directories,
+                                                       common::ThreadPool& threadPool,
+                                                       std::pmr::memory_resource* const resource) const
+      {
+        const std::string manifest = GetManifest(loader.GetTopology(), directories, threadPool);
+
+        Lesson2DLibrary<T> library{ resource };
+        if (TryRead(manifest, loader.GetTopology(), library))
+        {
+          return library;
+        }
+
+        library = loader.Load(directories, threadPool, resource);
+        Write(manifest, loader.GetTopology(), library);
+        return library;
+      }
+
+      template <typename T>
+      std::filesystem::path Lesson2DLibraryCache<T>::GetManifestPath() const
+      {
+        std::filesystem::path manifestPath = Path;
+        manifestPath += ".manifest";
+        return manifestPath;
+      }
+
+      template <typename T>
+      std::string Lesson2DLibraryCache<T>::GetManifest(const Lesson2DTopology& topology,
+                                                       const std::vector<std::filesystem::path>& directories,
+                                                       common::ThreadPool& threadPool)
+      {
+        std::vector<std::string> directoryManifests(directories.size());
+        auto task = [&directories, &directoryManifests](const size_t d)
+        {
+          std::ostringstream ostream{ std::ios::binary };
+          WriteString(ostream, directories[d].generic_string());
+
+          const auto bitmaps = Lesson2DLibraryLoader<T>::FindBitmaps(directories[d]);
+          const uint64_t bitmapCount = bitmaps.size();
+          ostream.write(reinterpret_cast<const char*>(&bitmapCount), sizeof(bitmapCount));
+          for (const auto& bitmap : bitmaps)
+          {
+            WriteString(ostream, bitmap.filename().generic_string());
+            const uint64_t size = std::filesystem::file_size(bitmap);
+            const int64_t time = static_cast<int64_t>(std::filesystem::last_write_time(bitmap).time_since_epoch().count());
+            ostream.write(reinterpret_cast<const char*>(&size), sizeof(size));
+            ostream.write(reinterpret_cast<const char*>(&time), sizeof(time));
+          }
+          directoryManifests[d] = ostream.str();
+        };
+        threadPool.ParallelFor(directories.size(), task);
+
+        std::ostringstream ostream{ std::ios::binary };
+        const uint64_t header[] = { MAGIC,
+                                    VERSION,
+                                    sizeof(T),
+                                    topology.GetInputSize().GetWidth(),
+                                    topology.GetInputSize().GetHeight(),
+                                    topology.GetInputCount(),
+                                    topology.GetOutputCount(),
+                                    topology.GetBinaryInputs(),
+                                    topology.GetClassLabels(),
+                                    directories.size() };
+        ostream.write(reinterpret_cast<const char*>(header), sizeof(header));
+        for (const auto& directoryManifest : directoryManifests)
+        {
+          ostream << directoryManifest;
+        }
+        return ostream.str();
+      }
+
+      template <typename T>
+      bool Lesson2DLibraryCache<T>::TryRead(const std::string& manifest, const Lesson2DTopology& topology, Lesson2DLibrary<T>& library) const
+      {
+        {
+          std::ifstream istream{ GetManifestPath(), std::ios::binary };
+          if (istream.good() == false)
+          {
+            return false;
+          }
+          const std::string cachedManifest{ std::istreambuf_iterator<char>{ istream }, std::istreambuf_iterator<char>{} };
+          if (cachedManifest != manifest)
+          {
+            return false;
+          }
+        }
+
+        common::MappedFile file;
+        try
+        {
+          file = common::MappedFile{ Path };
+        }
+        catch (const std::runtime_error&)
+        {
+          return false;
+        }
+
+        uint64_t header[HEADER_VALUE_COUNT]{};
+        if (file.GetSize() < sizeof(header))
+        {
+          return false;
+        }
+        std::memcpy(header, file.GetData(), sizeof(header));
+
+        const size_t lessonCount = static_cast<size_t>(header[9]);
+        const size_t inputByteCount = GetInputByteCount(topology);
+        const size_t outputByteCount = GetOutputByteCount(topology);
+        if ((header[0] != MAGIC) ||
+            (header[1] != VERSION) ||
+            (header[2] != sizeof(T)) ||
+            (header[3] != topology.GetInputSize().GetWidth()) ||
+            (header[4] != topology.GetInputSize().GetHeight()) ||
+            (header[5] != topology.GetInputCount()) ||
+            (header[6] != topology.GetOutputCount()) ||
+            (header[7] != static_cast<uint64_t>(topology.GetBinaryInputs())) ||
+            (header[8] != static_cast<uint64_t>(topology.GetClassLabels())) ||
+            (file.GetSize() != sizeof(header) + lessonCount * (inputByteCount + outputByteCount)))
+        {
+          return false;
+        }
+
+        // Inputs of all lessons go first, then outputs of all lessons.
+        const uint8_t* inputs = file.GetData() + sizeof(header);
+        const uint8_t* outputs = inputs + lessonCount * inputByteCount;
+
+        Lesson2DLibrary<T> tmpLibrary{ lessonCount, topology, library.GetResource() };
+        if (lessonCount != 0)
+        {
+          if (topology.GetBinaryInputs())
+          {
+            std::memcpy(tmpLibrary.GetBinaryInputs(0), inputs, lessonCount * inputByteCount);
+          }
+          else
+          {
+            std::memcpy(tmpLibrary.GetInputs(0), inputs, lessonCount * inputByteCount);
+          }
+          if (topology.GetClassLabels())
+          {
+            std::memcpy(tmpLibrary.GetLabels(0), outputs, lessonCount * outputByteCount);
+          }
+          else
+          {
+            std::memcpy(tmpLibrary.GetOutputs(0), outputs, lessonCount * outputByteCount);
+          }
+        }
+
+        library = std::move(tmpLibrary);
+        return true;
+      }
+
+      template <typename T>
+      void Lesson2DLibraryCache<T>::Write(const std::string& manifest, const Lesson2DTopology& topology, const Lesson2DLibrary<T>& library) const
+      {
+        // The cache is only an optimization, so the failure to write it doesn't fail the loading.
+        // The manifest is written last, so a broken cache is never taken as valid.
+        std::error_code errorCode;
+        std::filesystem::remove(GetManifestPath(), errorCode);
+
+        {
+          std::ofstream ostream{ Path, std::ios::binary | std::ios::trunc };
+          const uint64_t header[HEADER_VALUE_COUNT] = { MAGIC,
+                                                        VERSION,
+                                                        sizeof(T),
+                                                        topology.GetInputSize().GetWidth(),
+                                                        topology.GetInputSize().GetHeight(),
+                                                        topology.GetInputCount(),
+                                                        topology.GetOutputCount(),
+                                                        topology.GetBinaryInputs(),
+                                                        topology.GetClassLabels(),
+                                                        library.GetLessonCount() };
+          ostream.write(reinterpret_cast<const char*>(header), sizeof(header));
+
+          if (library.GetLessonCount() != 0)
+          {
+            const void* const inputs = topology.GetBinaryInputs() ? static_cast<const void*>(library.GetBinaryInputs(0))
+                                                                  : static_cast<const void*>(library.GetInputs(0));
+            ostream.write(static_cast<const char*>(inputs),
+                          static_cast<std::streamsize>(library.GetLessonCount() * GetInputByteCount(topology)));
+            const void* const outputs = topology.GetClassLabels() ? static_cast<const void*>(library.GetLabels(0))
+                                                                  : static_cast<const void*>(library.GetOutputs(0));
+            ostream.write(static_cast<const char*>(outputs),
+                          static_cast<std::streamsize>(library.GetLessonCount() * GetOutputByteCount(topology)));
+          }
+
+          ostream.close();
+          if (ostream.fail())
+          {
+            std::filesystem::remove(Path, errorCode);
+            return;
+          }
+        }
+
+        std::ofstream ostream{ GetManifestPath(), std::ios::binary | std::ios::trunc };
+        ostream.write(manifest.data(), static_cast<std::streamsize>(manifest.size()));
+        ostream.close();
+        if (ostream.fail())
+        {
+          std::filesystem::remove(GetManifestPath(), errorCode);
+        }
+      }
+
+      template <typename T>
+      void Lesson2DLibraryCache<T>::WriteString(std::ostream& ostream, const std::string& value)
+      {
+        const uint64_t size = value.size();
+        ostream.write(reinterpret_cast<const char*>(&size), sizeof(size));
+        ostream.write(value.data(), static_cast<std::streamsize>(value.size()));
+      }
+
+      template <typename T>
+      size_t Lesson2DLibraryCache<T>::GetInputByteCount(const Lesson2DTopology& topology) noexcept
+      {
+        if (topology.GetBinaryInputs())
+        {
+          const size_t rowWordCount = common::BitPacking::GetWordCount(topology.GetInputSize().GetWidth());
+          return topology.GetInputCount() * topology.GetInputSize().GetHeight() * rowWordCount * sizeof(uint64_t);
+        }
+        return topology.GetInputCount() * topology.GetInputSize().GetArea() * sizeof(T);
+      }
+
+      template <typename T>
+      size_t Lesson2DLibraryCache<T>::GetOutputByteCount(const Lesson2DTopology& topology) noexcept
+      {
+        return topology.GetClassLabels() ? sizeof(uint32_t) : topology.GetOutputCount() * sizeof(T);
+      }
+    }
+  }
+}
@@ -0,0 +1,191 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <filesystem>
+#include <fstream>
+#include <algorithm>
+#include <utility>
+#include <vector>
+#include <memory_resource>
+#include <stdexcept>
+
+#include "Lesson2DTopology.hpp"
+#include "Lesson2DLibrary.hpp"
+
+#include "../common/Bitmap.hpp"
+#include "../common/ThreadPool.hpp"
+
+namespace cnn
+{
+  namespace engine
+  {
+    namespace complex
+    {
+      // Lesson2DLibraryLoader builds a lesson library from directories of bitmaps.
+      // Lessons of the i-th directory get the output, where only the i-th value is 1 (or the class label i).
+      // Directories are walked and bitmaps are decoded across the thread pool;
+      // every lesson is written in place into the preallocated library.
+      template <typename T>
+      class Lesson2DLibraryLoader
+      {
+
+        static_assert(std::is_floating_point<T>::value);
+
+      public:
+
+        // The topology must have one input, because a bitmap gives one input map.
+        Lesson2DLibraryLoader(const Lesson2DTopology& topology);
+
+        const Lesson2DTopology& GetTopology() const noexcept;
+
+        // Exception guarantee: strong.
+        // Files with .bmp extension are taken in the order of their names.
+        // Dark pixels give high inputs: black is 1 and white is 0.
+        // If the topology declares binary inputs, pixels darker than the middle gray give 1.
+        // The library is allocated by the resource.
+        Lesson2DLibrary<T> Load(const std::vector<std::filesystem::path>& directories,
+                                common::ThreadPool& threadPool,
+                                std::pmr::memory_resource* const resource = std::pmr::get_default_resource()) const;
+
+        // It returns the bitmaps of the directory in the order of their names.
+        static std::vector<std::filesystem::path> FindBitmaps(const std::filesystem::path& directory);
+
+      private:
+
+        Lesson2DTopology Topology;
+
+        void LoadLesson(const std::filesystem::path& path, const size_t outputIndex, const size_t lessonIndex, Lesson2DLibrary<T>& library) const;
+
+        void CheckTopology(const Lesson2DTopology& topology) const;
+
+      };
+
+      template <typename T>
+      Lesson2DLibraryLoader<T>::Lesson2DLibraryLoader(const Lesson2DTopology& topology)
+      {
+        CheckTopology(topology);
+
+        Topology = topology;
+      }
+
+      template <typename T>
+      const Lesson2DTopology& Lesson2DLibraryLoader<T>::GetTopology() const noexcept
+      {
+        return Topology;
+      }
+
+      template <typename T>
+      Lesson2DLibrary<T> Lesson2DLibraryLoader<T>::Load(const std::vector<std::filesystem::path>& directories,
+                                                        common::ThreadPool& threadPool,
+                                                        std::pmr::memory_resource* const resource) const
+      {
+        if (directories.size() > Topology.GetOutputCount())
+        {
+          throw std::invalid_argument("cnn::engine::complex::Lesson2DLibraryLoader::Load(), directories.size() > Topology.GetOutputCount().");
+        }
+
+        std::vector<std::vector<std::filesystem::path>> bitmaps(directories.size());
+        auto findTask = [&directories, &bitmaps](const size_t d)
+        {
+          bitmaps[d] = FindBitmaps(directories[d]);
+        };
+        threadPool.ParallelFor(directories.size(), findTask);
+
+        std::vector<std::pair<const std::filesystem::path*, size_t>> lessonSources;
+        for (size_t d = 0; d < bitmaps.size(); ++d)
+        {
+          for (const auto& bitmap : bitmaps[d])
+          {
+            lessonSources.emplace_back(&bitmap, d);
+          }
+        }
+
+        Lesson2DLibrary<T> library{ lessonSources.size(), Topology, resource };
+        auto loadTask = [this, &lessonSources, &library](const size_t l)
+        {
+          LoadLesson(*lessonSources[l].first, lessonSources[l].second, l, library);
+        };
+        threadPool.ParallelFor(lessonSources.size(), loadTask);
+
+        return library;
+      }
+
+      template <typename T>
+      std::vector<std::filesystem::path> Lesson2DLibraryLoader<T>::FindBitmaps(const std::filesystem::path& directory)
+      {
+        std::vector<std::filesystem::path> bitmaps;
+        for (const auto& entry : std::filesystem::directory_iterator{ directory })
+        {
+          if ((entry.is_directory() == false) && (entry.path().extension() == ".bmp"))
+          {
+            bitmaps.push_back(entry.path());
+          }
+        }
+        std::sort(bitmaps.begin(), bitmaps.end());
+        return bitmaps;
+      }
+
+      template <typename T>
+      void Lesson2DLibraryLoader<T>::LoadLesson(const std::filesystem::path& path, const size_t outputIndex, const size_t lessonIndex, Lesson2DLibrary<T>& library) const
+      {
+        std::ifstream istream{ path, std::ios::binary };
+        common::Bitmap bitmap;
+        bitmap.Load(istream);
+
+        if ((bitmap.GetWidth() != Topology.GetInputSize().GetWidth()) || (bitmap.GetHeight() != Topology.GetInputSize().GetHeight()))
+        {
+          throw std::runtime_error("cnn::engine::complex::Lesson2DLibraryLoader::LoadLesson(), the size of the bitmap != Topology.GetInputSize().");
+        }
+
+        const uint32_t* pixels = bitmap.GetPixels();
+        if (Topology.GetBinaryInputs())
+        {
+          // Lessons never share words, so threads write their own words only.
+          const size_t width = Topology.GetInputSize().GetWidth();
+          const size_t rowWordCount = common::BitPacking::GetWordCount(width);
+          uint64_t* const inputs = library.GetBinaryInputs(lessonIndex);
+          for (size_t y = 0; y < Topology.GetInputSize().GetHeight(); ++y)
+          {
+            for (size_t x = 0; x < width; ++x)
+            {
+              common::BitPacking::SetBit(inputs + y * rowWordCount, x, common::Bitmap::GetIntensity(pixels[x + y * width]) < 0.5);
+            }
+          }
+        }
+        else
+        {
+          T* const inputs = library.GetInputs(lessonIndex);
+          const size_t area = Topology.GetInputSize().GetArea();
+          for (size_t i = 0; i < area; ++i)
+          {
+            inputs[i] = 1 - static_cast<T>(common::Bitmap::GetIntensity(pixels[i]));
+          }
+        }
+
+        if (Topology.GetClassLabels())
+        {
+          library.GetLabels(lessonIndex)[0] = static_cast<uint32_t>(outputIndex);
+        }
+        else
+        {
+          library.GetOutputs(lessonIndex)[outputIndex] = 1;
+        }
+      }
+
+      template <typename T>
+      void Lesson2DLibraryLoader<T>::CheckTopology(const Lesson2DTopology& topology) const
+      {
+        if ((topology.GetInputSize().GetArea() == 0) || (topology.GetOutputCount() == 0))
+        {
+          throw std::invalid_argument("cnn::engine::complex::Lesson2DLibraryLoader::CheckTopology(), (topology.GetInputSize().GetArea() == 0) || (topology.GetOutputCount() == 0).");
+        }
+        if (topology.GetInputCount() != 1)
+        {
+          throw std::invalid_argument("cnn::engine::complex::Lesson2DLibraryLoader::CheckTopology(), topology.GetInputCount() != 1.");
+        }
+      }
+    }
+  }
+}
@@ -32,9 +32,9 @@ namespace cnn
 
         const Lesson2DTopology& GetTopology() const noexcept;
 
-        const convolution::Map2D<T>& GetConstInput() const noexcept;
+        const convolution::Map2D<T>& GetConstInput(const size_t index) const;
 
-        convolution::Map2DProtectingReference<T> GetInput() const noexcept;
+        convolution::Map2DProtectingReference<T> GetInput(const size_t index) const;
 
         const common::Map<T>& GetConstOutput() const noexcept;
 
@@ -74,21 +74,21 @@ namespace cnn
       }
 
       template <typename T>
-      const convolution::Map2D<T>& Lesson2DProtectingReference<T>::GetConstInput() const noexcept
+      const convolution::Map2D<T>& Lesson2DProtectingReference<T>::GetConstInput(const size_t index) const
       {
-        return Lesson.GetInput();
+        return static_cast<const Lesson2D<T>&>(Lesson).GetInput(index);
       }
 
       template <typename T>
-      convolution::Map2DProtectingReference<T> Lesson2DProtectingReference<T>::GetInput() const noexcept
+      convolution::Map2DProtectingReference<T> Lesson2DProtectingReference<T>::GetInput(const size_t index) const
       {
-        return Lesson.GetInput();
+        return Lesson.GetInput(index);
       }
 
       template <typename T>
       const common::Map<T>& Lesson2DProtectingReference<T>::GetConstOutput() const noexcept
       {
-        return Lesson.GetOutput();
+        return static_cast<const Lesson2D<T>&>(Lesson).GetOutput();
       }
 
       template <typename T>
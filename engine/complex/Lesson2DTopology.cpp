@@ -8,11 +8,15 @@ namespace cnn
     {
       Lesson2DTopology::Lesson2DTopology(const convolution::Size2D& inputSize,
                                          const size_t inputCount,
-                                         const size_t outputCount) noexcept
+                                         const size_t outputCount,
+                                         const bool binaryInputs,
+                                         const bool classLabels) noexcept
         :
         InputSize{ inputSize },
         InputCount{ inputCount },
-        OutputCount{ outputCount }
+        OutputCount{ outputCount },
+        BinaryInputs{ binaryInputs },
+        ClassLabels{ classLabels }
       {
       }
 
@@ -20,7 +24,9 @@ namespace cnn
         :
         InputSize{ std::move(topology.InputSize) },
         InputCount{ topology.InputCount },
-        OutputCount{ topology.OutputCount }
+        OutputCount{ topology.OutputCount },
+        BinaryInputs{ topology.BinaryInputs },
+        ClassLabels{ topology.ClassLabels }
       {
         topology.Reset();
       }
@@ -32,6 +38,8 @@ namespace cnn
           InputSize = std::move(topology.InputSize);
           InputCount = topology.InputCount;
           OutputCount = std::move(topology.OutputCount);
+          BinaryInputs = topology.BinaryInputs;
+          ClassLabels = topology.ClassLabels;
 
           topology.Reset();
         }
@@ -40,7 +48,11 @@ namespace cnn
 
       bool Lesson2DTopology::operator==(const Lesson2DTopology& topology) const noexcept
       {
-        if ((InputSize == topology.InputSize) && (InputCount == topology.InputCount) && (OutputCount == topology.OutputCount))
+        if ((InputSize == topology.InputSize) &&
+            (InputCount == topology.InputCount) &&
+            (OutputCount == topology.OutputCount) &&
+            (BinaryInputs == topology.BinaryInputs) &&
+            (ClassLabels == topology.ClassLabels))
         {
           return true;
         } else {
@@ -88,11 +100,33 @@ namespace cnn
         OutputCount = outputCount;
       }
 
+      bool Lesson2DTopology::GetBinaryInputs() const noexcept
+      {
+        return BinaryInputs;
+      }
+
+      void Lesson2DTopology::SetBinaryInputs(const bool binaryInputs) noexcept
+      {
+        BinaryInputs = binaryInputs;
+      }
+
+      bool Lesson2DTopology::GetClassLabels() const noexcept
+      {
+        return ClassLabels;
+      }
+
+      void Lesson2DTopology::SetClassLabels(const bool classLabels) noexcept
+      {
+        ClassLabels = classLabels;
+      }
+
       void Lesson2DTopology::Reset() noexcept
       {
         InputSize.Reset();
         InputCount = 0;
         OutputCount = 0;
+        BinaryInputs = false;
+        ClassLabels = false;
       }
 
       void Lesson2DTopology::Save(std::ostream& ostream) const
@@ -105,6 +139,8 @@ namespace cnn
         InputSize.Save(ostream);
         ostream.write(reinterpret_cast<const char* const>(&InputCount), sizeof(InputCount));
         ostream.write(reinterpret_cast<const char* const>(&OutputCount), sizeof(OutputCount));
+        const uint8_t flags = (BinaryInputs ? BINARY_INPUTS_FLAG : 0) | (ClassLabels ? CLASS_LABELS_FLAG : 0);
+        ostream.write(reinterpret_cast<const char* const>(&flags), sizeof(flags));
 
         if (ostream.good() == false)
         {
@@ -122,10 +158,12 @@ namespace cnn
         decltype(InputSize) inputSize{};
         decltype(InputCount) inputCount{};
         decltype(OutputCount) outputCount{};
+        uint8_t flags{};
 
-        istream.read(reinterpret_cast<char* const>(&inputSize), sizeof(inputSize));
+        inputSize.Load(istream);
         istream.read(reinterpret_cast<char* const>(&inputCount), sizeof(inputCount));
         istream.read(reinterpret_cast<char*const>(&outputCount), sizeof(outputCount));
+        istream.read(reinterpret_cast<char* const>(&flags), sizeof(flags));
 
         if (istream.good() == false)
         {
@@ -135,7 +173,8 @@ namespace cnn
         InputSize = inputSize;
         InputCount = inputCount;
         OutputCount = outputCount;
-
+        BinaryInputs = (flags & BINARY_INPUTS_FLAG) != 0;
+        ClassLabels = (flags & CLASS_LABELS_FLAG) != 0;
       }
     }
   }
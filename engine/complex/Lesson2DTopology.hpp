@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstdint>
+
 #include "../convolution/Size2D.hpp"
 
 namespace cnn
@@ -18,7 +20,9 @@ namespace cnn
 
         Lesson2DTopology(const convolution::Size2D& inputSize = {},
                          const size_t inputCount = {},
-                         const size_t outputSize = {}) noexcept;
+                         const size_t outputSize = {},
+                         const bool binaryInputs = {},
+                         const bool classLabels = {}) noexcept;
 
         Lesson2DTopology(const Lesson2DTopology& topology) noexcept = default;
 
@@ -44,6 +48,16 @@ namespace cnn
 
         void SetOutputCount(const size_t outputCount) noexcept;
 
+        // Binary inputs contain only 0 and 1, so lessons store them bit-packed (see common::BitPacking).
+        bool GetBinaryInputs() const noexcept;
+
+        void SetBinaryInputs(const bool binaryInputs) noexcept;
+
+        // Outputs of class labels are one-hot, so lessons store only the index of the class, where the output is 1.
+        bool GetClassLabels() const noexcept;
+
+        void SetClassLabels(const bool classLabels) noexcept;
+
         // It resets the state to zero.
         void Reset() noexcept;
 
@@ -60,6 +74,11 @@ namespace cnn
         convolution::Size2D InputSize;
         size_t InputCount;
         size_t OutputCount;
+        bool BinaryInputs;
+        bool ClassLabels;
+
+        constexpr static uint8_t BINARY_INPUTS_FLAG = 1;
+        constexpr static uint8_t CLASS_LABELS_FLAG = 2;
 
       };
     }
@@ -0,0 +1,180 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <stdexcept>
+
+#include "Lesson2DTopology.hpp"
+#include "Lesson2D.hpp"
+
+#include "../common/BitPacking.hpp"
+
+namespace cnn
+{
+  namespace engine
+  {
+    namespace complex
+    {
+      // Lesson2DView is a read-only view to a lesson, which is stored in Lesson2DLibrary.
+      // The view is valid until the library is changed.
+      template <typename T>
+      class Lesson2DView
+      {
+
+        static_assert(std::is_floating_point<T>::value);
+
+      public:
+
+        // Binary inputs are passed by binaryInputs, then inputs are not used.
+        // Class labels are passed by label, then output is not used.
+        Lesson2DView(const Lesson2DTopology& topology,
+                     const T* inputs,
+                     const uint64_t* binaryInputs,
+                     const T* output,
+                     const uint32_t* label) noexcept;
+
+        Lesson2DView(const Lesson2DView& view) noexcept = default;
+
+        Lesson2DView& operator=(const Lesson2DView& view) noexcept = default;
+
+        const Lesson2DTopology& GetTopology() const noexcept;
+
+        // It returns GetInputSize().GetArea() values of the input, which are stored row by row (x + y * width).
+        const T* GetInput(const size_t index) const;
+
+        // It returns the bit-packed input (see common::BitPacking), if the topology declares binary inputs.
+        // Inputs follow one another, so GetBinaryInput(0) addresses all of them.
+        const uint64_t* GetBinaryInput(const size_t index) const;
+
+        // It returns GetOutputCount() values of the output.
+        const T* GetOutput() const;
+
+        // It returns the index of the class, if the topology declares class labels.
+        size_t GetLabel() const;
+
+        // Exception guarantee: strong.
+        // It copies the lesson out of the library.
+        Lesson2D<T> GetLesson() const;
+
+      private:
+
+        const Lesson2DTopology* Topology;
+        const T* Inputs;
+        const uint64_t* BinaryInputs;
+        const T* Output;
+        const uint32_t* Label;
+
+      };
+
+      template <typename T>
+      Lesson2DView<T>::Lesson2DView(const Lesson2DTopology& topology,
+                                    const T* inputs,
+                                    const uint64_t* binaryInputs,
+                                    const T* output,
+                                    const uint32_t* label) noexcept
+        :
+        Topology{ &topology },
+        Inputs{ inputs },
+        BinaryInputs{ binaryInputs },
+        Output{ output },
+        Label{ label }
+      {
+      }
+
+      template <typename T>
+      const Lesson2DTopology& Lesson2DView<T>::GetTopology() const noexcept
+      {
+        return *Topology;
+      }
+
+      template <typename T>
+      const T* Lesson2DView<T>::GetInput(const size_t index) const
+      {
+        if (index >= Topology->GetInputCount())
+        {
+          throw std::range_error("cnn::engine::complex::Lesson2DView::GetInput(), index >= Topology->GetInputCount().");
+        }
+        if (Topology->GetBinaryInputs())
+        {
+          throw std::logic_error("cnn::engine::complex::Lesson2DView::GetInput(), Topology->GetBinaryInputs() == true.");
+        }
+        return Inputs + index * Topology->GetInputSize().GetArea();
+      }
+
+      template <typename T>
+      const uint64_t* Lesson2DView<T>::GetBinaryInput(const size_t index) const
+      {
+        if (index >= Topology->GetInputCount())
+        {
+          throw std::range_error("cnn::engine::complex::Lesson2DView::GetBinaryInput(), index >= Topology->GetInputCount().");
+        }
+        if (Topology->GetBinaryInputs() == false)
+        {
+          throw std::logic_error("cnn::engine::complex::Lesson2DView::GetBinaryInput(), Topology->GetBinaryInputs() == false.");
+        }
+        const size_t inputWordCount = common::BitPacking::GetWordCount(Topology->GetInputSize().GetWidth()) * Topology->GetInputSize().GetHeight();
+        return BinaryInputs + index * inputWordCount;
+      }
+
+      template <typename T>
+      const T* Lesson2DView<T>::GetOutput() const
+      {
+        if (Topology->GetClassLabels())
+        {
+          throw std::logic_error("cnn::engine::complex::Lesson2DView::GetOutput(), Topology->GetClassLabels() == true.");
+        }
+        return Output;
+      }
+
+      template <typename T>
+      size_t Lesson2DView<T>::GetLabel() const
+      {
+        if (Topology->GetClassLabels() == false)
+        {
+          throw std::logic_error("cnn::engine::complex::Lesson2DView::GetLabel(), Topology->GetClassLabels() == false.");
+        }
+        return *Label;
+      }
+
+      template <typename T>
+      Lesson2D<T> Lesson2DView<T>::GetLesson() const
+      {
+        Lesson2D<T> lesson{ *Topology };
+        const size_t width = Topology->GetInputSize().GetWidth();
+        const size_t height = Topology->GetInputSize().GetHeight();
+        for (size_t i = 0; i < Topology->GetInputCount(); ++i)
+        {
+          if (Topology->GetBinaryInputs())
+          {
+            T* const values = lesson.GetInput(i).GetValues();
+            const size_t stride = lesson.GetInput(i).GetStride();
+            const size_t rowWordCount = common::BitPacking::GetWordCount(width);
+            const uint64_t* const input = GetBinaryInput(i);
+            for (size_t y = 0; y < height; ++y)
+            {
+              for (size_t x = 0; x < width; ++x)
+              {
+                values[x + y * stride] = common::BitPacking::GetBit(input + y * rowWordCount, x) ? static_cast<T>(1) : static_cast<T>(0);
+              }
+            }
+          }
+          else
+          {
+            lesson.GetInput(i).CopyFrom(GetInput(i));
+          }
+        }
+        if (Topology->GetClassLabels())
+        {
+          lesson.GetOutput().SetValue(GetLabel(), 1);
+        }
+        else
+        {
+          std::memcpy(lesson.GetOutput().GetValues(), Output, sizeof(T) * Topology->GetOutputCount());
+        }
+        return lesson;
+      }
+    }
+  }
+}
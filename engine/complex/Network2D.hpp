@@ -1,5 +1,11 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include <memory_resource>
+
 #include "Network2DTopology.hpp"
 
 #include "../convolution/Network2DProtectingReference.hpp"
@@ -16,7 +22,8 @@ namespace cnn
       {
       public:
 
-        Network2D(const Network2DTopology& topology = {});
+        // Both networks are allocated by the resource.
+        Network2D(const Network2DTopology& topology = {}, std::pmr::memory_resource* const resource = std::pmr::get_default_resource());
 
         Network2D(const Network2D& network) = default;
 
@@ -26,6 +33,8 @@ namespace cnn
 
         Network2D& operator=(Network2D&& network) noexcept = default;
 
+        std::pmr::memory_resource* GetResource() const noexcept;
+
         const Network2DTopology& GetTopology() const;
 
         void SetTopology(const Network2DTopology& topology);
@@ -43,8 +52,20 @@ namespace cnn
         // Exception guarantee: base for this.
         void GenerateOutput();
 
+        // Exception guarantee: base for this.
+        // It is intended for low-latency inference of a single sample: the work of large layers is split across the pool.
+        void GenerateOutput(common::ThreadPool& threadPool);
+
+        // Exception guarantee: base for this.
+        // The inputs of the convolution network are bit-packed binary maps (see convolution::Layer2D::GenerateOutputFromBinary()).
+        void GenerateOutputFromBinary(const uint64_t* const inputs);
+
+        // It copies the options of the execution of both networks of the network.
+        void CopyExecutionOptions(const Network2D& network) noexcept;
+
+        // Exception guarantee: base for this.
         // It clears the state without changing of the topology.
-        void Clear() noexcept;
+        void Clear();
 
         // It resets the state to zero including the topology.
         void Reset() noexcept;
@@ -57,11 +78,36 @@ namespace cnn
         // It loads full state.
         void Load(std::istream& istream);
 
-        // We expect that the method never throws any exception.
-        void FillWeights(common::ValueGenerator<T>& valueGenerator) noexcept;
+        // Exception guarantee: base for this.
+        void FillWeights(common::ValueGenerator<T>& valueGenerator);
+
+        // Exception guarantee: base for this.
+        void Mutate(common::Mutagen<T>& mutagen);
+
+        // Exception guarantee: strong for this.
+        // It shares the weights of the network of the same topology, so they are duplicated only when one of the sides writes them.
+        void ShareWeights(const Network2D& network);
 
-        // We expect that the method never throws any exception.
-        void Mutate(common::Mutagen<T>& mutagen) noexcept;
+        // Exception guarantee: base for this.
+        // It copies the weights of the network of the same topology, so no memory is allocated, if own weights aren't shared.
+        void CopyWeights(const Network2D& network);
+
+        // Exception guarantee: strong for this and oldWeights.
+        // It mutates weightCount random weights in place (a weight can be chosen several times)
+        // and appends their indices and old values to oldWeights, so RestoreWeights() undoes the mutation.
+        void Mutate(common::Mutagen<T>& mutagen, const size_t weightCount, std::vector<std::pair<size_t, T>>& oldWeights);
+
+        // Exception guarantee: base for this.
+        // Old weights are restored in the reverse order, so a weight mutated several times gets its first old value.
+        void RestoreWeights(const std::vector<std::pair<size_t, T>>& oldWeights);
+
+        // Weights of the convolution network go first, then weights of the perceptron network.
+        size_t GetWeightCount() const noexcept;
+
+        T GetWeight(const size_t index) const;
+
+        // Exception guarantee: strong for this.
+        void SetWeight(const size_t index, const T value);
 
       private:
 
@@ -71,10 +117,16 @@ namespace cnn
 
         void CheckTopology(const Network2DTopology& topology) const;
 
+        // It moves the outputs of the convolution network to the input of the perceptron network.
+        void TransferConvolutionOutput();
+
       };
 
       template <typename T>
-      Network2D<T>::Network2D(const Network2DTopology& topology)
+      Network2D<T>::Network2D(const Network2DTopology& topology, std::pmr::memory_resource* const resource)
+        :
+        ConvolutionNetwork{ convolution::Network2DTopology{}, resource },
+        PerceptronNetwork{ perceptron::NetworkTopology{}, resource }
       {
         CheckTopology(topology);
 
@@ -96,6 +148,12 @@ namespace cnn
         return *this;
       }
 
+      template <typename T>
+      std::pmr::memory_resource* Network2D<T>::GetResource() const noexcept
+      {
+        return ConvolutionNetwork.GetResource();
+      }
+
       template <typename T>
       const Network2DTopology& Network2D<T>::GetTopology() const
       {
@@ -105,7 +163,7 @@ namespace cnn
       template <typename T>
       void Network2D<T>::SetTopology(const Network2DTopology& topology)
       {
-        Network2D<T> tmpNetwork{ topology };
+        Network2D<T> tmpNetwork{ topology, GetResource() };
         // Beware, it is very intimate place for strong exception guarantee.
         std::swap(*this, tmpNetwork);
       }
@@ -140,6 +198,36 @@ namespace cnn
       void Network2D<T>::GenerateOutput()
       {
         ConvolutionNetwork.GenerateOutput();
+        TransferConvolutionOutput();
+        PerceptronNetwork.GenerateOutput();
+      }
+
+      template <typename T>
+      void Network2D<T>::GenerateOutput(common::ThreadPool& threadPool)
+      {
+        ConvolutionNetwork.GenerateOutput(threadPool);
+        TransferConvolutionOutput();
+        PerceptronNetwork.GenerateOutput(threadPool);
+      }
+
+      template <typename T>
+      void Network2D<T>::GenerateOutputFromBinary(const uint64_t* const inputs)
+      {
+        ConvolutionNetwork.GenerateOutputFromBinary(inputs);
+        TransferConvolutionOutput();
+        PerceptronNetwork.GenerateOutput();
+      }
+
+      template <typename T>
+      void Network2D<T>::CopyExecutionOptions(const Network2D& network) noexcept
+      {
+        ConvolutionNetwork.CopyExecutionOptions(network.ConvolutionNetwork);
+        PerceptronNetwork.CopyExecutionOptions(network.PerceptronNetwork);
+      }
+
+      template <typename T>
+      void Network2D<T>::TransferConvolutionOutput()
+      {
         const auto& lastLayer = ConvolutionNetwork.GetLastLayer();
         auto input = PerceptronNetwork.GetFirstLayer().GetInput();
 
@@ -151,16 +239,14 @@ namespace cnn
           {
             for (size_t y = 0; y < output.GetSize().GetHeight(); ++y)
             {
-              input.SetValue(i, output.GetValue(x, y));
+              input.SetValue(i++, output.GetValue(x, y));
             }
           }
         }
-
-        PerceptronNetwork.GenerateOutput();
       }
 
       template <typename T>
-      void Network2D<T>::Clear() noexcept
+      void Network2D<T>::Clear()
       {
         ConvolutionNetwork.Clear();
         PerceptronNetwork.Clear();
@@ -201,8 +287,8 @@ namespace cnn
         }
 
         decltype(Topology) topology;
-        decltype(ConvolutionNetwork) convolutionNetwork;
-        decltype(PerceptronNetwork) perceptronNetwork;
+        decltype(ConvolutionNetwork) convolutionNetwork{ convolution::Network2DTopology{}, GetResource() };
+        decltype(PerceptronNetwork) perceptronNetwork{ perceptron::NetworkTopology{}, GetResource() };
 
         topology.Load(istream);
         CheckTopology(topology);
@@ -230,19 +316,86 @@ namespace cnn
       }
 
       template <typename T>
-      void Network2D<T>::FillWeights(common::ValueGenerator<T>& valueGenerator) noexcept
+      void Network2D<T>::FillWeights(common::ValueGenerator<T>& valueGenerator)
       {
         ConvolutionNetwork.FillWeights(valueGenerator);
         PerceptronNetwork.FillWeights(valueGenerator);
       }
 
       template <typename T>
-      void Network2D<T>::Mutate(common::Mutagen<T>& mutagen) noexcept
+      void Network2D<T>::Mutate(common::Mutagen<T>& mutagen)
       {
         ConvolutionNetwork.Mutate(mutagen);
         PerceptronNetwork.Mutate(mutagen);
       }
 
+      template <typename T>
+      void Network2D<T>::Mutate(common::Mutagen<T>& mutagen, const size_t weightCount, std::vector<std::pair<size_t, T>>& oldWeights)
+      {
+        const size_t networkWeightCount = GetWeightCount();
+        if ((weightCount == 0) || (networkWeightCount == 0))
+        {
+          return;
+        }
+
+        oldWeights.reserve(oldWeights.size() + weightCount);
+        for (size_t i = 0; i < weightCount; ++i)
+        {
+          const size_t index = mutagen.GenerateIndex(networkWeightCount);
+          const T weight = GetWeight(index);
+          oldWeights.emplace_back(index, weight);
+          SetWeight(index, mutagen.Mutate(weight));
+        }
+      }
+
+      template <typename T>
+      void Network2D<T>::RestoreWeights(const std::vector<std::pair<size_t, T>>& oldWeights)
+      {
+        for (auto oldWeight = oldWeights.rbegin(); oldWeight != oldWeights.rend(); ++oldWeight)
+        {
+          SetWeight(oldWeight->first, oldWeight->second);
+        }
+      }
+
+      template <typename T>
+      size_t Network2D<T>::GetWeightCount() const noexcept
+      {
+        return ConvolutionNetwork.GetWeightCount() + PerceptronNetwork.GetWeightCount();
+      }
+
+      template <typename T>
+      T Network2D<T>::GetWeight(const size_t index) const
+      {
+        if (index >= GetWeightCount())
+        {
+          throw std::range_error("cnn::engine::complex::Network2D::GetWeight() const, index >= GetWeightCount().");
+        }
+        const size_t convolutionWeightCount = ConvolutionNetwork.GetWeightCount();
+        if (index < convolutionWeightCount)
+        {
+          return ConvolutionNetwork.GetWeight(index);
+        }
+        return PerceptronNetwork.GetWeight(index - convolutionWeightCount);
+      }
+
+      template <typename T>
+      void Network2D<T>::SetWeight(const size_t index, const T value)
+      {
+        if (index >= GetWeightCount())
+        {
+          throw std::range_error("cnn::engine::complex::Network2D::SetWeight(), index >= GetWeightCount().");
+        }
+        const size_t convolutionWeightCount = ConvolutionNetwork.GetWeightCount();
+        if (index < convolutionWeightCount)
+        {
+          ConvolutionNetwork.SetWeight(index, value);
+        }
+        else
+        {
+          PerceptronNetwork.SetWeight(index - convolutionWeightCount, value);
+        }
+      }
+
       template <typename T>
       void Network2D<T>::CheckTopology(const Network2DTopology& topology) const
       {
@@ -263,6 +416,30 @@ namespace cnn
         }
       }
 
+
+      template <typename T>
+      void Network2D<T>::ShareWeights(const Network2D& network)
+      {
+        if ((ConvolutionNetwork.GetTopology() != network.ConvolutionNetwork.GetTopology()) ||
+            (PerceptronNetwork.GetTopology() != network.PerceptronNetwork.GetTopology()))
+        {
+          throw std::invalid_argument("cnn::engine::complex::Network2D::ShareWeights(), the topology != network.GetTopology().");
+        }
+        ConvolutionNetwork.ShareWeights(network.ConvolutionNetwork);
+        PerceptronNetwork.ShareWeights(network.PerceptronNetwork);
+      }
+
+      template <typename T>
+      void Network2D<T>::CopyWeights(const Network2D& network)
+      {
+        if ((ConvolutionNetwork.GetTopology() != network.ConvolutionNetwork.GetTopology()) ||
+            (PerceptronNetwork.GetTopology() != network.PerceptronNetwork.GetTopology()))
+        {
+          throw std::invalid_argument("cnn::engine::complex::Network2D::CopyWeights(), the topology != network.GetTopology().");
+        }
+        ConvolutionNetwork.CopyWeights(network.ConvolutionNetwork);
+        PerceptronNetwork.CopyWeights(network.PerceptronNetwork);
+      }
     }
   }
 }
\ No newline at end of file
@@ -0,0 +1,167 @@
+#pragma once
+
+#include <cstddef>
+#include <cmath>
+#include <algorithm>
+#include <numeric>
+#include <vector>
+#include <stdexcept>
+#include <type_traits>
+
+#include "Network2D.hpp"
+
+namespace cnn
+{
+  namespace engine
+  {
+    namespace complex
+    {
+      // Pruning2D zeroes weights of small magnitude, which the genetic search leaves near zero.
+      // Pruning makes layers, which are sparse enough, sparse, so they apply only nonzero weights: convolution layers by lists of taps
+      // of cores and perceptron layers by compressed sparse rows (see convolution::Layer2D::SetSparse() and perceptron::Layer::SetSparse()).
+      // Pruned weights are ordinary zeros, so they are saved, loaded and mutated as usual, but the sparsity state is not saved,
+      // and mutations of whole layers make them dense.
+      template <typename T>
+      class Pruning2D
+      {
+
+        static_assert(std::is_floating_point<T>::value);
+
+      public:
+
+        // Exception guarantee: base for network.
+        // It zeroes weights, which magnitude is less than the threshold, and returns the count of zero weights of the network.
+        static size_t PruneByThreshold(Network2D<T>& network, const T threshold);
+
+        // Exception guarantee: base for network.
+        // It keeps round(density * weight count) weights of the largest magnitude in every layer and zeroes the rest,
+        // so small layers are not pruned out by large ones. It returns the count of zero weights of the network.
+        static size_t PruneByDensity(Network2D<T>& network, const T density);
+
+        // It returns the count of zero weights of the network.
+        static size_t GetZeroCount(const Network2D<T>& network);
+
+        // It makes every layer sparse, if the sparse kernel is estimated to be faster for it, and dense otherwise,
+        // e.g. after a pruned network is loaded.
+        static void SetSparsity(Network2D<T>& network);
+
+      private:
+
+        ~Pruning2D() = delete;
+
+        // It returns the weight counts of the layers in the order of Network2D::GetWeight().
+        static std::vector<size_t> GetLayerWeightCounts(const Network2D<T>& network);
+
+      };
+
+      template <typename T>
+      size_t Pruning2D<T>::PruneByThreshold(Network2D<T>& network, const T threshold)
+      {
+        if (!(threshold >= 0))
+        {
+          throw std::invalid_argument("cnn::engine::complex::Pruning2D::PruneByThreshold(), !(threshold >= 0).");
+        }
+
+        for (size_t i = 0; i < network.GetWeightCount(); ++i)
+        {
+          const T weight = network.GetWeight(i);
+          if ((weight != 0) && (std::abs(weight) < threshold))
+          {
+            network.SetWeight(i, static_cast<T>(0.L));
+          }
+        }
+        SetSparsity(network);
+        return GetZeroCount(network);
+      }
+
+      template <typename T>
+      size_t Pruning2D<T>::PruneByDensity(Network2D<T>& network, const T density)
+      {
+        if (!((density >= 0) && (density <= 1)))
+        {
+          throw std::invalid_argument("cnn::engine::complex::Pruning2D::PruneByDensity(), !((density >= 0) && (density <= 1)).");
+        }
+
+        std::vector<T> magnitudes;
+        std::vector<size_t> order;
+        size_t beginIndex = 0;
+        for (const size_t layerWeightCount : GetLayerWeightCounts(network))
+        {
+          const size_t keptCount = static_cast<size_t>(std::round(density * static_cast<T>(layerWeightCount)));
+          if (keptCount < layerWeightCount)
+          {
+            magnitudes.resize(layerWeightCount);
+            for (size_t i = 0; i < layerWeightCount; ++i)
+            {
+              magnitudes[i] = std::abs(network.GetWeight(beginIndex + i));
+            }
+            // Weights of equal magnitude are ordered by their indices, so the result doesn't depend on the implementation.
+            order.resize(layerWeightCount);
+            std::iota(order.begin(), order.end(), size_t{ 0 });
+            std::nth_element(order.begin(), order.begin() + keptCount, order.end(), [&magnitudes](const size_t a, const size_t b)
+            {
+              return (magnitudes[a] > magnitudes[b]) || ((magnitudes[a] == magnitudes[b]) && (a < b));
+            });
+            for (size_t i = keptCount; i < layerWeightCount; ++i)
+            {
+              if (magnitudes[order[i]] != 0)
+              {
+                network.SetWeight(beginIndex + order[i], static_cast<T>(0.L));
+              }
+            }
+          }
+          beginIndex += layerWeightCount;
+        }
+        SetSparsity(network);
+        return GetZeroCount(network);
+      }
+
+      template <typename T>
+      size_t Pruning2D<T>::GetZeroCount(const Network2D<T>& network)
+      {
+        size_t zeroCount{};
+        for (size_t i = 0; i < network.GetWeightCount(); ++i)
+        {
+          zeroCount += network.GetWeight(i) == 0;
+        }
+        return zeroCount;
+      }
+
+      template <typename T>
+      void Pruning2D<T>::SetSparsity(Network2D<T>& network)
+      {
+        const convolution::Network2DProtectingReference<T> convolutionNetwork = network.GetConvolutionNetwork();
+        for (size_t i = 0; i < convolutionNetwork.GetTopology().GetLayerCount(); ++i)
+        {
+          const convolution::Layer2DProtectingReference<T> layer = convolutionNetwork.GetLayer(i);
+          layer.SetSparse(layer.IsSparseFaster());
+        }
+
+        const perceptron::NetworkProtectingReference<T> perceptronNetwork = network.GetPerceptronNetwork();
+        for (size_t i = 0; i < perceptronNetwork.GetTopology().GetLayerCount(); ++i)
+        {
+          const perceptron::LayerProtectingReference<T> layer = perceptronNetwork.GetLayer(i);
+          layer.SetSparse(layer.IsSparseFaster());
+        }
+      }
+
+      template <typename T>
+      std::vector<size_t> Pruning2D<T>::GetLayerWeightCounts(const Network2D<T>& network)
+      {
+        const convolution::Network2D<T>& convolutionNetwork = network.GetConvolutionNetwork();
+        const perceptron::Network<T>& perceptronNetwork = network.GetPerceptronNetwork();
+
+        std::vector<size_t> layerWeightCounts;
+        for (size_t i = 0; i < convolutionNetwork.GetTopology().GetLayerCount(); ++i)
+        {
+          layerWeightCounts.push_back(convolutionNetwork.GetLayer(i).GetWeightCount());
+        }
+        for (size_t i = 0; i < perceptronNetwork.GetTopology().GetLayerCount(); ++i)
+        {
+          layerWeightCounts.push_back(perceptronNetwork.GetLayer(i).GetWeightCount());
+        }
+        return layerWeightCounts;
+      }
+    }
+  }
+}
@@ -0,0 +1,138 @@
+#pragma once
+
+#include <cstddef>
+#include <cmath>
+#include <algorithm>
+#include <type_traits>
+
+#include "Lesson2DLibrary.hpp"
+#include "Lesson2DView.hpp"
+#include "Network2D.hpp"
+#include "QuantizedNetwork2D.hpp"
+#include "GeneticTester2D.hpp"
+
+namespace cnn
+{
+  namespace engine
+  {
+    namespace complex
+    {
+      // QuantizationReport2D compares a float network with its quantized copy (see QuantizedNetwork2D) on a lesson library,
+      // so the accuracy lost by the quantization is known before the quantized network is deployed.
+      template <typename T>
+      class QuantizationReport2D
+      {
+
+        static_assert(std::is_floating_point<T>::value);
+
+      public:
+
+        // Exception guarantee: strong for this.
+        // Both networks are evaluated on every lesson of the library by their copies.
+        QuantizationReport2D(const Network2D<T>& network,
+                             const QuantizedNetwork2D<T>& quantizedNetwork,
+                             const Lesson2DLibrary<T>& lessonLibrary);
+
+        size_t GetLessonCount() const noexcept;
+
+        // It returns the total error of the float network (see GeneticTester2D::GetError()).
+        T GetFloatError() const noexcept;
+
+        // It returns the total error of the quantized network (see GeneticTester2D::GetError()).
+        T GetQuantizedError() const noexcept;
+
+        // It returns the maximum absolute difference of outputs of the networks.
+        T GetMaxOutputDifference() const noexcept;
+
+        // It returns the count of lessons, which label is the maximum output of the float network (only for class labels).
+        size_t GetFloatHitCount() const noexcept;
+
+        // It returns the count of lessons, which label is the maximum output of the quantized network (only for class labels).
+        size_t GetQuantizedHitCount() const noexcept;
+
+      private:
+
+        size_t LessonCount;
+        T FloatError;
+        T QuantizedError;
+        T MaxOutputDifference;
+        size_t FloatHitCount;
+        size_t QuantizedHitCount;
+
+      };
+
+      template <typename T>
+      QuantizationReport2D<T>::QuantizationReport2D(const Network2D<T>& network,
+                                                    const QuantizedNetwork2D<T>& quantizedNetwork,
+                                                    const Lesson2DLibrary<T>& lessonLibrary)
+        :
+        LessonCount{ lessonLibrary.GetLessonCount() },
+        FloatError{},
+        QuantizedError{},
+        MaxOutputDifference{},
+        FloatHitCount{},
+        QuantizedHitCount{}
+      {
+        Network2D<T> floatNetwork{ network };
+        QuantizedNetwork2D<T> intNetwork{ quantizedNetwork };
+        const size_t outputCount = intNetwork.GetOutputCount();
+        for (size_t lessonIndex = 0; lessonIndex < LessonCount; ++lessonIndex)
+        {
+          const Lesson2DView<T> lesson = lessonLibrary.GetLesson(lessonIndex);
+          FloatError += GeneticTester2D<T>::GetError(lesson, floatNetwork);
+          QuantizedError += intNetwork.GetError(lesson);
+
+          const T* const floatOutput = floatNetwork.GetPerceptronNetwork().GetLastLayer().GetOutput().GetValues();
+          const T* const intOutput = intNetwork.GetOutput();
+          for (size_t o = 0; o < outputCount; ++o)
+          {
+            MaxOutputDifference = std::max(MaxOutputDifference, std::abs(floatOutput[o] - intOutput[o]));
+          }
+
+          if (lesson.GetTopology().GetClassLabels())
+          {
+            const size_t label = lesson.GetLabel();
+            FloatHitCount += static_cast<size_t>(std::max_element(floatOutput, floatOutput + outputCount) - floatOutput) == label;
+            QuantizedHitCount += static_cast<size_t>(std::max_element(intOutput, intOutput + outputCount) - intOutput) == label;
+          }
+        }
+      }
+
+      template <typename T>
+      size_t QuantizationReport2D<T>::GetLessonCount() const noexcept
+      {
+        return LessonCount;
+      }
+
+      template <typename T>
+      T QuantizationReport2D<T>::GetFloatError() const noexcept
+      {
+        return FloatError;
+      }
+
+      template <typename T>
+      T QuantizationReport2D<T>::GetQuantizedError() const noexcept
+      {
+        return QuantizedError;
+      }
+
+      template <typename T>
+      T QuantizationReport2D<T>::GetMaxOutputDifference() const noexcept
+      {
+        return MaxOutputDifference;
+      }
+
+      template <typename T>
+      size_t QuantizationReport2D<T>::GetFloatHitCount() const noexcept
+      {
+        return FloatHitCount;
+      }
+
+      template <typename T>
+      size_t QuantizationReport2D<T>::GetQuantizedHitCount() const noexcept
+      {
+        return QuantizedHitCount;
+      }
+    }
+  }
+}
@@ -0,0 +1,626 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <cmath>
+#include <algorithm>
+#include <vector>
+#include <stdexcept>
+#include <type_traits>
+#include <memory_resource>
+
+#include "Lesson2DLibrary.hpp"
+#include "Lesson2DView.hpp"
+#include "Network2D.hpp"
+#include "GeneticTester2D.hpp"
+
+#include "../common/AlignedBuffer.hpp"
+#include "../common/BitPacking.hpp"
+#include "../common/Activation.hpp"
+#include "../common/Quantization.hpp"
+
+namespace cnn
+{
+  namespace engine
+  {
+    namespace complex
+    {
+      // QuantizedNetwork2D is an int8 inference copy of a trained Network2D (post-training quantization).
+      // Weights are quantized symmetrically per filter or neuron, and activations are quantized asymmetrically per tensor
+      // by ranges, which are calibrated by running the network over a lesson library (see common::Quantization).
+      // Layers are chained through quantized tensors, and only the outputs of the last layer are kept in T.
+      // Tensors are stored as maps one after another, so maps are row by row (x + y * width) even for the input of the perceptron.
+      // Depthwise separable convolution layers are quantized as the equivalent full layers.
+      template <typename T>
+      class QuantizedNetwork2D
+      {
+
+        static_assert(std::is_floating_point<T>::value);
+
+      public:
+
+        // Exception guarantee: strong for this.
+        // The network is evaluated on every lesson of the library, so the topologies must match.
+        // Weights and tensors are allocated by the resource.
+        QuantizedNetwork2D(const Network2D<T>& network,
+                           const Lesson2DLibrary<T>& lessonLibrary,
+                           std::pmr::memory_resource* const resource = std::pmr::get_default_resource());
+
+        QuantizedNetwork2D(const QuantizedNetwork2D& network) = default;
+
+        QuantizedNetwork2D(QuantizedNetwork2D&& network) noexcept = default;
+
+        // Exception guarantee: strong for this.
+        QuantizedNetwork2D& operator=(const QuantizedNetwork2D& network);
+
+        QuantizedNetwork2D& operator=(QuantizedNetwork2D&& network) noexcept = default;
+
+        std::pmr::memory_resource* GetResource() const noexcept;
+
+        const Network2DTopology& GetTopology() const noexcept;
+
+        // Exception guarantee: strong for this.
+        // It quantizes the input of the input size, which is stored row by row (x + y * width).
+        void SetInput(const size_t index, const T* const values);
+
+        // We expect that the method never throws any exception.
+        void GenerateOutput() noexcept;
+
+        // Exception guarantee: strong for this.
+        // The inputs are binary maps of the input size, which are bit-packed (see common::BitPacking) one after another.
+        void GenerateOutputFromBinary(const uint64_t* const inputs);
+
+        size_t GetOutputCount() const noexcept;
+
+        // It returns the outputs of the last GenerateOutput().
+        const T* GetOutput() const noexcept;
+
+        // Exception guarantee: base for this.
+        // It returns the error of the network on the lesson (see GeneticTester2D::GetError()), which is evaluated in place.
+        T GetError(const Lesson2DView<T>& lesson);
+
+      private:
+
+        Network2DTopology Topology;
+
+        // Rows of weights of every filter and neuron, which are padded to common::BUFFER_ALIGNMENT.
+        common::AlignedBuffer<int8_t> Weights;
+        common::AlignedBuffer<T> WeightScales;
+        common::AlignedBuffer<int32_t> WeightSums;
+        // The first weight and the first row of every layer.
+        common::AlignedBuffer<size_t> WeightOffsets;
+        common::AlignedBuffer<size_t> RowOffsets;
+
+        // Tensors of the input and the outputs of every layer except the last one.
+        common::AlignedBuffer<uint8_t> Values;
+        common::AlignedBuffer<T> Scales;
+        common::AlignedBuffer<int32_t> ZeroPoints;
+        common::AlignedBuffer<size_t> ValueOffsets;
+
+        // The receptive field of an output value of a convolution layer.
+        common::AlignedBuffer<uint8_t> Patch;
+        common::AlignedBuffer<T> Output;
+
+        size_t GetLayerCount() const noexcept;
+
+        // It returns the unpadded length of rows of weights of the layer.
+        size_t GetRowLength(const size_t layerIndex) const noexcept;
+
+        size_t GetRowCount(const size_t layerIndex) const noexcept;
+
+        size_t GetTensorLength(const size_t tensorIndex) const noexcept;
+
+        void QuantizeWeights(const Network2D<T>& network);
+
+        void Calibrate(const Network2D<T>& network, const Lesson2DLibrary<T>& lessonLibrary);
+
+        // Kernels are instantiated for every activation type (see common::Activation::Dispatch()).
+        template <common::ActivationType ACTIVATION_TYPE>
+        void GenerateConvolutionOutput(const size_t layerIndex) noexcept;
+
+        template <common::ActivationType ACTIVATION_TYPE>
+        void GeneratePerceptronOutput(const size_t layerIndex) noexcept;
+
+        // It converts the accumulator of the row of the layer to the activated value.
+        template <common::ActivationType ACTIVATION_TYPE>
+        T Activate(const size_t layerIndex, const size_t rowIndex, const int32_t sum) const noexcept;
+
+        void CheckTopologies(const Network2D<T>& network, const Lesson2DLibrary<T>& lessonLibrary) const;
+
+      };
+
+      template <typename T>
+      QuantizedNetwork2D<T>::QuantizedNetwork2D(const Network2D<T>& network,
+                                                const Lesson2DLibrary<T>& lessonLibrary,
+                                                std::pmr::memory_resource* const resource)
+        :
+        Topology{ network.GetTopology() },
+        Weights{ 0, resource },
+        WeightScales{ 0, resource },
+        WeightSums{ 0, resource },
+        WeightOffsets{ 0, resource },
+        RowOffsets{ 0, resource },
+        Values{ 0, resource },
+        Scales{ 0, resource },
+        ZeroPoints{ 0, resource },
+        ValueOffsets{ 0, resource },
+        Patch{ 0, resource },
+        Output{ 0, resource }
+      {
+        CheckTopologies(network, lessonLibrary);
+
+        const size_t layerCount = GetLayerCount();
+        const size_t convolutionLayerCount = Topology.GetConvolutionTopology().GetLayerCount();
+
+        WeightOffsets = common::AlignedBuffer<size_t>{ layerCount + 1, resource };
+        RowOffsets = common::AlignedBuffer<size_t>{ layerCount + 1, resource };
+        size_t patchLength{};
+        for (size_t l = 0; l < layerCount; ++l)
+        {
+          const size_t rowLength = common::GetPaddedCount<int8_t>(GetRowLength(l));
+          WeightOffsets.GetData()[l + 1] = WeightOffsets.GetData()[l] + GetRowCount(l) * rowLength;
+          RowOffsets.GetData()[l + 1] = RowOffsets.GetData()[l] + GetRowCount(l);
+          if (l < convolutionLayerCount)
+          {
+            patchLength = std::max(patchLength, rowLength);
+          }
+        }
+        Weights = common::AlignedBuffer<int8_t>{ WeightOffsets.GetData()[layerCount], resource };
+        WeightScales = common::AlignedBuffer<T>{ RowOffsets.GetData()[layerCount], resource };
+        WeightSums = common::AlignedBuffer<int32_t>{ RowOffsets.GetData()[layerCount], resource };
+        Patch = common::AlignedBuffer<uint8_t>{ patchLength, resource };
+        Output = common::AlignedBuffer<T>{ Topology.GetPerceptronTopology().GetLastLayerTopology().GetNeuronCount(), resource };
+
+        // The output of the last layer isn't quantized.
+        ValueOffsets = common::AlignedBuffer<size_t>{ layerCount + 1, resource };
+        for (size_t t = 0; t < layerCount; ++t)
+        {
+          ValueOffsets.GetData()[t + 1] = ValueOffsets.GetData()[t] + common::GetPaddedCount<uint8_t>(GetTensorLength(t));
+        }
+        Values = common::AlignedBuffer<uint8_t>{ ValueOffsets.GetData()[layerCount], resource };
+        Scales = common::AlignedBuffer<T>{ layerCount, resource };
+        ZeroPoints = common::AlignedBuffer<int32_t>{ layerCount, resource };
+
+        QuantizeWeights(network);
+        Calibrate(network, lessonLibrary);
+      }
+
+      template <typename T>
+      QuantizedNetwork2D<T>& QuantizedNetwork2D<T>::operator=(const QuantizedNetwork2D& network)
+      {
+        if (this != &network)
+        {
+          QuantizedNetwork2D<T> tmpNetwork{ network };
+          // Beware, it is very intimate place for strong exception guarantee.
+          std::swap(*this, tmpNetwork);
+        }
+        return *this;
+      }
+
+      template <typename T>
+      std::pmr::memory_resource* QuantizedNetwork2D<T>::GetResource() const noexcept
+      {
+        return Values.GetResource();
+      }
+
+      template <typename T>
+      const Network2DTopology& QuantizedNetwork2D<T>::GetTopology() const noexcept
+      {
+        return Topology;
+      }
+
+      template <typename T>
+      void QuantizedNetwork2D<T>::SetInput(const size_t index, const T* const values)
+      {
+        const auto& firstLayerTopology = Topology.GetConvolutionTopology().GetFirstLayerTopology();
+        if (index >= firstLayerTopology.GetInputCount())
+        {
+          throw std::range_error("cnn::engine::complex::QuantizedNetwork2D::SetInput(), index >= firstLayerTopology.GetInputCount().");
+        }
+
+        const size_t area = firstLayerTopology.GetInputSize().GetArea();
+        uint8_t* const input = Values.GetData() + index * area;
+        for (size_t i = 0; i < area; ++i)
+        {
+          input[i] = common::Quantization::QuantizeValue(values[i], Scales.GetData()[0], ZeroPoints.GetData()[0]);
+        }
+      }
+
+      template <typename T>
+      void QuantizedNetwork2D<T>::GenerateOutput() noexcept
+      {
+        const size_t convolutionLayerCount = Topology.GetConvolutionTopology().GetLayerCount();
+        for (size_t l = 0; l < convolutionLayerCount; ++l)
+        {
+          common::Activation::Dispatch(Topology.GetConvolutionTopology().GetLayerTopology(l).GetActivationType(), [this, l](auto activation)
+          {
+            GenerateConvolutionOutput<decltype(activation)::value>(l);
+          });
+        }
+        for (size_t l = convolutionLayerCount; l < GetLayerCount(); ++l)
+        {
+          common::Activation::Dispatch(Topology.GetPerceptronTopology().GetLayerTopology(l - convolutionLayerCount).GetActivationType(), [this, l](auto activation)
+          {
+            GeneratePerceptronOutput<decltype(activation)::value>(l);
+          });
+        }
+      }
+
+      template <typename T>
+      void QuantizedNetwork2D<T>::GenerateOutputFromBinary(const uint64_t* const inputs)
+      {
+        const auto& firstLayerTopology = Topology.GetConvolutionTopology().GetFirstLayerTopology();
+        const size_t width = firstLayerTopology.GetInputSize().GetWidth();
+        const size_t height = firstLayerTopology.GetInputSize().GetHeight();
+        const size_t wordCount = common::BitPacking::GetWordCount(width);
+
+        const uint8_t zero = common::Quantization::QuantizeValue(static_cast<T>(0.L), Scales.GetData()[0], ZeroPoints.GetData()[0]);
+        const uint8_t one = common::Quantization::QuantizeValue(static_cast<T>(1.L), Scales.GetData()[0], ZeroPoints.GetData()[0]);
+        uint8_t* input = Values.GetData();
+        for (size_t i = 0; i < firstLayerTopology.GetInputCount(); ++i)
+        {
+          for (size_t y = 0; y < height; ++y)
+          {
+            const uint64_t* const row = inputs + (i * height + y) * wordCount;
+            for (size_t x = 0; x < width; ++x)
+            {
+              *input++ = common::BitPacking::GetBit(row, x) ? one : zero;
+            }
+          }
+        }
+        GenerateOutput();
+      }
+
+      template <typename T>
+      size_t QuantizedNetwork2D<T>::GetOutputCount() const noexcept
+      {
+        return Output.GetCount();
+      }
+
+      template <typename T>
+      const T* QuantizedNetwork2D<T>::GetOutput() const noexcept
+      {
+        return Output.GetData();
+      }
+
+      template <typename T>
+      T QuantizedNetwork2D<T>::GetError(const Lesson2DView<T>& lesson)
+      {
+        if (lesson.GetTopology().GetBinaryInputs())
+        {
+          GenerateOutputFromBinary(lesson.GetBinaryInput(0));
+        }
+        else
+        {
+          for (size_t inputIndex = 0; inputIndex < lesson.GetTopology().GetInputCount(); ++inputIndex)
+          {
+            SetInput(inputIndex, lesson.GetInput(inputIndex));
+          }
+          GenerateOutput();
+        }
+        return GeneticTester2D<T>::GetError(lesson, Output.GetData());
+      }
+
+      template <typename T>
+      size_t QuantizedNetwork2D<T>::GetLayerCount() const noexcept
+      {
+        return Topology.GetConvolutionTopology().GetLayerCount() + Topology.GetPerceptronTopology().GetLayerCount();
+      }
+
+      template <typename T>
+      size_t QuantizedNetwork2D<T>::GetRowLength(const size_t layerIndex) const noexcept
+      {
+        const size_t convolutionLayerCount = Topology.GetConvolutionTopology().GetLayerCount();
+        if (layerIndex < convolutionLayerCount)
+        {
+          const auto& filterTopology = Topology.GetConvolutionTopology().GetLayerTopology(layerIndex).GetFilterTopology();
+          return filterTopology.GetCoreCount() * filterTopology.GetSize().GetArea();
+        }
+        return Topology.GetPerceptronTopology().GetLayerTopology(layerIndex - convolutionLayerCount).GetInputCount();
+      }
+
+      template <typename T>
+      size_t QuantizedNetwork2D<T>::GetRowCount(const size_t layerIndex) const noexcept
+      {
+        const size_t convolutionLayerCount = Topology.GetConvolutionTopology().GetLayerCount();
+        if (layerIndex < convolutionLayerCount)
+        {
+          return Topology.GetConvolutionTopology().GetLayerTopology(layerIndex).GetFilterCount();
+        }
+        return Topology.GetPerceptronTopology().GetLayerTopology(layerIndex - convolutionLayerCount).GetNeuronCount();
+      }
+
+      template <typename T>
+      size_t QuantizedNetwork2D<T>::GetTensorLength(const size_t tensorIndex) const noexcept
+      {
+        // The tensor t is the input of the layer t.
+        const size_t convolutionLayerCount = Topology.GetConvolutionTopology().GetLayerCount();
+        if (tensorIndex < convolutionLayerCount)
+        {
+          const auto& layerTopology = Topology.GetConvolutionTopology().GetLayerTopology(tensorIndex);
+          return layerTopology.GetInputCount() * layerTopology.GetInputSize().GetArea();
+        }
+        return Topology.GetPerceptronTopology().GetLayerTopology(tensorIndex - convolutionLayerCount).GetInputCount();
+      }
+
+      template <typename T>
+      void QuantizedNetwork2D<T>::QuantizeWeights(const Network2D<T>& network)
+      {
+        const size_t convolutionLayerCount = Topology.GetConvolutionTopology().GetLayerCount();
+        std::vector<T> row;
+        for (size_t l = 0; l < GetLayerCount(); ++l)
+        {
+          const size_t rowLength = GetRowLength(l);
+          row.resize(rowLength);
+          for (size_t r = 0; r < GetRowCount(l); ++r)
+          {
+            if (l < convolutionLayerCount)
+            {
+              // Cores of the filter follow one another, as maps of the patch do.
+              const auto& layerTopology = Topology.GetConvolutionTopology().GetLayerTopology(l);
+              const auto& filterTopology = layerTopology.GetFilterTopology();
+              const auto& layer = network.GetConvolutionNetwork().GetLayer(l);
+              const auto& filter = layer.GetFilter(r);
+              const size_t coreArea = filterTopology.GetSize().GetArea();
+              for (size_t c = 0; c < filterTopology.GetCoreCount(); ++c)
+              {
+                if (layerTopology.GetType() == convolution::Layer2DType::DepthwiseSeparable)
+                {
+                  // The core of the equivalent full layer is the depthwise core scaled by the 1 x 1 core of the filter.
+                  const T* const depthwiseWeights = layer.GetDepthwiseFilter().GetConstCore(c).GetWeights();
+                  const T scale = filter.GetConstCore(c).GetWeights()[0];
+                  for (size_t i = 0; i < coreArea; ++i)
+                  {
+                    row[c * coreArea + i] = scale * depthwiseWeights[i];
+                  }
+                }
+                else
+                {
+                  std::memcpy(row.data() + c * coreArea, filter.GetConstCore(c).GetWeights(), coreArea * sizeof(T));
+                }
+              }
+            }
+            else if (l == convolutionLayerCount)
+            {
+              // The float network transfers every map of the convolution network column by column (see Network2D::TransferConvolutionOutput()).
+              const auto& lastLayerTopology = Topology.GetConvolutionTopology().GetLastLayerTopology();
+              const size_t width = lastLayerTopology.GetOutputSize().GetWidth();
+              const size_t height = lastLayerTopology.GetOutputSize().GetHeight();
+              const T* const weights = network.GetPerceptronNetwork().GetLayer(0).GetNeuron(r).GetWeights();
+              for (size_t o = 0; o < lastLayerTopology.GetOutputCount(); ++o)
+              {
+                for (size_t y = 0; y < height; ++y)
+                {
+                  for (size_t x = 0; x < width; ++x)
+                  {
+                    row[o * width * height + y * width + x] = weights[o * width * height + x * height + y];
+                  }
+                }
+              }
+            }
+            else
+            {
+              const T* const weights = network.GetPerceptronNetwork().GetLayer(l - convolutionLayerCount).GetNeuron(r).GetWeights();
+              std::memcpy(row.data(), weights, rowLength * sizeof(T));
+            }
+
+            T maximum{};
+            for (const T weight : row)
+            {
+              maximum = std::max(maximum, std::abs(weight));
+            }
+            const T scale = maximum > 0 ? maximum / common::Quantization::MAX_WEIGHT : static_cast<T>(1.L);
+
+            int8_t* const weights = Weights.GetData() + WeightOffsets.GetData()[l] + r * common::GetPaddedCount<int8_t>(rowLength);
+            int32_t sum{};
+            for (size_t i = 0; i < rowLength; ++i)
+            {
+              weights[i] = common::Quantization::QuantizeWeight(row[i], scale);
+              sum += weights[i];
+            }
+            WeightScales.GetData()[RowOffsets.GetData()[l] + r] = scale;
+            WeightSums.GetData()[RowOffsets.GetData()[l] + r] = sum;
+          }
+        }
+      }
+
+      template <typename T>
+      void QuantizedNetwork2D<T>::Calibrate(const Network2D<T>& network, const Lesson2DLibrary<T>& lessonLibrary)
+      {
+        const size_t layerCount = GetLayerCount();
+        const size_t convolutionLayerCount = Topology.GetConvolutionTopology().GetLayerCount();
+
+        // Ranges include zero, so zero is exact, and zero points are valid quantized values.
+        std::vector<T> minimums(layerCount);
+        std::vector<T> maximums(layerCount);
+        auto update = [&minimums, &maximums](const size_t tensorIndex, const T value)
+        {
+          minimums[tensorIndex] = std::min(minimums[tensorIndex], value);
+          maximums[tensorIndex] = std::max(maximums[tensorIndex], value);
+        };
+
+        Network2D<T> floatNetwork{ network };
+        // Outputs of every layer are read, so the head is not fused.
+        floatNetwork.GetPerceptronNetwork().SetFusedHead(false);
+        for (size_t lessonIndex = 0; lessonIndex < lessonLibrary.GetLessonCount(); ++lessonIndex)
+        {
+          const Lesson2DView<T> lesson = lessonLibrary.GetLesson(lessonIndex);
+          GeneticTester2D<T>::GetError(lesson, floatNetwork);
+
+          if (lesson.GetTopology().GetBinaryInputs())
+          {
+            update(0, static_cast<T>(1.L));
+          }
+          else
+          {
+            for (size_t i = 0; i < lesson.GetTopology().GetInputCount(); ++i)
+            {
+              const T* const input = lesson.GetInput(i);
+              for (size_t j = 0; j < lesson.GetTopology().GetInputSize().GetArea(); ++j)
+              {
+                update(0, input[j]);
+              }
+            }
+          }
+
+          for (size_t t = 1; t < layerCount; ++t)
+          {
+            if (t <= convolutionLayerCount)
+            {
+              const auto& layer = floatNetwork.GetConvolutionNetwork().GetLayer(t - 1);
+              for (size_t o = 0; o < layer.GetTopology().GetOutputCount(); ++o)
+              {
+                const auto& output = layer.GetOutput(o);
+                for (size_t y = 0; y < output.GetSize().GetHeight(); ++y)
+                {
+                  for (size_t x = 0; x < output.GetSize().GetWidth(); ++x)
+                  {
+                    update(t, output.GetValue(x, y));
+                  }
+                }
+              }
+            }
+            else
+            {
+              const auto& output = floatNetwork.GetPerceptronNetwork().GetLayer(t - convolutionLayerCount - 1).GetOutput();
+              for (size_t i = 0; i < output.GetValueCount(); ++i)
+              {
+                update(t, output.GetValues()[i]);
+              }
+            }
+          }
+        }
+
+        for (size_t t = 0; t < layerCount; ++t)
+        {
+          const T range = maximums[t] - minimums[t];
+          const T scale = range > 0 ? range / common::Quantization::MAX_VALUE : static_cast<T>(1.L);
+          Scales.GetData()[t] = scale;
+          ZeroPoints.GetData()[t] = static_cast<int32_t>(std::round(-minimums[t] / scale));
+        }
+      }
+
+      template <typename T>
+      template <common::ActivationType ACTIVATION_TYPE>
+      void QuantizedNetwork2D<T>::GenerateConvolutionOutput(const size_t layerIndex) noexcept
+      {
+        const auto& layerTopology = Topology.GetConvolutionTopology().GetLayerTopology(layerIndex);
+        const size_t inputWidth = layerTopology.GetInputSize().GetWidth();
+        const size_t inputArea = layerTopology.GetInputSize().GetArea();
+        const size_t coreWidth = layerTopology.GetFilterTopology().GetSize().GetWidth();
+        const size_t coreHeight = layerTopology.GetFilterTopology().GetSize().GetHeight();
+        const size_t dilation = layerTopology.GetFilterTopology().GetDilation();
+        const size_t outputWidth = layerTopology.GetOutputSize().GetWidth();
+        const size_t outputHeight = layerTopology.GetOutputSize().GetHeight();
+        const size_t outputArea = layerTopology.GetOutputSize().GetArea();
+        const size_t rowLength = common::GetPaddedCount<int8_t>(GetRowLength(layerIndex));
+
+        // The perceptron network follows, so the output of a convolution layer is always quantized.
+        const uint8_t* const input = Values.GetData() + ValueOffsets.GetData()[layerIndex];
+        uint8_t* const output = Values.GetData() + ValueOffsets.GetData()[layerIndex + 1];
+        const int8_t* const weights = Weights.GetData() + WeightOffsets.GetData()[layerIndex];
+        const T outputScale = Scales.GetData()[layerIndex + 1];
+        const int32_t outputZeroPoint = ZeroPoints.GetData()[layerIndex + 1];
+
+        // The patch is gathered once per output pixel and is multiplied by rows of all filters.
+        // The padding of the patch is never written, so it stays zero.
+        uint8_t* const patch = Patch.GetData();
+        for (size_t oy = 0; oy < outputHeight; ++oy)
+        {
+          for (size_t ox = 0; ox < outputWidth; ++ox)
+          {
+            uint8_t* patchRow = patch;
+            for (size_t c = 0; c < layerTopology.GetInputCount(); ++c)
+            {
+              for (size_t cy = 0; cy < coreHeight; ++cy)
+              {
+                const uint8_t* const inputRow = input + c * inputArea + (oy + cy * dilation) * inputWidth + ox;
+                if (dilation == 1)
+                {
+                  std::memcpy(patchRow, inputRow, coreWidth);
+                }
+                else
+                {
+                  for (size_t cx = 0; cx < coreWidth; ++cx)
+                  {
+                    patchRow[cx] = inputRow[cx * dilation];
+                  }
+                }
+                patchRow += coreWidth;
+              }
+            }
+
+            for (size_t f = 0; f < layerTopology.GetFilterCount(); ++f)
+            {
+              const int32_t sum = common::Quantization::DotProduct(patch, weights + f * rowLength, rowLength);
+              output[f * outputArea + oy * outputWidth + ox] =
+                common::Quantization::QuantizeValue(Activate<ACTIVATION_TYPE>(layerIndex, f, sum), outputScale, outputZeroPoint);
+            }
+          }
+        }
+      }
+
+      template <typename T>
+      template <common::ActivationType ACTIVATION_TYPE>
+      void QuantizedNetwork2D<T>::GeneratePerceptronOutput(const size_t layerIndex) noexcept
+      {
+        const size_t rowLength = common::GetPaddedCount<int8_t>(GetRowLength(layerIndex));
+        const bool isLast = layerIndex + 1 == GetLayerCount();
+
+        // The padding of the input is never written, so it stays zero.
+        const uint8_t* const input = Values.GetData() + ValueOffsets.GetData()[layerIndex];
+        const int8_t* const weights = Weights.GetData() + WeightOffsets.GetData()[layerIndex];
+        for (size_t n = 0; n < GetRowCount(layerIndex); ++n)
+        {
+          const int32_t sum = common::Quantization::DotProduct(input, weights + n * rowLength, rowLength);
+          const T value = Activate<ACTIVATION_TYPE>(layerIndex, n, sum);
+          if (isLast)
+          {
+            Output.GetData()[n] = value;
+          }
+          else
+          {
+            Values.GetData()[ValueOffsets.GetData()[layerIndex + 1] + n] =
+              common::Quantization::QuantizeValue(value, Scales.GetData()[layerIndex + 1], ZeroPoints.GetData()[layerIndex + 1]);
+          }
+        }
+      }
+
+      template <typename T>
+      template <common::ActivationType ACTIVATION_TYPE>
+      T QuantizedNetwork2D<T>::Activate(const size_t layerIndex, const size_t rowIndex, const int32_t sum) const noexcept
+      {
+        // sum((s * (q - z)) * (ws * w)) = s * ws * (sum(q * w) - z * sum(w)).
+        const size_t row = RowOffsets.GetData()[layerIndex] + rowIndex;
+        const int32_t centeredSum = sum - ZeroPoints.GetData()[layerIndex] * WeightSums.GetData()[row];
+        return common::Activation::Activate<ACTIVATION_TYPE>(Scales.GetData()[layerIndex] * WeightScales.GetData()[row] * static_cast<T>(centeredSum));
+      }
+
+      template <typename T>
+      void QuantizedNetwork2D<T>::CheckTopologies(const Network2D<T>& network, const Lesson2DLibrary<T>& lessonLibrary) const
+      {
+        if (network.GetTopology().GetConvolutionTopology().GetLayerCount() == 0)
+        {
+          throw std::invalid_argument("cnn::engine::complex::QuantizedNetwork2D::CheckTopologies(), network.GetTopology().GetConvolutionTopology().GetLayerCount() == 0.");
+        }
+        if (lessonLibrary.GetLessonCount() == 0)
+        {
+          throw std::invalid_argument("cnn::engine::complex::QuantizedNetwork2D::CheckTopologies(), lessonLibrary.GetLessonCount() == 0.");
+        }
+        if (lessonLibrary.GetTopology().GetInputSize() != network.GetConvolutionNetwork().GetTopology().GetFirstLayerTopology().GetInputSize())
+        {
+          throw std::invalid_argument("cnn::engine::complex::QuantizedNetwork2D::CheckTopologies(), lessonLibrary.GetTopology().GetInputSize() != network.GetConvolutionNetwork().GetTopology().GetFirstLayerTopology().GetInputSize().");
+        }
+        if (lessonLibrary.GetTopology().GetInputCount() != network.GetConvolutionNetwork().GetTopology().GetFirstLayerTopology().GetInputCount())
+        {
+          throw std::invalid_argument("cnn::engine::complex::QuantizedNetwork2D::CheckTopologies(), lessonLibrary.GetTopology().GetInputCount() != network.GetConvolutionNetwork().GetTopology().GetFirstLayerTopology().GetInputCount().");
+        }
+        if (lessonLibrary.GetTopology().GetOutputCount() != network.GetPerceptronNetwork().GetTopology().GetLastLayerTopology().GetNeuronCount())
+        {
+          throw std::invalid_argument("cnn::engine::complex::QuantizedNetwork2D::CheckTopologies(), lessonLibrary.GetTopology().GetOutputCount() != network.GetPerceptronNetwork().GetTopology().GetLastLayerTopology().GetNeuronCount().");
+        }
+      }
+    }
+  }
+}
@@ -0,0 +1,198 @@
+#pragma once
+
+#include <cstddef>
+#include <type_traits>
+#include <stdexcept>
+#include <memory_resource>
+
+#include "Size2D.hpp"
+#include "Map2D.hpp"
+
+#include "../common/MemoryResource.hpp"
+#include "../common/AlignedBuffer.hpp"
+
+namespace cnn
+{
+  namespace engine
+  {
+    namespace convolution
+    {
+      // BlockedTensor2D holds channels of maps of one size in the blocked layout (NCHWc).
+      // Channels are interleaved in blocks of BLOCK_SIZE, which fill a cache line, so the value of the channel c at (x, y)
+      // is stored at c % BLOCK_SIZE + BLOCK_SIZE * (x + width * (y + height * (c / BLOCK_SIZE))).
+      // Lanes of missing channels of the last block are zeros.
+      template <typename T>
+      class BlockedTensor2D
+      {
+
+        static_assert(std::is_floating_point<T>::value);
+
+      public:
+
+        constexpr static size_t BLOCK_SIZE = common::BUFFER_ALIGNMENT / sizeof(T);
+
+        // The values are allocated by the resource.
+        BlockedTensor2D(const Size2D& size = {},
+                        const size_t channelCount = 0,
+                        std::pmr::memory_resource* const resource = std::pmr::get_default_resource());
+
+        std::pmr::memory_resource* GetResource() const noexcept;
+
+        const Size2D& GetSize() const noexcept;
+
+        size_t GetChannelCount() const noexcept;
+
+        size_t GetBlockCount() const noexcept;
+
+        T GetValue(const size_t channel, const size_t x, const size_t y) const;
+
+        // It gives direct access to the values of the block, which are stored pixel by pixel (lane + BLOCK_SIZE * (x + y * width)).
+        const T* GetBlock(const size_t blockIndex) const noexcept;
+
+        // It gives direct access to the values of the block, which are stored pixel by pixel (lane + BLOCK_SIZE * (x + y * width)).
+        // Lanes of missing channels must stay zero.
+        T* GetBlock(const size_t blockIndex) noexcept;
+
+        // Exception guarantee: strong for this.
+        // It copies the map to the channel.
+        void Pack(const size_t channel, const Map2D<T>& map);
+
+        // Exception guarantee: strong for map.
+        // It copies the channel to the map.
+        void Unpack(const size_t channel, Map2D<T>& map) const;
+
+        // It clears the state without changing of the topology.
+        void Clear() noexcept;
+
+        // It releases the values, so the size and the channel count are zero.
+        void Reset() noexcept;
+
+      private:
+
+        Size2D Size;
+        size_t ChannelCount;
+        common::AlignedBuffer<T> Values;
+
+      };
+
+      template <typename T>
+      BlockedTensor2D<T>::BlockedTensor2D(const Size2D& size, const size_t channelCount, std::pmr::memory_resource* const resource)
+        :
+        Size{ size },
+        ChannelCount{ channelCount },
+        Values{ (channelCount + BLOCK_SIZE - 1) / BLOCK_SIZE * BLOCK_SIZE * size.GetWidth() * size.GetHeight(), resource }
+      {
+      }
+
+      template <typename T>
+      std::pmr::memory_resource* BlockedTensor2D<T>::GetResource() const noexcept
+      {
+        return Values.GetResource();
+      }
+
+      template <typename T>
+      const Size2D& BlockedTensor2D<T>::GetSize() const noexcept
+      {
+        return Size;
+      }
+
+      template <typename T>
+      size_t BlockedTensor2D<T>::GetChannelCount() const noexcept
+      {
+        return ChannelCount;
+      }
+
+      template <typename T>
+      size_t BlockedTensor2D<T>::GetBlockCount() const noexcept
+      {
+        return (ChannelCount + BLOCK_SIZE - 1) / BLOCK_SIZE;
+      }
+
+      template <typename T>
+      T BlockedTensor2D<T>::GetValue(const size_t channel, const size_t x, const size_t y) const
+      {
+        if (channel >= ChannelCount)
+        {
+          throw std::range_error("cnn::engine::convolution::BlockedTensor2D::GetValue() const, channel >= ChannelCount.");
+        }
+        if ((x >= Size.GetWidth()) || (y >= Size.GetHeight()))
+        {
+          throw std::range_error("cnn::engine::convolution::BlockedTensor2D::GetValue() const, (x, y) is out of Size.");
+        }
+        return GetBlock(channel / BLOCK_SIZE)[channel % BLOCK_SIZE + BLOCK_SIZE * (x + y * Size.GetWidth())];
+      }
+
+      template <typename T>
+      const T* BlockedTensor2D<T>::GetBlock(const size_t blockIndex) const noexcept
+      {
+        return Values.GetData() + blockIndex * BLOCK_SIZE * Size.GetWidth() * Size.GetHeight();
+      }
+
+      template <typename T>
+      T* BlockedTensor2D<T>::GetBlock(const size_t blockIndex) noexcept
+      {
+        return Values.GetData() + blockIndex * BLOCK_SIZE * Size.GetWidth() * Size.GetHeight();
+      }
+
+      template <typename T>
+      void BlockedTensor2D<T>::Pack(const size_t channel, const Map2D<T>& map)
+      {
+        if (channel >= ChannelCount)
+        {
+          throw std::range_error("cnn::engine::convolution::BlockedTensor2D::Pack(), channel >= ChannelCount.");
+        }
+        if (map.GetSize() != Size)
+        {
+          throw std::invalid_argument("cnn::engine::convolution::BlockedTensor2D::Pack(), map.GetSize() != Size.");
+        }
+
+        T* const values = GetBlock(channel / BLOCK_SIZE) + channel % BLOCK_SIZE;
+        const T* const mapValues = map.GetValues();
+        for (size_t y = 0; y < Size.GetHeight(); ++y)
+        {
+          for (size_t x = 0; x < Size.GetWidth(); ++x)
+          {
+            values[BLOCK_SIZE * (x + y * Size.GetWidth())] = mapValues[x + y * map.GetStride()];
+          }
+        }
+      }
+
+      template <typename T>
+      void BlockedTensor2D<T>::Unpack(const size_t channel, Map2D<T>& map) const
+      {
+        if (channel >= ChannelCount)
+        {
+          throw std::range_error("cnn::engine::convolution::BlockedTensor2D::Unpack() const, channel >= ChannelCount.");
+        }
+        if (map.GetSize() != Size)
+        {
+          throw std::invalid_argument("cnn::engine::convolution::BlockedTensor2D::Unpack() const, map.GetSize() != Size.");
+        }
+
+        const T* const values = GetBlock(channel / BLOCK_SIZE) + channel % BLOCK_SIZE;
+        T* const mapValues = map.GetValues();
+        for (size_t y = 0; y < Size.GetHeight(); ++y)
+        {
+          for (size_t x = 0; x < Size.GetWidth(); ++x)
+          {
+            mapValues[x + y * map.GetStride()] = values[BLOCK_SIZE * (x + y * Size.GetWidth())];
+          }
+        }
+      }
+
+      template <typename T>
+      void BlockedTensor2D<T>::Clear() noexcept
+      {
+        Values.Clear();
+      }
+
+      template <typename T>
+      void BlockedTensor2D<T>::Reset() noexcept
+      {
+        Size.Reset();
+        ChannelCount = 0;
+        Values.Reset();
+      }
+    }
+  }
+}
@@ -3,6 +3,7 @@
 #include <type_traits>
 #include <istream>
 #include <ostream>
+#include <memory_resource>
 
 #include "../common/Neuron.hpp"
 #include "Size2D.hpp"
@@ -21,7 +22,7 @@ namespace cnn
 
       public:
 
-        Core2D(const Size2D& size = {});
+        Core2D(const Size2D& size = {}, std::pmr::memory_resource* const resource = std::pmr::get_default_resource());
 
         Core2D(const Core2D& core) = default;
 
@@ -32,6 +33,8 @@ namespace cnn
 
         Core2D& operator=(Core2D&& core) noexcept = default;
 
+        std::pmr::memory_resource* GetResource() const noexcept;
+
         const Size2D& GetSize() const noexcept;
 
         // Exception guarantee: strong for this.
@@ -47,21 +50,27 @@ namespace cnn
         // Exception guarantee: strong for this.
         void SetWeight(const size_t x, const size_t y, const T value);
 
-        void GenerateOutput() noexcept;
+        // It gives direct access to the weights, which are stored row by row (x + y * width).
+        const T* GetWeights() const noexcept;
+
+        void GenerateOutput(const common::ActivationType activationType = common::ActivationType::Sigmoid) noexcept;
 
         T GetOutput() const noexcept;
 
+        // Exception guarantee: base for this.
         // It clears the state without changing of the topology.
-        void ClearInputs() noexcept;
+        void ClearInputs();
 
+        // Exception guarantee: base for this.
         // It clears the state without changing of the topology.
-        void ClearWeights() noexcept;
+        void ClearWeights();
 
         // It clears the state without changing of the topology.
         void ClearOutput() noexcept;
 
+        // Exception guarantee: base for this.
         // It clears the state without changing of the topology.
-        void Clear() noexcept;
+        void Clear();
 
         // It resets the state to zero including the topology.
         void Reset() noexcept;
@@ -74,11 +83,19 @@ namespace cnn
         // It loads full state.
         void Load(std::istream& istream);
 
-        // We expect that the method never throws any exception.
-        void FillWeights(common::ValueGenerator<T>& valueGenerator) noexcept;
+        // Exception guarantee: base for this.
+        void FillWeights(common::ValueGenerator<T>& valueGenerator);
 
-        // We expect that the method never throws any exception.
-        void Mutate(common::Mutagen<T>& mutagen) noexcept;
+        // Exception guarantee: base for this.
+        void Mutate(common::Mutagen<T>& mutagen);
+
+        // Exception guarantee: strong for this.
+        // It shares the weights of the core of the same topology, so they are duplicated only when one of the sides writes them.
+        void ShareWeights(const Core2D& core);
+
+        // Exception guarantee: base for this.
+        // It copies the weights of the core of the same topology, so no memory is allocated, if own weights aren't shared.
+        void CopyWeights(const Core2D& core);
 
       private:
 
@@ -91,10 +108,10 @@ namespace cnn
       };
 
       template <typename T>
-      Core2D<T>::Core2D(const Size2D& size)
+      Core2D<T>::Core2D(const Size2D& size, std::pmr::memory_resource* const resource)
         :
         Size{ size }, 
-        Neuron{ Size.GetArea() }
+        Neuron{ Size.GetArea(), resource }
       {
         Clear();
       }
@@ -111,6 +128,12 @@ namespace cnn
         return *this;
       }
 
+      template <typename T>
+      std::pmr::memory_resource* Core2D<T>::GetResource() const noexcept
+      {
+        return Neuron.GetResource();
+      }
+
       template <typename T>
       const Size2D& Core2D<T>::GetSize() const noexcept
       {
@@ -120,7 +143,7 @@ namespace cnn
       template <typename T>
       void Core2D<T>::SetSize(const Size2D& size)
       {
-        Core2D<T> core{ size };
+        Core2D<T> core{ size, GetResource() };
         // Beware, it is very intimate place for strong exception guarantee.
         std::swap(core, *this);
       }
@@ -154,9 +177,15 @@ namespace cnn
       }
 
       template <typename T>
-      void Core2D<T>::GenerateOutput() noexcept
+      const T* Core2D<T>::GetWeights() const noexcept
+      {
+        return Neuron.GetWeights();
+      }
+
+      template <typename T>
+      void Core2D<T>::GenerateOutput(const common::ActivationType activationType) noexcept
       {
-        Neuron.GenerateOutput();
+        Neuron.GenerateOutput(activationType);
       }
 
       template <typename T>
@@ -182,13 +211,13 @@ namespace cnn
       }
 
       template <typename T>
-      void Core2D<T>::ClearInputs() noexcept
+      void Core2D<T>::ClearInputs()
       {
         Neuron.ClearInputs();
       }
 
       template <typename T>
-      void Core2D<T>::ClearWeights() noexcept
+      void Core2D<T>::ClearWeights()
       {
         Neuron.ClearWeights();
       }
@@ -200,7 +229,7 @@ namespace cnn
       }
 
       template <typename T>
-      void Core2D<T>::Clear() noexcept
+      void Core2D<T>::Clear()
       {
         Neuron.Clear();
       }
@@ -238,7 +267,7 @@ namespace cnn
         }
 
         decltype(Size) size;
-        decltype(Neuron) neuron;
+        decltype(Neuron) neuron{ 0, GetResource() };
 
         size.Load(istream);
         neuron.Load(istream);
@@ -258,16 +287,36 @@ namespace cnn
       }
 
       template <typename T>
-      void Core2D<T>::FillWeights(common::ValueGenerator<T>& valueGenerator) noexcept
+      void Core2D<T>::FillWeights(common::ValueGenerator<T>& valueGenerator)
       {
         Neuron.FillWeights(valueGenerator);
       }
 
       template <typename T>
-      void Core2D<T>::Mutate(common::Mutagen<T>& mutagen) noexcept
+      void Core2D<T>::Mutate(common::Mutagen<T>& mutagen)
       {
         Neuron.Mutate(mutagen);
       }
+
+      template <typename T>
+      void Core2D<T>::ShareWeights(const Core2D& core)
+      {
+        if (Size != core.Size)
+        {
+          throw std::invalid_argument("cnn::engine::convolution::Core2D::ShareWeights(), Size != core.Size.");
+        }
+        Neuron.ShareWeights(core.Neuron);
+      }
+
+      template <typename T>
+      void Core2D<T>::CopyWeights(const Core2D& core)
+      {
+        if (Size != core.Size)
+        {
+          throw std::invalid_argument("cnn::engine::convolution::Core2D::CopyWeights(), Size != core.Size.");
+        }
+        Neuron.CopyWeights(core.Neuron);
+      }
     }
   }
 }
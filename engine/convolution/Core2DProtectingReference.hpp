@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Core2D.hpp"
+#include "../common/WeightStamp.hpp"
 
 namespace cnn
 {
@@ -12,6 +13,7 @@ namespace cnn
       // The protecting reference proxies all methods of Core2D and doesn't allow to use methods, which change
       // the topology of the target core.
       // It allow to protect consistency of complex objects, which contain the target core as its part.
+      // If the owner gives its weight stamp, then every write of weights through the reference renews the stamp.
       template <typename T>
       class Core2DProtectingReference
       {
@@ -20,10 +22,13 @@ namespace cnn
 
       public:
 
-        Core2DProtectingReference(Core2D<T>& core) noexcept;
+        Core2DProtectingReference(Core2D<T>& core, uint64_t* const weightStamp = nullptr) noexcept;
 
         Core2DProtectingReference(const Core2DProtectingReference& coreReference) noexcept;
 
+        // It refers to the core of coreReference and renews the given weight stamp instead of the stamp of coreReference.
+        Core2DProtectingReference(const Core2DProtectingReference& coreReference, uint64_t* const weightStamp) noexcept;
+
         Core2DProtectingReference(Core2DProtectingReference&& coreReference) noexcept = delete;
         
         Core2DProtectingReference& operator=(const Core2DProtectingReference& coreReference) noexcept = delete;
@@ -46,45 +51,61 @@ namespace cnn
 
         T GetOutput() const noexcept;
 
+        // Exception guarantee: base for the core.
         // It clears the state without changing of the topology of the core.
-        void ClearInputs() const noexcept;
+        void ClearInputs() const;
 
+        // Exception guarantee: base for the core.
         // It clears the state without changing of the topology of the core.
-        void ClearWeights() const noexcept;
+        void ClearWeights() const;
 
         // It clears the state without changing of the topology of the core.
         void ClearOutput() const noexcept;
 
+        // Exception guarantee: base for the core.
         // It clears the state without changing of the topology of the core.
-        void Clear() const noexcept;
+        void Clear() const;
 
         // Exception guarantee: base for ostream.
         // It saves full state.
         void Save(std::ostream& ostream) const;
 
-        // We expect that the method never throws any exception.
-        void FillWeights(common::ValueGenerator<T>& valueGenerator) const noexcept;
+        // Exception guarantee: base for the core.
+        void FillWeights(common::ValueGenerator<T>& valueGenerator) const;
 
-        // We expect that the method never throws any exception.
-        void Mutate(common::Mutagen<T>& mutagen) const noexcept;
+        // Exception guarantee: base for the core.
+        void Mutate(common::Mutagen<T>& mutagen) const;
 
       private:
 
         Core2D<T>& Core;
+        uint64_t* const WeightStamp;
+
+        void RenewWeightStamp() const noexcept;
 
       };
 
       template <typename T>
-      Core2DProtectingReference<T>::Core2DProtectingReference(Core2D<T>& core) noexcept
+      Core2DProtectingReference<T>::Core2DProtectingReference(Core2D<T>& core, uint64_t* const weightStamp) noexcept
         :
-        Core{ core }
+        Core{ core },
+        WeightStamp{ weightStamp }
       {
       }
 
       template <typename T>
       Core2DProtectingReference<T>::Core2DProtectingReference(const Core2DProtectingReference& coreReference) noexcept
         :
-        Core{ coreReference.Core }
+        Core{ coreReference.Core },
+        WeightStamp{ coreReference.WeightStamp }
+      {
+      }
+
+      template <typename T>
+      Core2DProtectingReference<T>::Core2DProtectingReference(const Core2DProtectingReference& coreReference, uint64_t* const weightStamp) noexcept
+        :
+        Core{ coreReference.Core },
+        WeightStamp{ weightStamp }
       {
       }
 
@@ -115,6 +136,7 @@ namespace cnn
       template <typename T>
       void Core2DProtectingReference<T>::SetWeight(const size_t x, const size_t y, const T value) const
       {
+        RenewWeightStamp();
         Core.SetWeight(x, y, value);
       }
 
@@ -131,14 +153,15 @@ namespace cnn
       }
 
       template <typename T>
-      void Core2DProtectingReference<T>::ClearInputs() const noexcept
+      void Core2DProtectingReference<T>::ClearInputs() const
       {
         Core.ClearInputs();
       }
 
       template <typename T>
-      void Core2DProtectingReference<T>::ClearWeights() const noexcept
+      void Core2DProtectingReference<T>::ClearWeights() const
       {
+        RenewWeightStamp();
         Core.ClearWeights();
       }
 
@@ -149,8 +172,9 @@ namespace cnn
       }
 
       template <typename T>
-      void Core2DProtectingReference<T>::Clear() const noexcept
+      void Core2DProtectingReference<T>::Clear() const
       {
+        RenewWeightStamp();
         Core.Clear();
       }
 
@@ -161,16 +185,27 @@ namespace cnn
       }
 
       template <typename T>
-      void Core2DProtectingReference<T>::FillWeights(common::ValueGenerator<T>& valueGenerator) const noexcept
+      void Core2DProtectingReference<T>::FillWeights(common::ValueGenerator<T>& valueGenerator) const
       {
+        RenewWeightStamp();
         Core.FillWeights(valueGenerator);
       }
 
       template <typename T>
-      void Core2DProtectingReference<T>::Mutate(common::Mutagen<T>& mutagen) const noexcept
+      void Core2DProtectingReference<T>::Mutate(common::Mutagen<T>& mutagen) const
       {
+        RenewWeightStamp();
         Core.Mutate(mutagen);
       }
+
+      template <typename T>
+      void Core2DProtectingReference<T>::RenewWeightStamp() const noexcept
+      {
+        if (WeightStamp != nullptr)
+        {
+          *WeightStamp = common::WeightStamp::Generate();
+        }
+      }
     }
   }
 }
\ No newline at end of file
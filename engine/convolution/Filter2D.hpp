@@ -3,11 +3,14 @@
 #include <memory>
 #include <type_traits>
 #include <stdexcept>
+#include <memory_resource>
 
 #include "Core2D.hpp"
 #include "Core2DProtectingReference.hpp"
 #include "Filter2DTopology.hpp"
 
+#include "../common/MemoryResource.hpp"
+
 namespace cnn
 {
   namespace engine
@@ -22,7 +25,8 @@ namespace cnn
 
       public:
 
-        Filter2D(const Filter2DTopology& topology = {});
+        // Cores and their values are allocated by the resource.
+        Filter2D(const Filter2DTopology& topology = {}, std::pmr::memory_resource* const resource = std::pmr::get_default_resource());
 
         Filter2D(const Filter2D& filter);
 
@@ -33,6 +37,8 @@ namespace cnn
 
         Filter2D& operator=(Filter2D&& filter) noexcept = default;
 
+        std::pmr::memory_resource* GetResource() const noexcept;
+
         const Filter2DTopology& GetTopology() const noexcept;
 
         // Exception guarantee: strong for this.
@@ -43,8 +49,9 @@ namespace cnn
         // Exception guarantee: strong for this.
         Core2DProtectingReference<T> GetCore(const size_t index);
 
+        // Exception guarantee: base for this.
         // It clears the state without changing of the topology.
-        void Clear() noexcept;
+        void Clear();
 
         // It resets the state to zero including the topology.
         void Reset() noexcept;
@@ -57,44 +64,49 @@ namespace cnn
         // It loads full state.
         void Load(std::istream& istream);
 
-        // We expect that the method never throws any exception.
-        void FillWeights(common::ValueGenerator<T>& valueGenerator) noexcept;
+        // Exception guarantee: base for this.
+        void FillWeights(common::ValueGenerator<T>& valueGenerator);
+
+        // Exception guarantee: base for this.
+        void Mutate(common::Mutagen<T>& mutagen);
+
+        // Exception guarantee: strong for this.
+        // It shares the weights of the filter of the same topology, so they are duplicated only when one of the sides writes them.
+        void ShareWeights(const Filter2D& filter);
+
+        // Exception guarantee: base for this.
+        // It copies the weights of the filter of the same topology, so no memory is allocated, if own weights aren't shared.
+        void CopyWeights(const Filter2D& filter);
+
+        // Weights are indexed core by core, and row by row in a core.
+        size_t GetWeightCount() const noexcept;
 
-        // We expect that the method never throws any exception.
-        void Mutate(common::Mutagen<T>& mutagen) noexcept;
+        T GetWeight(const size_t index) const;
+
+        // Exception guarantee: strong for this.
+        void SetWeight(const size_t index, const T value);
 
       private:
 
         Filter2DTopology Topology;
-        std::unique_ptr<Core2D<T>[]> Cores;
+        common::ResourceArray<Core2D<T>> Cores;
 
       };
 
       template <typename T>
-      Filter2D<T>::Filter2D(const Filter2DTopology& topology)
+      Filter2D<T>::Filter2D(const Filter2DTopology& topology, std::pmr::memory_resource* const resource)
         :
-        Topology{ topology }
+        Topology{ topology },
+        Cores{ common::MakeResourceArray<Core2D<T>>(topology.GetCoreCount(), resource, topology.GetSize()) }
       {
-        Cores = std::make_unique<Core2D<T>[]>(Topology.GetCoreCount());
-        if (Topology.GetSize().GetArea() != 0)
-        {
-          for (size_t i = 0; i < Topology.GetCoreCount(); ++i)
-          {
-            Cores[i].SetSize(Topology.GetSize());
-          }
-        }
       }
 
       template <typename T>
       Filter2D<T>::Filter2D(const Filter2D& filter)
         :
-        Topology{ filter.Topology }
+        Topology{ filter.Topology },
+        Cores{ common::CopyResourceArray(filter.Cores.get(), filter.Topology.GetCoreCount(), filter.GetResource()) }
       {
-        Cores = std::make_unique<Core2D<T>[]>(Topology.GetCoreCount());
-        for (size_t i = 0; i < Topology.GetCoreCount(); ++i)
-        {
-          Cores[i] = filter.Cores[i];
-        }
       }
 
       template <typename T>
@@ -109,6 +121,12 @@ namespace cnn
         return *this;
       }
 
+      template <typename T>
+      std::pmr::memory_resource* Filter2D<T>::GetResource() const noexcept
+      {
+        return Cores.get_deleter().GetResource();
+      }
+
       template <typename T>
       const Filter2DTopology& Filter2D<T>::GetTopology() const noexcept
       {
@@ -118,7 +136,7 @@ namespace cnn
       template <typename T>
       void Filter2D<T>::SetTopology(const Filter2DTopology& topology)
       {
-        Filter2D<T> tmpFilter{ topology };
+        Filter2D<T> tmpFilter{ topology, GetResource() };
         // Beware, it is very intimate place for strong exception guarantee.
         std::swap(*this, tmpFilter);
       }
@@ -144,7 +162,7 @@ namespace cnn
       }
 
       template <typename T>
-      void Filter2D<T>::Clear() noexcept
+      void Filter2D<T>::Clear()
       {
         for (size_t c = 0; c < Topology.GetCoreCount(); ++c)
         {
@@ -190,8 +208,7 @@ namespace cnn
 
         topology.Load(istream);
 
-        // TODO: How can we change Core2D<T>[] on decltype()?
-        cores = std::make_unique<Core2D<T>[]>(topology.GetCoreCount());
+        cores = common::MakeResourceArray<Core2D<T>>(topology.GetCoreCount(), GetResource(), Size2D{});
         for (size_t i = 0; i < topology.GetCoreCount(); ++i)
         {
           cores[i].Load(istream);
@@ -211,7 +228,7 @@ namespace cnn
       }
 
       template <typename T>
-      void Filter2D<T>::FillWeights(common::ValueGenerator<T>& valueGenerator) noexcept
+      void Filter2D<T>::FillWeights(common::ValueGenerator<T>& valueGenerator)
       {
         for (size_t i = 0; i < Topology.GetCoreCount(); ++i)
         {
@@ -220,13 +237,71 @@ namespace cnn
       }
 
       template <typename T>
-      void Filter2D<T>::Mutate(common::Mutagen<T>& mutagen) noexcept
+      void Filter2D<T>::Mutate(common::Mutagen<T>& mutagen)
       {
         for (size_t i = 0; i < Topology.GetCoreCount(); ++i)
         {
           Cores[i].Mutate(mutagen);
         }
       }
+
+      template <typename T>
+      size_t Filter2D<T>::GetWeightCount() const noexcept
+      {
+        return Topology.GetCoreCount() * Topology.GetSize().GetArea();
+      }
+
+      template <typename T>
+      T Filter2D<T>::GetWeight(const size_t index) const
+      {
+        if (index >= GetWeightCount())
+        {
+          throw std::range_error("cnn::engine::convolution::Filter2D::GetWeight() const, index >= GetWeightCount().");
+        }
+        const size_t width = Topology.GetSize().GetWidth();
+        const size_t coreWeightCount = Topology.GetSize().GetArea();
+        const size_t weightIndex = index % coreWeightCount;
+        return Cores[index / coreWeightCount].GetWeight(weightIndex % width, weightIndex / width);
+      }
+
+      template <typename T>
+      void Filter2D<T>::SetWeight(const size_t index, const T value)
+      {
+        if (index >= GetWeightCount())
+        {
+          throw std::range_error("cnn::engine::convolution::Filter2D::SetWeight(), index >= GetWeightCount().");
+        }
+        const size_t width = Topology.GetSize().GetWidth();
+        const size_t coreWeightCount = Topology.GetSize().GetArea();
+        const size_t weightIndex = index % coreWeightCount;
+        Cores[index / coreWeightCount].SetWeight(weightIndex % width, weightIndex / width, value);
+      }
+
+      template <typename T>
+      void Filter2D<T>::ShareWeights(const Filter2D& filter)
+      {
+        if (Topology != filter.Topology)
+        {
+          throw std::invalid_argument("cnn::engine::convolution::Filter2D::ShareWeights(), Topology != filter.Topology.");
+        }
+        for (size_t i = 0; i < Topology.GetCoreCount(); ++i)
+        {
+          Cores[i].ShareWeights(filter.Cores[i]);
+        }
+      }
+
+      template <typename T>
+      void Filter2D<T>::CopyWeights(const Filter2D& filter)
+      {
+        if (Topology != filter.Topology)
+        {
+          throw std::invalid_argument("cnn::engine::convolution::Filter2D::CopyWeights(), Topology != filter.Topology.");
+        }
+        for (size_t i = 0; i < Topology.GetCoreCount(); ++i)
+        {
+          Cores[i].CopyWeights(filter.Cores[i]);
+        }
+      }
     }
   }
 }
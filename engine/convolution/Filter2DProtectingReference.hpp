@@ -2,6 +2,7 @@
 
 #include "Filter2D.hpp"
 #include "Core2DProtectingReference.hpp"
+#include "../common/WeightStamp.hpp"
 
 namespace cnn
 {
@@ -13,6 +14,8 @@ namespace cnn
       // The smart reference proxies all methods of Filter2D and doesn't allow to use methods, which change
       // the topology of the target filter.
       // It allow to protect consistency of complex objects, which contain the target filter as its part.
+      // If the owner gives its weight stamp, then every write of weights through the reference renews the stamp,
+      // so caches of the owner, which are derived from weights, are rebuilt (see common::WeightStamp).
       template <typename T>
       class Filter2DProtectingReference
       {
@@ -21,7 +24,7 @@ namespace cnn
 
       public:
 
-        Filter2DProtectingReference(Filter2D<T>& filter) noexcept;
+        Filter2DProtectingReference(Filter2D<T>& filter, uint64_t* const weightStamp = nullptr) noexcept;
 
         Filter2DProtectingReference(const Filter2DProtectingReference& filterReference) noexcept;
 
@@ -38,36 +41,42 @@ namespace cnn
         // Exception guarantee: strong for the filter.
         Core2DProtectingReference<T> GetCore(const size_t index) const;
 
+        // Exception guarantee: base for the filter.
         // It clears the state without changing of the topology of the filter.
-        void Clear() const noexcept;
+        void Clear() const;
 
         // Exception guarantee: base for ostream.
         // It saves full state.
         void Save(std::ostream& ostream) const;
 
-        // We expect that the method never throws any exception.
-        void FillWeights(common::ValueGenerator<T>& valueGenerator) const noexcept;
+        // Exception guarantee: base for the filter.
+        void FillWeights(common::ValueGenerator<T>& valueGenerator) const;
 
-        // We expect that the method never throws any exception.
-        void Mutate(common::Mutagen<T>& mutagen) const noexcept;
+        // Exception guarantee: base for the filter.
+        void Mutate(common::Mutagen<T>& mutagen) const;
 
       private:
 
         Filter2D<T>& Filter;
+        uint64_t* const WeightStamp;
+
+        void RenewWeightStamp() const noexcept;
         
       };
 
       template <typename T>
-      Filter2DProtectingReference<T>::Filter2DProtectingReference(Filter2D<T>& filter) noexcept
+      Filter2DProtectingReference<T>::Filter2DProtectingReference(Filter2D<T>& filter, uint64_t* const weightStamp) noexcept
         :
-        Filter{ filter }
+        Filter{ filter },
+        WeightStamp{ weightStamp }
       {
       }
 
       template <typename T>
       Filter2DProtectingReference<T>::Filter2DProtectingReference(const Filter2DProtectingReference& filterReference) noexcept
         :
-        Filter{ filterReference.Filter }
+        Filter{ filterReference.Filter },
+        WeightStamp{ filterReference.WeightStamp }
       {
       }
 
@@ -80,18 +89,19 @@ namespace cnn
       template <typename T>
       const Core2D<T>& Filter2DProtectingReference<T>::GetConstCore(const size_t index) const
       {
-        return Filter.GetCore(index);
+        return Filter.GetConstCore(index);
       }
 
       template <typename T>
       Core2DProtectingReference<T> Filter2DProtectingReference<T>::GetCore(const size_t index) const
       {
-        return Filter.GetCore(index);
+        return Core2DProtectingReference<T>{ Filter.GetCore(index), WeightStamp };
       }
 
       template <typename T>
-      void Filter2DProtectingReference<T>::Clear() const noexcept
+      void Filter2DProtectingReference<T>::Clear() const
       {
+        RenewWeightStamp();
         Filter.Clear();
       }
 
@@ -102,16 +112,26 @@ namespace cnn
       }
 
       template <typename T>
-      void Filter2DProtectingReference<T>::FillWeights(common::ValueGenerator<T>& valueGenerator) const noexcept
+      void Filter2DProtectingReference<T>::FillWeights(common::ValueGenerator<T>& valueGenerator) const
       {
+        RenewWeightStamp();
         Filter.FillWeights(valueGenerator);
       }
 
       template <typename T>
-      void Filter2DProtectingReference<T>::Mutate(common::Mutagen<T>& mutagen) const noexcept
+      void Filter2DProtectingReference<T>::Mutate(common::Mutagen<T>& mutagen) const
       {
+        RenewWeightStamp();
         Filter.Mutate(mutagen);
       }
+      template <typename T>
+      void Filter2DProtectingReference<T>::RenewWeightStamp() const noexcept
+      {
+        if (WeightStamp != nullptr)
+        {
+          *WeightStamp = common::WeightStamp::Generate();
+        }
+      }
     }
   }
 }
\ No newline at end of file
@@ -8,17 +8,19 @@ namespace cnn
   {
     namespace convolution
     {
-      Filter2DTopology::Filter2DTopology(const Size2D& size, const size_t coreCount) noexcept
+      Filter2DTopology::Filter2DTopology(const Size2D& size, const size_t coreCount, const size_t dilation) noexcept
         :
         Size{ size },
-        CoreCount{ coreCount }
+        CoreCount{ coreCount },
+        Dilation{ dilation }
       {
       }
 
       Filter2DTopology::Filter2DTopology(Filter2DTopology&& topology) noexcept
         :
         Size{ topology.GetSize() },
-        CoreCount{ topology.CoreCount }
+        CoreCount{ topology.CoreCount },
+        Dilation{ topology.Dilation }
       {
         topology.Reset();
       }
@@ -29,6 +31,7 @@ namespace cnn
         {
           Size = std::move(topology.Size);
           CoreCount = topology.CoreCount;
+          Dilation = topology.Dilation;
 
           topology.Reset();
         }
@@ -37,7 +40,7 @@ namespace cnn
 
       bool Filter2DTopology::operator==(const Filter2DTopology& topology) const noexcept
       {
-        if ((Size == topology.Size) && (CoreCount == topology.CoreCount))
+        if ((Size == topology.Size) && (CoreCount == topology.CoreCount) && (Dilation == topology.Dilation))
         {
           return true;
         } else {
@@ -75,10 +78,28 @@ namespace cnn
         CoreCount = coreCount;
       }
 
+      size_t Filter2DTopology::GetDilation() const noexcept
+      {
+        return Dilation;
+      }
+
+      void Filter2DTopology::SetDilation(const size_t dilation) noexcept
+      {
+        Dilation = dilation;
+      }
+
+      Size2D Filter2DTopology::GetDilatedSize() const noexcept
+      {
+        const size_t width = Size.GetWidth() == 0 ? 0 : (Size.GetWidth() - 1) * Dilation + 1;
+        const size_t height = Size.GetHeight() == 0 ? 0 : (Size.GetHeight() - 1) * Dilation + 1;
+        return Size2D{ width, height };
+      }
+
       void Filter2DTopology::Reset() noexcept
       {
         Size.Reset();
         CoreCount = 0;
+        Dilation = 1;
       }
 
       void Filter2DTopology::Save(std::ostream& ostream) const
@@ -87,8 +108,10 @@ namespace cnn
         {
           throw std::invalid_argument("cnn::engine::convolution::Filter2DTopology::Save(), ostream.good() == false.");
         }
+        common::FormatVersion::Save(ostream, FORMAT_VERSION);
         Size.Save(ostream);
         ostream.write(reinterpret_cast<const char* const>(&CoreCount), sizeof(CoreCount));
+        ostream.write(reinterpret_cast<const char* const>(&Dilation), sizeof(Dilation));
         if (ostream.good() == false)
         {
           throw std::runtime_error("cnn::engine::convolution::Filter2DTopology::Save(), ostream.good() == false.");
@@ -102,19 +125,28 @@ namespace cnn
           throw std::invalid_argument("cnn::engine::convolution::Filter2DTopology::Load(), istream.good() == false.");
         }
 
-        decltype(Size) size;
+        size_t width{};
+        size_t height{};
         decltype(CoreCount) coreCount{};
+        decltype(Dilation) dilation{ 1 };
 
-        size.Load(istream);
+        // The width of the size is the first value of the stream.
+        const uint32_t version = common::FormatVersion::Load(istream, FORMAT_VERSION, width);
+        istream.read(reinterpret_cast<char* const>(&height), sizeof(height));
         istream.read(reinterpret_cast<char* const>(&coreCount), sizeof(coreCount));
+        if (version != common::FormatVersion::LEGACY)
+        {
+          istream.read(reinterpret_cast<char* const>(&dilation), sizeof(dilation));
+        }
 
         if (istream.good() == false)
         {
           throw std::runtime_error("cnn::engine::convolution::Filter2DTopology::Load(), istream.good() == false.");
         }
 
-        Size = std::move(size);
+        Size = Size2D{ width, height };
         CoreCount = coreCount;
+        Dilation = dilation;
       }
     }
   }
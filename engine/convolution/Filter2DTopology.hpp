@@ -2,18 +2,25 @@
 
 #include "Size2D.hpp"
 
+#include "../common/FormatVersion.hpp"
+
+#include <cstdint>
+
 namespace cnn
 {
   namespace engine
   {
     namespace convolution
     {
+      // The dilation is the step between taps of a core in the input, so a core of size k covers (k - 1) * dilation + 1 pixels
+      // and a dilated core reaches a large receptive field by the multiply-adds of a small one.
       class Filter2DTopology
       {
       public:
 
         Filter2DTopology(const Size2D& size = {},
-                         const size_t coreCount = 0) noexcept;
+                         const size_t coreCount = 0,
+                         const size_t dilation = 1) noexcept;
 
         Filter2DTopology(const Filter2DTopology& topology) noexcept = default;
 
@@ -35,18 +42,30 @@ namespace cnn
 
         void SetCoreCount(const size_t coreCount) noexcept;
 
+        size_t GetDilation() const noexcept;
+
+        void SetDilation(const size_t dilation) noexcept;
+
+        // It returns the size of the input window, which a core covers.
+        Size2D GetDilatedSize() const noexcept;
+
         void Reset() noexcept;
 
         // Exception guarantee: base for ostream.
         void Save(std::ostream& ostream) const;
 
         // Exception guarantee: strong for this and base for istream.
+        // Legacy streams (see common::FormatVersion) are loaded without dilation.
         void Load(std::istream& istream);
 
       private:
 
+        // Version 1 adds the dilation.
+        constexpr static uint32_t FORMAT_VERSION = 1;
+
         Size2D Size;
         size_t CoreCount;
+        size_t Dilation;
 
       };
     }
@@ -0,0 +1,117 @@
+#pragma once
+
+#include <cstddef>
+#include <type_traits>
+#include <memory_resource>
+
+#include "Size2D.hpp"
+
+#include "../common/FourierTransform.hpp"
+
+namespace cnn
+{
+  namespace engine
+  {
+    namespace convolution
+    {
+      // Fourier2D computes 2D discrete Fourier transforms of planes of the size (both sides are powers of 2).
+      // A plane is stored row by row (x + y * width) as two planes of real and imaginary parts.
+      template <typename T>
+      class Fourier2D
+      {
+
+        static_assert(std::is_floating_point<T>::value);
+
+      public:
+
+        // Exception guarantee: strong for this.
+        // The twiddle factors are allocated by the resource.
+        Fourier2D(const Size2D& size = { 1, 1 }, std::pmr::memory_resource* const resource = std::pmr::get_default_resource());
+
+        std::pmr::memory_resource* GetResource() const noexcept;
+
+        Size2D GetSize() const noexcept;
+
+        // Rows from rowCount are zero, so they are not transformed.
+        void Transform(T* const real, T* const imaginary, const size_t rowCount) const noexcept;
+
+        // Only rows before rowCount of the result are computed. The result is multiplied by the area of the size.
+        void InverseTransform(T* const real, T* const imaginary, const size_t rowCount) const noexcept;
+
+        // It releases the twiddle factors, so the transform is of 1 x 1 values.
+        void Reset() noexcept;
+
+        // It returns the least size of the transform, which holds the size.
+        static Size2D GetTransformSize(const Size2D& size) noexcept;
+
+      private:
+
+        common::FourierTransform<T> RowTransform;
+        common::FourierTransform<T> ColumnTransform;
+
+      };
+
+      template <typename T>
+      Fourier2D<T>::Fourier2D(const Size2D& size, std::pmr::memory_resource* const resource)
+        :
+        RowTransform{ size.GetWidth(), resource },
+        ColumnTransform{ size.GetHeight(), resource }
+      {
+      }
+
+      template <typename T>
+      std::pmr::memory_resource* Fourier2D<T>::GetResource() const noexcept
+      {
+        return RowTransform.GetResource();
+      }
+
+      template <typename T>
+      Size2D Fourier2D<T>::GetSize() const noexcept
+      {
+        return Size2D{ RowTransform.GetCount(), ColumnTransform.GetCount() };
+      }
+
+      template <typename T>
+      void Fourier2D<T>::Transform(T* const real, T* const imaginary, const size_t rowCount) const noexcept
+      {
+        const size_t width = RowTransform.GetCount();
+        for (size_t y = 0; y < rowCount; ++y)
+        {
+          RowTransform.Transform(real + y * width, imaginary + y * width);
+        }
+        for (size_t x = 0; x < width; ++x)
+        {
+          ColumnTransform.Transform(real + x, imaginary + x, width);
+        }
+      }
+
+      template <typename T>
+      void Fourier2D<T>::InverseTransform(T* const real, T* const imaginary, const size_t rowCount) const noexcept
+      {
+        const size_t width = RowTransform.GetCount();
+        for (size_t x = 0; x < width; ++x)
+        {
+          ColumnTransform.InverseTransform(real + x, imaginary + x, width);
+        }
+        for (size_t y = 0; y < rowCount; ++y)
+        {
+          RowTransform.InverseTransform(real + y * width, imaginary + y * width);
+        }
+      }
+
+      template <typename T>
+      void Fourier2D<T>::Reset() noexcept
+      {
+        RowTransform.Reset();
+        ColumnTransform.Reset();
+      }
+
+      template <typename T>
+      Size2D Fourier2D<T>::GetTransformSize(const Size2D& size) noexcept
+      {
+        return Size2D{ common::FourierTransform<T>::GetTransformCount(size.GetWidth()),
+                       common::FourierTransform<T>::GetTransformCount(size.GetHeight()) };
+      }
+    }
+  }
+}
@@ -7,6 +7,22 @@
 
 #include "Filter2D.hpp"
 #include "Filter2DProtectingReference.hpp"
+#include "Winograd2D.hpp"
+#include "Fourier2D.hpp"
+#include "BlockedTensor2D.hpp"
+
+#include "../common/ThreadPool.hpp"
+#include "../common/BitPacking.hpp"
+#include "../common/MemoryResource.hpp"
+#include "../common/AlignedBuffer.hpp"
+#include "../common/Activation.hpp"
+#include "../common/WeightStamp.hpp"
+
+#include <cstdint>
+#include <algorithm>
+#include <vector>
+#include <memory_resource>
+#include <utility>
 
 namespace cnn
 {
@@ -22,15 +38,18 @@ namespace cnn
 
       public:
 
-        Layer2D(const Layer2DTopology& topology = {});
+        // Inputs, filters and outputs are allocated by the resource.
+        Layer2D(const Layer2DTopology& topology = {}, std::pmr::memory_resource* const resource = std::pmr::get_default_resource());
 
         Layer2D(const Layer2D& layer);
 
-        Layer2D(Layer2D&& layer) noexcept = default;
+        Layer2D(Layer2D&& layer) noexcept;
 
         Layer2D& operator=(const Layer2D& layer);
 
-        Layer2D& operator=(Layer2D&& layer) noexcept = default;
+        Layer2D& operator=(Layer2D&& layer) noexcept;
+
+        std::pmr::memory_resource* GetResource() const noexcept;
 
         const Layer2DTopology& GetTopology() const noexcept;
 
@@ -47,8 +66,17 @@ namespace cnn
         const Filter2D<T>& GetFilter(const size_t index) const;
 
         // Exception guarantee: strong for this.
+        // Writes of weights through the reference renew the weight stamp of this, so the cached transforms of weights are rebuilt.
+        // Filters of a depthwise separable layer have 1 x 1 cores, which mix the outputs of the depthwise filter.
         Filter2DProtectingReference<T> GetFilter(const size_t index);
 
+        // Exception guarantee: strong for this.
+        // It is the filter of a depthwise separable layer, which core c convolves the input c.
+        const Filter2D<T>& GetDepthwiseFilter() const;
+
+        // Exception guarantee: strong for this.
+        Filter2DProtectingReference<T> GetDepthwiseFilter();
+
         // Exception guarantee: strong for this.
         const Map2D<T>& GetOutput(const size_t index) const;
 
@@ -58,8 +86,68 @@ namespace cnn
         // Exception guarantee: base for this.
         void GenerateOutput();
 
+        // Exception guarantee: base for this.
+        // The work is split across filters and blocks of output rows (or blocks of rows of Winograd tiles,
+        // or inputs and pairs of filters of the Fourier kernel).
+        // Small layers are processed by the calling thread, because fork/join would cost more than the work.
+        void GenerateOutput(common::ThreadPool& threadPool);
+
+        // Exception guarantee: base for this.
+        // It generates rows [beginY, endY) of all outputs, which depend on rows [beginY, endY + core height - 1) of the inputs.
+        // It is a stage of the depth-first execution of a network (see Network2D::SetFusedTileHeight()),
+        // so whole-map kernels (Fourier) are not used.
+        void GenerateOutputRows(const size_t beginY, const size_t endY);
+
+        // Exception guarantee: base for this.
+        // The work is split across filters.
+        void GenerateOutputRows(const size_t beginY, const size_t endY, common::ThreadPool& threadPool);
+
+        // It returns true, if the layer is estimated to be cheaper by the Fourier kernel than by the direct one,
+        // so GenerateOutput() uses the Fourier kernel.
+        bool IsFourierUsed() const noexcept;
+
+        // Exception guarantee: base for this.
+        // It generates all outputs by the Fourier kernel regardless of the estimate, so the kernel can be measured against the direct one.
+        void GenerateOutputByFourier();
+
+        bool IsSparse() const noexcept;
+
+        // A sparse layer applies only its nonzero weights one by one, and a dense layer applies all weights by the fastest kernel
+        // without scanning them. Layers are dense by default, complex::Pruning2D makes pruned layers sparse,
+        // and FillWeights(), Mutate(), Clear() and Load() make them dense. The state is not saved.
+        // A depthwise separable layer has no sparse kernel, so it is always applied as a dense one.
+        void SetSparse(const bool sparse) noexcept;
+
+        // It counts nonzero weights and returns true, if the sparse kernel is estimated to be faster than the dense one.
+        bool IsSparseFaster() const noexcept;
+
+        // Exception guarantee: base for this.
+        // The inputs are binary maps of the input size, which are bit-packed (see common::BitPacking) one after another.
+        // Every receptive field sum is accumulated from the weights, which are masked by the input bits,
+        // so there are no multiplications. The inputs of the layer are not changed.
+        void GenerateOutputFromBinary(const uint64_t* const inputs);
+
+        // Exception guarantee: base for this.
+        // The inputs are maps of the input size and count in the blocked layout, and the outputs are generated to
+        // GetBlockedOutputs() in the same layout, so layers are chained without conversions.
+        // Every input value is multiplied by a vector of weights of a block of filters. The inputs and outputs of the layer are not changed.
+        // A depthwise separable layer has no blocked kernel, so it unpacks the inputs to its inputs and packs its outputs.
+        void GenerateOutputFromBlocked(const BlockedTensor2D<T>& inputs);
+
+        // Exception guarantee: base for this.
+        // The work is split across blocks of filters and blocks of output rows.
+        void GenerateOutputFromBlocked(const BlockedTensor2D<T>& inputs, common::ThreadPool& threadPool);
+
+        // It returns the outputs of the last GenerateOutputFromBlocked(). A copy of the layer has none until it generates them.
+        const BlockedTensor2D<T>& GetBlockedOutputs() const noexcept;
+
+        // Exception guarantee: base for this.
+        // It converts the blocked outputs to the outputs.
+        void UnpackBlockedOutputs();
+
+        // Exception guarantee: base for this.
         // It clears the state without changing of the topology.
-        void Clear() noexcept;
+        void Clear();
 
         // It resets the state to zero including the topology.
         void Reset() noexcept;
@@ -72,196 +160,1734 @@ namespace cnn
         // It loads full state.
         void Load(std::istream& istream);
 
-        // We expect that the method never throws any exception.
-        void FillWeights(common::ValueGenerator<T>& valueGenerator) noexcept;
+        // Exception guarantee: base for this.
+        void FillWeights(common::ValueGenerator<T>& valueGenerator);
+
+        // Exception guarantee: base for this.
+        void Mutate(common::Mutagen<T>& mutagen);
+
+        // Exception guarantee: strong for this.
+        // It shares the weights of the layer of the same topology, so they are duplicated only when one of the sides writes them.
+        // The sparsity state is taken from the layer too.
+        void ShareWeights(const Layer2D& layer);
+
+        // Exception guarantee: base for this.
+        // It copies the weights of the layer of the same topology, so no memory is allocated, if own weights aren't shared.
+        // The sparsity state is taken from the layer too.
+        void CopyWeights(const Layer2D& layer);
+
+        // Weights are indexed filter by filter (see Filter2D::GetWeight()), and weights of the depthwise filter go first.
+        size_t GetWeightCount() const noexcept;
+
+        T GetWeight(const size_t index) const;
 
-        // We expect that the method never throws any exception.
-        void Mutate(common::Mutagen<T>& mutagen) noexcept;
+        // Exception guarantee: strong for this.
+        void SetWeight(const size_t index, const T value);
 
       private:
 
+        // The count of multiply-adds, below which the layer is not split across threads.
+        constexpr static size_t MIN_PARALLEL_WORK = 32768;
+
+        // Up to this core width, sums of masked weights are taken from a table of all bit patterns of a core row.
+        constexpr static size_t MAX_TABLE_CORE_WIDTH = 8;
+
+        // From these output sizes (of both sides), 3 x 3 cores without dilation are applied by Winograd F(2 x 2, 3 x 3) and F(4 x 4, 3 x 3).
+        constexpr static size_t MIN_WINOGRAD_2_OUTPUT_SIZE = 4;
+        constexpr static size_t MIN_WINOGRAD_4_OUTPUT_SIZE = 16;
+
+        // The estimated multiply-adds of the Fourier kernel per butterfly of a transform and per product of spectra.
+        // Other cores are applied by Fourier transforms, when they are estimated to be cheaper than the direct kernel.
+        constexpr static size_t FOURIER_BUTTERFLY_WORK = 8;
+        constexpr static size_t FOURIER_PRODUCT_WORK = 4;
+
+        // The count of pixels of a row, which are accumulated at once by the blocked kernel.
+        constexpr static size_t BLOCKED_PIXEL_COUNT = 4;
+
+        // The count of filters, which output rows are accumulated at once from every input row by the pointwise kernel.
+        constexpr static size_t POINTWISE_FILTER_COUNT = 4;
+
+        // The sparse kernel is estimated to be faster, if weights outnumber nonzero weights this much,
+        // because Winograd tiles cost up to 4 times less multiply-adds than the direct kernel.
+        constexpr static size_t MIN_SPARSE_RATIO = 4;
+
         Layer2DTopology Topology;
 
-        std::unique_ptr<Map2D<T>[]> Inputs;
-        std::unique_ptr<Filter2D<T>[]> Filters;
-        std::unique_ptr<Map2D<T>[]> Outputs;
+        common::ResourceArray<Map2D<T>> Inputs;
+        common::ResourceArray<Filter2D<T>> Filters;
+        common::ResourceArray<Map2D<T>> Outputs;
+
+        // The depthwise filter and its outputs [input][y][x], which are not activated, of a depthwise separable layer.
+        // The layer is equivalent to a full layer, which core c of the filter f is the depthwise core c scaled by the weight c of the filter f.
+        Filter2D<T> DepthwiseFilter;
+        common::AlignedBuffer<T> DepthwiseOutputs;
+
+        // Weights [filter][input] of 1 x 1 cores, which are the matrix of the pointwise kernel.
+        common::AlignedBuffer<T> PointwiseWeights;
+
+        // Winograd transforms of cores [filter][core][tile].
+        common::AlignedBuffer<T> CoreTiles;
+
+        // Conjugated spectra of cores [filter][core][real and imaginary planes], which are divided by the transform area,
+        // and spectra of inputs [core][real and imaginary planes], which are shared by all filters.
+        Fourier2D<T> Fourier;
+        common::AlignedBuffer<T> CoreSpectra;
+        common::AlignedBuffer<T> InputSpectra;
+
+        // Weights [block of filters][core][y][x][filter of the block] and outputs of the blocked layout.
+        common::AlignedBuffer<T> BlockedWeights;
+        BlockedTensor2D<T> BlockedOutputs;
+
+        // Nonzero weights of filters and their taps [core, x, y], which offsets are scaled by the dilation: taps of the filter f are [TapOffsets[f], TapOffsets[f + 1]).
+        // Only the first TapOffsets[filter count] of them are used.
+        common::AlignedBuffer<T> SparseWeights;
+        common::AlignedBuffer<uint32_t> SparseTaps;
+        common::AlignedBuffer<size_t> TapOffsets;
+        bool Sparse;
+
+        // Transforms of cores, blocked weights and taps are valid, while their stamps are equal to the stamp of weights.
+        uint64_t WeightStamp;
+        uint64_t CoreTransformsStamp;
+        uint64_t BlockedWeightsStamp;
+        uint64_t SparseTapsStamp;
+        uint64_t PointwiseWeightsStamp;
+
+        // It gives weights a new stamp, so all transforms of cores are rebuilt.
+        void DropCoreTransforms() noexcept;
 
         void CheckTopology(const Layer2DTopology& topology) const;
 
+        // It returns the topology of Filters.
+        static Filter2DTopology GetStoredFilterTopology(const Layer2DTopology& topology) noexcept;
+
+        // It returns the topology of DepthwiseFilter, which is empty for a full layer.
+        static Filter2DTopology GetDepthwiseFilterTopology(const Layer2DTopology& topology) noexcept;
+
+        bool IsDepthwiseSeparable() const noexcept;
+
+        // It returns the count of values of a row of DepthwiseOutputs, which rows start at cache line boundaries.
+        size_t GetDepthwiseStride() const noexcept;
+
+        size_t GetWork() const noexcept;
+
+        // It generates rows [beginY, endY) of the output of the filter.
+        void GenerateOutput(const size_t filterIndex, const size_t beginY, const size_t endY);
+
+        // It lists nonzero weights of a sparse layer, so GenerateOutput() applies only them. A dense layer is not scanned.
+        void PrepareSparseTaps();
+
+        void GenerateSparseOutput(const size_t filterIndex, const size_t beginY, const size_t endY) noexcept;
+
+        // It generates rows [beginY, endY) of the outputs of a depthwise separable layer.
+        void GenerateSeparableOutput(const size_t beginY, const size_t endY);
+
+        // The work is split across inputs and then across blocks of filters.
+        void GenerateSeparableOutput(const size_t beginY, const size_t endY, common::ThreadPool& threadPool);
+
+        // It generates rows [beginY, endY) of the depthwise output of the input.
+        void GenerateDepthwiseOutput(const size_t inputIndex, const size_t beginY, const size_t endY) noexcept;
+
+        void GenerateDepthwiseOutputFromBinary(const uint64_t* const inputs, const size_t inputIndex) noexcept;
+
+        // It returns true, if the layer has 1 x 1 cores, which are applied by the pointwise kernel.
+        bool IsPointwiseUsed() const noexcept;
+
+        void PreparePointwiseWeights();
+
+        // It returns the row of the input of the pointwise kernel: the depthwise output or the input of the layer.
+        const T* GetPointwiseInputRow(const size_t inputIndex, const size_t y) const noexcept;
+
+        // It generates rows [beginY, endY) of the outputs of filters [beginFilter, endFilter) as the product of the matrix of weights
+        // [filter][input] and the matrix of inputs [input][pixel], which is processed row by row.
+        void GeneratePointwiseOutput(const size_t beginFilter, const size_t endFilter, const size_t beginY, const size_t endY) noexcept;
+
+        // The work is split across blocks of filters and blocks of rows.
+        void GeneratePointwiseOutput(const size_t beginY, const size_t endY, common::ThreadPool& threadPool);
+
+        void GenerateSeparableOutputFromBlocked(const BlockedTensor2D<T>& inputs, common::ThreadPool* const threadPool);
+
+        // It returns the output tile size of the Winograd kernel for the layer, or 0, if the direct kernel is used.
+        size_t GetWinogradTileSize() const noexcept;
+
+        void PrepareCoreTiles(const size_t tileSize);
+
+        template <size_t OUTPUT_TILE_SIZE>
+        void PrepareCoreTiles();
+
+        // It generates rows [beginY, endY) of the outputs of all filters by rows of tiles from beginY.
+        void GenerateWinogradOutput(const size_t tileSize, const size_t beginY, const size_t endY);
+
+        template <size_t OUTPUT_TILE_SIZE>
+        void GenerateWinogradOutput(const size_t beginY, const size_t endY);
+
+        void PrepareCoreSpectra();
+
+        void GenerateInputSpectrum(const size_t inputIndex);
+
+        // The spectra of the pair of filters are combined as real and imaginary parts, so one inverse transform gives both outputs.
+        void GenerateFourierOutput(const size_t pairIndex);
+
+        void GenerateOutputFromBinary(const uint64_t* const inputs, const size_t filterIndex, std::vector<T>& table);
+
+        // Exception guarantee: strong for this.
+        // It checks the inputs, allocates the blocked outputs and packs the weights.
+        void PrepareBlocked(const BlockedTensor2D<T>& inputs);
+
+        // It generates rows [beginY, endY) of the blocked output of the block of filters.
+        void GenerateOutputFromBlocked(const BlockedTensor2D<T>& inputs, const size_t filterBlockIndex, const size_t beginY, const size_t endY);
+
+        // It generates PIXEL_COUNT pixels of the row of the blocked output of the block of filters from (ox, oy).
+        template <size_t PIXEL_COUNT, common::ActivationType ACTIVATION_TYPE>
+        void GenerateBlockedPixels(const BlockedTensor2D<T>& inputs, const size_t filterBlockIndex, const size_t ox, const size_t oy);
+
       };
 
       template <typename T>
-      Layer2D<T>::Layer2D(const Layer2DTopology& topology)
+      Layer2D<T>::Layer2D(const Layer2DTopology& topology, std::pmr::memory_resource* const resource)
+        :
+        DepthwiseFilter{ Filter2DTopology{}, resource },
+        DepthwiseOutputs{ 0, resource },
+        PointwiseWeights{ 0, resource },
+        CoreTiles{ 0, resource },
+        Fourier{ Size2D{ 1, 1 }, resource },
+        CoreSpectra{ 0, resource },
+        InputSpectra{ 0, resource },
+        BlockedWeights{ 0, resource },
+        BlockedOutputs{ Size2D{}, 0, resource },
+        SparseWeights{ 0, resource },
+        SparseTaps{ 0, resource },
+        TapOffsets{ 0, resource },
+        Sparse{ false },
+        WeightStamp{ common::WeightStamp::Generate() },
+        CoreTransformsStamp{ common::WeightStamp::NONE },
+        BlockedWeightsStamp{ common::WeightStamp::NONE },
+        SparseTapsStamp{ common::WeightStamp::NONE },
+        PointwiseWeightsStamp{ common::WeightStamp::NONE }
       {
         CheckTopology(topology);
 
         Topology = topology;
 
-        Inputs = std::make_unique<Map2D<T>[]>(Topology.GetInputCount());
-        for (size_t i = 0; i < Topology.GetInputCount(); ++i)
+        Inputs = common::MakeResourceArray<Map2D<T>>(Topology.GetInputCount(), resource, Topology.GetInputSize());
+        Filters = common::MakeResourceArray<Filter2D<T>>(Topology.GetFilterCount(), resource, GetStoredFilterTopology(Topology));
+        Outputs = common::MakeResourceArray<Map2D<T>>(Topology.GetOutputCount(), resource, Topology.GetOutputSize());
+        if (IsDepthwiseSeparable())
+        {
+          DepthwiseFilter = Filter2D<T>{ GetDepthwiseFilterTopology(Topology), resource };
+          DepthwiseOutputs = common::AlignedBuffer<T>{ Topology.GetInputCount() * Topology.GetOutputSize().GetHeight() * GetDepthwiseStride(), resource };
+        }
+      }
+
+      template <typename T>
+      Layer2D<T>::Layer2D(const Layer2D& layer)
+        :
+        Topology{ layer.Topology },
+        Inputs{ common::CopyResourceArray(layer.Inputs.get(), layer.Topology.GetInputCount(), layer.GetResource()) },
+        Filters{ common::CopyResourceArray(layer.Filters.get(), layer.Topology.GetFilterCount(), layer.GetResource()) },
+        Outputs{ common::CopyResourceArray(layer.Outputs.get(), layer.Topology.GetOutputCount(), layer.GetResource()) },
+        DepthwiseFilter{ layer.DepthwiseFilter },
+        DepthwiseOutputs{ layer.DepthwiseOutputs.GetCount(), layer.GetResource() },
+        PointwiseWeights{ 0, layer.GetResource() },
+        CoreTiles{ 0, layer.GetResource() },
+        Fourier{ Size2D{ 1, 1 }, layer.GetResource() },
+        CoreSpectra{ 0, layer.GetResource() },
+        InputSpectra{ 0, layer.GetResource() },
+        BlockedWeights{ 0, layer.GetResource() },
+        BlockedOutputs{ Size2D{}, 0, layer.GetResource() },
+        SparseWeights{ 0, layer.GetResource() },
+        SparseTaps{ 0, layer.GetResource() },
+        TapOffsets{ 0, layer.GetResource() },
+        Sparse{ layer.Sparse },
+        WeightStamp{ layer.WeightStamp },
+        CoreTransformsStamp{ common::WeightStamp::NONE },
+        BlockedWeightsStamp{ common::WeightStamp::NONE },
+        SparseTapsStamp{ common::WeightStamp::NONE },
+        PointwiseWeightsStamp{ common::WeightStamp::NONE }
+      {
+        // Transforms of weights, blocked weights and taps are derived from the weights, so the copy builds them on demand.
+      }
+
+      template <typename T>
+      Layer2D<T>::Layer2D(Layer2D&& layer) noexcept
+        :
+        Topology{ std::move(layer.Topology) },
+        Inputs{ std::move(layer.Inputs) },
+        Filters{ std::move(layer.Filters) },
+        Outputs{ std::move(layer.Outputs) },
+        DepthwiseFilter{ std::move(layer.DepthwiseFilter) },
+        DepthwiseOutputs{ std::move(layer.DepthwiseOutputs) },
+        PointwiseWeights{ std::move(layer.PointwiseWeights) },
+        CoreTiles{ std::move(layer.CoreTiles) },
+        Fourier{ std::move(layer.Fourier) },
+        CoreSpectra{ std::move(layer.CoreSpectra) },
+        InputSpectra{ std::move(layer.InputSpectra) },
+        BlockedWeights{ std::move(layer.BlockedWeights) },
+        BlockedOutputs{ std::move(layer.BlockedOutputs) },
+        SparseWeights{ std::move(layer.SparseWeights) },
+        SparseTaps{ std::move(layer.SparseTaps) },
+        TapOffsets{ std::move(layer.TapOffsets) },
+        Sparse{ layer.Sparse },
+        WeightStamp{ layer.WeightStamp },
+        CoreTransformsStamp{ layer.CoreTransformsStamp },
+        BlockedWeightsStamp{ layer.BlockedWeightsStamp },
+        SparseTapsStamp{ layer.SparseTapsStamp },
+        PointwiseWeightsStamp{ layer.PointwiseWeightsStamp }
+      {
+        layer.Reset();
+      }
+
+      template <typename T>
+      Layer2D<T>& Layer2D<T>::operator=(const Layer2D<T>& layer)
+      {
+        if (this != &layer)
+        {
+          Layer2D<T> tmpLayer{ layer };
+          // Beware, it is very intimate place for strong exception guarantee.
+          std::swap(*this, tmpLayer);
+        }
+        return *this;
+      }
+
+      template <typename T>
+      Layer2D<T>& Layer2D<T>::operator=(Layer2D<T>&& layer) noexcept
+      {
+        if (this != &layer)
+        {
+          Topology = std::move(layer.Topology);
+          Inputs = std::move(layer.Inputs);
+          Filters = std::move(layer.Filters);
+          Outputs = std::move(layer.Outputs);
+          DepthwiseFilter = std::move(layer.DepthwiseFilter);
+          DepthwiseOutputs = std::move(layer.DepthwiseOutputs);
+          PointwiseWeights = std::move(layer.PointwiseWeights);
+          CoreTiles = std::move(layer.CoreTiles);
+          Fourier = std::move(layer.Fourier);
+          CoreSpectra = std::move(layer.CoreSpectra);
+          InputSpectra = std::move(layer.InputSpectra);
+          BlockedWeights = std::move(layer.BlockedWeights);
+          BlockedOutputs = std::move(layer.BlockedOutputs);
+          SparseWeights = std::move(layer.SparseWeights);
+          SparseTaps = std::move(layer.SparseTaps);
+          TapOffsets = std::move(layer.TapOffsets);
+          Sparse = layer.Sparse;
+          WeightStamp = layer.WeightStamp;
+          CoreTransformsStamp = layer.CoreTransformsStamp;
+          BlockedWeightsStamp = layer.BlockedWeightsStamp;
+          SparseTapsStamp = layer.SparseTapsStamp;
+          PointwiseWeightsStamp = layer.PointwiseWeightsStamp;
+
+          layer.Reset();
+        }
+        return *this;
+      }
+
+      template <typename T>
+      std::pmr::memory_resource* Layer2D<T>::GetResource() const noexcept
+      {
+        return Filters.get_deleter().GetResource();
+      }
+
+      template <typename T>
+      const Layer2DTopology& Layer2D<T>::GetTopology() const noexcept
+      {
+        return Topology;
+      }
+
+      template <typename T>
+      void Layer2D<T>::SetTopology(const Layer2DTopology& topology)
+      {
+        Layer2D<T> tmpLayer{ topology, GetResource() };
+        // Beware, it is very intimate place for strong exception guarantee.
+        std::swap(*this, tmpLayer);
+      }
+
+      template <typename T>
+      const Map2D<T>& Layer2D<T>::GetInput(const size_t index) const
+      {
+        if (index >= Topology.GetInputCount())
+        {
+          throw std::range_error("cnn::engine::convolution::Layer2D::GetInput() const, index >= Topology.GetInputCount().");
+        }
+        return Inputs[index];
+      }
+
+      template <typename T>
+      Map2DProtectingReference<T> Layer2D<T>::GetInput(const size_t index)
+      {
+        if (index >= Topology.GetInputCount())
+        {
+          throw std::range_error("cnn::engine::convolution::Layer2D::GetInput(), index >= Topology.GetInputCount().");
+        }
+        return Inputs[index];
+      }
+
+      template <typename T>
+      const Filter2D<T>& Layer2D<T>::GetFilter(const size_t index) const
+      {
+        if (index >= Topology.GetFilterCount())
+        {
+          throw std::range_error("cnn::engine::convolution::Layer2D::GetFilter() const, index >= Topology.GetFilterCount().");
+        }
+        return Filters[index];
+      }
+
+      template <typename T>
+      Filter2DProtectingReference<T> Layer2D<T>::GetFilter(const size_t index) 
+      {
+        if (index >= Topology.GetFilterCount())
+        {
+          throw std::range_error("cnn::engine::convolution::Layer2D::GetFilter(), index >= Topology.GetFilterCount().");
+        }
+        return Filter2DProtectingReference<T>{ Filters[index], &WeightStamp };
+      }
+
+      template <typename T>
+      const Filter2D<T>& Layer2D<T>::GetDepthwiseFilter() const
+      {
+        if (IsDepthwiseSeparable() == false)
+        {
+          throw std::logic_error("cnn::engine::convolution::Layer2D::GetDepthwiseFilter() const, IsDepthwiseSeparable() == false.");
+        }
+        return DepthwiseFilter;
+      }
+
+      template <typename T>
+      Filter2DProtectingReference<T> Layer2D<T>::GetDepthwiseFilter()
+      {
+        if (IsDepthwiseSeparable() == false)
+        {
+          throw std::logic_error("cnn::engine::convolution::Layer2D::GetDepthwiseFilter(), IsDepthwiseSeparable() == false.");
+        }
+        return Filter2DProtectingReference<T>{ DepthwiseFilter, &WeightStamp };
+      }
+
+      template <typename T>
+      const Map2D<T>& Layer2D<T>::GetOutput(const size_t index) const
+      {
+        if (index >= Topology.GetOutputCount())
+        {
+          throw std::range_error("cnn::engine::convolution::Layer2D::GetOutput() const, index >= Topology.GetOutputCount().");
+        }
+        return Outputs[index];
+      }
+
+      template <typename T>
+      Map2DProtectingReference<T> Layer2D<T>::GetOutput(const size_t index)
+      {
+        if (index >= Topology.GetOutputCount())
+        {
+          throw std::range_error("cnn::engine::convolution::Layer2D::GetOutput(), index >= Topology.GetOutputCount().");
+        }
+        return Outputs[index];
+      }
+
+      template <typename T>
+      void Layer2D<T>::GenerateOutput()
+      {
+        if (IsDepthwiseSeparable())
+        {
+          GenerateSeparableOutput(0, Topology.GetOutputSize().GetHeight());
+          return;
+        }
+
+        PrepareSparseTaps();
+        if (IsPointwiseUsed())
+        {
+          PreparePointwiseWeights();
+          GeneratePointwiseOutput(0, Topology.GetFilterCount(), 0, Topology.GetOutputSize().GetHeight());
+          return;
+        }
+
+        const size_t tileSize = GetWinogradTileSize();
+        if (tileSize != 0)
+        {
+          PrepareCoreTiles(tileSize);
+          GenerateWinogradOutput(tileSize, 0, Topology.GetOutputSize().GetHeight());
+          return;
+        }
+
+        if (IsFourierUsed())
+        {
+          GenerateOutputByFourier();
+          return;
+        }
+
+        for (size_t f = 0; f < Topology.GetFilterCount(); ++f)
+        {
+          GenerateOutput(f, 0, Topology.GetOutputSize().GetHeight());
+        }
+      }
+
+      template <typename T>
+      void Layer2D<T>::GenerateOutput(common::ThreadPool& threadPool)
+      {
+        const size_t threadCount = threadPool.GetThreadCount();
+        if ((threadCount == 1) || (GetWork() < MIN_PARALLEL_WORK))
+        {
+          GenerateOutput();
+          return;
+        }
+
+        if (IsDepthwiseSeparable())
+        {
+          GenerateSeparableOutput(0, Topology.GetOutputSize().GetHeight(), threadPool);
+          return;
+        }
+
+        PrepareSparseTaps();
+        if (IsPointwiseUsed())
+        {
+          GeneratePointwiseOutput(0, Topology.GetOutputSize().GetHeight(), threadPool);
+          return;
+        }
+
+        const size_t tileSize = GetWinogradTileSize();
+        if (tileSize != 0)
+        {
+          // Input tiles are shared by all filters, so the work is split only into blocks of rows of tiles.
+          PrepareCoreTiles(tileSize);
+          const size_t outputHeight = Topology.GetOutputSize().GetHeight();
+          const size_t tileRowCount = (outputHeight + tileSize - 1) / tileSize;
+          const size_t blockHeight = (tileRowCount + 2 * threadCount - 1) / (2 * threadCount) * tileSize;
+          const size_t blockCount = (outputHeight + blockHeight - 1) / blockHeight;
+          auto tileTask = [this, tileSize, blockHeight, outputHeight](const size_t taskIndex)
+          {
+            const size_t beginY = taskIndex * blockHeight;
+            GenerateWinogradOutput(tileSize, beginY, std::min(beginY + blockHeight, outputHeight));
+          };
+          threadPool.ParallelFor(blockCount, tileTask);
+          return;
+        }
+
+        if (IsFourierUsed())
+        {
+          PrepareCoreSpectra();
+          auto inputTask = [this](const size_t taskIndex)
+          {
+            GenerateInputSpectrum(taskIndex);
+          };
+          threadPool.ParallelFor(Topology.GetInputCount(), inputTask);
+          auto outputTask = [this](const size_t taskIndex)
+          {
+            GenerateFourierOutput(taskIndex);
+          };
+          threadPool.ParallelFor((Topology.GetFilterCount() + 1) / 2, outputTask);
+          return;
+        }
+
+        // We want about two tasks per thread, so every filter is split into blocks of rows.
+        const size_t filterCount = Topology.GetFilterCount();
+        const size_t outputHeight = Topology.GetOutputSize().GetHeight();
+        const size_t desiredBlockCount = std::min((2 * threadCount + filterCount - 1) / filterCount, outputHeight);
+        const size_t blockHeight = (outputHeight + desiredBlockCount - 1) / desiredBlockCount;
+        const size_t blockCount = (outputHeight + blockHeight - 1) / blockHeight;
+
+        auto task = [this, blockCount, blockHeight, outputHeight](const size_t taskIndex)
+        {
+          const size_t filterIndex = taskIndex / blockCount;
+          const size_t beginY = (taskIndex % blockCount) * blockHeight;
+          const size_t endY = std::min(beginY + blockHeight, outputHeight);
+          GenerateOutput(filterIndex, beginY, endY);
+        };
+        threadPool.ParallelFor(filterCount * blockCount, task);
+      }
+
+      template <typename T>
+      void Layer2D<T>::GenerateOutputByFourier()
+      {
+        if (IsDepthwiseSeparable())
+        {
+          throw std::logic_error("cnn::engine::convolution::Layer2D::GenerateOutputByFourier(), IsDepthwiseSeparable() == true.");
+        }
+
+        PrepareCoreSpectra();
+        for (size_t i = 0; i < Topology.GetInputCount(); ++i)
+        {
+          GenerateInputSpectrum(i);
+        }
+        for (size_t p = 0; p < (Topology.GetFilterCount() + 1) / 2; ++p)
+        {
+          GenerateFourierOutput(p);
+        }
+      }
+
+      template <typename T>
+      void Layer2D<T>::GenerateOutputRows(const size_t beginY, const size_t endY)
+      {
+        if ((beginY > endY) || (endY > Topology.GetOutputSize().GetHeight()))
+        {
+          throw std::range_error("cnn::engine::convolution::Layer2D::GenerateOutputRows(), [beginY, endY) is out of the output.");
+        }
+
+        if (IsDepthwiseSeparable())
+        {
+          GenerateSeparableOutput(beginY, endY);
+          return;
+        }
+
+        PrepareSparseTaps();
+        if (IsPointwiseUsed())
+        {
+          PreparePointwiseWeights();
+          GeneratePointwiseOutput(0, Topology.GetFilterCount(), beginY, endY);
+          return;
+        }
+
+        const size_t tileSize = GetWinogradTileSize();
+        if (tileSize != 0)
+        {
+          PrepareCoreTiles(tileSize);
+          GenerateWinogradOutput(tileSize, beginY, endY);
+          return;
+        }
+
+        for (size_t f = 0; f < Topology.GetFilterCount(); ++f)
+        {
+          GenerateOutput(f, beginY, endY);
+        }
+      }
+
+      template <typename T>
+      void Layer2D<T>::GenerateOutputRows(const size_t beginY, const size_t endY, common::ThreadPool& threadPool)
+      {
+        if ((beginY > endY) || (endY > Topology.GetOutputSize().GetHeight()))
+        {
+          throw std::range_error("cnn::engine::convolution::Layer2D::GenerateOutputRows(), [beginY, endY) is out of the output.");
+        }
+
+        const size_t threadCount = threadPool.GetThreadCount();
+        const size_t rowWork = GetWork() / Topology.GetOutputSize().GetHeight();
+        if ((threadCount == 1) || (rowWork * (endY - beginY) < MIN_PARALLEL_WORK))
+        {
+          GenerateOutputRows(beginY, endY);
+          return;
+        }
+
+        if (IsDepthwiseSeparable())
+        {
+          GenerateSeparableOutput(beginY, endY, threadPool);
+          return;
+        }
+
+        PrepareSparseTaps();
+        if (IsPointwiseUsed())
+        {
+          GeneratePointwiseOutput(beginY, endY, threadPool);
+          return;
+        }
+
+        const size_t tileSize = GetWinogradTileSize();
+        if (tileSize != 0)
+        {
+          // Input tiles are shared by all filters, so the rows are split into blocks of whole tiles.
+          PrepareCoreTiles(tileSize);
+          const size_t tileRowCount = (endY - beginY + tileSize - 1) / tileSize;
+          const size_t blockHeight = (tileRowCount + threadCount - 1) / threadCount * tileSize;
+          const size_t blockCount = (endY - beginY + blockHeight - 1) / blockHeight;
+          auto tileTask = [this, tileSize, blockHeight, beginY, endY](const size_t taskIndex)
+          {
+            const size_t blockBeginY = beginY + taskIndex * blockHeight;
+            GenerateWinogradOutput(tileSize, blockBeginY, std::min(blockBeginY + blockHeight, endY));
+          };
+          threadPool.ParallelFor(blockCount, tileTask);
+          return;
+        }
+
+        auto task = [this, beginY, endY](const size_t taskIndex)
+        {
+          GenerateOutput(taskIndex, beginY, endY);
+        };
+        threadPool.ParallelFor(Topology.GetFilterCount(), task);
+      }
+
+      template <typename T>
+      void Layer2D<T>::GenerateOutput(const size_t filterIndex, const size_t beginY, const size_t endY)
+      {
+        if (Sparse)
+        {
+          GenerateSparseOutput(filterIndex, beginY, endY);
+          return;
+        }
+
+        const size_t coreWidth = Topology.GetFilterTopology().GetSize().GetWidth();
+        const size_t coreHeight = Topology.GetFilterTopology().GetSize().GetHeight();
+        const size_t coreCount = Topology.GetFilterTopology().GetCoreCount();
+        const size_t dilation = Topology.GetFilterTopology().GetDilation();
+        const size_t outputWidth = Topology.GetOutputSize().GetWidth();
+
+        const auto& filter = Filters[filterIndex];
+        T* const output = Outputs[filterIndex].GetValues();
+        const size_t outputStride = Outputs[filterIndex].GetStride();
+
+        // The output row accumulates all cores of the filter, so the inner loop is contiguous for both maps.
+        // Rows start at cache line boundaries, and the padding of output rows isn't written, so it stays zero.
+        for (size_t oy = beginY; oy < endY; ++oy)
+        {
+          T* const outputRow = output + oy * outputStride;
+          for (size_t ox = 0; ox < outputWidth; ++ox)
+          {
+            outputRow[ox] = static_cast<T>(0.L);
+          }
+
+          for (size_t c = 0; c < coreCount; ++c)
+          {
+            const T* const input = Inputs[c].GetValues();
+            const size_t inputStride = Inputs[c].GetStride();
+            const T* const weights = filter.GetConstCore(c).GetWeights();
+            for (size_t cy = 0; cy < coreHeight; ++cy)
+            {
+              const T* const inputRow = input + (oy + cy * dilation) * inputStride;
+              for (size_t cx = 0; cx < coreWidth; ++cx)
+              {
+                const T weight = weights[cx + cy * coreWidth];
+                const T* const shiftedInputRow = inputRow + cx * dilation;
+                for (size_t ox = 0; ox < outputWidth; ++ox)
+                {
+                  outputRow[ox] += weight * shiftedInputRow[ox];
+                }
+              }
+            }
+          }
+
+          common::Activation::Activate(Topology.GetActivationType(), outputRow, outputWidth);
+        }
+      }
+
+      template <typename T>
+      bool Layer2D<T>::IsSparse() const noexcept
+      {
+        return Sparse;
+      }
+
+      template <typename T>
+      void Layer2D<T>::SetSparse(const bool sparse) noexcept
+      {
+        Sparse = sparse && (IsDepthwiseSeparable() == false);
+      }
+
+      template <typename T>
+      bool Layer2D<T>::IsSparseFaster() const noexcept
+      {
+        if (IsDepthwiseSeparable())
+        {
+          return false;
+        }
+
+        const size_t coreArea = Topology.GetFilterTopology().GetSize().GetArea();
+        const size_t coreCount = Topology.GetFilterTopology().GetCoreCount();
+        const size_t filterCount = Topology.GetFilterCount();
+
+        size_t nonzeroCount{};
+        for (size_t f = 0; f < filterCount; ++f)
+        {
+          for (size_t c = 0; c < coreCount; ++c)
+          {
+            const T* const weights = Filters[f].GetConstCore(c).GetWeights();
+            nonzeroCount += static_cast<size_t>(std::count_if(weights, weights + coreArea, [](const T weight) { return weight != 0; }));
+          }
+        }
+        return nonzeroCount * MIN_SPARSE_RATIO <= filterCount * coreCount * coreArea;
+      }
+
+      template <typename T>
+      void Layer2D<T>::PrepareSparseTaps()
+      {
+        if ((Sparse == false) || (SparseTapsStamp == WeightStamp))
+        {
+          return;
+        }
+
+        const size_t coreWidth = Topology.GetFilterTopology().GetSize().GetWidth();
+        const size_t coreArea = Topology.GetFilterTopology().GetSize().GetArea();
+        const size_t coreCount = Topology.GetFilterTopology().GetCoreCount();
+        const size_t dilation = Topology.GetFilterTopology().GetDilation();
+        const size_t filterCount = Topology.GetFilterCount();
+
+        size_t nonzeroCount{};
+        for (size_t f = 0; f < filterCount; ++f)
+        {
+          for (size_t c = 0; c < coreCount; ++c)
+          {
+            const T* const weights = Filters[f].GetConstCore(c).GetWeights();
+            nonzeroCount += static_cast<size_t>(std::count_if(weights, weights + coreArea, [](const T weight) { return weight != 0; }));
+          }
+        }
+
+        // The buffers only grow, so they aren't reallocated, when mutations change the count a little.
+        if (SparseWeights.GetCount() < nonzeroCount)
+        {
+          SparseWeights = common::AlignedBuffer<T>{ nonzeroCount, GetResource() };
+          SparseTaps = common::AlignedBuffer<uint32_t>{ nonzeroCount * 3, GetResource() };
+        }
+        if (TapOffsets.GetCount() != filterCount + 1)
+        {
+          TapOffsets = common::AlignedBuffer<size_t>{ filterCount + 1, GetResource() };
+        }
+
+        size_t k{};
+        for (size_t f = 0; f < filterCount; ++f)
+        {
+          TapOffsets.GetData()[f] = k;
+          for (size_t c = 0; c < coreCount; ++c)
+          {
+            const T* const weights = Filters[f].GetConstCore(c).GetWeights();
+            for (size_t i = 0; i < coreArea; ++i)
+            {
+              if (weights[i] != 0)
+              {
+                SparseWeights.GetData()[k] = weights[i];
+                uint32_t* const tap = SparseTaps.GetData() + k * 3;
+                tap[0] = static_cast<uint32_t>(c);
+                tap[1] = static_cast<uint32_t>(i % coreWidth * dilation);
+                tap[2] = static_cast<uint32_t>(i / coreWidth * dilation);
+                ++k;
+              }
+            }
+          }
+        }
+        TapOffsets.GetData()[filterCount] = k;
+        SparseTapsStamp = WeightStamp;
+      }
+
+      template <typename T>
+      void Layer2D<T>::GenerateSparseOutput(const size_t filterIndex, const size_t beginY, const size_t endY) noexcept
+      {
+        const size_t outputWidth = Topology.GetOutputSize().GetWidth();
+        T* const output = Outputs[filterIndex].GetValues();
+        const size_t outputStride = Outputs[filterIndex].GetStride();
+        const size_t beginTap = TapOffsets.GetData()[filterIndex];
+        const size_t endTap = TapOffsets.GetData()[filterIndex + 1];
+
+        // It is the direct kernel, which skips zero weights, so every tap is an axpy of a shifted input row.
+        for (size_t oy = beginY; oy < endY; ++oy)
+        {
+          T* const outputRow = output + oy * outputStride;
+          for (size_t ox = 0; ox < outputWidth; ++ox)
+          {
+            outputRow[ox] = static_cast<T>(0.L);
+          }
+
+          for (size_t k = beginTap; k < endTap; ++k)
+          {
+            const uint32_t* const tap = SparseTaps.GetData() + k * 3;
+            const T weight = SparseWeights.GetData()[k];
+            const T* const shiftedInputRow = Inputs[tap[0]].GetValues() + (oy + tap[2]) * Inputs[tap[0]].GetStride() + tap[1];
+            for (size_t ox = 0; ox < outputWidth; ++ox)
+            {
+              outputRow[ox] += weight * shiftedInputRow[ox];
+            }
+          }
+
+          common::Activation::Activate(Topology.GetActivationType(), outputRow, outputWidth);
+        }
+      }
+
+      template <typename T>
+      void Layer2D<T>::GenerateSeparableOutput(const size_t beginY, const size_t endY)
+      {
+        PreparePointwiseWeights();
+        for (size_t i = 0; i < Topology.GetInputCount(); ++i)
+        {
+          GenerateDepthwiseOutput(i, beginY, endY);
+        }
+        GeneratePointwiseOutput(0, Topology.GetFilterCount(), beginY, endY);
+      }
+
+      template <typename T>
+      void Layer2D<T>::GenerateSeparableOutput(const size_t beginY, const size_t endY, common::ThreadPool& threadPool)
+      {
+        // Every filter reads the depthwise outputs of all inputs, so the stages are separated by the join.
+        auto depthwiseTask = [this, beginY, endY](const size_t taskIndex)
+        {
+          GenerateDepthwiseOutput(taskIndex, beginY, endY);
+        };
+        threadPool.ParallelFor(Topology.GetInputCount(), depthwiseTask);
+        GeneratePointwiseOutput(beginY, endY, threadPool);
+      }
+
+      template <typename T>
+      void Layer2D<T>::GenerateDepthwiseOutput(const size_t inputIndex, const size_t beginY, const size_t endY) noexcept
+      {
+        const size_t coreWidth = Topology.GetFilterTopology().GetSize().GetWidth();
+        const size_t coreHeight = Topology.GetFilterTopology().GetSize().GetHeight();
+        const size_t dilation = Topology.GetFilterTopology().GetDilation();
+        const size_t outputWidth = Topology.GetOutputSize().GetWidth();
+        const size_t depthwiseStride = GetDepthwiseStride();
+
+        const T* const input = Inputs[inputIndex].GetValues();
+        const size_t inputStride = Inputs[inputIndex].GetStride();
+        const T* const weights = DepthwiseFilter.GetConstCore(inputIndex).GetWeights();
+        T* const output = DepthwiseOutputs.GetData() + inputIndex * Topology.GetOutputSize().GetHeight() * depthwiseStride;
+
+        for (size_t oy = beginY; oy < endY; ++oy)
+        {
+          T* const outputRow = output + oy * depthwiseStride;
+          for (size_t ox = 0; ox < outputWidth; ++ox)
+          {
+            outputRow[ox] = static_cast<T>(0.L);
+          }
+          for (size_t cy = 0; cy < coreHeight; ++cy)
+          {
+            const T* const inputRow = input + (oy + cy * dilation) * inputStride;
+            for (size_t cx = 0; cx < coreWidth; ++cx)
+            {
+              const T weight = weights[cx + cy * coreWidth];
+              const T* const shiftedInputRow = inputRow + cx * dilation;
+              for (size_t ox = 0; ox < outputWidth; ++ox)
+              {
+                outputRow[ox] += weight * shiftedInputRow[ox];
+              }
+            }
+          }
+        }
+      }
+
+      template <typename T>
+      bool Layer2D<T>::IsPointwiseUsed() const noexcept
+      {
+        const Size2D& coreSize = Topology.GetFilterTopology().GetSize();
+        return (Sparse == false) && (coreSize.GetWidth() == 1) && (coreSize.GetHeight() == 1);
+      }
+
+      template <typename T>
+      void Layer2D<T>::PreparePointwiseWeights()
+      {
+        if (PointwiseWeightsStamp == WeightStamp)
+        {
+          return;
+        }
+
+        const size_t inputCount = Topology.GetInputCount();
+        const size_t filterCount = Topology.GetFilterCount();
+        if (PointwiseWeights.GetCount() != filterCount * inputCount)
+        {
+          PointwiseWeights = common::AlignedBuffer<T>{ filterCount * inputCount, GetResource() };
+        }
+        for (size_t f = 0; f < filterCount; ++f)
+        {
+          for (size_t i = 0; i < inputCount; ++i)
+          {
+            PointwiseWeights.GetData()[f * inputCount + i] = Filters[f].GetConstCore(i).GetWeights()[0];
+          }
+        }
+        PointwiseWeightsStamp = WeightStamp;
+      }
+
+      template <typename T>
+      const T* Layer2D<T>::GetPointwiseInputRow(const size_t inputIndex, const size_t y) const noexcept
+      {
+        if (IsDepthwiseSeparable())
+        {
+          return DepthwiseOutputs.GetData() + (inputIndex * Topology.GetOutputSize().GetHeight() + y) * GetDepthwiseStride();
+        }
+        return Inputs[inputIndex].GetValues() + y * Inputs[inputIndex].GetStride();
+      }
+
+      template <typename T>
+      void Layer2D<T>::GeneratePointwiseOutput(const size_t beginFilter, const size_t endFilter, const size_t beginY, const size_t endY) noexcept
+      {
+        const size_t inputCount = Topology.GetInputCount();
+        const size_t outputWidth = Topology.GetOutputSize().GetWidth();
+
+        // Every input row is read once per block of filters, and the output rows of the block stay in the cache.
+        for (size_t oy = beginY; oy < endY; ++oy)
+        {
+          for (size_t f0 = beginFilter; f0 < endFilter; f0 += POINTWISE_FILTER_COUNT)
+          {
+            const size_t blockFilterCount = std::min(POINTWISE_FILTER_COUNT, endFilter - f0);
+            T* outputRows[POINTWISE_FILTER_COUNT];
+            const T* weights[POINTWISE_FILTER_COUNT];
+            for (size_t k = 0; k < blockFilterCount; ++k)
+            {
+              outputRows[k] = Outputs[f0 + k].GetValues() + oy * Outputs[f0 + k].GetStride();
+              weights[k] = PointwiseWeights.GetData() + (f0 + k) * inputCount;
+              for (size_t ox = 0; ox < outputWidth; ++ox)
+              {
+                outputRows[k][ox] = static_cast<T>(0.L);
+              }
+            }
+
+            for (size_t i = 0; i < inputCount; ++i)
+            {
+              const T* const inputRow = GetPointwiseInputRow(i, oy);
+              if (blockFilterCount == POINTWISE_FILTER_COUNT)
+              {
+                T* const outputRow0 = outputRows[0];
+                T* const outputRow1 = outputRows[1];
+                T* const outputRow2 = outputRows[2];
+                T* const outputRow3 = outputRows[3];
+                const T weight0 = weights[0][i];
+                const T weight1 = weights[1][i];
+                const T weight2 = weights[2][i];
+                const T weight3 = weights[3][i];
+                for (size_t ox = 0; ox < outputWidth; ++ox)
+                {
+                  const T value = inputRow[ox];
+                  outputRow0[ox] += weight0 * value;
+                  outputRow1[ox] += weight1 * value;
+                  outputRow2[ox] += weight2 * value;
+                  outputRow3[ox] += weight3 * value;
+                }
+              }
+              else
+              {
+                for (size_t k = 0; k < blockFilterCount; ++k)
+                {
+                  const T weight = weights[k][i];
+                  for (size_t ox = 0; ox < outputWidth; ++ox)
+                  {
+                    outputRows[k][ox] += weight * inputRow[ox];
+                  }
+                }
+              }
+            }
+
+            for (size_t k = 0; k < blockFilterCount; ++k)
+            {
+              common::Activation::Activate(Topology.GetActivationType(), outputRows[k], outputWidth);
+            }
+          }
+        }
+      }
+
+      template <typename T>
+      void Layer2D<T>::GeneratePointwiseOutput(const size_t beginY, const size_t endY, common::ThreadPool& threadPool)
+      {
+        PreparePointwiseWeights();
+
+        // We want about two tasks per thread, so every block of filters is split into blocks of rows.
+        const size_t threadCount = threadPool.GetThreadCount();
+        const size_t filterCount = Topology.GetFilterCount();
+        const size_t filterBlockCount = (filterCount + POINTWISE_FILTER_COUNT - 1) / POINTWISE_FILTER_COUNT;
+        const size_t rowCount = endY - beginY;
+        const size_t desiredBlockCount = std::max(std::min((2 * threadCount + filterBlockCount - 1) / filterBlockCount, rowCount), size_t{ 1 });
+        const size_t blockHeight = std::max((rowCount + desiredBlockCount - 1) / desiredBlockCount, size_t{ 1 });
+        const size_t blockCount = (rowCount + blockHeight - 1) / blockHeight;
+
+        auto task = [this, filterCount, blockCount, blockHeight, beginY, endY](const size_t taskIndex)
+        {
+          const size_t beginFilter = taskIndex / blockCount * POINTWISE_FILTER_COUNT;
+          const size_t blockBeginY = beginY + (taskIndex % blockCount) * blockHeight;
+          GeneratePointwiseOutput(beginFilter, std::min(beginFilter + POINTWISE_FILTER_COUNT, filterCount),
+                                  blockBeginY, std::min(blockBeginY + blockHeight, endY));
+        };
+        threadPool.ParallelFor(filterBlockCount * blockCount, task);
+      }
+
+      template <typename T>
+      size_t Layer2D<T>::GetWinogradTileSize() const noexcept
+      {
+        const Size2D& coreSize = Topology.GetFilterTopology().GetSize();
+        if ((Sparse) || (coreSize.GetWidth() != 3) || (coreSize.GetHeight() != 3) || (Topology.GetFilterTopology().GetDilation() != 1))
+        {
+          return 0;
+        }
+        const size_t outputSize = std::min(Topology.GetOutputSize().GetWidth(), Topology.GetOutputSize().GetHeight());
+        if (outputSize >= MIN_WINOGRAD_4_OUTPUT_SIZE)
+        {
+          return 4;
+        }
+        if (outputSize >= MIN_WINOGRAD_2_OUTPUT_SIZE)
+        {
+          return 2;
+        }
+        return 0;
+      }
+
+      template <typename T>
+      void Layer2D<T>::PrepareCoreTiles(const size_t tileSize)
+      {
+        if (tileSize == 4)
+        {
+          PrepareCoreTiles<4>();
+        }
+        else
+        {
+          PrepareCoreTiles<2>();
+        }
+      }
+
+      template <typename T>
+      template <size_t OUTPUT_TILE_SIZE>
+      void Layer2D<T>::PrepareCoreTiles()
+      {
+        if (CoreTransformsStamp == WeightStamp)
+        {
+          return;
+        }
+
+        using Winograd = Winograd2D<T, OUTPUT_TILE_SIZE>;
+        const size_t coreCount = Topology.GetFilterTopology().GetCoreCount();
+        const size_t tileCount = Topology.GetFilterCount() * coreCount;
+        if (CoreTiles.GetCount() != tileCount * Winograd::TILE_AREA)
+        {
+          CoreTiles = common::AlignedBuffer<T>{ tileCount * Winograd::TILE_AREA, GetResource() };
+        }
+
+        for (size_t f = 0; f < Topology.GetFilterCount(); ++f)
+        {
+          for (size_t c = 0; c < coreCount; ++c)
+          {
+            T* const tile = CoreTiles.GetData() + (f * coreCount + c) * Winograd::TILE_AREA;
+            Winograd::TransformCore(Filters[f].GetConstCore(c).GetWeights(), tile);
+          }
+        }
+        CoreTransformsStamp = WeightStamp;
+      }
+
+      template <typename T>
+      void Layer2D<T>::GenerateWinogradOutput(const size_t tileSize, const size_t beginY, const size_t endY)
+      {
+        if (tileSize == 4)
+        {
+          GenerateWinogradOutput<4>(beginY, endY);
+        }
+        else
+        {
+          GenerateWinogradOutput<2>(beginY, endY);
+        }
+      }
+
+      template <typename T>
+      template <size_t OUTPUT_TILE_SIZE>
+      void Layer2D<T>::GenerateWinogradOutput(const size_t beginY, const size_t endY)
+      {
+        using Winograd = Winograd2D<T, OUTPUT_TILE_SIZE>;
+        constexpr size_t inputTileSize = Winograd::INPUT_TILE_SIZE;
+        constexpr size_t tileArea = Winograd::TILE_AREA;
+
+        const size_t inputWidth = Topology.GetInputSize().GetWidth();
+        const size_t inputHeight = Topology.GetInputSize().GetHeight();
+        const size_t outputWidth = Topology.GetOutputSize().GetWidth();
+        const size_t coreCount = Topology.GetFilterTopology().GetCoreCount();
+
+        // Input tiles of all cores are transformed once and used by all filters.
+        // The tiles are reused by the thread, so the layer doesn't allocate memory for every sample.
+        thread_local std::vector<T> inputTiles;
+        inputTiles.resize(coreCount * tileArea);
+        T products[tileArea];
+        T outputs[OUTPUT_TILE_SIZE * OUTPUT_TILE_SIZE];
+
+        for (size_t y0 = beginY; y0 < endY; y0 += OUTPUT_TILE_SIZE)
+        {
+          const size_t rowCount = std::min(OUTPUT_TILE_SIZE, endY - y0);
+          // Input rows past the band may be stale for GenerateOutputRows(), and transforms mix them into the valid outputs,
+          // so they are completed by zeros as well.
+          const size_t endInputY = std::min(inputHeight, y0 + rowCount + inputTileSize - OUTPUT_TILE_SIZE);
+          for (size_t x0 = 0; x0 < outputWidth; x0 += OUTPUT_TILE_SIZE)
+          {
+            const size_t columnCount = std::min(OUTPUT_TILE_SIZE, outputWidth - x0);
+
+            for (size_t c = 0; c < coreCount; ++c)
+            {
+              T* const tile = inputTiles.data() + c * tileArea;
+              const T* const input = Inputs[c].GetValues();
+              const size_t inputStride = Inputs[c].GetStride();
+              // Tiles on the right and bottom edges and partial tiles of the band are completed by zeros, which don't affect the valid outputs.
+              for (size_t ty = 0; ty < inputTileSize; ++ty)
+              {
+                for (size_t tx = 0; tx < inputTileSize; ++tx)
+                {
+                  const size_t x = x0 + tx;
+                  const size_t y = y0 + ty;
+                  tile[tx + ty * inputTileSize] = ((x < inputWidth) && (y < endInputY)) ? input[x + y * inputStride] : static_cast<T>(0.L);
+                }
+              }
+              Winograd::TransformInput(tile);
+            }
+
+            for (size_t f = 0; f < Topology.GetFilterCount(); ++f)
+            {
+              const T* const coreTiles = CoreTiles.GetData() + f * coreCount * tileArea;
+              for (size_t i = 0; i < tileArea; ++i)
+              {
+                products[i] = static_cast<T>(0.L);
+              }
+              for (size_t c = 0; c < coreCount; ++c)
+              {
+                const T* const coreTile = coreTiles + c * tileArea;
+                const T* const inputTile = inputTiles.data() + c * tileArea;
+                for (size_t i = 0; i < tileArea; ++i)
+                {
+                  products[i] += coreTile[i] * inputTile[i];
+                }
+              }
+              Winograd::TransformOutput(products, outputs);
+
+              T* const output = Outputs[f].GetValues();
+              const size_t outputStride = Outputs[f].GetStride();
+              for (size_t oy = 0; oy < rowCount; ++oy)
+              {
+                for (size_t ox = 0; ox < columnCount; ++ox)
+                {
+                  output[x0 + ox + (y0 + oy) * outputStride] = outputs[ox + oy * OUTPUT_TILE_SIZE];
+                }
+              }
+            }
+          }
+
+          // The rows of the tiles are complete, and they are still in the cache.
+          for (size_t f = 0; f < Topology.GetFilterCount(); ++f)
+          {
+            for (size_t oy = y0; oy < y0 + rowCount; ++oy)
+            {
+              common::Activation::Activate(Topology.GetActivationType(), Outputs[f].GetValues() + oy * Outputs[f].GetStride(), outputWidth);
+            }
+          }
+        }
+      }
+
+      template <typename T>
+      bool Layer2D<T>::IsFourierUsed() const noexcept
+      {
+        if ((Sparse) || (IsPointwiseUsed()))
+        {
+          return false;
+        }
+        const size_t area = Fourier2D<T>::GetTransformSize(Topology.GetInputSize()).GetArea();
+        size_t levelCount = 0;
+        while ((size_t{ 1 } << levelCount) < area)
+        {
+          ++levelCount;
+        }
+        const size_t transformCount = Topology.GetInputCount() + (Topology.GetFilterCount() + 1) / 2;
+        const size_t work = transformCount * area / 2 * levelCount * FOURIER_BUTTERFLY_WORK +
+                            Topology.GetFilterCount() * Topology.GetFilterTopology().GetCoreCount() * area * FOURIER_PRODUCT_WORK;
+        return work < GetWork();
+      }
+
+      template <typename T>
+      void Layer2D<T>::PrepareCoreSpectra()
+      {
+        if (CoreTransformsStamp == WeightStamp)
+        {
+          return;
+        }
+
+        const Size2D transformSize = Fourier2D<T>::GetTransformSize(Topology.GetInputSize());
+        const size_t area = transformSize.GetArea();
+        const size_t coreCount = Topology.GetFilterTopology().GetCoreCount();
+        if (Fourier.GetSize() != transformSize)
+        {
+          Fourier = Fourier2D<T>{ transformSize, GetResource() };
+        }
+        if (CoreSpectra.GetCount() != Topology.GetFilterCount() * coreCount * 2 * area)
+        {
+          CoreSpectra = common::AlignedBuffer<T>{ Topology.GetFilterCount() * coreCount * 2 * area, GetResource() };
+        }
+        if (InputSpectra.GetCount() != Topology.GetInputCount() * 2 * area)
+        {
+          InputSpectra = common::AlignedBuffer<T>{ Topology.GetInputCount() * 2 * area, GetResource() };
+        }
+
+        const size_t coreWidth = Topology.GetFilterTopology().GetSize().GetWidth();
+        const size_t coreHeight = Topology.GetFilterTopology().GetSize().GetHeight();
+        const size_t dilation = Topology.GetFilterTopology().GetDilation();
+        const T scale = static_cast<T>(1.L / area);
+        for (size_t f = 0; f < Topology.GetFilterCount(); ++f)
+        {
+          for (size_t c = 0; c < coreCount; ++c)
+          {
+            T* const real = CoreSpectra.GetData() + (f * coreCount + c) * 2 * area;
+            T* const imaginary = real + area;
+            std::fill(real, real + 2 * area, static_cast<T>(0.L));
+            const T* const weights = Filters[f].GetConstCore(c).GetWeights();
+            for (size_t cy = 0; cy < coreHeight; ++cy)
+            {
+              for (size_t cx = 0; cx < coreWidth; ++cx)
+              {
+                real[(cx + cy * transformSize.GetWidth()) * dilation] = weights[cx + cy * coreWidth] * scale;
+              }
+            }
+            // A dilated core is spread in the transform, so the spectra cost the same for any dilation.
+            Fourier.Transform(real, imaginary, Topology.GetFilterTopology().GetDilatedSize().GetHeight());
+            // The product with the conjugated spectrum of the core is the spectrum of the correlation.
+            for (size_t i = 0; i < area; ++i)
+            {
+              imaginary[i] = -imaginary[i];
+            }
+          }
+        }
+        CoreTransformsStamp = WeightStamp;
+      }
+
+      template <typename T>
+      void Layer2D<T>::GenerateInputSpectrum(const size_t inputIndex)
+      {
+        const size_t transformWidth = Fourier.GetSize().GetWidth();
+        const size_t area = Fourier.GetSize().GetArea();
+        const size_t inputWidth = Topology.GetInputSize().GetWidth();
+        const size_t inputHeight = Topology.GetInputSize().GetHeight();
+
+        T* const real = InputSpectra.GetData() + inputIndex * 2 * area;
+        T* const imaginary = real + area;
+        std::fill(real, real + 2 * area, static_cast<T>(0.L));
+        const T* const input = Inputs[inputIndex].GetValues();
+        const size_t inputStride = Inputs[inputIndex].GetStride();
+        for (size_t y = 0; y < inputHeight; ++y)
+        {
+          std::copy(input + y * inputStride, input + y * inputStride + inputWidth, real + y * transformWidth);
+        }
+        // The input is smaller than the transform, so the correlation doesn't wrap around for valid outputs.
+        Fourier.Transform(real, imaginary, inputHeight);
+      }
+
+      template <typename T>
+      void Layer2D<T>::GenerateFourierOutput(const size_t pairIndex)
+      {
+        const size_t transformWidth = Fourier.GetSize().GetWidth();
+        const size_t area = Fourier.GetSize().GetArea();
+        const size_t coreCount = Topology.GetFilterTopology().GetCoreCount();
+        const size_t outputWidth = Topology.GetOutputSize().GetWidth();
+        const size_t outputHeight = Topology.GetOutputSize().GetHeight();
+        const size_t firstFilter = 2 * pairIndex;
+        const bool isPair = firstFilter + 1 < Topology.GetFilterCount();
+
+        // The spectrum is reused by the thread, so the layer doesn't allocate memory for every sample.
+        thread_local std::vector<T> spectrum;
+        spectrum.assign(2 * area, static_cast<T>(0.L));
+        T* const real = spectrum.data();
+        T* const imaginary = real + area;
+
+        for (size_t c = 0; c < coreCount; ++c)
         {
-          Inputs[i].SetSize(Topology.GetInputSize());
+          const T* const inputReal = InputSpectra.GetData() + c * 2 * area;
+          const T* const inputImaginary = inputReal + area;
+          const T* const firstReal = CoreSpectra.GetData() + (firstFilter * coreCount + c) * 2 * area;
+          const T* const firstImaginary = firstReal + area;
+          for (size_t i = 0; i < area; ++i)
+          {
+            real[i] += inputReal[i] * firstReal[i] - inputImaginary[i] * firstImaginary[i];
+            imaginary[i] += inputReal[i] * firstImaginary[i] + inputImaginary[i] * firstReal[i];
+          }
+          if (isPair)
+          {
+            // The spectrum of the second filter is multiplied by i.
+            const T* const secondReal = firstReal + coreCount * 2 * area;
+            const T* const secondImaginary = secondReal + area;
+            for (size_t i = 0; i < area; ++i)
+            {
+              real[i] -= inputReal[i] * secondImaginary[i] + inputImaginary[i] * secondReal[i];
+              imaginary[i] += inputReal[i] * secondReal[i] - inputImaginary[i] * secondImaginary[i];
+            }
+          }
         }
 
-        Filters = std::make_unique<Filter2D<T>[]>(Topology.GetFilterCount());
-        for (size_t i = 0; i < Topology.GetFilterCount(); ++i)
+        Fourier.InverseTransform(real, imaginary, outputHeight);
+
+        T* const firstOutput = Outputs[firstFilter].GetValues();
+        const size_t outputStride = Outputs[firstFilter].GetStride();
+        for (size_t oy = 0; oy < outputHeight; ++oy)
         {
-          Filters[i].SetTopology(Topology.GetFilterTopology());
+          std::copy(real + oy * transformWidth, real + oy * transformWidth + outputWidth, firstOutput + oy * outputStride);
+          common::Activation::Activate(Topology.GetActivationType(), firstOutput + oy * outputStride, outputWidth);
         }
-
-        Outputs = std::make_unique<Map2D<T>[]>(Topology.GetOutputCount());
-        for (size_t i = 0; i < Topology.GetOutputCount(); ++i)
+        if (isPair)
         {
-          Outputs[i].SetSize(Topology.GetOutputSize());
+          T* const secondOutput = Outputs[firstFilter + 1].GetValues();
+          for (size_t oy = 0; oy < outputHeight; ++oy)
+          {
+            std::copy(imaginary + oy * transformWidth, imaginary + oy * transformWidth + outputWidth, secondOutput + oy * outputStride);
+            common::Activation::Activate(Topology.GetActivationType(), secondOutput + oy * outputStride, outputWidth);
+          }
         }
       }
 
       template <typename T>
-      Layer2D<T>::Layer2D(const Layer2D& layer)
-        :
-        Topology{ layer.Topology }
+      void Layer2D<T>::GenerateOutputFromBinary(const uint64_t* const inputs)
       {
-        Inputs = std::make_unique<Map2D<T>[]>(Topology.GetInputCount());
-        for (size_t i = 0; i < Topology.GetInputCount(); ++i)
+        if (IsDepthwiseSeparable())
         {
-          Inputs[i] = layer.Inputs[i];
+          PreparePointwiseWeights();
+          for (size_t i = 0; i < Topology.GetInputCount(); ++i)
+          {
+            GenerateDepthwiseOutputFromBinary(inputs, i);
+          }
+          GeneratePointwiseOutput(0, Topology.GetFilterCount(), 0, Topology.GetOutputSize().GetHeight());
+          return;
         }
 
-        Filters = std::make_unique<Filter2D<T>[]>(Topology.GetFilterCount());
-        for (size_t i = 0; i < Topology.GetFilterCount(); ++i)
+        const size_t coreWidth = Topology.GetFilterTopology().GetSize().GetWidth();
+        const size_t coreHeight = Topology.GetFilterTopology().GetSize().GetHeight();
+        const size_t coreCount = Topology.GetFilterTopology().GetCoreCount();
+
+        // The table is reused by the thread, so the layer doesn't allocate memory for every sample.
+        thread_local std::vector<T> table;
+        if (coreWidth <= MAX_TABLE_CORE_WIDTH)
         {
-          Filters[i] = layer.Filters[i];
+          table.resize((coreCount * coreHeight) << coreWidth);
         }
 
-        Outputs = std::make_unique<Map2D<T>[]>(Topology.GetOutputCount());
-        for (size_t i = 0; i < Topology.GetOutputCount(); ++i)
+        for (size_t f = 0; f < Topology.GetFilterCount(); ++f)
         {
-          Outputs[i] = layer.Outputs[i];
+          GenerateOutputFromBinary(inputs, f, table);
         }
       }
 
       template <typename T>
-      Layer2D<T>& Layer2D<T>::operator=(const Layer2D<T>& layer)
+      void Layer2D<T>::GenerateDepthwiseOutputFromBinary(const uint64_t* const inputs, const size_t inputIndex) noexcept
       {
-        if (this != &layer)
+        const size_t coreWidth = Topology.GetFilterTopology().GetSize().GetWidth();
+        const size_t coreHeight = Topology.GetFilterTopology().GetSize().GetHeight();
+        const size_t outputWidth = Topology.GetOutputSize().GetWidth();
+        const size_t dilation = Topology.GetFilterTopology().GetDilation();
+        const size_t outputHeight = Topology.GetOutputSize().GetHeight();
+        const size_t rowWordCount = common::BitPacking::GetWordCount(Topology.GetInputSize().GetWidth());
+        const size_t depthwiseStride = GetDepthwiseStride();
+
+        const uint64_t* const input = inputs + inputIndex * rowWordCount * Topology.GetInputSize().GetHeight();
+        const T* const weights = DepthwiseFilter.GetConstCore(inputIndex).GetWeights();
+        T* const output = DepthwiseOutputs.GetData() + inputIndex * outputHeight * depthwiseStride;
+
+        // Only the weights under set bits are added.
+        for (size_t oy = 0; oy < outputHeight; ++oy)
         {
-          Layer2D<T> tmpLayer{ layer };
-          // Beware, it is very intimate place for strong exception guarantee.
-          std::swap(*this, tmpLayer);
+          T* const outputRow = output + oy * depthwiseStride;
+          for (size_t ox = 0; ox < outputWidth; ++ox)
+          {
+            T sum{};
+            for (size_t cy = 0; cy < coreHeight; ++cy)
+            {
+              const uint64_t* const inputRow = input + (oy + cy * dilation) * rowWordCount;
+              for (size_t cx = 0; cx < coreWidth; ++cx)
+              {
+                if (common::BitPacking::GetBit(inputRow, ox + cx * dilation))
+                {
+                  sum += weights[cx + cy * coreWidth];
+                }
+              }
+            }
+            outputRow[ox] = sum;
+          }
         }
-        return *this;
       }
 
       template <typename T>
-      const Layer2DTopology& Layer2D<T>::GetTopology() const noexcept
+      void Layer2D<T>::GenerateOutputFromBinary(const uint64_t* const inputs, const size_t filterIndex, std::vector<T>& table)
       {
-        return Topology;
+        const size_t inputHeight = Topology.GetInputSize().GetHeight();
+        const size_t coreWidth = Topology.GetFilterTopology().GetSize().GetWidth();
+        const size_t coreHeight = Topology.GetFilterTopology().GetSize().GetHeight();
+        const size_t coreCount = Topology.GetFilterTopology().GetCoreCount();
+        const size_t dilation = Topology.GetFilterTopology().GetDilation();
+        const size_t outputWidth = Topology.GetOutputSize().GetWidth();
+        const size_t outputHeight = Topology.GetOutputSize().GetHeight();
+        const size_t rowWordCount = common::BitPacking::GetWordCount(Topology.GetInputSize().GetWidth());
+        const size_t inputWordCount = rowWordCount * inputHeight;
+
+        const auto& filter = Filters[filterIndex];
+        T* const output = Outputs[filterIndex].GetValues();
+        const size_t outputStride = Outputs[filterIndex].GetStride();
+
+        if (coreWidth <= MAX_TABLE_CORE_WIDTH)
+        {
+          // table[row][pattern] is the sum of the weights of the core row, which are selected by the bits of the pattern.
+          const size_t patternCount = size_t{ 1 } << coreWidth;
+          for (size_t c = 0; c < coreCount; ++c)
+          {
+            const T* const weights = filter.GetConstCore(c).GetWeights();
+            for (size_t cy = 0; cy < coreHeight; ++cy)
+            {
+              T* const rowTable = table.data() + (c * coreHeight + cy) * patternCount;
+              const T* const rowWeights = weights + cy * coreWidth;
+              rowTable[0] = static_cast<T>(0.L);
+              for (size_t pattern = 1; pattern < patternCount; ++pattern)
+              {
+                rowTable[pattern] = rowTable[pattern & (pattern - 1)] + rowWeights[common::BitPacking::CountTrailingZeros(pattern)];
+              }
+            }
+          }
+
+          for (size_t oy = 0; oy < outputHeight; ++oy)
+          {
+            for (size_t ox = 0; ox < outputWidth; ++ox)
+            {
+              T sum{};
+              for (size_t c = 0; c < coreCount; ++c)
+              {
+                const uint64_t* const input = inputs + c * inputWordCount + oy * rowWordCount;
+                const T* const coreTable = table.data() + c * coreHeight * patternCount;
+                for (size_t cy = 0; cy < coreHeight; ++cy)
+                {
+                  const uint64_t pattern = common::BitPacking::GetBits(input + cy * dilation * rowWordCount, ox, coreWidth, dilation);
+                  sum += coreTable[cy * patternCount + pattern];
+                }
+              }
+              output[ox + oy * outputStride] = sum;
+            }
+            common::Activation::Activate(Topology.GetActivationType(), output + oy * outputStride, outputWidth);
+          }
+        }
+        else
+        {
+          // Wide cores: only the weights under set bits are visited.
+          for (size_t oy = 0; oy < outputHeight; ++oy)
+          {
+            for (size_t ox = 0; ox < outputWidth; ++ox)
+            {
+              T sum{};
+              for (size_t c = 0; c < coreCount; ++c)
+              {
+                const uint64_t* const input = inputs + c * inputWordCount + oy * rowWordCount;
+                const T* const weights = filter.GetConstCore(c).GetWeights();
+                for (size_t cy = 0; cy < coreHeight; ++cy)
+                {
+                  const T* const rowWeights = weights + cy * coreWidth;
+                  for (size_t cx = 0; cx < coreWidth; cx += common::BitPacking::WORD_BIT_COUNT)
+                  {
+                    const size_t count = std::min(coreWidth - cx, common::BitPacking::WORD_BIT_COUNT);
+                    uint64_t bits = common::BitPacking::GetBits(input + cy * dilation * rowWordCount, ox + cx * dilation, count, dilation);
+                    while (bits != 0)
+                    {
+                      sum += rowWeights[cx + common::BitPacking::CountTrailingZeros(bits)];
+                      bits &= bits - 1;
+                    }
+                  }
+                }
+              }
+              output[ox + oy * outputStride] = sum;
+            }
+            common::Activation::Activate(Topology.GetActivationType(), output + oy * outputStride, outputWidth);
+          }
+        }
       }
 
       template <typename T>
-      void Layer2D<T>::SetTopology(const Layer2DTopology& topology)
+      size_t Layer2D<T>::GetWork() const noexcept
       {
-        Layer2D<T> tmpLayer{ topology };
-        // Beware, it is very intimate place for strong exception guarantee.
-        std::swap(*this, tmpLayer);
+        if (IsDepthwiseSeparable())
+        {
+          return Topology.GetInputCount() *
+                 (Topology.GetFilterTopology().GetSize().GetArea() + Topology.GetFilterCount()) *
+                 Topology.GetOutputSize().GetArea();
+        }
+        return Topology.GetFilterCount() *
+               Topology.GetFilterTopology().GetCoreCount() *
+               Topology.GetFilterTopology().GetSize().GetWidth() *
+               Topology.GetFilterTopology().GetSize().GetHeight() *
+               Topology.GetOutputSize().GetWidth() *
+               Topology.GetOutputSize().GetHeight();
       }
 
       template <typename T>
-      const Map2D<T>& Layer2D<T>::GetInput(const size_t index) const
+      void Layer2D<T>::GenerateOutputFromBlocked(const BlockedTensor2D<T>& inputs)
       {
-        if (index >= Topology.GetInputCount())
+        if (IsDepthwiseSeparable())
         {
-          throw std::range_error("cnn::engine::convolution::Layer2D::GetInput() const, index >= Topology.GetInputCount().");
+          GenerateSeparableOutputFromBlocked(inputs, nullptr);
+          return;
+        }
+
+        PrepareBlocked(inputs);
+        for (size_t b = 0; b < BlockedOutputs.GetBlockCount(); ++b)
+        {
+          GenerateOutputFromBlocked(inputs, b, 0, Topology.GetOutputSize().GetHeight());
         }
-        return Inputs[index];
       }
 
       template <typename T>
-      Map2DProtectingReference<T> Layer2D<T>::GetInput(const size_t index)
+      void Layer2D<T>::GenerateOutputFromBlocked(const BlockedTensor2D<T>& inputs, common::ThreadPool& threadPool)
       {
-        if (index >= Topology.GetInputCount())
+        const size_t threadCount = threadPool.GetThreadCount();
+        if ((threadCount == 1) || (GetWork() < MIN_PARALLEL_WORK))
         {
-          throw std::range_error("cnn::engine::convolution::Layer2D::GetInput(), index >= Topology.GetInputCount().");
+          GenerateOutputFromBlocked(inputs);
+          return;
         }
-        return Inputs[index];
+
+        if (IsDepthwiseSeparable())
+        {
+          GenerateSeparableOutputFromBlocked(inputs, &threadPool);
+          return;
+        }
+
+        PrepareBlocked(inputs);
+
+        // We want about two tasks per thread, so every block of filters is split into blocks of rows.
+        const size_t filterBlockCount = BlockedOutputs.GetBlockCount();
+        const size_t outputHeight = Topology.GetOutputSize().GetHeight();
+        const size_t desiredBlockCount = std::min((2 * threadCount + filterBlockCount - 1) / filterBlockCount, outputHeight);
+        const size_t blockHeight = (outputHeight + desiredBlockCount - 1) / desiredBlockCount;
+        const size_t blockCount = (outputHeight + blockHeight - 1) / blockHeight;
+
+        auto task = [this, &inputs, blockCount, blockHeight, outputHeight](const size_t taskIndex)
+        {
+          const size_t filterBlockIndex = taskIndex / blockCount;
+          const size_t beginY = (taskIndex % blockCount) * blockHeight;
+          const size_t endY = std::min(beginY + blockHeight, outputHeight);
+          GenerateOutputFromBlocked(inputs, filterBlockIndex, beginY, endY);
+        };
+        threadPool.ParallelFor(filterBlockCount * blockCount, task);
       }
 
       template <typename T>
-      const Filter2D<T>& Layer2D<T>::GetFilter(const size_t index) const
+      const BlockedTensor2D<T>& Layer2D<T>::GetBlockedOutputs() const noexcept
       {
-        if (index >= Topology.GetFilterCount())
-        {
-          throw std::range_error("cnn::engine::convolution::Layer2D::GetFilter() const, index >= Topology.GetFilterCount().");
-        }
-        return Filters[index];
+        return BlockedOutputs;
       }
 
       template <typename T>
-      Filter2DProtectingReference<T> Layer2D<T>::GetFilter(const size_t index) 
+      void Layer2D<T>::UnpackBlockedOutputs()
       {
-        if (index >= Topology.GetFilterCount())
+        if ((BlockedOutputs.GetSize() != Topology.GetOutputSize()) || (BlockedOutputs.GetChannelCount() != Topology.GetOutputCount()))
         {
-          throw std::range_error("cnn::engine::convolution::Layer2D::GetFilter(), index >= Topology.GetFilterCount().");
+          throw std::logic_error("cnn::engine::convolution::Layer2D::UnpackBlockedOutputs(), there are no blocked outputs.");
+        }
+        for (size_t i = 0; i < Topology.GetOutputCount(); ++i)
+        {
+          BlockedOutputs.Unpack(i, Outputs[i]);
         }
-        return Filters[index];
       }
 
       template <typename T>
-      const Map2D<T>& Layer2D<T>::GetOutput(const size_t index) const
+      void Layer2D<T>::GenerateSeparableOutputFromBlocked(const BlockedTensor2D<T>& inputs, common::ThreadPool* const threadPool)
       {
-        if (index >= Topology.GetOutputCount())
+        if ((inputs.GetSize() != Topology.GetInputSize()) || (inputs.GetChannelCount() != Topology.GetInputCount()))
         {
-          throw std::range_error("cnn::engine::convolution::Layer2D::GetOutput() const, index >= Topology.GetOutputCount().");
+          throw std::invalid_argument("cnn::engine::convolution::Layer2D::GenerateSeparableOutputFromBlocked(), inputs don't match the topology.");
+        }
+        if ((BlockedOutputs.GetSize() != Topology.GetOutputSize()) || (BlockedOutputs.GetChannelCount() != Topology.GetOutputCount()))
+        {
+          BlockedOutputs = BlockedTensor2D<T>{ Topology.GetOutputSize(), Topology.GetOutputCount(), GetResource() };
+        }
+
+        for (size_t i = 0; i < Topology.GetInputCount(); ++i)
+        {
+          inputs.Unpack(i, Inputs[i]);
+        }
+        if (threadPool != nullptr)
+        {
+          GenerateOutput(*threadPool);
+        }
+        else
+        {
+          GenerateOutput();
+        }
+        for (size_t i = 0; i < Topology.GetOutputCount(); ++i)
+        {
+          BlockedOutputs.Pack(i, Outputs[i]);
         }
-        return Outputs[index];
       }
 
       template <typename T>
-      Map2DProtectingReference<T> Layer2D<T>::GetOutput(const size_t index)
+      void Layer2D<T>::PrepareBlocked(const BlockedTensor2D<T>& inputs)
       {
-        if (index >= Topology.GetOutputCount())
+        if (inputs.GetSize() != Topology.GetInputSize())
         {
-          throw std::range_error("cnn::engine::convolution::Layer2D::GetOutput(), index >= Topology.GetOutputCount().");
+          throw std::invalid_argument("cnn::engine::convolution::Layer2D::PrepareBlocked(), inputs.GetSize() != Topology.GetInputSize().");
         }
-        return Outputs[index];
+        if (inputs.GetChannelCount() != Topology.GetInputCount())
+        {
+          throw std::invalid_argument("cnn::engine::convolution::Layer2D::PrepareBlocked(), inputs.GetChannelCount() != Topology.GetInputCount().");
+        }
+
+        if ((BlockedOutputs.GetSize() != Topology.GetOutputSize()) || (BlockedOutputs.GetChannelCount() != Topology.GetOutputCount()))
+        {
+          BlockedOutputs = BlockedTensor2D<T>{ Topology.GetOutputSize(), Topology.GetOutputCount(), GetResource() };
+        }
+
+        if (BlockedWeightsStamp == WeightStamp)
+        {
+          return;
+        }
+
+        constexpr size_t blockSize = BlockedTensor2D<T>::BLOCK_SIZE;
+        const size_t coreCount = Topology.GetFilterTopology().GetCoreCount();
+        const size_t coreArea = Topology.GetFilterTopology().GetSize().GetArea();
+        const size_t weightCount = BlockedOutputs.GetBlockCount() * coreCount * coreArea * blockSize;
+        if (BlockedWeights.GetCount() != weightCount)
+        {
+          BlockedWeights = common::AlignedBuffer<T>{ weightCount, GetResource() };
+        }
+
+        T* const blockedWeights = BlockedWeights.GetData();
+        for (size_t f = 0; f < Topology.GetFilterCount(); ++f)
+        {
+          T* const filterWeights = blockedWeights + (f / blockSize) * coreCount * coreArea * blockSize + f % blockSize;
+          for (size_t c = 0; c < coreCount; ++c)
+          {
+            const T* const weights = Filters[f].GetConstCore(c).GetWeights();
+            for (size_t i = 0; i < coreArea; ++i)
+            {
+              filterWeights[(c * coreArea + i) * blockSize] = weights[i];
+            }
+          }
+        }
+        BlockedWeightsStamp = WeightStamp;
       }
 
       template <typename T>
-      void Layer2D<T>::GenerateOutput()
+      void Layer2D<T>::GenerateOutputFromBlocked(const BlockedTensor2D<T>& inputs, const size_t filterBlockIndex, const size_t beginY, const size_t endY)
       {
-        for (size_t f = 0; f < Topology.GetFilterCount(); ++f)
+        const size_t outputWidth = Topology.GetOutputSize().GetWidth();
+        // Sums of pixels are activated in registers, so the kernel is instantiated for every activation type.
+        common::Activation::Dispatch(Topology.GetActivationType(), [&](auto activation)
         {
-          auto& output = Outputs[f];
-          output.Clear();
-
-          auto& filter = Filters[f];
-          for (size_t c = 0; c < Topology.GetFilterTopology().GetCoreCount(); ++c)
+          constexpr common::ActivationType activationType = decltype(activation)::value;
+          for (size_t oy = beginY; oy < endY; ++oy)
           {
-            const auto& input = Inputs[c];
-            auto core = filter.GetCore(c);
+            size_t ox = 0;
+            for (; ox + BLOCKED_PIXEL_COUNT <= outputWidth; ox += BLOCKED_PIXEL_COUNT)
+            {
+              GenerateBlockedPixels<BLOCKED_PIXEL_COUNT, activationType>(inputs, filterBlockIndex, ox, oy);
+            }
+            for (; ox < outputWidth; ++ox)
+            {
+              GenerateBlockedPixels<1, activationType>(inputs, filterBlockIndex, ox, oy);
+            }
+          }
+        });
+      }
 
-            for (size_t ox = 0; ox < Topology.GetOutputSize().GetWidth(); ++ox)
+      template <typename T>
+      template <size_t PIXEL_COUNT, common::ActivationType ACTIVATION_TYPE>
+      void Layer2D<T>::GenerateBlockedPixels(const BlockedTensor2D<T>& inputs, const size_t filterBlockIndex, const size_t ox, const size_t oy)
+      {
+        constexpr size_t blockSize = BlockedTensor2D<T>::BLOCK_SIZE;
+        const size_t coreWidth = Topology.GetFilterTopology().GetSize().GetWidth();
+        const size_t coreHeight = Topology.GetFilterTopology().GetSize().GetHeight();
+        const size_t coreCount = Topology.GetFilterTopology().GetCoreCount();
+        const size_t dilation = Topology.GetFilterTopology().GetDilation();
+        const size_t inputWidth = Topology.GetInputSize().GetWidth();
+        const size_t outputWidth = Topology.GetOutputSize().GetWidth();
+        const size_t laneCount = std::min(blockSize, Topology.GetFilterCount() - filterBlockIndex * blockSize);
+
+        // Every input value is broadcast and multiplied by the weights of all filters of the block, which are one vector,
+        // and the sums of the pixels stay in registers for all cores. Lanes of missing filters have zero weights.
+        T sums[PIXEL_COUNT][blockSize] = {};
+        const T* weights = BlockedWeights.GetData() + filterBlockIndex * coreCount * coreWidth * coreHeight * blockSize;
+        for (size_t c = 0; c < coreCount; ++c)
+        {
+          const T* const input = inputs.GetBlock(c / blockSize) + c % blockSize;
+          for (size_t cy = 0; cy < coreHeight; ++cy)
+          {
+            const T* const inputRow = input + ((oy + cy * dilation) * inputWidth + ox) * blockSize;
+            for (size_t cx = 0; cx < coreWidth; ++cx, weights += blockSize)
             {
-              for (size_t oy = 0; oy < Topology.GetOutputSize().GetHeight(); ++oy)
+              for (size_t p = 0; p < PIXEL_COUNT; ++p)
               {
-                for (size_t cx = 0; cx < Topology.GetFilterTopology().GetSize().GetWidth(); ++cx)
+                const T value = inputRow[(p + cx * dilation) * blockSize];
+                for (size_t l = 0; l < blockSize; ++l)
                 {
-                  for (size_t cy = 0; cy < Topology.GetFilterTopology().GetSize().GetHeight(); ++cy)
-                  {
-                    const T value = input.GetValue(ox + cx, oy + cy);
-                    core.SetInput(cx, cy, value);
-                  }
+                  sums[p][l] += value * weights[l];
                 }
-                core.GenerateOutput();
-                output.SetValue(ox, oy, core.GetOutput());
               }
             }
           }
         }
+
+        T* const output = BlockedOutputs.GetBlock(filterBlockIndex) + (ox + oy * outputWidth) * blockSize;
+        for (size_t p = 0; p < PIXEL_COUNT; ++p)
+        {
+          for (size_t l = 0; l < laneCount; ++l)
+          {
+            output[p * blockSize + l] = common::Activation::Activate<ACTIVATION_TYPE>(sums[p][l]);
+          }
+        }
       }
 
       template <typename T>
-      void Layer2D<T>::Clear() noexcept
+      void Layer2D<T>::Clear()
       {
         for (size_t i = 0; i < Topology.GetInputCount(); ++i)
         {
@@ -272,11 +1898,15 @@ namespace cnn
         {
           Filters[i].Clear();
         }
+        DepthwiseFilter.Clear();
 
         for (size_t i = 0; i < Topology.GetOutputCount(); ++i)
         {
           Outputs[i].Clear();
         }
+        BlockedOutputs.Clear();
+        Sparse = false;
+        DropCoreTransforms();
       }
 
       template <typename T>
@@ -286,6 +1916,20 @@ namespace cnn
         Inputs.reset(nullptr);
         Filters.reset(nullptr);
         Outputs.reset(nullptr);
+        DepthwiseFilter.Reset();
+        DepthwiseOutputs.Reset();
+        PointwiseWeights.Reset();
+        CoreTiles.Reset();
+        Fourier.Reset();
+        CoreSpectra.Reset();
+        InputSpectra.Reset();
+        BlockedWeights.Reset();
+        BlockedOutputs.Reset();
+        SparseWeights.Reset();
+        SparseTaps.Reset();
+        TapOffsets.Reset();
+        Sparse = false;
+        DropCoreTransforms();
       }
 
       template <typename T>
@@ -308,6 +1952,11 @@ namespace cnn
           Filters[i].Save(ostream);
         }
 
+        if (IsDepthwiseSeparable())
+        {
+          DepthwiseFilter.Save(ostream);
+        }
+
         for (size_t i = 0; i < Topology.GetOutputCount(); ++i)
         {
           Outputs[i].Save(ostream);
@@ -331,12 +1980,13 @@ namespace cnn
         decltype(Inputs) inputs;
         decltype(Filters) filters;
         decltype(Outputs) outputs;
+        decltype(DepthwiseFilter) depthwiseFilter{ Filter2DTopology{}, GetResource() };
 
         topology.Load(istream);
 
         CheckTopology(topology);
 
-        inputs = std::make_unique<Map2D<T>[]>(topology.GetInputCount());
+        inputs = common::MakeResourceArray<Map2D<T>>(topology.GetInputCount(), GetResource(), Size2D{});
         for (size_t i = 0; i < topology.GetInputCount(); ++i)
         {
           inputs[i].Load(istream);
@@ -346,17 +1996,26 @@ namespace cnn
           }
         }
 
-        filters = std::make_unique<Filter2D<T>[]>(topology.GetFilterCount());
+        filters = common::MakeResourceArray<Filter2D<T>>(topology.GetFilterCount(), GetResource(), Filter2DTopology{});
         for (size_t i = 0; i < topology.GetFilterCount(); ++i)
         {
           filters[i].Load(istream);
-          if (filters[i].GetTopology() != topology.GetFilterTopology())
+          if (filters[i].GetTopology() != GetStoredFilterTopology(topology))
+          {
+            throw std::logic_error("cnn::engine::convolution::Layer2D::Load(), filters[i].GetTopology() != GetStoredFilterTopology(topology).");
+          }
+        }
+
+        if (topology.GetType() == Layer2DType::DepthwiseSeparable)
+        {
+          depthwiseFilter.Load(istream);
+          if (depthwiseFilter.GetTopology() != GetDepthwiseFilterTopology(topology))
           {
-            throw std::logic_error("cnn::engine::convolution::Layer2D::Load(), filters[i].GetTopology() != topology.GetFilterTopology().");
+            throw std::logic_error("cnn::engine::convolution::Layer2D::Load(), depthwiseFilter.GetTopology() != GetDepthwiseFilterTopology(topology).");
           }
         }
 
-        outputs = std::make_unique<Map2D<T>[]>(topology.GetOutputCount());
+        outputs = common::MakeResourceArray<Map2D<T>>(topology.GetOutputCount(), GetResource(), Size2D{});
         for (size_t i = 0; i < topology.GetOutputCount(); ++i)
         {
           outputs[i].Load(istream);
@@ -366,6 +2025,10 @@ namespace cnn
           }
         }
 
+        const size_t depthwiseOutputCount = topology.GetType() == Layer2DType::DepthwiseSeparable ?
+                                            topology.GetInputCount() * topology.GetOutputSize().GetHeight() * common::GetPaddedCount<T>(topology.GetOutputSize().GetWidth()) : 0;
+        common::AlignedBuffer<T> depthwiseOutputs{ depthwiseOutputCount, GetResource() };
+
         if (istream.good() == false)
         {
           throw std::runtime_error("cnn::engine::convolution::Layer2D::Load(), istream.good() == false.");
@@ -375,29 +2038,55 @@ namespace cnn
         Inputs = std::move(inputs);
         Filters = std::move(filters);
         Outputs = std::move(outputs);
+        DepthwiseFilter = std::move(depthwiseFilter);
+        DepthwiseOutputs = std::move(depthwiseOutputs);
+        Sparse = false;
+        DropCoreTransforms();
       }
 
       template <typename T>
-      void Layer2D<T>::FillWeights(common::ValueGenerator<T>& valueGenerator) noexcept
+      void Layer2D<T>::FillWeights(common::ValueGenerator<T>& valueGenerator)
       {
+        DepthwiseFilter.FillWeights(valueGenerator);
         for (size_t i = 0; i < Topology.GetFilterCount(); ++i)
         {
           Filters[i].FillWeights(valueGenerator);
         }
+        Sparse = false;
+        DropCoreTransforms();
       }
 
       template <typename T>
-      void Layer2D<T>::Mutate(common::Mutagen<T>& mutagen) noexcept
+      void Layer2D<T>::Mutate(common::Mutagen<T>& mutagen)
       {
+        DepthwiseFilter.Mutate(mutagen);
         for (size_t i = 0; i < Topology.GetFilterCount(); ++i)
         {
           Filters[i].Mutate(mutagen);
         }
+        Sparse = false;
+        DropCoreTransforms();
+      }
+
+      template <typename T>
+      void Layer2D<T>::DropCoreTransforms() noexcept
+      {
+        WeightStamp = common::WeightStamp::Generate();
       }
 
       template <typename T>
       void Layer2D<T>::CheckTopology(const Layer2DTopology& topology) const
       {
+        if ((topology.GetType() != Layer2DType::Full) && (topology.GetType() != Layer2DType::DepthwiseSeparable))
+        {
+          throw std::invalid_argument("cnn::engine::convolution::Layer2D::CheckTopology(), wrong type.");
+        }
+
+        if (common::Activation::IsValid(topology.GetActivationType()) == false)
+        {
+          throw std::invalid_argument("cnn::engine::convolution::Layer2D::CheckTopology(), common::Activation::IsValid(topology.GetActivationType()) == false.");
+        }
+
         // Zero topology is allowed.
         if ((topology.GetInputCount() == 0) && (topology.GetFilterCount() == 0) && (topology.GetOutputCount() == 0))
         {
@@ -419,16 +2108,27 @@ namespace cnn
           throw std::invalid_argument("cnn::engine::convolution::Layer2D::CheckTopology(), topology.GetFilterCount() != topology.GetOutputCount().");
         }
 
+        if (topology.GetFilterTopology().GetDilation() == 0)
+        {
+          throw std::invalid_argument("cnn::engine::convolution::Layer2D::CheckTopology(), topology.GetFilterTopology().GetDilation() == 0.");
+        }
+
         // Width's
         {
-          if (topology.GetInputSize().GetWidth() <= 1)
+          if (topology.GetInputSize().GetWidth() == 0)
+          {
+            throw std::invalid_argument("cnn::engine::convolution::Layer2D::CheckTopology(), topology.GetInputSize().GetWidth() == 0.");
+          }
+
+          // 1 x 1 cores are allowed, because they mix inputs by the pointwise kernel.
+          if (topology.GetFilterTopology().GetSize().GetWidth() == 0)
           {
-            throw std::invalid_argument("cnn::engine::convolution::Layer2D::CheckTopology(), topology.GetInputSize().GetWidth() <= 1.");
+            throw std::invalid_argument("cnn::engine::convolution::Layer2D::CheckTopology(), topology.GetFilterTopology().GetSize().GetWidth() == 0.");
           }
 
-          if (topology.GetFilterTopology().GetSize().GetWidth() <= 1)
+          if (topology.GetFilterTopology().GetDilatedSize().GetWidth() > topology.GetInputSize().GetWidth())
           {
-            throw std::invalid_argument("cnn::engine::convolution::Layer2D::CheckTopology(), topology.GetFilterTopology().GetSize().GetWidth() <= 1.");
+            throw std::invalid_argument("cnn::engine::convolution::Layer2D::CheckTopology(), topology.GetFilterTopology().GetDilatedSize().GetWidth() > topology.GetInputSize().GetWidth().");
           }
 
           if (topology.GetOutputSize().GetWidth() == 0)
@@ -436,22 +2136,27 @@ namespace cnn
             throw std::invalid_argument("cnn::engine::convolution::Layer2D::CheckTopology(), topology.GetOutputSize().GetWidth() == 0.");
           }
 
-          if ((topology.GetInputSize().GetWidth() - topology.GetFilterTopology().GetSize().GetWidth() + 1) != topology.GetOutputSize().GetWidth())
+          if ((topology.GetInputSize().GetWidth() - topology.GetFilterTopology().GetDilatedSize().GetWidth() + 1) != topology.GetOutputSize().GetWidth())
           {
-            throw std::invalid_argument("cnn::engine::convolution::Layer2D::CheckTopology(), (topology.GetInputSize().GetWidth() - topology.GetFilterTopology().GetSize().GetWidth() + 1) != topology.GetOutputSize().GetWidth().");
+            throw std::invalid_argument("cnn::engine::convolution::Layer2D::CheckTopology(), (topology.GetInputSize().GetWidth() - topology.GetFilterTopology().GetDilatedSize().GetWidth() + 1) != topology.GetOutputSize().GetWidth().");
           }
         }
 
         // Height's
         {
-          if (topology.GetInputSize().GetHeight() <= 1)
+          if (topology.GetInputSize().GetHeight() == 0)
+          {
+            throw std::invalid_argument("cnn::engine::convolution::Layer2D::CheckTopology(), topology.GetInputSize().GetHeight() == 0.");
+          }
+
+          if (topology.GetFilterTopology().GetSize().GetHeight() == 0)
           {
-            throw std::invalid_argument("cnn::engine::convolution::Layer2D::CheckTopology(), topology.GetInputSize().GetHeight() <= 1.");
+            throw std::invalid_argument("cnn::engine::convolution::Layer2D::CheckTopology(), topology.GetFilterTopology().GetSize().GetHeight() == 0.");
           }
 
-          if (topology.GetFilterTopology().GetSize().GetHeight() <= 1)
+          if (topology.GetFilterTopology().GetDilatedSize().GetHeight() > topology.GetInputSize().GetHeight())
           {
-            throw std::invalid_argument("cnn::engine::convolution::Layer2D::CheckTopology(), topology.GetFilterTopology().GetSize().GetHeight() <= 1.");
+            throw std::invalid_argument("cnn::engine::convolution::Layer2D::CheckTopology(), topology.GetFilterTopology().GetDilatedSize().GetHeight() > topology.GetInputSize().GetHeight().");
           }
 
           if (topology.GetOutputSize().GetHeight() == 0)
@@ -459,12 +2164,122 @@ namespace cnn
             throw std::invalid_argument("cnn::engine::convolution::Layer2D::CheckTopology(), topology.GetOutputSize().GetHeight() == 0.");
           }
 
-          if ((topology.GetInputSize().GetHeight() - topology.GetFilterTopology().GetSize().GetHeight() + 1) != topology.GetOutputSize().GetHeight())
+          if ((topology.GetInputSize().GetHeight() - topology.GetFilterTopology().GetDilatedSize().GetHeight() + 1) != topology.GetOutputSize().GetHeight())
           {
-            throw std::invalid_argument("cnn::engine::convolution::Layer2D::CheckTopology(), (topology.GetInputSize().GetHeight() - topology.GetFilterTopology().GetSize().GetHeight() + 1) != topology.GetOutputSize().GetHeight().");
+            throw std::invalid_argument("cnn::engine::convolution::Layer2D::CheckTopology(), (topology.GetInputSize().GetHeight() - topology.GetFilterTopology().GetDilatedSize().GetHeight() + 1) != topology.GetOutputSize().GetHeight().");
           }
         }
       }
+
+      template <typename T>
+      size_t Layer2D<T>::GetWeightCount() const noexcept
+      {
+        return DepthwiseFilter.GetWeightCount() + Topology.GetFilterCount() * GetStoredFilterTopology(Topology).GetCoreCount() *
+               GetStoredFilterTopology(Topology).GetSize().GetArea();
+      }
+
+      template <typename T>
+      T Layer2D<T>::GetWeight(const size_t index) const
+      {
+        if (index >= GetWeightCount())
+        {
+          throw std::range_error("cnn::engine::convolution::Layer2D::GetWeight() const, index >= GetWeightCount().");
+        }
+        const size_t depthwiseWeightCount = DepthwiseFilter.GetWeightCount();
+        if (index < depthwiseWeightCount)
+        {
+          return DepthwiseFilter.GetWeight(index);
+        }
+        const size_t filterWeightCount = (GetWeightCount() - depthwiseWeightCount) / Topology.GetFilterCount();
+        return Filters[(index - depthwiseWeightCount) / filterWeightCount].GetWeight((index - depthwiseWeightCount) % filterWeightCount);
+      }
+
+      template <typename T>
+      Filter2DTopology Layer2D<T>::GetStoredFilterTopology(const Layer2DTopology& topology) noexcept
+      {
+        if (topology.GetType() == Layer2DType::DepthwiseSeparable)
+        {
+          return Filter2DTopology{ Size2D{ 1, 1 }, topology.GetInputCount() };
+        }
+        return topology.GetFilterTopology();
+      }
+
+      template <typename T>
+      Filter2DTopology Layer2D<T>::GetDepthwiseFilterTopology(const Layer2DTopology& topology) noexcept
+      {
+        if (topology.GetType() == Layer2DType::DepthwiseSeparable)
+        {
+          return topology.GetFilterTopology();
+        }
+        return Filter2DTopology{};
+      }
+
+      template <typename T>
+      bool Layer2D<T>::IsDepthwiseSeparable() const noexcept
+      {
+        return Topology.GetType() == Layer2DType::DepthwiseSeparable;
+      }
+
+      template <typename T>
+      size_t Layer2D<T>::GetDepthwiseStride() const noexcept
+      {
+        return common::GetPaddedCount<T>(Topology.GetOutputSize().GetWidth());
+      }
+
+      template <typename T>
+      void Layer2D<T>::SetWeight(const size_t index, const T value)
+      {
+        if (index >= GetWeightCount())
+        {
+          throw std::range_error("cnn::engine::convolution::Layer2D::SetWeight(), index >= GetWeightCount().");
+        }
+        const size_t depthwiseWeightCount = DepthwiseFilter.GetWeightCount();
+        if (index < depthwiseWeightCount)
+        {
+          DepthwiseFilter.SetWeight(index, value);
+        }
+        else
+        {
+          const size_t filterWeightCount = (GetWeightCount() - depthwiseWeightCount) / Topology.GetFilterCount();
+          Filters[(index - depthwiseWeightCount) / filterWeightCount].SetWeight((index - depthwiseWeightCount) % filterWeightCount, value);
+        }
+        DropCoreTransforms();
+      }
+
+      template <typename T>
+      void Layer2D<T>::ShareWeights(const Layer2D& layer)
+      {
+        if (Topology != layer.Topology)
+        {
+          throw std::invalid_argument("cnn::engine::convolution::Layer2D::ShareWeights(), Topology != layer.Topology.");
+        }
+        for (size_t i = 0; i < Topology.GetFilterCount(); ++i)
+        {
+          Filters[i].ShareWeights(layer.Filters[i]);
+        }
+        DepthwiseFilter.ShareWeights(layer.DepthwiseFilter);
+        // Transforms, which were built for these weights, stay valid.
+        Sparse = layer.Sparse;
+        WeightStamp = layer.WeightStamp;
+      }
+
+      template <typename T>
+      void Layer2D<T>::CopyWeights(const Layer2D& layer)
+      {
+        if (Topology != layer.Topology)
+        {
+          throw std::invalid_argument("cnn::engine::convolution::Layer2D::CopyWeights(), Topology != layer.Topology.");
+        }
+        // Weights stay mixed, if a copy throws.
+        DropCoreTransforms();
+        for (size_t i = 0; i < Topology.GetFilterCount(); ++i)
+        {
+          Filters[i].CopyWeights(layer.Filters[i]);
+        }
+        DepthwiseFilter.CopyWeights(layer.DepthwiseFilter);
+        Sparse = layer.Sparse;
+        WeightStamp = layer.WeightStamp;
+      }
     }
   }
 }
\ No newline at end of file
@@ -44,6 +44,12 @@ namespace cnn
         // Exception guarantee: strong for the layer.
         Filter2DProtectingReference<T> GetFilter(const size_t index) const;
 
+        // Exception guarantee: strong for the layer.
+        const Filter2D<T>& GetConstDepthwiseFilter() const;
+
+        // Exception guarantee: strong for the layer.
+        Filter2DProtectingReference<T> GetDepthwiseFilter() const;
+
         // Exception guarantee: strong for the layer.
         const Map2D<T>& GetConstOutput(const size_t index) const;
 
@@ -53,18 +59,28 @@ namespace cnn
         // Exception guarantee: base for this.
         void GenerateOutput() const;
 
+        // Exception guarantee: base for the layer.
+        void GenerateOutput(common::ThreadPool& threadPool) const;
+
+        bool IsSparse() const noexcept;
+
+        void SetSparse(const bool sparse) const noexcept;
+
+        bool IsSparseFaster() const noexcept;
+
+        // Exception guarantee: base for the layer.
         // It clears the state without changing of the topology of the layer.
-        void Clear() const noexcept;
+        void Clear() const;
 
         // Exception guarantee: base for ostream.
         // It saves full state.
         void Save(std::ostream& ostream) const;
 
-        // We expect that the method never throws any exception.
-        void FillWeights(common::ValueGenerator<T>& valueGenerator) const noexcept;
+        // Exception guarantee: base for the layer.
+        void FillWeights(common::ValueGenerator<T>& valueGenerator) const;
 
-        // We expect that the method never throws any exception.
-        void Mutate(common::Mutagen<T>& mutagen) const noexcept;
+        // Exception guarantee: base for the layer.
+        void Mutate(common::Mutagen<T>& mutagen) const;
 
       private:
 
@@ -116,6 +132,18 @@ namespace cnn
         return Layer.GetFilter(index);
       }
 
+      template <typename T>
+      const Filter2D<T>& Layer2DProtectingReference<T>::GetConstDepthwiseFilter() const
+      {
+        return static_cast<const Layer2D<T>&>(Layer).GetDepthwiseFilter();
+      }
+
+      template <typename T>
+      Filter2DProtectingReference<T> Layer2DProtectingReference<T>::GetDepthwiseFilter() const
+      {
+        return Layer.GetDepthwiseFilter();
+      }
+
       template <typename T>
       const Map2D<T>& Layer2DProtectingReference<T>::GetConstOutput(const size_t index) const
       {
@@ -135,7 +163,31 @@ namespace cnn
       }
 
       template <typename T>
-      void Layer2DProtectingReference<T>::Clear() const noexcept
+      void Layer2DProtectingReference<T>::GenerateOutput(common::ThreadPool& threadPool) const
+      {
+        Layer.GenerateOutput(threadPool);
+      }
+
+      template <typename T>
+      bool Layer2DProtectingReference<T>::IsSparse() const noexcept
+      {
+        return Layer.IsSparse();
+      }
+
+      template <typename T>
+      void Layer2DProtectingReference<T>::SetSparse(const bool sparse) const noexcept
+      {
+        Layer.SetSparse(sparse);
+      }
+
+      template <typename T>
+      bool Layer2DProtectingReference<T>::IsSparseFaster() const noexcept
+      {
+        return Layer.IsSparseFaster();
+      }
+
+      template <typename T>
+      void Layer2DProtectingReference<T>::Clear() const
       {
         Layer.Clear();
       }
@@ -147,13 +199,13 @@ namespace cnn
       }
 
       template <typename T>
-      void Layer2DProtectingReference<T>::FillWeights(common::ValueGenerator<T>& valueGenerator) const noexcept
+      void Layer2DProtectingReference<T>::FillWeights(common::ValueGenerator<T>& valueGenerator) const
       {
         Layer.FillWeights(valueGenerator);
       }
 
       template <typename T>
-      void Layer2DProtectingReference<T>::Mutate(common::Mutagen<T>& mutagen) const noexcept
+      void Layer2DProtectingReference<T>::Mutate(common::Mutagen<T>& mutagen) const
       {
         Layer.Mutate(mutagen);
       }
@@ -11,14 +11,18 @@ namespace cnn
                                        const Filter2DTopology filterTopology,
                                        const size_t filterCount,
                                        const Size2D outputSize,
-                                       const size_t outputCount)
+                                       const size_t outputCount,
+                                       const Layer2DType type,
+                                       const common::ActivationType activationType)
         :
         InputSize{ inputSize },
         InputCount{ inputCount },
         FilterTopology{ filterTopology },
         FilterCount{ filterCount },
         OutputSize{ outputSize },
-        OutputCount{ outputCount }
+        OutputCount{ outputCount },
+        Type{ type },
+        ActivationType{ activationType }
       {
       }
 
@@ -29,7 +33,9 @@ namespace cnn
         FilterTopology{ topology.FilterTopology },
         FilterCount{ topology.FilterCount },
         OutputSize{ topology.OutputSize },
-        OutputCount{ topology.OutputCount }
+        OutputCount{ topology.OutputCount },
+        Type{ topology.Type },
+        ActivationType{ topology.ActivationType }
       {
         topology.Reset();
       }
@@ -44,6 +50,8 @@ namespace cnn
           FilterCount = topology.FilterCount;
           OutputSize = topology.OutputSize;
           OutputCount = topology.OutputCount;
+          Type = topology.Type;
+          ActivationType = topology.ActivationType;
 
           topology.Reset();
         }
@@ -57,7 +65,9 @@ namespace cnn
             (FilterTopology == topology.FilterTopology) &&
             (FilterCount == topology.FilterCount) &&
             (OutputSize == topology.OutputSize) &&
-            (OutputCount == topology.OutputCount))
+            (OutputCount == topology.OutputCount) &&
+            (Type == topology.Type) &&
+            (ActivationType == topology.ActivationType))
         {
           return true;
         } else {
@@ -135,6 +145,26 @@ namespace cnn
         OutputCount = outputCount;
       }
 
+      Layer2DType Layer2DTopology::GetType() const noexcept
+      {
+        return Type;
+      }
+
+      void Layer2DTopology::SetType(const Layer2DType type) noexcept
+      {
+        Type = type;
+      }
+
+      common::ActivationType Layer2DTopology::GetActivationType() const noexcept
+      {
+        return ActivationType;
+      }
+
+      void Layer2DTopology::SetActivationType(const common::ActivationType activationType) noexcept
+      {
+        ActivationType = activationType;
+      }
+
       size_t Layer2DTopology::GetOutputValueCount() const
       {
         if ((OutputSize.GetArea() == 0) || (OutputCount == 0))
@@ -159,6 +189,8 @@ namespace cnn
         FilterCount = 0;
         OutputSize.Reset();
         OutputCount = 0;
+        Type = Layer2DType::Full;
+        ActivationType = common::ActivationType::Sigmoid;
       }
 
       void Layer2DTopology::Save(std::ostream& ostream) const
@@ -168,12 +200,15 @@ namespace cnn
           throw std::invalid_argument("cnn::engine::convolution::Layer2DTopology::Save(), ostream.good() == false.");
         }
 
+        common::FormatVersion::Save(ostream, FORMAT_VERSION);
         InputSize.Save(ostream);
         ostream.write(reinterpret_cast<const char*const>(&InputCount), sizeof(InputCount));
         FilterTopology.Save(ostream);
         ostream.write(reinterpret_cast<const char* const>(&FilterCount), sizeof(FilterCount));
         OutputSize.Save(ostream);
         ostream.write(reinterpret_cast<const char* const>(&OutputCount), sizeof(OutputCount));
+        ostream.write(reinterpret_cast<const char* const>(&Type), sizeof(Type));
+        ostream.write(reinterpret_cast<const char* const>(&ActivationType), sizeof(ActivationType));
 
         if (ostream.good() == false)
         {
@@ -188,31 +223,46 @@ namespace cnn
           throw std::invalid_argument("cnn::engine::convolution::Layer2DTopology::Load(), istream.good() == false.");
         }
 
-        decltype(InputSize) inputSize;
+        size_t inputWidth{};
+        size_t inputHeight{};
         decltype(InputCount) inputCount{};
         decltype(FilterTopology) filterTopology;
         decltype(FilterCount) filterCount{};
         decltype(OutputSize) outputSize;
         decltype(OutputCount) outputCount{};
+        decltype(Type) type{ Layer2DType::Full };
+        decltype(ActivationType) activationType{ common::ActivationType::Sigmoid };
 
-        inputSize.Load(istream);
+        // The width of the input size is the first value of the stream.
+        const uint32_t version = common::FormatVersion::Load(istream, FORMAT_VERSION, inputWidth);
+        istream.read(reinterpret_cast<char*const>(&inputHeight), sizeof(inputHeight));
         istream.read(reinterpret_cast<char*const>(&inputCount), sizeof(inputCount));
         filterTopology.Load(istream);
         istream.read(reinterpret_cast<char*const>(&filterCount), sizeof(filterCount));
         outputSize.Load(istream);
         istream.read(reinterpret_cast<char*const>(&outputCount), sizeof(outputCount));
+        if (version >= 1)
+        {
+          istream.read(reinterpret_cast<char*const>(&type), sizeof(type));
+        }
+        if (version >= 2)
+        {
+          istream.read(reinterpret_cast<char*const>(&activationType), sizeof(activationType));
+        }
 
         if (istream.good() == false)
         {
           throw std::runtime_error("cnn::engine::convolution::Layer2DTopology::Load(), istream.good() == false.");
         }
 
-        InputSize = std::move(inputSize);
+        InputSize = Size2D{ inputWidth, inputHeight };
         InputCount = inputCount;
         FilterTopology = std::move(filterTopology);
         FilterCount = filterCount;
         OutputSize = std::move(outputSize);
         OutputCount = outputCount;
+        Type = type;
+        ActivationType = activationType;
       }
     }
   }
@@ -3,12 +3,27 @@
 #include "Size2D.hpp"
 #include "Filter2DTopology.hpp"
 
+#include "../common/Activation.hpp"
+#include "../common/FormatVersion.hpp"
+
+#include <cstdint>
+
 namespace cnn
 {
   namespace engine
   {
     namespace convolution
     {
+      // Layer2DType is the way filters of a layer combine its inputs.
+      enum class Layer2DType : uint32_t
+      {
+        // Every filter convolves every input with its own core.
+        Full = 0,
+        // Every input is convolved with its own depthwise core, which is shared by all filters (the filter topology describes
+        // these cores), and then every filter mixes the convolved inputs by its 1 x 1 cores.
+        DepthwiseSeparable = 1
+      };
+
       // It is only a container type for parameters, so it doesn't validate contained values.
       // Contained values are checked by a type, which takes this type as parameter.
       // For example, convolution::Network2D validates correctness of convolution::Network2DTopology.
@@ -22,7 +37,9 @@ namespace cnn
                         const Filter2DTopology filterTopology = {},
                         const size_t filterCount = 0,
                         const Size2D outputSize = {},
-                        const size_t outputCount = 0);
+                        const size_t outputCount = 0,
+                        const Layer2DType type = Layer2DType::Full,
+                        const common::ActivationType activationType = common::ActivationType::Sigmoid);
 
         Layer2DTopology(const Layer2DTopology& topology) noexcept = default;
 
@@ -60,6 +77,14 @@ namespace cnn
 
         void SetOutputCount(const size_t outputCount) noexcept;
 
+        Layer2DType GetType() const noexcept;
+
+        void SetType(const Layer2DType type) noexcept;
+
+        common::ActivationType GetActivationType() const noexcept;
+
+        void SetActivationType(const common::ActivationType activationType) noexcept;
+
         size_t GetOutputValueCount() const;
 
         void Reset() noexcept;
@@ -68,10 +93,14 @@ namespace cnn
         void Save(std::ostream& ostream) const;
 
         // Exception guarantee: strong for this and base for istream.
+        // Legacy streams (see common::FormatVersion) are loaded as full layers, and streams before version 2 with sigmoid activation.
         void Load(std::istream& istream);
 
       private:
 
+        // Version 1 adds the type, and version 2 the activation type.
+        constexpr static uint32_t FORMAT_VERSION = 2;
+
         Size2D InputSize;
         size_t InputCount;
 
@@ -81,6 +110,9 @@ namespace cnn
         Size2D OutputSize;
         size_t OutputCount;
 
+        Layer2DType Type;
+        common::ActivationType ActivationType;
+
       };
     }
   }
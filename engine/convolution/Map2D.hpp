@@ -3,8 +3,13 @@
 #include <memory>
 #include <type_traits>
 #include <stdexcept>
+#include <cstring>
+#include <memory_resource>
+#include <istream>
+#include <ostream>
 
 #include "../common/Map.hpp"
+#include "../common/MemoryResource.hpp"
 #include "Size2D.hpp"
 
 namespace cnn
@@ -13,6 +18,8 @@ namespace cnn
   {
     namespace convolution
     {
+      // Rows are padded with zeros to whole cache lines, so every row starts at a cache line boundary.
+      // The padding is not saved, so the format doesn't depend on it.
       template <typename T>
       class Map2D
       {
@@ -21,7 +28,7 @@ namespace cnn
 
       public:
 
-        Map2D(const Size2D size = {});
+        Map2D(const Size2D size = {}, std::pmr::memory_resource* const resource = std::pmr::get_default_resource());
 
         Map2D(const Map2D& map) = default;
 
@@ -32,6 +39,8 @@ namespace cnn
 
         Map2D& operator=(Map2D&& map) noexcept = default;
 
+        std::pmr::memory_resource* GetResource() const noexcept;
+
         const Size2D& GetSize() const noexcept;
 
         // Exception guarantee: strong for this.
@@ -42,6 +51,23 @@ namespace cnn
         // Exception guarantee: strong for this.
         void SetValue(const size_t x, const size_t y, const T value);
 
+        // It returns the distance between rows in values.
+        size_t GetStride() const noexcept;
+
+        // It gives direct access to the values, which are stored row by row (x + y * GetStride()).
+        // The padding of rows must stay zero.
+        const T* GetValues() const noexcept;
+
+        // It gives direct access to the values, which are stored row by row (x + y * GetStride()).
+        // The padding of rows must stay zero.
+        T* GetValues() noexcept;
+
+        // It copies width * height values, which are stored row by row without padding (x + y * width).
+        void CopyFrom(const T* const values) noexcept;
+
+        // It copies width * height values to the array, row by row without padding (x + y * width).
+        void CopyTo(T* const values) const noexcept;
+
         // It clears the state without changing of the topology.
         void Clear() noexcept;
 
@@ -60,10 +86,16 @@ namespace cnn
         // Topologies of this and map must be equal.
         void FillFrom(const Map2D& map);
 
+        // Exception guarantee: strong for this.
+        // It copies rows [beginY, endY) of the map. Topologies of this and map must be equal.
+        void FillFrom(const Map2D& map, const size_t beginY, const size_t endY);
+
       private:
 
         Size2D Size;
 
+        size_t Stride;
+
         common::Map<T> Map;
 
         size_t ToIndex(const size_t x, const size_t y) const;
@@ -71,10 +103,11 @@ namespace cnn
       };
 
       template <typename T>
-      Map2D<T>::Map2D(const Size2D size)
+      Map2D<T>::Map2D(const Size2D size, std::pmr::memory_resource* const resource)
         :
         Size{ size },
-        Map{ Size.GetArea() }
+        Stride{ common::GetPaddedCount<T>(size.GetWidth()) },
+        Map{ Stride * size.GetHeight(), resource }
       {
         Clear();
       }
@@ -91,6 +124,12 @@ namespace cnn
         return *this;
       }
 
+      template <typename T>
+      std::pmr::memory_resource* Map2D<T>::GetResource() const noexcept
+      {
+        return Map.GetResource();
+      }
+
       template <typename T>
       const Size2D& Map2D<T>::GetSize() const noexcept
       {
@@ -100,7 +139,7 @@ namespace cnn
       template <typename T>
       void Map2D<T>::SetSize(const Size2D& size)
       {
-        Map2D<T> tmpMap{ size };
+        Map2D<T> tmpMap{ size, GetResource() };
         // Beware, it is very intimate place for strong exception guarantee.
         std::swap(*this, tmpMap);
       }
@@ -119,6 +158,44 @@ namespace cnn
         Map.SetValue(index, value);
       }
 
+      template <typename T>
+      size_t Map2D<T>::GetStride() const noexcept
+      {
+        return Stride;
+      }
+
+      template <typename T>
+      const T* Map2D<T>::GetValues() const noexcept
+      {
+        return Map.GetValues();
+      }
+
+      template <typename T>
+      T* Map2D<T>::GetValues() noexcept
+      {
+        return Map.GetValues();
+      }
+
+      template <typename T>
+      void Map2D<T>::CopyFrom(const T* const values) noexcept
+      {
+        const size_t width = Size.GetWidth();
+        for (size_t y = 0; y < Size.GetHeight(); ++y)
+        {
+          std::memcpy(Map.GetValues() + y * Stride, values + y * width, sizeof(T) * width);
+        }
+      }
+
+      template <typename T>
+      void Map2D<T>::CopyTo(T* const values) const noexcept
+      {
+        const size_t width = Size.GetWidth();
+        for (size_t y = 0; y < Size.GetHeight(); ++y)
+        {
+          std::memcpy(values + y * width, Map.GetValues() + y * Stride, sizeof(T) * width);
+        }
+      }
+
       template <typename T>
       void Map2D<T>::Clear() noexcept
       {
@@ -138,8 +215,16 @@ namespace cnn
         {
           throw std::invalid_argument("cnn::engine::convolution::Map2D::Save(), ostream.good() == false.");
         }
+
+        // The format is the same as for the size and the map of Size.GetArea() values.
         Size.Save(ostream);
-        Map.Save(ostream);
+        const size_t valueCount = Size.GetArea();
+        ostream.write(reinterpret_cast<const char* const>(&valueCount), sizeof(valueCount));
+        for (size_t y = 0; y < Size.GetHeight(); ++y)
+        {
+          ostream.write(reinterpret_cast<const char* const>(Map.GetValues() + y * Stride), sizeof(T) * Size.GetWidth());
+        }
+
         if (ostream.good() == false)
         {
           throw std::runtime_error("cnn::engine::convolution::Map2D::save(), ostream.good() == false.");
@@ -153,19 +238,35 @@ namespace cnn
         {
           throw std::invalid_argument("cnn::engine::convolution::Map2D::Load(), istream.good() == false.");
         }
+
         decltype(Size) size;
-        decltype(Map) map;
+        size_t valueCount{};
 
         size.Load(istream);
-        map.Load(istream);
+        istream.read(reinterpret_cast<char* const>(&valueCount), sizeof(valueCount));
 
         if (istream.good() == false)
         {
           throw std::runtime_error("cnn::engine::convolution::Map2D::Load(), istream.good() == false.");
         }
+        if (valueCount != size.GetArea())
+        {
+          throw std::logic_error("cnn::engine::convolution::Map2D::Load(), valueCount != size.GetArea().");
+        }
 
-        Size = std::move(size);
-        Map = std::move(map);
+        Map2D<T> map{ size, GetResource() };
+        for (size_t y = 0; y < size.GetHeight(); ++y)
+        {
+          istream.read(reinterpret_cast<char* const>(map.Map.GetValues() + y * map.Stride), sizeof(T) * size.GetWidth());
+        }
+
+        if (istream.good() == false)
+        {
+          throw std::runtime_error("cnn::engine::convolution::Map2D::Load(), istream.good() == false.");
+        }
+
+        // Beware, it is very intimate place for strong exception guarantee.
+        std::swap(*this, map);
       }
 
       template <typename T>
@@ -181,7 +282,7 @@ namespace cnn
           throw std::range_error("cnn::engine::convolution::Map2D::ToIndex(), y >= Size.GetHeight().");
         }
 #endif
-        return x + y * Size.GetWidth();
+        return x + y * Stride;
       }
 
       template <typename T>
@@ -196,6 +297,24 @@ namespace cnn
           Map.FillFrom(map.Map);
         }
       }
+
+      template <typename T>
+      void Map2D<T>::FillFrom(const Map2D& map, const size_t beginY, const size_t endY)
+      {
+        if (Size != map.Size)
+        {
+          throw std::invalid_argument("cnn::engine::convolution::Map2D::FillFrom(), Size != map.Size.");
+        }
+        if ((beginY > endY) || (endY > Size.GetHeight()))
+        {
+          throw std::range_error("cnn::engine::convolution::Map2D::FillFrom(), [beginY, endY) is out of Size.");
+        }
+        if ((this != &map) && (beginY != endY))
+        {
+          // Rows are padded equally, so the rows are copied with their padding at once.
+          std::memcpy(GetValues() + beginY * Stride, map.GetValues() + beginY * Stride, sizeof(T) * Stride * (endY - beginY));
+        }
+      }
     }
   }
 }
@@ -37,6 +37,14 @@ namespace cnn
         // Exception guarantee: strong for the map.
         void SetValue(const size_t x, const size_t y, const T value) const;
 
+        size_t GetStride() const noexcept;
+
+        // It gives direct access to the values, which are stored row by row (x + y * GetStride()).
+        T* GetValues() const noexcept;
+
+        // It copies width * height values, which are stored row by row without padding (x + y * width).
+        void CopyFrom(const T* const values) const noexcept;
+
         // It clears the state without changing of the topology of the map.
         void Clear() const noexcept;
 
@@ -48,6 +56,10 @@ namespace cnn
         // Topologies of the Map and map must be equal.
         void FillFrom(const Map2D<T>& map) const;
 
+        // Exception guarantee: strong for the map.
+        // It copies rows [beginY, endY) of the map. Topologies of the Map and map must be equal.
+        void FillFrom(const Map2D<T>& map, const size_t beginY, const size_t endY) const;
+
       private:
 
         Map2D<T>& Map;
@@ -86,6 +98,24 @@ namespace cnn
         Map.SetValue(x, y, value);
       }
 
+      template <typename T>
+      size_t Map2DProtectingReference<T>::GetStride() const noexcept
+      {
+        return Map.GetStride();
+      }
+
+      template <typename T>
+      T* Map2DProtectingReference<T>::GetValues() const noexcept
+      {
+        return Map.GetValues();
+      }
+
+      template <typename T>
+      void Map2DProtectingReference<T>::CopyFrom(const T* const values) const noexcept
+      {
+        Map.CopyFrom(values);
+      }
+
       template <typename T>
       void Map2DProtectingReference<T>::Clear() const noexcept
       {
@@ -103,6 +133,12 @@ namespace cnn
       {
         Map.FillFrom(map);
       }
+
+      template <typename T>
+      void Map2DProtectingReference<T>::FillFrom(const Map2D<T>& map, const size_t beginY, const size_t endY) const
+      {
+        Map.FillFrom(map, beginY, endY);
+      }
     }
   }
 }
\ No newline at end of file
@@ -1,9 +1,14 @@
 #pragma once
 
+#include <cstdint>
+#include <utility>
+#include <memory_resource>
+
 #include "Layer2D.hpp"
 #include "Layer2DProtectingReference.hpp"
 
 #include "Network2DTopology.hpp"
+#include "BlockedTensor2D.hpp"
 
 namespace cnn
 {
@@ -19,7 +24,8 @@ namespace cnn
 
       public:
 
-        Network2D(const Network2DTopology& topology = {});
+        // Layers are allocated by the resource.
+        Network2D(const Network2DTopology& topology = {}, std::pmr::memory_resource* const resource = std::pmr::get_default_resource());
 
         Network2D(const Network2D& network);
 
@@ -34,6 +40,8 @@ namespace cnn
         // Exception guarantee: strong for this.
         void SetTopology(const Network2DTopology& topology);
 
+        std::pmr::memory_resource* GetResource() const noexcept;
+
         const Layer2D<T>& GetLayer(const size_t index) const;
 
         // Exception guarantee: strong for this.
@@ -52,8 +60,35 @@ namespace cnn
         // Exception guarantee: base for this.
         void GenerateOutput();
 
+        // Exception guarantee: base for this.
+        // Every layer splits its work across the pool, if it is large enough.
+        void GenerateOutput(common::ThreadPool& threadPool);
+
+        // Exception guarantee: base for this.
+        // The inputs of the first layer are bit-packed binary maps (see Layer2D::GenerateOutputFromBinary()).
+        void GenerateOutputFromBinary(const uint64_t* const inputs);
+
+        bool GetBlockedLayout() const noexcept;
+
+        // In the blocked layout layers exchange their outputs as BlockedTensor2D (see Layer2D::GenerateOutputFromBlocked()),
+        // so maps are converted only at the inputs of the network and the outputs of the last layer.
+        // Inputs and outputs of other layers are not updated. The layout is not saved.
+        void SetBlockedLayout(const bool blockedLayout) noexcept;
+
+        size_t GetFusedTileHeight() const noexcept;
+
+        // If the height isn't zero, layers are computed depth first by bands of rows of the output of the last layer.
+        // Every band is passed through all layers, which generate only the rows it depends on (with the halo of
+        // core height - 1 rows), so the rows stay in caches between layers. Rows of the halo, which are generated
+        // for the previous band, are not generated again. The blocked layout takes precedence. The height is not saved.
+        void SetFusedTileHeight(const size_t fusedTileHeight) noexcept;
+
+        // It copies the options of the execution (the blocked layout and the fused tile height) of the network.
+        void CopyExecutionOptions(const Network2D& network) noexcept;
+
+        // Exception guarantee: base for this.
         // It clears the state without changing of the topology.
-        void Clear() noexcept;
+        void Clear();
 
         // It resets the state to zero including the topology.
         void Reset() noexcept;
@@ -66,29 +101,63 @@ namespace cnn
         // It loads full state.
         void Load(std::istream& istream);
 
-        // We expect that the method never throws any exception.
-        void FillWeights(common::ValueGenerator<T>& valueGenerator) noexcept;
+        // Exception guarantee: base for this.
+        void FillWeights(common::ValueGenerator<T>& valueGenerator);
+
+        // Exception guarantee: base for this.
+        void Mutate(common::Mutagen<T>& mutagen);
+
+        // Exception guarantee: strong for this.
+        // It shares the weights of the network of the same topology, so they are duplicated only when one of the sides writes them.
+        void ShareWeights(const Network2D& network);
+
+        // Exception guarantee: base for this.
+        // It copies the weights of the network of the same topology, so no memory is allocated, if own weights aren't shared.
+        void CopyWeights(const Network2D& network);
+
+        // Weights are indexed layer by layer (see Layer2D::GetWeight()).
+        size_t GetWeightCount() const noexcept;
 
-        // We expect that the method never throws any exception.
-        void Mutate(common::Mutagen<T>& mutagen) noexcept;
+        T GetWeight(const size_t index) const;
+
+        // Exception guarantee: strong for this.
+        void SetWeight(const size_t index, const T value);
 
       private:
 
         Network2DTopology Topology;
-        std::unique_ptr<Layer2D<T>[]> Layers;
+        common::ResourceArray<Layer2D<T>> Layers;
+
+        bool BlockedLayout;
+        BlockedTensor2D<T> BlockedInputs;
+
+        size_t FusedTileHeight;
 
         void CheckTopology(const Network2DTopology& topology) const;
 
+        // It packs the inputs of the layer and generates the outputs of it and all next layers in the blocked layout.
+        void GenerateBlockedOutput(const size_t beginLayer, common::ThreadPool* const threadPool);
+
+        // It generates the outputs of the layer and all next layers depth first, and the layer takes its inputs as they are.
+        void GenerateFusedOutput(const size_t beginLayer, common::ThreadPool* const threadPool);
+
+        // It returns the count of the first output rows of the layer, which the first outputRowCount rows of the last layer depend on.
+        size_t GetFusedRowCount(const size_t layerIndex, const size_t outputRowCount) const noexcept;
+
       };
 
       template <typename T>
-      Network2D<T>::Network2D(const Network2DTopology& topology)
+      Network2D<T>::Network2D(const Network2DTopology& topology, std::pmr::memory_resource* const resource)
+        :
+        BlockedLayout{ false },
+        BlockedInputs{ Size2D{}, 0, resource },
+        FusedTileHeight{ 0 }
       {
         CheckTopology(topology);
 
         Topology = topology;
 
-        Layers = std::make_unique<Layer2D<T>[]>(Topology.GetLayerCount());
+        Layers = common::MakeResourceArray<Layer2D<T>>(Topology.GetLayerCount(), resource, Layer2DTopology{});
         for (size_t i = 0; i < Topology.GetLayerCount(); ++i)
         {
           Layers[i].SetTopology(Topology.GetLayerTopology(i));
@@ -98,13 +167,12 @@ namespace cnn
       template <typename T>
       Network2D<T>::Network2D(const Network2D& network)
         :
-        Topology{ network.Topology }
+        Topology{ network.Topology },
+        Layers{ common::CopyResourceArray(network.Layers.get(), network.Topology.GetLayerCount(), network.GetResource()) },
+        BlockedLayout{ network.BlockedLayout },
+        BlockedInputs{ network.BlockedInputs },
+        FusedTileHeight{ network.FusedTileHeight }
       {
-        Layers = std::make_unique<Layer2D<T>[]>(Topology.GetLayerCount());
-        for (size_t i = 0; i < Topology.GetLayerCount(); ++i)
-        {
-          Layers[i] = network.Layers[i];
-        }
       }
 
       template <typename T>
@@ -128,11 +196,17 @@ namespace cnn
       template <typename T>
       void Network2D<T>::SetTopology(const Network2DTopology& topology)
       {
-        Network2D<T> tmpNetwork{ topology };
+        Network2D<T> tmpNetwork{ topology, GetResource() };
         // Beware, it is very intimate place for strong exception guarantee.
         std::swap(*this, tmpNetwork);
       }
 
+      template <typename T>
+      std::pmr::memory_resource* Network2D<T>::GetResource() const noexcept
+      {
+        return Layers.get_deleter().GetResource();
+      }
+
       template <typename T>
       const Layer2D<T>& Network2D<T>::GetLayer(const size_t index) const
       {
@@ -196,6 +270,17 @@ namespace cnn
       template <typename T>
       void Network2D<T>::GenerateOutput()
       {
+        if (BlockedLayout)
+        {
+          GenerateBlockedOutput(0, nullptr);
+          return;
+        }
+        if (FusedTileHeight != 0)
+        {
+          GenerateFusedOutput(0, nullptr);
+          return;
+        }
+
         for (size_t l = 0; l < Topology.GetLayerCount(); ++l)
         {
           auto& currentLayer = Layers[l];
@@ -213,12 +298,205 @@ namespace cnn
       }
 
       template <typename T>
-      void Network2D<T>::Clear() noexcept
+      void Network2D<T>::GenerateOutput(common::ThreadPool& threadPool)
+      {
+        if (BlockedLayout)
+        {
+          GenerateBlockedOutput(0, &threadPool);
+          return;
+        }
+        if (FusedTileHeight != 0)
+        {
+          GenerateFusedOutput(0, &threadPool);
+          return;
+        }
+
+        for (size_t l = 0; l < Topology.GetLayerCount(); ++l)
+        {
+          auto& currentLayer = Layers[l];
+          if (l != 0)
+          {
+            const auto& topology = Topology.GetLayerTopology(l);
+            const auto& previousLayer = Layers[l - 1];
+            for (size_t i = 0; i < topology.GetInputCount(); ++i)
+            {
+              currentLayer.GetInput(i).FillFrom(previousLayer.GetOutput(i));
+            }
+          }
+          currentLayer.GenerateOutput(threadPool);
+        }
+      }
+
+      template <typename T>
+      void Network2D<T>::GenerateOutputFromBinary(const uint64_t* const inputs)
+      {
+        if ((BlockedLayout) && (Topology.GetLayerCount() != 0))
+        {
+          Layers[0].GenerateOutputFromBinary(inputs);
+          GenerateBlockedOutput(1, nullptr);
+          return;
+        }
+        if ((FusedTileHeight != 0) && (Topology.GetLayerCount() > 1))
+        {
+          Layers[0].GenerateOutputFromBinary(inputs);
+          for (size_t i = 0; i < Topology.GetLayerTopology(1).GetInputCount(); ++i)
+          {
+            Layers[1].GetInput(i).FillFrom(std::as_const(Layers[0]).GetOutput(i));
+          }
+          GenerateFusedOutput(1, nullptr);
+          return;
+        }
+
+        for (size_t l = 0; l < Topology.GetLayerCount(); ++l)
+        {
+          auto& currentLayer = Layers[l];
+          if (l != 0)
+          {
+            const auto& topology = Topology.GetLayerTopology(l);
+            const auto& previousLayer = Layers[l - 1];
+            for (size_t i = 0; i < topology.GetInputCount(); ++i)
+            {
+              currentLayer.GetInput(i).FillFrom(previousLayer.GetOutput(i));
+            }
+            currentLayer.GenerateOutput();
+          }
+          else
+          {
+            currentLayer.GenerateOutputFromBinary(inputs);
+          }
+        }
+      }
+
+      template <typename T>
+      bool Network2D<T>::GetBlockedLayout() const noexcept
+      {
+        return BlockedLayout;
+      }
+
+      template <typename T>
+      void Network2D<T>::SetBlockedLayout(const bool blockedLayout) noexcept
+      {
+        BlockedLayout = blockedLayout;
+      }
+
+      template <typename T>
+      size_t Network2D<T>::GetFusedTileHeight() const noexcept
+      {
+        return FusedTileHeight;
+      }
+
+      template <typename T>
+      void Network2D<T>::SetFusedTileHeight(const size_t fusedTileHeight) noexcept
+      {
+        FusedTileHeight = fusedTileHeight;
+      }
+
+      template <typename T>
+      void Network2D<T>::CopyExecutionOptions(const Network2D& network) noexcept
+      {
+        BlockedLayout = network.BlockedLayout;
+        FusedTileHeight = network.FusedTileHeight;
+      }
+
+      template <typename T>
+      void Network2D<T>::GenerateFusedOutput(const size_t beginLayer, common::ThreadPool* const threadPool)
+      {
+        if (beginLayer >= Topology.GetLayerCount())
+        {
+          return;
+        }
+
+        const size_t lastLayer = Topology.GetLayerCount() - 1;
+        const size_t outputHeight = Topology.GetLayerTopology(lastLayer).GetOutputSize().GetHeight();
+        for (size_t bandBeginY = 0; bandBeginY < outputHeight; bandBeginY += FusedTileHeight)
+        {
+          const size_t bandEndY = std::min(bandBeginY + FusedTileHeight, outputHeight);
+          for (size_t l = beginLayer; l <= lastLayer; ++l)
+          {
+            // Rows before beginY are generated for the previous bands.
+            const size_t beginY = GetFusedRowCount(l, bandBeginY);
+            const size_t endY = GetFusedRowCount(l, bandEndY);
+            if (threadPool != nullptr)
+            {
+              Layers[l].GenerateOutputRows(beginY, endY, *threadPool);
+            }
+            else
+            {
+              Layers[l].GenerateOutputRows(beginY, endY);
+            }
+            if (l != lastLayer)
+            {
+              for (size_t i = 0; i < Topology.GetLayerTopology(l + 1).GetInputCount(); ++i)
+              {
+                Layers[l + 1].GetInput(i).FillFrom(std::as_const(Layers[l]).GetOutput(i), beginY, endY);
+              }
+            }
+          }
+        }
+      }
+
+      template <typename T>
+      size_t Network2D<T>::GetFusedRowCount(const size_t layerIndex, const size_t outputRowCount) const noexcept
+      {
+        size_t rowCount = outputRowCount;
+        for (size_t l = Topology.GetLayerCount() - 1; (l > layerIndex) && (rowCount != 0); --l)
+        {
+          // The rows of the layer depend on dilated core height - 1 more rows of its inputs, which are the outputs of the previous layer.
+          const auto& topology = Topology.GetLayerTopology(l);
+          rowCount = std::min(rowCount + topology.GetFilterTopology().GetDilatedSize().GetHeight() - 1, topology.GetInputSize().GetHeight());
+        }
+        return rowCount;
+      }
+
+      template <typename T>
+      void Network2D<T>::GenerateBlockedOutput(const size_t beginLayer, common::ThreadPool* const threadPool)
+      {
+        if (beginLayer >= Topology.GetLayerCount())
+        {
+          return;
+        }
+
+        const auto& topology = Topology.GetLayerTopology(beginLayer);
+        if ((BlockedInputs.GetSize() != topology.GetInputSize()) || (BlockedInputs.GetChannelCount() != topology.GetInputCount()))
+        {
+          BlockedInputs = BlockedTensor2D<T>{ topology.GetInputSize(), topology.GetInputCount(), GetResource() };
+        }
+        for (size_t i = 0; i < topology.GetInputCount(); ++i)
+        {
+          if (beginLayer == 0)
+          {
+            BlockedInputs.Pack(i, std::as_const(Layers[0]).GetInput(i));
+          }
+          else
+          {
+            BlockedInputs.Pack(i, std::as_const(Layers[beginLayer - 1]).GetOutput(i));
+          }
+        }
+
+        const BlockedTensor2D<T>* inputs = &BlockedInputs;
+        for (size_t l = beginLayer; l < Topology.GetLayerCount(); ++l)
+        {
+          if (threadPool != nullptr)
+          {
+            Layers[l].GenerateOutputFromBlocked(*inputs, *threadPool);
+          }
+          else
+          {
+            Layers[l].GenerateOutputFromBlocked(*inputs);
+          }
+          inputs = &Layers[l].GetBlockedOutputs();
+        }
+        Layers[Topology.GetLayerCount() - 1].UnpackBlockedOutputs();
+      }
+
+      template <typename T>
+      void Network2D<T>::Clear()
       {
         for (size_t i = 0; i < Topology.GetLayerCount(); ++i)
         {
           Layers[i].Clear();
         }
+        BlockedInputs.Clear();
       }
 
       template <typename T>
@@ -260,7 +538,7 @@ namespace cnn
         topology.Load(istream);
         CheckTopology(topology);
 
-        layers = std::make_unique<Layer2D<T>[]>(topology.GetLayerCount());
+        layers = common::MakeResourceArray<Layer2D<T>>(topology.GetLayerCount(), GetResource(), Layer2DTopology{});
         for (size_t i = 0; i < topology.GetLayerCount(); ++i)
         {
           layers[i].Load(istream);
@@ -280,7 +558,7 @@ namespace cnn
       }
 
       template <typename T>
-      void Network2D<T>::FillWeights(common::ValueGenerator<T>& valueGenerator) noexcept
+      void Network2D<T>::FillWeights(common::ValueGenerator<T>& valueGenerator)
       {
         for (size_t i = 0; i < Topology.GetLayerCount(); ++i)
         {
@@ -289,7 +567,7 @@ namespace cnn
       }
 
       template <typename T>
-      void Network2D<T>::Mutate(common::Mutagen<T>& mutagen) noexcept
+      void Network2D<T>::Mutate(common::Mutagen<T>& mutagen)
       {
         for (size_t i = 0; i < Topology.GetLayerCount(); ++i)
         {
@@ -325,6 +603,77 @@ namespace cnn
           }
         }
       }
+
+      template <typename T>
+      size_t Network2D<T>::GetWeightCount() const noexcept
+      {
+        size_t weightCount{};
+        for (size_t i = 0; i < Topology.GetLayerCount(); ++i)
+        {
+          weightCount += Layers[i].GetWeightCount();
+        }
+        return weightCount;
+      }
+
+      template <typename T>
+      T Network2D<T>::GetWeight(const size_t index) const
+      {
+        if (index >= GetWeightCount())
+        {
+          throw std::range_error("cnn::engine::convolution::Network2D::GetWeight() const, index >= GetWeightCount().");
+        }
+        size_t weightIndex = index;
+        size_t i = 0;
+        while (weightIndex >= Layers[i].GetWeightCount())
+        {
+          weightIndex -= Layers[i].GetWeightCount();
+          ++i;
+        }
+        return Layers[i].GetWeight(weightIndex);
+      }
+
+      template <typename T>
+      void Network2D<T>::SetWeight(const size_t index, const T value)
+      {
+        if (index >= GetWeightCount())
+        {
+          throw std::range_error("cnn::engine::convolution::Network2D::SetWeight(), index >= GetWeightCount().");
+        }
+        size_t weightIndex = index;
+        size_t i = 0;
+        while (weightIndex >= Layers[i].GetWeightCount())
+        {
+          weightIndex -= Layers[i].GetWeightCount();
+          ++i;
+        }
+        Layers[i].SetWeight(weightIndex, value);
+      }
+
+      template <typename T>
+      void Network2D<T>::ShareWeights(const Network2D& network)
+      {
+        if (Topology != network.Topology)
+        {
+          throw std::invalid_argument("cnn::engine::convolution::Network2D::ShareWeights(), Topology != network.Topology.");
+        }
+        for (size_t i = 0; i < Topology.GetLayerCount(); ++i)
+        {
+          Layers[i].ShareWeights(network.Layers[i]);
+        }
+      }
+
+      template <typename T>
+      void Network2D<T>::CopyWeights(const Network2D& network)
+      {
+        if (Topology != network.Topology)
+        {
+          throw std::invalid_argument("cnn::engine::convolution::Network2D::CopyWeights(), Topology != network.Topology.");
+        }
+        for (size_t i = 0; i < Topology.GetLayerCount(); ++i)
+        {
+          Layers[i].CopyWeights(network.Layers[i]);
+        }
+      }
     }
   }
 }
\ No newline at end of file
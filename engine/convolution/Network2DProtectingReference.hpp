@@ -50,18 +50,32 @@ namespace cnn
         // Exception guarantee: base for the network.
         void GenerateOutput() const;
 
+        // Exception guarantee: base for the network.
+        void GenerateOutput(common::ThreadPool& threadPool) const;
+
+        bool GetBlockedLayout() const noexcept;
+
+        void SetBlockedLayout(const bool blockedLayout) const noexcept;
+
+        size_t GetFusedTileHeight() const noexcept;
+
+        void SetFusedTileHeight(const size_t fusedTileHeight) const noexcept;
+
+        void CopyExecutionOptions(const Network2D<T>& network) const noexcept;
+
+        // Exception guarantee: base for the network.
         // It clears the state without changing of the topology of the network.
-        void Clear() const noexcept;
+        void Clear() const;
 
         // Exception guarantee: base for ostream.
         // It saves full state.
         void Save(std::ostream& ostream) const;
 
-        // We expect that the method never throws any exception.
-        void FillWeights(common::ValueGenerator<T>& valueGenerator) const noexcept;
+        // Exception guarantee: base for the network.
+        void FillWeights(common::ValueGenerator<T>& valueGenerator) const;
 
-        // We expect that the method never throws any exception.
-        void Mutate(common::Mutagen<T>& mutagen) const noexcept;
+        // Exception guarantee: base for the network.
+        void Mutate(common::Mutagen<T>& mutagen) const;
 
       private:
 
@@ -132,7 +146,43 @@ namespace cnn
       }
 
       template <typename T>
-      void Network2DProtectingReference<T>::Clear() const noexcept
+      void Network2DProtectingReference<T>::GenerateOutput(common::ThreadPool& threadPool) const
+      {
+        Network.GenerateOutput(threadPool);
+      }
+
+      template <typename T>
+      bool Network2DProtectingReference<T>::GetBlockedLayout() const noexcept
+      {
+        return Network.GetBlockedLayout();
+      }
+
+      template <typename T>
+      void Network2DProtectingReference<T>::SetBlockedLayout(const bool blockedLayout) const noexcept
+      {
+        Network.SetBlockedLayout(blockedLayout);
+      }
+
+      template <typename T>
+      size_t Network2DProtectingReference<T>::GetFusedTileHeight() const noexcept
+      {
+        return Network.GetFusedTileHeight();
+      }
+
+      template <typename T>
+      void Network2DProtectingReference<T>::SetFusedTileHeight(const size_t fusedTileHeight) const noexcept
+      {
+        Network.SetFusedTileHeight(fusedTileHeight);
+      }
+
+      template <typename T>
+      void Network2DProtectingReference<T>::CopyExecutionOptions(const Network2D<T>& network) const noexcept
+      {
+        Network.CopyExecutionOptions(network);
+      }
+
+      template <typename T>
+      void Network2DProtectingReference<T>::Clear() const
       {
         Network.Clear();
       }
@@ -144,13 +194,13 @@ namespace cnn
       }
 
       template <typename T>
-      void Network2DProtectingReference<T>::FillWeights(common::ValueGenerator<T>& valueGenerator) const noexcept
+      void Network2DProtectingReference<T>::FillWeights(common::ValueGenerator<T>& valueGenerator) const
       {
         Network.FillWeights(valueGenerator);
       }
 
       template <typename T>
-      void Network2DProtectingReference<T>::Mutate(common::Mutagen<T>& mutagen) const noexcept
+      void Network2DProtectingReference<T>::Mutate(common::Mutagen<T>& mutagen) const
       {
         Network.Mutate(mutagen);
       }
@@ -0,0 +1,169 @@
+#pragma once
+
+#include <cstddef>
+#include <type_traits>
+
+namespace cnn
+{
+  namespace engine
+  {
+    namespace convolution
+    {
+      // Winograd2DMatrices are the transforms of the minimal filtering algorithm F(m x m, 3 x 3)
+      // (Lavin and Gray, "Fast Algorithms for Convolutional Neural Networks").
+      template <size_t OUTPUT_TILE_SIZE>
+      struct Winograd2DMatrices;
+
+      template <>
+      struct Winograd2DMatrices<2>
+      {
+        constexpr static double INPUT[4][4] =
+        {
+          { 1,  0, -1,  0 },
+          { 0,  1,  1,  0 },
+          { 0, -1,  1,  0 },
+          { 0,  1,  0, -1 }
+        };
+
+        constexpr static double CORE[4][3] =
+        {
+          { 1,    0,   0   },
+          { 0.5,  0.5, 0.5 },
+          { 0.5, -0.5, 0.5 },
+          { 0,    0,   1   }
+        };
+
+        constexpr static double OUTPUT[2][4] =
+        {
+          { 1, 1,  1,  0 },
+          { 0, 1, -1, -1 }
+        };
+      };
+
+      template <>
+      struct Winograd2DMatrices<4>
+      {
+        constexpr static double INPUT[6][6] =
+        {
+          { 4,  0, -5,  0, 1, 0 },
+          { 0, -4, -4,  1, 1, 0 },
+          { 0,  4, -4, -1, 1, 0 },
+          { 0, -2, -1,  2, 1, 0 },
+          { 0,  2, -1, -2, 1, 0 },
+          { 0,  4,  0, -5, 0, 1 }
+        };
+
+        constexpr static double CORE[6][3] =
+        {
+          {  1.0 / 4,   0,          0        },
+          { -1.0 / 6,  -1.0 / 6,   -1.0 / 6  },
+          { -1.0 / 6,   1.0 / 6,   -1.0 / 6  },
+          {  1.0 / 24,  1.0 / 12,   1.0 / 6  },
+          {  1.0 / 24, -1.0 / 12,   1.0 / 6  },
+          {  0,         0,          1        }
+        };
+
+        constexpr static double OUTPUT[4][6] =
+        {
+          { 1, 1,  1, 1,  1, 0 },
+          { 0, 1, -1, 2, -2, 0 },
+          { 0, 1,  1, 4,  4, 0 },
+          { 0, 1, -1, 8, -8, 1 }
+        };
+      };
+
+      // Winograd2D computes a tile of m x m outputs of a 3 x 3 correlation by (m + 2) x (m + 2) multiplications
+      // instead of 9 * m * m: the output tile is OUTPUT * ((CORE * g * CORE^T) . (INPUT * d * INPUT^T)) * OUTPUT^T.
+      // All tiles are stored row by row (x + y * width).
+      template <typename T, size_t OUTPUT_TILE_SIZE>
+      class Winograd2D
+      {
+
+        static_assert(std::is_floating_point<T>::value);
+
+      public:
+
+        constexpr static size_t CORE_SIZE = 3;
+
+        constexpr static size_t INPUT_TILE_SIZE = OUTPUT_TILE_SIZE + CORE_SIZE - 1;
+
+        constexpr static size_t TILE_AREA = INPUT_TILE_SIZE * INPUT_TILE_SIZE;
+
+        // It transforms CORE_SIZE x CORE_SIZE weights to a tile of TILE_AREA values.
+        static void TransformCore(const T* const weights, T* const tile) noexcept;
+
+        // It transforms an input tile of TILE_AREA values in place.
+        static void TransformInput(T* const tile) noexcept;
+
+        // It transforms a tile of TILE_AREA products to OUTPUT_TILE_SIZE x OUTPUT_TILE_SIZE outputs.
+        static void TransformOutput(const T* const tile, T* const outputs) noexcept;
+
+      private:
+
+        using Matrices = Winograd2DMatrices<OUTPUT_TILE_SIZE>;
+
+        // It computes y = matrix * x * matrix^T, where x is COLUMN_COUNT x COLUMN_COUNT and y is ROW_COUNT x ROW_COUNT.
+        template <size_t ROW_COUNT, size_t COLUMN_COUNT>
+        static void Transform(const double (&matrix)[ROW_COUNT][COLUMN_COUNT], const T* const x, T* const y) noexcept;
+
+        ~Winograd2D() = delete;
+
+      };
+
+      template <typename T, size_t OUTPUT_TILE_SIZE>
+      void Winograd2D<T, OUTPUT_TILE_SIZE>::TransformCore(const T* const weights, T* const tile) noexcept
+      {
+        Transform(Matrices::CORE, weights, tile);
+      }
+
+      template <typename T, size_t OUTPUT_TILE_SIZE>
+      void Winograd2D<T, OUTPUT_TILE_SIZE>::TransformInput(T* const tile) noexcept
+      {
+        T input[TILE_AREA];
+        for (size_t i = 0; i < TILE_AREA; ++i)
+        {
+          input[i] = tile[i];
+        }
+        Transform(Matrices::INPUT, input, tile);
+      }
+
+      template <typename T, size_t OUTPUT_TILE_SIZE>
+      void Winograd2D<T, OUTPUT_TILE_SIZE>::TransformOutput(const T* const tile, T* const outputs) noexcept
+      {
+        Transform(Matrices::OUTPUT, tile, outputs);
+      }
+
+      template <typename T, size_t OUTPUT_TILE_SIZE>
+      template <size_t ROW_COUNT, size_t COLUMN_COUNT>
+      void Winograd2D<T, OUTPUT_TILE_SIZE>::Transform(const double (&matrix)[ROW_COUNT][COLUMN_COUNT], const T* const x, T* const y) noexcept
+      {
+        T product[ROW_COUNT][COLUMN_COUNT];
+        for (size_t r = 0; r < ROW_COUNT; ++r)
+        {
+          for (size_t c = 0; c < COLUMN_COUNT; ++c)
+          {
+            T sum{};
+            for (size_t k = 0; k < COLUMN_COUNT; ++k)
+            {
+              sum += static_cast<T>(matrix[r][k]) * x[c + k * COLUMN_COUNT];
+            }
+            product[r][c] = sum;
+          }
+        }
+
+        for (size_t r = 0; r < ROW_COUNT; ++r)
+        {
+          for (size_t c = 0; c < ROW_COUNT; ++c)
+          {
+            T sum{};
+            for (size_t k = 0; k < COLUMN_COUNT; ++k)
+            {
+              sum += product[r][k] * static_cast<T>(matrix[c][k]);
+            }
+            y[c + r * ROW_COUNT] = sum;
+          }
+        }
+      }
+    }
+  }
+}
@@ -8,7 +8,16 @@
 #include "../common/Neuron.hpp"
 #include "../common/NeuronProtectingReference.hpp"
 
+#include "../common/ThreadPool.hpp"
+#include "../common/MemoryResource.hpp"
+#include "../common/AlignedBuffer.hpp"
+#include "../common/HalfFloat.hpp"
+#include "../common/Activation.hpp"
+#include "../common/WeightStamp.hpp"
+
 #include <stdexcept>
+#include <algorithm>
+#include <memory_resource>
 
 namespace cnn
 {
@@ -24,7 +33,8 @@ namespace cnn
 
       public:
 
-        Layer(const LayerTopology& topology = {});
+        // The input, neurons and the output are allocated by the resource.
+        Layer(const LayerTopology& topology = {}, std::pmr::memory_resource* const resource = std::pmr::get_default_resource());
 
         Layer(const Layer& layer);
 
@@ -35,6 +45,8 @@ namespace cnn
 
         Layer& operator=(Layer&& layer) noexcept = default;
 
+        std::pmr::memory_resource* GetResource() const noexcept;
+
         const LayerTopology& GetTopology() const noexcept;
 
         // Exception guarantee: strong for this.
@@ -56,8 +68,32 @@ namespace cnn
         // Exception guarantee: base for this.
         void GenerateOutput();
 
+        // Exception guarantee: base for this.
+        // The work is split across blocks of neurons.
+        // Small layers are processed by the calling thread, because fork/join would cost more than the work.
+        void GenerateOutput(common::ThreadPool& threadPool);
+
+        common::WeightFormat GetWeightFormat() const noexcept;
+
+        // If the format isn't native, GenerateOutput() streams a 16-bit copy of weights, which is converted in registers,
+        // so the memory traffic of weights is halved, and sums are still accumulated in T.
+        // The copy is made on demand and is dropped, when weights are changed. The format is not saved.
+        // A sparse layer uses its compressed weights in T regardless of the format.
+        void SetWeightFormat(const common::WeightFormat format) noexcept;
+
+        bool IsSparse() const noexcept;
+
+        // A sparse layer applies only its nonzero weights, which are compressed by rows, and a dense layer applies all weights
+        // without scanning them. Layers are dense by default, complex::Pruning2D makes pruned layers sparse,
+        // and FillWeights(), Mutate(), Clear() and Load() make them dense. The state is not saved.
+        void SetSparse(const bool sparse) noexcept;
+
+        // It counts nonzero weights and returns true, if the sparse kernel is estimated to be faster than the dense one.
+        bool IsSparseFaster() const noexcept;
+
+        // Exception guarantee: base for this.
         // It clears the state without changing of the topology.
-        void Clear() noexcept;
+        void Clear();
 
         // It resets the state to zero including the topology.
         void Reset() noexcept;
@@ -70,40 +106,102 @@ namespace cnn
         // It loads full state.
         void Load(std::istream& istream);
 
-        // We expect that the method never throws any exception.
-        void FillWeights(common::ValueGenerator<T>& valueGenerator) noexcept;
+        // Exception guarantee: base for this.
+        void FillWeights(common::ValueGenerator<T>& valueGenerator);
+
+        // Exception guarantee: base for this.
+        void Mutate(common::Mutagen<T>& mutagen);
+
+        // Exception guarantee: strong for this.
+        // It shares the weights of the layer of the same topology, so they are duplicated only when one of the sides writes them.
+        // The sparsity state is taken from the layer too.
+        void ShareWeights(const Layer& layer);
+
+        // Exception guarantee: base for this.
+        // It copies the weights of the layer of the same topology, so no memory is allocated, if own weights aren't shared.
+        // The sparsity state is taken from the layer too.
+        void CopyWeights(const Layer& layer);
+
+        // Weights are indexed neuron by neuron.
+        size_t GetWeightCount() const noexcept;
 
-        // We expect that the method never throws any exception.
-        void Mutate(common::Mutagen<T>& mutagen) noexcept;
+        T GetWeight(const size_t index) const;
+
+        // Exception guarantee: strong for this.
+        void SetWeight(const size_t index, const T value);
 
       private:
 
+        // The count of multiply-adds, below which the layer is not split across threads.
+        constexpr static size_t MIN_PARALLEL_WORK = 32768;
+
+        // The sparse kernel is estimated to be faster, if weights outnumber nonzero weights this much, because every nonzero weight costs a gather.
+        constexpr static size_t MIN_SPARSE_RATIO = 2;
+
         LayerTopology Topology;
 
         common::Map<T> Input;
-        std::unique_ptr<common::Neuron<T>[]> Neurons;
+        common::ResourceArray<common::Neuron<T>> Neurons;
         common::Map<T> Output;
 
+        // Weights of neurons in the weight format, which are padded to cache lines neuron by neuron.
+        common::WeightFormat WeightFormat_;
+        common::AlignedBuffer<common::Float16> Float16Weights;
+        common::AlignedBuffer<common::BFloat16> BFloat16Weights;
+
+        // Nonzero weights of a sparse layer in the compressed sparse row format: weights of the neuron n and indices of their inputs
+        // are [SparseOffsets[n], SparseOffsets[n + 1]). Only the first SparseOffsets[neuron count] of them are used.
+        common::AlignedBuffer<T> SparseWeights;
+        common::AlignedBuffer<uint32_t> SparseIndices;
+        common::AlignedBuffer<size_t> SparseOffsets;
+        bool Sparse;
+
+        // Compact weights (16-bit or sparse ones) are valid, while their stamp is equal to the stamp of weights.
+        uint64_t WeightStamp;
+        uint64_t CompactWeightsStamp;
+
         void CheckTopology(const LayerTopology& topology) const;
 
+        void PrepareCompactWeights();
+
+        // It compresses the weights of a sparse layer.
+        void PrepareSparseWeights();
+
+        // It gives weights a new stamp, so compact weights are rebuilt.
+        void DropCompactWeights() noexcept;
+
+        // It generates outputs of neurons [beginNeuron, endNeuron).
+        void GenerateOutput(const size_t beginNeuron, const size_t endNeuron) noexcept;
+
+        void GenerateSparseOutput(const size_t beginNeuron, const size_t endNeuron) noexcept;
+
+        template <typename S>
+        void GenerateOutput(const common::AlignedBuffer<S>& weights, const size_t beginNeuron, const size_t endNeuron) noexcept;
+
       };
 
       template <typename T>
-      Layer<T>::Layer(const LayerTopology& topology)
+      Layer<T>::Layer(const LayerTopology& topology, std::pmr::memory_resource* const resource)
+        :
+        WeightFormat_{ common::WeightFormat::Native },
+        Float16Weights{ 0, resource },
+        BFloat16Weights{ 0, resource },
+        SparseWeights{ 0, resource },
+        SparseIndices{ 0, resource },
+        SparseOffsets{ 0, resource },
+        Sparse{ false },
+        WeightStamp{ common::WeightStamp::Generate() },
+        CompactWeightsStamp{ common::WeightStamp::NONE }
       {
         CheckTopology(topology);
 
         Topology = topology;
 
-        Input.SetValueCount(Topology.GetInputCount());
+        Input = common::Map<T>{ Topology.GetInputCount(), resource };
 
-        Neurons = std::make_unique<common::Neuron<T>[]>(Topology.GetNeuronCount());
-        for (size_t i = 0; i < Topology.GetNeuronCount(); ++i)
-        {
-          Neurons[i].SetInputCount(Topology.GetInputCount());
-        }
+        Neurons = common::MakeResourceArray<common::Neuron<T>>(Topology.GetNeuronCount(), resource, Topology.GetInputCount());
 
-        Output.SetValueCount(Topology.GetNeuronCount());
+        Output = common::Map<T>{ Topology.GetNeuronCount(), resource };
       }
 
       template <typename T>
@@ -111,13 +209,19 @@ namespace cnn
         :
         Topology{ layer.Topology },
         Input{ layer.Input },
-        Output{ layer.Output }
+        Neurons{ common::CopyResourceArray(layer.Neurons.get(), layer.Topology.GetNeuronCount(), layer.GetResource()) },
+        Output{ layer.Output },
+        WeightFormat_{ layer.WeightFormat_ },
+        Float16Weights{ 0, layer.GetResource() },
+        BFloat16Weights{ 0, layer.GetResource() },
+        SparseWeights{ 0, layer.GetResource() },
+        SparseIndices{ 0, layer.GetResource() },
+        SparseOffsets{ 0, layer.GetResource() },
+        Sparse{ layer.Sparse },
+        WeightStamp{ layer.WeightStamp },
+        CompactWeightsStamp{ common::WeightStamp::NONE }
       {
-        Neurons = std::make_unique<common::Neuron<T>[]>(Topology.GetNeuronCount());
-        for (size_t i = 0; i < Topology.GetNeuronCount(); ++i)
-        {
-          Neurons[i] = layer.Neurons[i];
-        }
+        // Compact weights are derived from the weights, so the copy builds them on demand.
       }
 
       template <typename T>
@@ -133,6 +237,12 @@ namespace cnn
       }
 
 
+      template <typename T>
+      std::pmr::memory_resource* Layer<T>::GetResource() const noexcept
+      {
+        return Neurons.get_deleter().GetResource();
+      }
+
       template <typename T>
       const LayerTopology& Layer<T>::GetTopology() const noexcept
       {
@@ -142,7 +252,7 @@ namespace cnn
       template <typename T>
       void Layer<T>::SetTopology(const LayerTopology& topology)
       {
-        Layer<T> tmpLayer{ topology };
+        Layer<T> tmpLayer{ topology, GetResource() };
         // Beware, it is very intimate place for strong exception guarantee.
         std::swap(*this, tmpLayer);
       }
@@ -176,7 +286,7 @@ namespace cnn
         {
           throw std::range_error("cnn::engine::perceptron::Layer::GetNeuron(), index >= Topology.GetNeuronCount().");
         }
-        return Neurons[index];
+        return common::NeuronProtectingReference<T>{ Neurons[index], &WeightStamp };
       }
 
       template <typename T>
@@ -194,20 +304,243 @@ namespace cnn
       template <typename T>
       void Layer<T>::GenerateOutput()
       {
-        for (size_t n = 0; n < Topology.GetNeuronCount(); ++n)
+        PrepareCompactWeights();
+        GenerateOutput(0, Topology.GetNeuronCount());
+      }
+
+      template <typename T>
+      void Layer<T>::GenerateOutput(common::ThreadPool& threadPool)
+      {
+        const size_t threadCount = threadPool.GetThreadCount();
+        const size_t neuronCount = Topology.GetNeuronCount();
+        if ((threadCount == 1) || (Topology.GetInputCount() * neuronCount < MIN_PARALLEL_WORK))
+        {
+          GenerateOutput();
+          return;
+        }
+
+        PrepareCompactWeights();
+
+        const size_t blockCount = std::min(neuronCount, threadCount);
+        const size_t blockSize = (neuronCount + blockCount - 1) / blockCount;
+
+        auto task = [this, blockSize, neuronCount](const size_t taskIndex)
+        {
+          const size_t beginNeuron = taskIndex * blockSize;
+          GenerateOutput(beginNeuron, std::min(beginNeuron + blockSize, neuronCount));
+        };
+        threadPool.ParallelFor((neuronCount + blockSize - 1) / blockSize, task);
+      }
+
+      template <typename T>
+      common::WeightFormat Layer<T>::GetWeightFormat() const noexcept
+      {
+        return WeightFormat_;
+      }
+
+      template <typename T>
+      void Layer<T>::SetWeightFormat(const common::WeightFormat format) noexcept
+      {
+        if (WeightFormat_ != format)
+        {
+          WeightFormat_ = format;
+          CompactWeightsStamp = common::WeightStamp::NONE;
+        }
+      }
+
+      template <typename T>
+      bool Layer<T>::IsSparse() const noexcept
+      {
+        return Sparse;
+      }
+
+      template <typename T>
+      void Layer<T>::SetSparse(const bool sparse) noexcept
+      {
+        if (Sparse != sparse)
         {
-          auto& neuron = Neurons[n];
-          for (size_t i = 0; i < Topology.GetInputCount(); ++i)
+          Sparse = sparse;
+          CompactWeightsStamp = common::WeightStamp::NONE;
+        }
+      }
+
+      template <typename T>
+      bool Layer<T>::IsSparseFaster() const noexcept
+      {
+        const size_t inputCount = Topology.GetInputCount();
+        const size_t neuronCount = Topology.GetNeuronCount();
+
+        size_t nonzeroCount{};
+        for (size_t n = 0; n < neuronCount; ++n)
+        {
+          const T* const weights = Neurons[n].GetWeights();
+          nonzeroCount += static_cast<size_t>(std::count_if(weights, weights + inputCount, [](const T weight) { return weight != 0; }));
+        }
+        return nonzeroCount * MIN_SPARSE_RATIO <= inputCount * neuronCount;
+      }
+
+      template <typename T>
+      void Layer<T>::PrepareCompactWeights()
+      {
+        if (CompactWeightsStamp == WeightStamp)
+        {
+          return;
+        }
+        if (Sparse)
+        {
+          PrepareSparseWeights();
+          CompactWeightsStamp = WeightStamp;
+          return;
+        }
+        if (WeightFormat_ == common::WeightFormat::Native)
+        {
+          CompactWeightsStamp = WeightStamp;
+          return;
+        }
+
+        const size_t inputCount = Topology.GetInputCount();
+        const size_t neuronCount = Topology.GetNeuronCount();
+        if (WeightFormat_ == common::WeightFormat::Float16)
+        {
+          const size_t stride = common::GetPaddedCount<common::Float16>(inputCount);
+          if (Float16Weights.GetCount() != stride * neuronCount)
           {
-            neuron.SetInput(i, Input.GetValue(i));
+            Float16Weights = common::AlignedBuffer<common::Float16>{ stride * neuronCount, GetResource() };
+          }
+          for (size_t n = 0; n < neuronCount; ++n)
+          {
+            common::HalfFloat::Convert(Neurons[n].GetWeights(), Float16Weights.GetData() + n * stride, inputCount);
+          }
+        }
+        else
+        {
+          const size_t stride = common::GetPaddedCount<common::BFloat16>(inputCount);
+          if (BFloat16Weights.GetCount() != stride * neuronCount)
+          {
+            BFloat16Weights = common::AlignedBuffer<common::BFloat16>{ stride * neuronCount, GetResource() };
+          }
+          for (size_t n = 0; n < neuronCount; ++n)
+          {
+            common::HalfFloat::Convert(Neurons[n].GetWeights(), BFloat16Weights.GetData() + n * stride, inputCount);
+          }
+        }
+        CompactWeightsStamp = WeightStamp;
+      }
+
+      template <typename T>
+      void Layer<T>::PrepareSparseWeights()
+      {
+        const size_t inputCount = Topology.GetInputCount();
+        const size_t neuronCount = Topology.GetNeuronCount();
+
+        size_t nonzeroCount{};
+        for (size_t n = 0; n < neuronCount; ++n)
+        {
+          const T* const weights = Neurons[n].GetWeights();
+          nonzeroCount += static_cast<size_t>(std::count_if(weights, weights + inputCount, [](const T weight) { return weight != 0; }));
+        }
+
+        // The buffers only grow, so they aren't reallocated, when mutations change the count a little.
+        if (SparseWeights.GetCount() < nonzeroCount)
+        {
+          SparseWeights = common::AlignedBuffer<T>{ nonzeroCount, GetResource() };
+          SparseIndices = common::AlignedBuffer<uint32_t>{ nonzeroCount, GetResource() };
+        }
+        if (SparseOffsets.GetCount() != neuronCount + 1)
+        {
+          SparseOffsets = common::AlignedBuffer<size_t>{ neuronCount + 1, GetResource() };
+        }
+
+        size_t k{};
+        for (size_t n = 0; n < neuronCount; ++n)
+        {
+          SparseOffsets.GetData()[n] = k;
+          const T* const weights = Neurons[n].GetWeights();
+          for (size_t i = 0; i < inputCount; ++i)
+          {
+            if (weights[i] != 0)
+            {
+              SparseWeights.GetData()[k] = weights[i];
+              SparseIndices.GetData()[k] = static_cast<uint32_t>(i);
+              ++k;
+            }
           }
-          neuron.GenerateOutput();
-          Output.SetValue(n, neuron.GetOutput());
         }
+        SparseOffsets.GetData()[neuronCount] = k;
       }
 
       template <typename T>
-      void Layer<T>::Clear() noexcept
+      void Layer<T>::DropCompactWeights() noexcept
+      {
+        WeightStamp = common::WeightStamp::Generate();
+      }
+
+      template <typename T>
+      void Layer<T>::GenerateOutput(const size_t beginNeuron, const size_t endNeuron) noexcept
+      {
+        if (Sparse)
+        {
+          GenerateSparseOutput(beginNeuron, endNeuron);
+          return;
+        }
+        if (WeightFormat_ == common::WeightFormat::Float16)
+        {
+          GenerateOutput(Float16Weights, beginNeuron, endNeuron);
+          return;
+        }
+        if (WeightFormat_ == common::WeightFormat::BFloat16)
+        {
+          GenerateOutput(BFloat16Weights, beginNeuron, endNeuron);
+          return;
+        }
+
+        const size_t inputCount = Topology.GetInputCount();
+        const T* const input = Input.GetValues();
+        T* const output = Output.GetValues();
+        for (size_t n = beginNeuron; n < endNeuron; ++n)
+        {
+          output[n] = common::HalfFloat::DotProduct(input, Neurons[n].GetWeights(), inputCount);
+        }
+        common::Activation::Activate(Topology.GetActivationType(), output + beginNeuron, endNeuron - beginNeuron);
+      }
+
+      template <typename T>
+      void Layer<T>::GenerateSparseOutput(const size_t beginNeuron, const size_t endNeuron) noexcept
+      {
+        const T* const input = Input.GetValues();
+        T* const output = Output.GetValues();
+        const T* const weights = SparseWeights.GetData();
+        const uint32_t* const indices = SparseIndices.GetData();
+        const size_t* const offsets = SparseOffsets.GetData();
+        for (size_t n = beginNeuron; n < endNeuron; ++n)
+        {
+          T sum{};
+          for (size_t k = offsets[n]; k < offsets[n + 1]; ++k)
+          {
+            sum += input[indices[k]] * weights[k];
+          }
+          output[n] = sum;
+        }
+        common::Activation::Activate(Topology.GetActivationType(), output + beginNeuron, endNeuron - beginNeuron);
+      }
+
+      template <typename T>
+      template <typename S>
+      void Layer<T>::GenerateOutput(const common::AlignedBuffer<S>& weights, const size_t beginNeuron, const size_t endNeuron) noexcept
+      {
+        const size_t inputCount = Topology.GetInputCount();
+        const size_t stride = common::GetPaddedCount<S>(inputCount);
+        const T* const input = Input.GetValues();
+        T* const output = Output.GetValues();
+        for (size_t n = beginNeuron; n < endNeuron; ++n)
+        {
+          output[n] = common::HalfFloat::DotProduct(input, weights.GetData() + n * stride, inputCount);
+        }
+        common::Activation::Activate(Topology.GetActivationType(), output + beginNeuron, endNeuron - beginNeuron);
+      }
+
+      template <typename T>
+      void Layer<T>::Clear()
       {
         Input.Clear();
         for (size_t i = 0; i < Topology.GetNeuronCount(); ++i)
@@ -215,6 +548,8 @@ namespace cnn
           Neurons[i].Clear();
         }
         Output.Clear();
+        Sparse = false;
+        DropCompactWeights();
       }
 
       template <typename T>
@@ -224,6 +559,8 @@ namespace cnn
         Input.Reset();
         Neurons.reset(nullptr);
         Output.Reset();
+        Sparse = false;
+        DropCompactWeights();
       }
 
       template <typename T>
@@ -257,9 +594,9 @@ namespace cnn
         }
 
         decltype(Topology) topology;
-        decltype(Input) input;
+        decltype(Input) input{ 0, GetResource() };
         decltype(Neurons) neurons;
-        decltype(Output) output;
+        decltype(Output) output{ 0, GetResource() };
 
         topology.Load(istream);
         CheckTopology(topology);
@@ -270,7 +607,7 @@ namespace cnn
           throw std::logic_error("cnn::engine::perceptron::Layer::Load(), input.GetValueCount() != topology.GetInputCount().");
         }
 
-        neurons = std::make_unique<common::Neuron<T>[]>(topology.GetNeuronCount());
+        neurons = common::MakeResourceArray<common::Neuron<T>>(topology.GetNeuronCount(), GetResource(), size_t{ 0 });
         for (size_t i = 0; i < topology.GetNeuronCount(); ++i)
         {
           neurons[i].Load(istream);
@@ -295,29 +632,40 @@ namespace cnn
         Input = std::move(input);
         Neurons = std::move(neurons);
         Output = std::move(output);
+        Sparse = false;
+        DropCompactWeights();
       }
 
       template <typename T>
-      void Layer<T>::FillWeights(common::ValueGenerator<T>& valueGenerator) noexcept
+      void Layer<T>::FillWeights(common::ValueGenerator<T>& valueGenerator)
       {
         for (size_t i = 0; i < Topology.GetNeuronCount(); ++i)
         {
           Neurons[i].FillWeights(valueGenerator);
         }
+        Sparse = false;
+        DropCompactWeights();
       }
 
       template <typename T>
-      void Layer<T>::Mutate(common::Mutagen<T>& mutagen) noexcept
+      void Layer<T>::Mutate(common::Mutagen<T>& mutagen)
       {
         for (size_t i = 0; i < Topology.GetNeuronCount(); ++i)
         {
           Neurons[i].Mutate(mutagen);
         }
+        Sparse = false;
+        DropCompactWeights();
       }
 
       template <typename T>
       void Layer<T>::CheckTopology(const LayerTopology& topology) const
       {
+        if (common::Activation::IsValid(topology.GetActivationType()) == false)
+        {
+          throw std::invalid_argument("cnn::engine::perceptron::Layer::CheckTopology(), common::Activation::IsValid(topology.GetActivationType()) == false.");
+        }
+
         // Zero topology is allowed.
         if ((topology.GetInputCount() == 0) && (topology.GetNeuronCount() == 0))
         {
@@ -329,6 +677,66 @@ namespace cnn
           throw std::invalid_argument("cnn::engine::perceptron::Layer::CheckTopology(), (topology.GetInputCount() == 0) || (topology.GetNeuronCount() == 0).");
         }
       }
+
+      template <typename T>
+      size_t Layer<T>::GetWeightCount() const noexcept
+      {
+        return Topology.GetNeuronCount() * Topology.GetInputCount();
+      }
+
+      template <typename T>
+      T Layer<T>::GetWeight(const size_t index) const
+      {
+        if (index >= GetWeightCount())
+        {
+          throw std::range_error("cnn::engine::perceptron::Layer::GetWeight() const, index >= GetWeightCount().");
+        }
+        return Neurons[index / Topology.GetInputCount()].GetWeight(index % Topology.GetInputCount());
+      }
+
+      template <typename T>
+      void Layer<T>::SetWeight(const size_t index, const T value)
+      {
+        if (index >= GetWeightCount())
+        {
+          throw std::range_error("cnn::engine::perceptron::Layer::SetWeight(), index >= GetWeightCount().");
+        }
+        Neurons[index / Topology.GetInputCount()].SetWeight(index % Topology.GetInputCount(), value);
+        DropCompactWeights();
+      }
+
+      template <typename T>
+      void Layer<T>::ShareWeights(const Layer& layer)
+      {
+        if (Topology != layer.Topology)
+        {
+          throw std::invalid_argument("cnn::engine::perceptron::Layer::ShareWeights(), Topology != layer.Topology.");
+        }
+        for (size_t i = 0; i < Topology.GetNeuronCount(); ++i)
+        {
+          Neurons[i].ShareWeights(layer.Neurons[i]);
+        }
+        // Compact weights, which were built for these weights, stay valid, unless the sparsity state is changed.
+        SetSparse(layer.Sparse);
+        WeightStamp = layer.WeightStamp;
+      }
+
+      template <typename T>
+      void Layer<T>::CopyWeights(const Layer& layer)
+      {
+        if (Topology != layer.Topology)
+        {
+          throw std::invalid_argument("cnn::engine::perceptron::Layer::CopyWeights(), Topology != layer.Topology.");
+        }
+        // Weights stay mixed, if a copy throws.
+        DropCompactWeights();
+        for (size_t i = 0; i < Topology.GetNeuronCount(); ++i)
+        {
+          Neurons[i].CopyWeights(layer.Neurons[i]);
+        }
+        SetSparse(layer.Sparse);
+        WeightStamp = layer.WeightStamp;
+      }
     }
   }
 }
\ No newline at end of file
@@ -48,18 +48,32 @@ namespace cnn
         // Exception guarantee: base for the layer.
         void GenerateOutput() const;
 
+        // Exception guarantee: base for the layer.
+        void GenerateOutput(common::ThreadPool& threadPool) const;
+
+        common::WeightFormat GetWeightFormat() const noexcept;
+
+        void SetWeightFormat(const common::WeightFormat format) const noexcept;
+
+        bool IsSparse() const noexcept;
+
+        void SetSparse(const bool sparse) const noexcept;
+
+        bool IsSparseFaster() const noexcept;
+
+        // Exception guarantee: base for the layer.
         // It clears the state without changing of the topology of the layer.
-        void Clear() const noexcept;
+        void Clear() const;
 
         // Exception guarantee: base for ostream.
         // It saves full state.
         void Save(std::ostream& ostream) const;
 
-        // We expect that the method never throws any exception.
-        void FillWeights(common::ValueGenerator<T>& valueGenerator) const noexcept;
+        // Exception guarantee: base for the layer.
+        void FillWeights(common::ValueGenerator<T>& valueGenerator) const;
 
-        // We expect that the method never throws any exception.
-        void Mutate(common::Mutagen<T>& mutagen) const noexcept;
+        // Exception guarantee: base for the layer.
+        void Mutate(common::Mutagen<T>& mutagen) const;
 
       private:
 
@@ -130,7 +144,43 @@ namespace cnn
       }
 
       template <typename T>
-      void LayerProtectingReference<T>::Clear() const noexcept
+      void LayerProtectingReference<T>::GenerateOutput(common::ThreadPool& threadPool) const
+      {
+        Layer_.GenerateOutput(threadPool);
+      }
+
+      template <typename T>
+      common::WeightFormat LayerProtectingReference<T>::GetWeightFormat() const noexcept
+      {
+        return Layer_.GetWeightFormat();
+      }
+
+      template <typename T>
+      void LayerProtectingReference<T>::SetWeightFormat(const common::WeightFormat format) const noexcept
+      {
+        Layer_.SetWeightFormat(format);
+      }
+
+      template <typename T>
+      bool LayerProtectingReference<T>::IsSparse() const noexcept
+      {
+        return Layer_.IsSparse();
+      }
+
+      template <typename T>
+      void LayerProtectingReference<T>::SetSparse(const bool sparse) const noexcept
+      {
+        Layer_.SetSparse(sparse);
+      }
+
+      template <typename T>
+      bool LayerProtectingReference<T>::IsSparseFaster() const noexcept
+      {
+        return Layer_.IsSparseFaster();
+      }
+
+      template <typename T>
+      void LayerProtectingReference<T>::Clear() const
       {
         Layer_.Clear();
       }
@@ -142,13 +192,13 @@ namespace cnn
       }
 
       template <typename T>
-      void LayerProtectingReference<T>::FillWeights(common::ValueGenerator<T>& valueGenerator) const noexcept
+      void LayerProtectingReference<T>::FillWeights(common::ValueGenerator<T>& valueGenerator) const
       {
         Layer_.FillWeights(valueGenerator);
       }
 
       template <typename T>
-      void LayerProtectingReference<T>::Mutate(common::Mutagen<T>& mutagen) const noexcept
+      void LayerProtectingReference<T>::Mutate(common::Mutagen<T>& mutagen) const
       {
         Layer_.Mutate(mutagen);
       }
@@ -8,17 +8,20 @@ namespace cnn
     {
 
       LayerTopology::LayerTopology(const size_t inputCount,
-                                   const size_t neuronCount)
+                                   const size_t neuronCount,
+                                   const common::ActivationType activationType)
         :
         InputCount{ inputCount },
-        NeuronCount{ neuronCount }
+        NeuronCount{ neuronCount },
+        ActivationType{ activationType }
       {
       }
 
       LayerTopology::LayerTopology(LayerTopology&& topology) noexcept
         :
         InputCount{ topology.InputCount },
-        NeuronCount{ topology.NeuronCount }
+        NeuronCount{ topology.NeuronCount },
+        ActivationType{ topology.ActivationType }
       {
         topology.Reset();
       }
@@ -29,6 +32,7 @@ namespace cnn
         {
           InputCount = topology.InputCount;
           NeuronCount = topology.NeuronCount;
+          ActivationType = topology.ActivationType;
 
           topology.Reset();
         }
@@ -37,7 +41,7 @@ namespace cnn
 
       bool LayerTopology::operator==(const LayerTopology& topology) const noexcept
       {
-        if ((InputCount == topology.InputCount) && (NeuronCount == topology.NeuronCount))
+        if ((InputCount == topology.InputCount) && (NeuronCount == topology.NeuronCount) && (ActivationType == topology.ActivationType))
         {
           return true;
         } else {
@@ -75,10 +79,21 @@ namespace cnn
         NeuronCount = neuronCount;
       }
 
+      common::ActivationType LayerTopology::GetActivationType() const noexcept
+      {
+        return ActivationType;
+      }
+
+      void LayerTopology::SetActivationType(const common::ActivationType activationType) noexcept
+      {
+        ActivationType = activationType;
+      }
+
       void LayerTopology::Reset() noexcept
       {
         InputCount = 0;
         NeuronCount = 0;
+        ActivationType = common::ActivationType::Sigmoid;
       }
 
       void LayerTopology::Save(std::ostream& ostream) const
@@ -88,8 +103,10 @@ namespace cnn
           throw std::invalid_argument("cnn::engine::perceptron::LayerTopology::Save(), ostream.good() == false.");
         }
 
+        common::FormatVersion::Save(ostream, FORMAT_VERSION);
         ostream.write(reinterpret_cast<const char* const>(&InputCount), sizeof(InputCount));
         ostream.write(reinterpret_cast<const char* const>(&NeuronCount), sizeof(NeuronCount));
+        ostream.write(reinterpret_cast<const char* const>(&ActivationType), sizeof(ActivationType));
 
         if (ostream.good() == false)
         {
@@ -106,9 +123,15 @@ namespace cnn
 
         decltype(InputCount) inputCount{};
         decltype(NeuronCount) neuronCount{};
+        decltype(ActivationType) activationType{ common::ActivationType::Sigmoid };
 
-        istream.read(reinterpret_cast<char* const>(&inputCount), sizeof(inputCount));
+        // The input count is the first value of the stream.
+        const uint32_t version = common::FormatVersion::Load(istream, FORMAT_VERSION, inputCount);
         istream.read(reinterpret_cast<char* const>(&neuronCount), sizeof(neuronCount));
+        if (version != common::FormatVersion::LEGACY)
+        {
+          istream.read(reinterpret_cast<char* const>(&activationType), sizeof(activationType));
+        }
 
         if (istream.good() == false)
         {
@@ -117,6 +140,7 @@ namespace cnn
 
         InputCount = inputCount;
         NeuronCount = neuronCount;
+        ActivationType = activationType;
 
       }
     }
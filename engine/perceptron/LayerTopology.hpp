@@ -5,6 +5,9 @@
 #include <istream>
 #include <ostream>
 
+#include "../common/Activation.hpp"
+#include "../common/FormatVersion.hpp"
+
 namespace cnn
 {
   namespace engine
@@ -20,7 +23,8 @@ namespace cnn
       public:
 
         LayerTopology(const size_t inputCount = 0,
-                      const size_t neuronCount = 0);
+                      const size_t neuronCount = 0,
+                      const common::ActivationType activationType = common::ActivationType::Sigmoid);
 
         LayerTopology(const LayerTopology& topology) noexcept = default;
 
@@ -42,18 +46,27 @@ namespace cnn
 
         void SetNeuronCount(const size_t neuronCount) noexcept;
 
+        common::ActivationType GetActivationType() const noexcept;
+
+        void SetActivationType(const common::ActivationType activationType) noexcept;
+
         void Reset() noexcept;
 
         // Exception guarantee: base for ostream.
         void Save(std::ostream& ostream) const;
 
         // Exception guarantee: strong for this and base for istream.
+        // Legacy streams (see common::FormatVersion) are loaded with sigmoid activation.
         void Load(std::istream& istream);
 
       private:
 
+        // Version 1 adds the activation type.
+        constexpr static uint32_t FORMAT_VERSION = 1;
+
         size_t InputCount;
         size_t NeuronCount;
+        common::ActivationType ActivationType;
 
       };
     }
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <memory_resource>
+
 #include "NetworkTopology.hpp"
 
 #include "Layer.hpp"
@@ -19,7 +21,8 @@ namespace cnn
 
       public:
 
-        Network(const NetworkTopology& topology = {});
+        // Layers are allocated by the resource.
+        Network(const NetworkTopology& topology = {}, std::pmr::memory_resource* const resource = std::pmr::get_default_resource());
 
         Network(const Network& network);
 
@@ -34,6 +37,8 @@ namespace cnn
         // Exception guarantee: strong for the network.
         void SetTopology(const NetworkTopology& topology);
 
+        std::pmr::memory_resource* GetResource() const noexcept;
+
         const Layer<T>& GetLayer(const size_t index) const;
 
         // Exception guarantee: strong for this.
@@ -52,8 +57,37 @@ namespace cnn
         // Exception guarantee: base for this.
         void GenerateOutput();
 
+        // Exception guarantee: base for this.
+        // Every layer splits its work across the pool, if it is large enough.
+        void GenerateOutput(common::ThreadPool& threadPool);
+
+        common::WeightFormat GetWeightFormat() const noexcept;
+
+        // It sets the weight format of all layers (see Layer::SetWeightFormat()). The format is not saved.
+        void SetWeightFormat(const common::WeightFormat format) noexcept;
+
+        bool GetFusedHead() const noexcept;
+
+        // The head is the tail of small layers (see GetHeadBeginLayer()), which is computed by one kernel:
+        // activations of its layers stay in registers and L1 cache, so only the outputs of the last layer are updated.
+        // Inputs and outputs of other layers of the head are not. The kernel reads native weights. The option is not saved.
+        void SetFusedHead(const bool fusedHead) noexcept;
+
+        // It returns the index of the first layer of the head, which inputs and neurons are not more than MAX_HEAD_WIDTH,
+        // or the layer count, if the last layer is wider.
+        size_t GetHeadBeginLayer() const noexcept;
+
+        // Exception guarantee: strong for this.
+        // It generates outputs [sample][neuron] of the last layer by inputs [sample][input] of the head for sampleCount samples.
+        // HEAD_SAMPLE_COUNT samples are processed at once, so every weight is loaded once per block of samples.
+        void GenerateHeadOutputs(const T* const inputs, T* const outputs, const size_t sampleCount) const;
+
+        // It copies the options of the execution (the weight format and the fused head) of the network.
+        void CopyExecutionOptions(const Network& network) noexcept;
+
+        // Exception guarantee: base for this.
         // It clears the state without changing of the topology.
-        void Clear() noexcept;
+        void Clear();
 
         // It resets the state to zero including the topology.
         void Reset() noexcept;
@@ -66,29 +100,63 @@ namespace cnn
         // It loads full state.
         void Load(std::istream& istream);
 
-        // We expect that the method never throws any exception.
-        void FillWeights(common::ValueGenerator<T>& valueGenerator) noexcept;
+        // Exception guarantee: base for this.
+        void FillWeights(common::ValueGenerator<T>& valueGenerator);
+
+        // Exception guarantee: base for this.
+        void Mutate(common::Mutagen<T>& mutagen);
+
+        // Exception guarantee: strong for this.
+        // It shares the weights of the network of the same topology, so they are duplicated only when one of the sides writes them.
+        void ShareWeights(const Network& network);
+
+        // Exception guarantee: base for this.
+        // It copies the weights of the network of the same topology, so no memory is allocated, if own weights aren't shared.
+        void CopyWeights(const Network& network);
+
+        // Weights are indexed layer by layer (see Layer::GetWeight()).
+        size_t GetWeightCount() const noexcept;
+
+        T GetWeight(const size_t index) const;
+
+        // Exception guarantee: strong for this.
+        void SetWeight(const size_t index, const T value);
+
+        // The maximum input and neuron count of a layer of the head.
+        constexpr static size_t MAX_HEAD_WIDTH = 32;
 
-        // We expect that the method never throws any exception.
-        void Mutate(common::Mutagen<T>& mutagen) noexcept;
+        // The count of samples, which the head kernel processes at once.
+        constexpr static size_t HEAD_SAMPLE_COUNT = 8;
 
       private:
 
         NetworkTopology Topology;
-        std::unique_ptr<Layer<T>[]> Layers;
+        common::ResourceArray<Layer<T>> Layers;
+        common::WeightFormat WeightFormat_;
+        bool FusedHead;
 
         void CheckTopology(const NetworkTopology& topology) const;
 
+        // It generates the outputs of the last layer by the outputs of the layer before the head.
+        void GenerateHeadOutput(const size_t beginLayer);
+
+        // Values of every layer are kept as [neuron][sample], so the samples of a neuron are one vector.
+        template <size_t SAMPLE_COUNT>
+        void GenerateHeadOutputs(const size_t beginLayer, const T* const inputs, T* const outputs) const;
+
       };
 
       template <typename T>
-      Network<T>::Network(const NetworkTopology& topology)
+      Network<T>::Network(const NetworkTopology& topology, std::pmr::memory_resource* const resource)
+        :
+        WeightFormat_{ common::WeightFormat::Native },
+        FusedHead{ false }
       {
         CheckTopology(topology);
 
         Topology = topology;
 
-        Layers = std::make_unique<Layer<T>[]>(Topology.GetLayerCount());
+        Layers = common::MakeResourceArray<Layer<T>>(Topology.GetLayerCount(), resource, LayerTopology{});
         for (size_t i = 0; i < Topology.GetLayerCount(); ++i)
         {
           Layers[i].SetTopology(Topology.GetLayerTopology(i));
@@ -98,13 +166,11 @@ namespace cnn
       template <typename T>
       Network<T>::Network(const Network& network)
         :
-        Topology{ network.Topology }
+        Topology{ network.Topology },
+        Layers{ common::CopyResourceArray(network.Layers.get(), network.Topology.GetLayerCount(), network.GetResource()) },
+        WeightFormat_{ network.WeightFormat_ },
+        FusedHead{ network.FusedHead }
       {
-        Layers = std::make_unique<Layer<T>[]>(Topology.GetLayerCount());
-        for (size_t i = 0; i < Topology.GetLayerCount(); ++i)
-        {
-          Layers[i] = network.Layers[i];
-        }
       }
 
       template <typename T>
@@ -128,11 +194,17 @@ namespace cnn
       template <typename T>
       void Network<T>::SetTopology(const NetworkTopology& topology)
       {
-        Network<T> tmpNetwork{ topology };
+        Network<T> tmpNetwork{ topology, GetResource() };
         // Beware, it is very intimate place for strong exception guarantee.
         std::swap(*this, tmpNetwork);
       }
 
+      template <typename T>
+      std::pmr::memory_resource* Network<T>::GetResource() const noexcept
+      {
+        return Layers.get_deleter().GetResource();
+      }
+
       template <typename T>
       const Layer<T>& Network<T>::GetLayer(const size_t index) const
       {
@@ -196,7 +268,8 @@ namespace cnn
       template <typename T>
       void Network<T>::GenerateOutput()
       {
-        for (size_t l = 0; l < Topology.GetLayerCount(); ++l)
+        const size_t headBeginLayer = FusedHead ? GetHeadBeginLayer() : Topology.GetLayerCount();
+        for (size_t l = 0; l < headBeginLayer; ++l)
         {
           auto& currentLayer = Layers[l];
           if (l != 0)
@@ -206,10 +279,170 @@ namespace cnn
           }
           currentLayer.GenerateOutput();
         }
+        if (headBeginLayer != Topology.GetLayerCount())
+        {
+          GenerateHeadOutput(headBeginLayer);
+        }
       }
 
       template <typename T>
-      void Network<T>::Clear() noexcept
+      void Network<T>::GenerateOutput(common::ThreadPool& threadPool)
+      {
+        const size_t headBeginLayer = FusedHead ? GetHeadBeginLayer() : Topology.GetLayerCount();
+        for (size_t l = 0; l < headBeginLayer; ++l)
+        {
+          auto& currentLayer = Layers[l];
+          if (l != 0)
+          {
+            const auto& previousLayer = Layers[l - 1];
+            currentLayer.GetInput().FillFrom(previousLayer.GetOutput());
+          }
+          currentLayer.GenerateOutput(threadPool);
+        }
+        if (headBeginLayer != Topology.GetLayerCount())
+        {
+          GenerateHeadOutput(headBeginLayer);
+        }
+      }
+
+      template <typename T>
+      common::WeightFormat Network<T>::GetWeightFormat() const noexcept
+      {
+        return WeightFormat_;
+      }
+
+      template <typename T>
+      void Network<T>::SetWeightFormat(const common::WeightFormat format) noexcept
+      {
+        WeightFormat_ = format;
+        for (size_t i = 0; i < Topology.GetLayerCount(); ++i)
+        {
+          Layers[i].SetWeightFormat(format);
+        }
+      }
+
+      template <typename T>
+      bool Network<T>::GetFusedHead() const noexcept
+      {
+        return FusedHead;
+      }
+
+      template <typename T>
+      void Network<T>::SetFusedHead(const bool fusedHead) noexcept
+      {
+        FusedHead = fusedHead;
+      }
+
+      template <typename T>
+      size_t Network<T>::GetHeadBeginLayer() const noexcept
+      {
+        size_t beginLayer = Topology.GetLayerCount();
+        while (beginLayer != 0)
+        {
+          const LayerTopology& layerTopology = Topology.GetLayerTopology(beginLayer - 1);
+          if ((layerTopology.GetInputCount() > MAX_HEAD_WIDTH) || (layerTopology.GetNeuronCount() > MAX_HEAD_WIDTH))
+          {
+            break;
+          }
+          --beginLayer;
+        }
+        return beginLayer;
+      }
+
+      template <typename T>
+      void Network<T>::GenerateHeadOutputs(const T* const inputs, T* const outputs, const size_t sampleCount) const
+      {
+        const size_t beginLayer = GetHeadBeginLayer();
+        if (beginLayer == Topology.GetLayerCount())
+        {
+          throw std::logic_error("cnn::engine::perceptron::Network::GenerateHeadOutputs() const, GetHeadBeginLayer() == Topology.GetLayerCount().");
+        }
+
+        const size_t inputCount = Topology.GetLayerTopology(beginLayer).GetInputCount();
+        const size_t outputCount = Topology.GetLastLayerTopology().GetNeuronCount();
+        size_t s = 0;
+        for (; s + HEAD_SAMPLE_COUNT <= sampleCount; s += HEAD_SAMPLE_COUNT)
+        {
+          GenerateHeadOutputs<HEAD_SAMPLE_COUNT>(beginLayer, inputs + s * inputCount, outputs + s * outputCount);
+        }
+        for (; s < sampleCount; ++s)
+        {
+          GenerateHeadOutputs<1>(beginLayer, inputs + s * inputCount, outputs + s * outputCount);
+        }
+      }
+
+      template <typename T>
+      void Network<T>::GenerateHeadOutput(const size_t beginLayer)
+      {
+        const Layer<T>& inputLayer = Layers[beginLayer == 0 ? 0 : beginLayer - 1];
+        const T* const inputs = beginLayer == 0 ? inputLayer.GetInput().GetValues() : inputLayer.GetOutput().GetValues();
+        GenerateHeadOutputs<1>(beginLayer, inputs, Layers[Topology.GetLayerCount() - 1].GetOutput().GetValues());
+      }
+
+      template <typename T>
+      template <size_t SAMPLE_COUNT>
+      void Network<T>::GenerateHeadOutputs(const size_t beginLayer, const T* const inputs, T* const outputs) const
+      {
+        T values[2][MAX_HEAD_WIDTH * SAMPLE_COUNT];
+        const size_t inputCount = Topology.GetLayerTopology(beginLayer).GetInputCount();
+        for (size_t s = 0; s < SAMPLE_COUNT; ++s)
+        {
+          for (size_t i = 0; i < inputCount; ++i)
+          {
+            values[0][i * SAMPLE_COUNT + s] = inputs[s * inputCount + i];
+          }
+        }
+
+        for (size_t l = beginLayer; l < Topology.GetLayerCount(); ++l)
+        {
+          const T* const layerInputs = values[(l - beginLayer) % 2];
+          T* const layerOutputs = values[(l - beginLayer + 1) % 2];
+          const LayerTopology& layerTopology = Topology.GetLayerTopology(l);
+          const size_t layerInputCount = layerTopology.GetInputCount();
+          const size_t neuronCount = layerTopology.GetNeuronCount();
+          const Layer<T>& layer = Layers[l];
+          common::Activation::Dispatch(layerTopology.GetActivationType(), [&](auto activation)
+          {
+            for (size_t n = 0; n < neuronCount; ++n)
+            {
+              const T* const weights = layer.GetNeuron(n).GetWeights();
+              T sums[SAMPLE_COUNT]{};
+              for (size_t i = 0; i < layerInputCount; ++i)
+              {
+                const T weight = weights[i];
+                for (size_t s = 0; s < SAMPLE_COUNT; ++s)
+                {
+                  sums[s] += weight * layerInputs[i * SAMPLE_COUNT + s];
+                }
+              }
+              for (size_t s = 0; s < SAMPLE_COUNT; ++s)
+              {
+                layerOutputs[n * SAMPLE_COUNT + s] = common::Activation::Activate<decltype(activation)::value>(sums[s]);
+              }
+            }
+          });
+        }
+
+        const T* const lastValues = values[(Topology.GetLayerCount() - beginLayer) % 2];
+        const size_t outputCount = Topology.GetLastLayerTopology().GetNeuronCount();
+        for (size_t s = 0; s < SAMPLE_COUNT; ++s)
+        {
+          for (size_t n = 0; n < outputCount; ++n)
+          {
+            outputs[s * outputCount + n] = lastValues[n * SAMPLE_COUNT + s];
+          }
+        }
+      }
+
+      template <typename T>
+      void Network<T>::CopyExecutionOptions(const Network& network) noexcept
+      {
+        SetWeightFormat(network.WeightFormat_);
+        FusedHead = network.FusedHead;
+      }
+
+      template <typename T>
+      void Network<T>::Clear()
       {
         for (size_t i = 0; i < Topology.GetLayerCount(); ++i)
         {
@@ -259,7 +492,7 @@ namespace cnn
         topology.Load(istream);
         CheckTopology(topology);
 
-        layers = std::make_unique<Layer<T>[]>(topology.GetLayerCount());
+        layers = common::MakeResourceArray<Layer<T>>(topology.GetLayerCount(), GetResource(), LayerTopology{});
         for (size_t i = 0; i < topology.GetLayerCount(); ++i)
         {
           layers[i].Load(istream);
@@ -267,6 +500,7 @@ namespace cnn
           {
             throw std::logic_error("cnn::engine::perceptron::Network::Load(), layers[i].GetTopology() != topology.GetLayerTopology(i).");
           }
+          layers[i].SetWeightFormat(WeightFormat_);
         }
 
         if (istream.good() == false)
@@ -279,7 +513,7 @@ namespace cnn
       }
 
       template <typename T>
-      void Network<T>::FillWeights(common::ValueGenerator<T>& valueGenerator) noexcept
+      void Network<T>::FillWeights(common::ValueGenerator<T>& valueGenerator)
       {
         for (size_t i = 0; i < Topology.GetLayerCount(); ++i)
         {
@@ -288,7 +522,7 @@ namespace cnn
       }
 
       template <typename T>
-      void Network<T>::Mutate(common::Mutagen<T>& mutagen) noexcept
+      void Network<T>::Mutate(common::Mutagen<T>& mutagen)
       {
         for (size_t i = 0; i < Topology.GetLayerCount(); ++i)
         {
@@ -320,6 +554,77 @@ namespace cnn
         }
       }
 
+
+      template <typename T>
+      size_t Network<T>::GetWeightCount() const noexcept
+      {
+        size_t weightCount{};
+        for (size_t i = 0; i < Topology.GetLayerCount(); ++i)
+        {
+          weightCount += Layers[i].GetWeightCount();
+        }
+        return weightCount;
+      }
+
+      template <typename T>
+      T Network<T>::GetWeight(const size_t index) const
+      {
+        if (index >= GetWeightCount())
+        {
+          throw std::range_error("cnn::engine::perceptron::Network::GetWeight() const, index >= GetWeightCount().");
+        }
+        size_t weightIndex = index;
+        size_t i = 0;
+        while (weightIndex >= Layers[i].GetWeightCount())
+        {
+          weightIndex -= Layers[i].GetWeightCount();
+          ++i;
+        }
+        return Layers[i].GetWeight(weightIndex);
+      }
+
+      template <typename T>
+      void Network<T>::SetWeight(const size_t index, const T value)
+      {
+        if (index >= GetWeightCount())
+        {
+          throw std::range_error("cnn::engine::perceptron::Network::SetWeight(), index >= GetWeightCount().");
+        }
+        size_t weightIndex = index;
+        size_t i = 0;
+        while (weightIndex >= Layers[i].GetWeightCount())
+        {
+          weightIndex -= Layers[i].GetWeightCount();
+          ++i;
+        }
+        Layers[i].SetWeight(weightIndex, value);
+      }
+
+      template <typename T>
+      void Network<T>::ShareWeights(const Network& network)
+      {
+        if (Topology != network.Topology)
+        {
+          throw std::invalid_argument("cnn::engine::perceptron::Network::ShareWeights(), Topology != network.Topology.");
+        }
+        for (size_t i = 0; i < Topology.GetLayerCount(); ++i)
+        {
+          Layers[i].ShareWeights(network.Layers[i]);
+        }
+      }
+
+      template <typename T>
+      void Network<T>::CopyWeights(const Network& network)
+      {
+        if (Topology != network.Topology)
+        {
+          throw std::invalid_argument("cnn::engine::perceptron::Network::CopyWeights(), Topology != network.Topology.");
+        }
+        for (size_t i = 0; i < Topology.GetLayerCount(); ++i)
+        {
+          Layers[i].CopyWeights(network.Layers[i]);
+        }
+      }
     }
   }
 }
\ No newline at end of file
@@ -50,18 +50,32 @@ namespace cnn
         // Exception guarantee: base for the network.
         void GenerateOutput() const;
 
+        // Exception guarantee: base for the network.
+        void GenerateOutput(common::ThreadPool& threadPool) const;
+
+        common::WeightFormat GetWeightFormat() const noexcept;
+
+        void SetWeightFormat(const common::WeightFormat format) const noexcept;
+
+        bool GetFusedHead() const noexcept;
+
+        void SetFusedHead(const bool fusedHead) const noexcept;
+
+        void CopyExecutionOptions(const Network<T>& network) const noexcept;
+
+        // Exception guarantee: base for the network.
         // It clears the state without changing of the topology of the network.
-        void Clear() const noexcept;
+        void Clear() const;
 
         // Exception guarantee: base for ostream.
         // It saves full state.
         void Save(std::ostream& ostream) const;
 
-        // We expect that the method never throws any exception.
-        void FillWeights(common::ValueGenerator<T>& valueGenerator) const noexcept;
+        // Exception guarantee: base for the network.
+        void FillWeights(common::ValueGenerator<T>& valueGenerator) const;
 
-        // We expect that the method never throws any exception.
-        void Mutate(common::Mutagen<T>& mutagen) const noexcept;
+        // Exception guarantee: base for the network.
+        void Mutate(common::Mutagen<T>& mutagen) const;
 
       private:
 
@@ -132,7 +146,43 @@ namespace cnn
       }
 
       template <typename T>
-      void NetworkProtectingReference<T>::Clear() const noexcept
+      void NetworkProtectingReference<T>::GenerateOutput(common::ThreadPool& threadPool) const
+      {
+        Network_.GenerateOutput(threadPool);
+      }
+
+      template <typename T>
+      common::WeightFormat NetworkProtectingReference<T>::GetWeightFormat() const noexcept
+      {
+        return Network_.GetWeightFormat();
+      }
+
+      template <typename T>
+      void NetworkProtectingReference<T>::SetWeightFormat(const common::WeightFormat format) const noexcept
+      {
+        Network_.SetWeightFormat(format);
+      }
+
+      template <typename T>
+      bool NetworkProtectingReference<T>::GetFusedHead() const noexcept
+      {
+        return Network_.GetFusedHead();
+      }
+
+      template <typename T>
+      void NetworkProtectingReference<T>::SetFusedHead(const bool fusedHead) const noexcept
+      {
+        Network_.SetFusedHead(fusedHead);
+      }
+
+      template <typename T>
+      void NetworkProtectingReference<T>::CopyExecutionOptions(const Network<T>& network) const noexcept
+      {
+        Network_.CopyExecutionOptions(network);
+      }
+
+      template <typename T>
+      void NetworkProtectingReference<T>::Clear() const
       {
         Network_.Clear();
       }
@@ -144,13 +194,13 @@ namespace cnn
       }
 
       template <typename T>
-      void NetworkProtectingReference<T>::FillWeights(common::ValueGenerator<T>& valueGenerator) const noexcept
+      void NetworkProtectingReference<T>::FillWeights(common::ValueGenerator<T>& valueGenerator) const
       {
         Network_.FillWeights(valueGenerator);
       }
 
       template <typename T>
-      void NetworkProtectingReference<T>::Mutate(common::Mutagen<T>& mutagen) const noexcept
+      void NetworkProtectingReference<T>::Mutate(common::Mutagen<T>& mutagen) const
       {
         Network_.Mutate(mutagen);
       }
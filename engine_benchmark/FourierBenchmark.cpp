@@ -0,0 +1,62 @@
+#include "FourierBenchmark.hpp"
+
+#include <iomanip>
+
+#include "../engine/common/ValueGenerator.hpp"
+#include "../engine/convolution/Layer2D.hpp"
+
+#include "Timer.hpp"
+
+namespace cnn
+{
+  namespace engine_benchmark
+  {
+    void FourierBenchmark::Run(std::ostream& ostream)
+    {
+      const size_t coreSizes[] = { 5, 7, 9, 11 };
+      const size_t inputSizes[] = { 8, 12, 16, 24, 32, 64, 128 };
+
+      ostream << "Fourier kernel against the direct kernel, " << INPUT_COUNT << " inputs, " << FILTER_COUNT << " filters, one thread:" << std::endl;
+      ostream << std::setw(6) << "core" << std::setw(8) << "input" << std::setw(14) << "direct, ms" << std::setw(14) << "Fourier, ms"
+              << std::setw(10) << "faster" << std::setw(10) << "chosen" << std::endl;
+      ostream << std::fixed << std::setprecision(3);
+
+      engine::common::ValueGenerator<float> valueGenerator;
+      valueGenerator.SetMaxValue(1.f);
+      valueGenerator.SetMinValue(-1.f);
+      for (const size_t coreSize : coreSizes)
+      {
+        for (const size_t inputSize : inputSizes)
+        {
+          if (inputSize < coreSize)
+          {
+            continue;
+          }
+
+          const size_t outputSize = inputSize - coreSize + 1;
+          engine::convolution::Layer2D<float> layer{ { { inputSize, inputSize }, INPUT_COUNT, { { coreSize, coreSize }, INPUT_COUNT },
+                                                       FILTER_COUNT, { outputSize, outputSize }, FILTER_COUNT } };
+          layer.FillWeights(valueGenerator);
+          for (size_t i = 0; i < INPUT_COUNT; ++i)
+          {
+            engine::convolution::Map2DProtectingReference<float> input = layer.GetInput(i);
+            for (size_t y = 0; y < inputSize; ++y)
+            {
+              for (size_t x = 0; x < inputSize; ++x)
+              {
+                input.SetValue(x, y, valueGenerator.Generate());
+              }
+            }
+          }
+
+          // Rows are generated by the direct kernel, because it is the only kernel of large cores, which works by rows.
+          const double directTime = Timer::GetMilliseconds([&layer, outputSize]() { layer.GenerateOutputRows(0, outputSize); });
+          const double fourierTime = Timer::GetMilliseconds([&layer]() { layer.GenerateOutputByFourier(); });
+          ostream << std::setw(6) << coreSize << std::setw(8) << inputSize << std::setw(14) << directTime << std::setw(14) << fourierTime
+                  << std::setw(10) << (fourierTime < directTime ? "Fourier" : "direct")
+                  << std::setw(10) << (layer.IsFourierUsed() ? "Fourier" : "direct") << std::endl;
+        }
+      }
+    }
+  }
+}
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <cstddef>
+#include <ostream>
+
+namespace cnn
+{
+  namespace engine_benchmark
+  {
+    // FourierBenchmark measures the direct and the Fourier kernels of Layer2D for large cores over input sizes,
+    // so the measured crossover can be compared with the estimate of Layer2D::IsFourierUsed().
+    class FourierBenchmark
+    {
+    public:
+
+      static void Run(std::ostream& ostream);
+
+    private:
+
+      constexpr static size_t INPUT_COUNT = 8;
+      constexpr static size_t FILTER_COUNT = 8;
+
+      ~FourierBenchmark() = delete;
+
+    };
+  }
+}
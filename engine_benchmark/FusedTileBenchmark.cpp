@@ -0,0 +1,77 @@
+#include "FusedTileBenchmark.hpp"
+
+#include <iomanip>
+#include <string>
+
+#include "../engine/common/ThreadPool.hpp"
+#include "../engine/common/ValueGenerator.hpp"
+#include "../engine/convolution/Network2D.hpp"
+
+#include "Timer.hpp"
+
+namespace cnn
+{
+  namespace engine_benchmark
+  {
+    void FusedTileBenchmark::Run(std::ostream& ostream)
+    {
+      const size_t inputSizes[] = { 32, 64, 128, 256, 512 };
+      const size_t channelCounts[] = { 10, 20 };
+      // Zero is the layer by layer execution.
+      const size_t tileHeights[] = { 0, 4, 8, 16 };
+
+      engine::common::ThreadPool threadPool{ THREAD_COUNT };
+      ostream << "Fused tiles of rows against layer by layer execution, three 3 x 3 layers, ms:" << std::endl;
+      ostream << std::setw(8) << "input" << std::setw(10) << "channels" << std::setw(8) << "threads";
+      for (const size_t tileHeight : tileHeights)
+      {
+        ostream << std::setw(12) << (tileHeight == 0 ? std::string{ "layers" } : "tile " + std::to_string(tileHeight));
+      }
+      ostream << std::endl;
+      ostream << std::fixed << std::setprecision(3);
+
+      engine::common::ValueGenerator<float> valueGenerator;
+      valueGenerator.SetMaxValue(0.3f);
+      valueGenerator.SetMinValue(-0.3f);
+      for (const size_t inputSize : inputSizes)
+      {
+        for (const size_t channelCount : channelCounts)
+        {
+          engine::convolution::Network2D<float> network{ GetTopology(inputSize, channelCount) };
+          network.FillWeights(valueGenerator);
+          engine::convolution::Map2DProtectingReference<float> input = network.GetFirstLayer().GetInput(0);
+          for (size_t y = 0; y < inputSize; ++y)
+          {
+            for (size_t x = 0; x < inputSize; ++x)
+            {
+              input.SetValue(x, y, valueGenerator.Generate());
+            }
+          }
+
+          for (const size_t threadCount : { size_t{ 1 }, THREAD_COUNT })
+          {
+            ostream << std::setw(8) << inputSize << std::setw(10) << channelCount << std::setw(8) << threadCount;
+            for (const size_t tileHeight : tileHeights)
+            {
+              network.SetFusedTileHeight(tileHeight);
+              const double time = (threadCount == 1) ?
+                                  Timer::GetMilliseconds([&network]() { network.GenerateOutput(); }) :
+                                  Timer::GetMilliseconds([&network, &threadPool]() { network.GenerateOutput(threadPool); });
+              ostream << std::setw(12) << time;
+            }
+            ostream << std::endl;
+          }
+        }
+      }
+    }
+
+    engine::convolution::Network2DTopology FusedTileBenchmark::GetTopology(const size_t inputSize, const size_t channelCount)
+    {
+      engine::convolution::Network2DTopology topology;
+      topology.PushBack({ { inputSize, inputSize }, 1, { { 3, 3 }, 1 }, channelCount, { inputSize - 2, inputSize - 2 }, channelCount });
+      topology.PushBack({ { inputSize - 2, inputSize - 2 }, channelCount, { { 3, 3 }, channelCount }, channelCount, { inputSize - 4, inputSize - 4 }, channelCount });
+      topology.PushBack({ { inputSize - 4, inputSize - 4 }, channelCount, { { 3, 3 }, channelCount }, channelCount, { inputSize - 6, inputSize - 6 }, channelCount });
+      return topology;
+    }
+  }
+}
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstddef>
+#include <ostream>
+
+#include "../engine/convolution/Network2DTopology.hpp"
+
+namespace cnn
+{
+  namespace engine_benchmark
+  {
+    // FusedTileBenchmark measures convolution::Network2D layer by layer and by fused tiles of rows
+    // (see Network2D::SetFusedTileHeight()) at input sizes, which intermediates don't fit caches at.
+    class FusedTileBenchmark
+    {
+    public:
+
+      static void Run(std::ostream& ostream);
+
+    private:
+
+      constexpr static size_t THREAD_COUNT = 4;
+
+      // It returns three 3 x 3 layers of channelCount filters, which follow a single input map.
+      static engine::convolution::Network2DTopology GetTopology(const size_t inputSize, const size_t channelCount);
+
+      ~FusedTileBenchmark() = delete;
+
+    };
+  }
+}
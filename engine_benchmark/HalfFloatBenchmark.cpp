@@ -0,0 +1,51 @@
+#include "HalfFloatBenchmark.hpp"
+
+#include <iomanip>
+
+#include "../engine/common/HalfFloat.hpp"
+#include "../engine/common/ValueGenerator.hpp"
+#include "../engine/perceptron/Layer.hpp"
+
+#include "Timer.hpp"
+
+namespace cnn
+{
+  namespace engine_benchmark
+  {
+    void HalfFloatBenchmark::Run(std::ostream& ostream)
+    {
+      const size_t inputCounts[] = { 256, 1024, 4096, 16384, 65536 };
+      const engine::common::WeightFormat formats[] = { engine::common::WeightFormat::Native,
+                                                       engine::common::WeightFormat::Float16,
+                                                       engine::common::WeightFormat::BFloat16 };
+
+      ostream << "16-bit weights against native ones, perceptron layer of " << NEURON_COUNT << " neurons, float, one thread, ms:" << std::endl;
+      ostream << std::setw(8) << "inputs" << std::setw(14) << "weights, MB" << std::setw(12) << "native" << std::setw(12) << "Float16"
+              << std::setw(12) << "BFloat16" << std::endl;
+      ostream << std::fixed << std::setprecision(3);
+
+      engine::common::ValueGenerator<float> valueGenerator;
+      valueGenerator.SetMaxValue(1.f);
+      valueGenerator.SetMinValue(-1.f);
+      for (const size_t inputCount : inputCounts)
+      {
+        engine::perceptron::Layer<float> layer{ { inputCount, NEURON_COUNT, engine::common::ActivationType::Identity } };
+        layer.FillWeights(valueGenerator);
+        engine::common::MapProtectingReference<float> input = layer.GetInput();
+        for (size_t i = 0; i < inputCount; ++i)
+        {
+          input.SetValue(i, valueGenerator.Generate());
+        }
+
+        ostream << std::setw(8) << inputCount << std::setw(14) << static_cast<double>(inputCount * NEURON_COUNT * sizeof(float)) / (1 << 20);
+        for (const engine::common::WeightFormat format : formats)
+        {
+          // The 16-bit copy of weights is made by the first call, which isn't measured.
+          layer.SetWeightFormat(format);
+          ostream << std::setw(12) << Timer::GetMilliseconds([&layer]() { layer.GenerateOutput(); });
+        }
+        ostream << std::endl;
+      }
+    }
+  }
+}
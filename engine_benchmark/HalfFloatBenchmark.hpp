@@ -0,0 +1,27 @@
+#pragma once
+
+#include <cstddef>
+#include <ostream>
+
+namespace cnn
+{
+  namespace engine_benchmark
+  {
+    // HalfFloatBenchmark measures perceptron::Layer with native, Float16 and BFloat16 weights (see Layer::SetWeightFormat())
+    // over input counts, which weights fit caches at and don't fit them at. All formats are summed by the same vectorized kernel
+    // (see common::HalfFloat::DotProduct()), so the difference is the memory traffic of weights and the cost of conversions.
+    class HalfFloatBenchmark
+    {
+    public:
+
+      static void Run(std::ostream& ostream);
+
+    private:
+
+      constexpr static size_t NEURON_COUNT = 256;
+
+      ~HalfFloatBenchmark() = delete;
+
+    };
+  }
+}
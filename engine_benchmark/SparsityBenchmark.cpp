@@ -0,0 +1,91 @@
+#include "SparsityBenchmark.hpp"
+
+#include <iomanip>
+
+#include "../engine/common/ValueGenerator.hpp"
+#include "../engine/convolution/Layer2D.hpp"
+#include "../engine/perceptron/Layer.hpp"
+
+#include "Timer.hpp"
+
+namespace cnn
+{
+  namespace engine_benchmark
+  {
+    void SparsityBenchmark::Run(std::ostream& ostream)
+    {
+      const float densities[] = { 1.f, 0.5f, 0.25f, 0.1f, 0.05f, 0.01f };
+
+      ostream << "Sparse layers against dense ones, " << INPUT_SIZE << " x " << INPUT_SIZE << " inputs, " << INPUT_COUNT << " inputs, "
+              << FILTER_COUNT << " filters of 3 x 3 cores and a perceptron layer of " << PERCEPTRON_INPUT_COUNT << " inputs and "
+              << NEURON_COUNT << " neurons, float, one thread, ms:" << std::endl;
+      ostream << std::setw(8) << "density" << std::setw(14) << "conv dense" << std::setw(14) << "conv sparse" << std::setw(10) << "chosen"
+              << std::setw(16) << "neurons dense" << std::setw(16) << "neurons sparse" << std::setw(10) << "chosen" << std::endl;
+      ostream << std::fixed << std::setprecision(3);
+
+      const size_t outputSize = INPUT_SIZE - 2;
+      engine::convolution::Layer2D<float> convolutionLayer{ { { INPUT_SIZE, INPUT_SIZE }, INPUT_COUNT, { { 3, 3 }, INPUT_COUNT },
+                                                              FILTER_COUNT, { outputSize, outputSize }, FILTER_COUNT } };
+      engine::perceptron::Layer<float> perceptronLayer{ { PERCEPTRON_INPUT_COUNT, NEURON_COUNT, engine::common::ActivationType::Identity } };
+
+      engine::common::ValueGenerator<float> valueGenerator;
+      valueGenerator.SetMaxValue(1.f);
+      valueGenerator.SetMinValue(-1.f);
+      for (size_t i = 0; i < INPUT_COUNT; ++i)
+      {
+        engine::convolution::Map2DProtectingReference<float> input = convolutionLayer.GetInput(i);
+        for (size_t y = 0; y < INPUT_SIZE; ++y)
+        {
+          for (size_t x = 0; x < INPUT_SIZE; ++x)
+          {
+            input.SetValue(x, y, valueGenerator.Generate());
+          }
+        }
+      }
+      engine::common::MapProtectingReference<float> input = perceptronLayer.GetInput();
+      for (size_t i = 0; i < PERCEPTRON_INPUT_COUNT; ++i)
+      {
+        input.SetValue(i, valueGenerator.Generate());
+      }
+
+      // Weights are kept at random, so the sparse kernels don't benefit from a regular pattern.
+      engine::common::ValueGenerator<float> keepGenerator;
+      keepGenerator.SetMaxValue(1.f);
+      keepGenerator.SetMinValue(0.f);
+      for (const float density : densities)
+      {
+        convolutionLayer.FillWeights(valueGenerator);
+        for (size_t i = 0; i < convolutionLayer.GetWeightCount(); ++i)
+        {
+          if (keepGenerator.Generate() >= density)
+          {
+            convolutionLayer.SetWeight(i, 0.f);
+          }
+        }
+        perceptronLayer.FillWeights(valueGenerator);
+        for (size_t i = 0; i < perceptronLayer.GetWeightCount(); ++i)
+        {
+          if (keepGenerator.Generate() >= density)
+          {
+            perceptronLayer.SetWeight(i, 0.f);
+          }
+        }
+
+        // Compressed weights are built by the first call, which isn't measured.
+        convolutionLayer.SetSparse(false);
+        const double convolutionDenseTime = Timer::GetMilliseconds([&convolutionLayer]() { convolutionLayer.GenerateOutput(); });
+        convolutionLayer.SetSparse(true);
+        const double convolutionSparseTime = Timer::GetMilliseconds([&convolutionLayer]() { convolutionLayer.GenerateOutput(); });
+        perceptronLayer.SetSparse(false);
+        const double perceptronDenseTime = Timer::GetMilliseconds([&perceptronLayer]() { perceptronLayer.GenerateOutput(); });
+        perceptronLayer.SetSparse(true);
+        const double perceptronSparseTime = Timer::GetMilliseconds([&perceptronLayer]() { perceptronLayer.GenerateOutput(); });
+
+        ostream << std::setw(8) << density << std::setw(14) << convolutionDenseTime << std::setw(14) << convolutionSparseTime
+                << std::setw(10) << (convolutionLayer.IsSparseFaster() ? "sparse" : "dense")
+                << std::setw(16) << perceptronDenseTime << std::setw(16) << perceptronSparseTime
+                << std::setw(10) << (perceptronLayer.IsSparseFaster() ? "sparse" : "dense") << std::endl;
+      }
+    }
+  }
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstddef>
+#include <ostream>
+
+namespace cnn
+{
+  namespace engine_benchmark
+  {
+    // SparsityBenchmark measures convolution::Layer2D (3 x 3 cores, which dense layers apply by Winograd tiles) and perceptron::Layer
+    // as dense and sparse layers (see SetSparse()) over densities of randomly kept weights, so the sparse kernels are measured
+    // against the dense ones, and the estimate of IsSparseFaster() is compared with the measurement.
+    class SparsityBenchmark
+    {
+    public:
+
+      static void Run(std::ostream& ostream);
+
+    private:
+
+      constexpr static size_t INPUT_SIZE = 64;
+      constexpr static size_t INPUT_COUNT = 16;
+      constexpr static size_t FILTER_COUNT = 16;
+
+      constexpr static size_t PERCEPTRON_INPUT_COUNT = 4096;
+      constexpr static size_t NEURON_COUNT = 256;
+
+      ~SparsityBenchmark() = delete;
+
+    };
+  }
+}
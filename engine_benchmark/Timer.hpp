@@ -0,0 +1,46 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+
+namespace cnn
+{
+  namespace engine_benchmark
+  {
+    // Timer measures the average duration of a function, which is repeated until the measurement is long enough to be stable.
+    class Timer
+    {
+    public:
+
+      constexpr static std::chrono::milliseconds MIN_DURATION{ 200 };
+      constexpr static size_t MIN_REPEAT_COUNT = 3;
+
+      // The first call warms caches and buffers up, so it isn't measured.
+      template <typename F>
+      static double GetMilliseconds(F&& function);
+
+    private:
+
+      ~Timer() = delete;
+
+    };
+
+    template <typename F>
+    double Timer::GetMilliseconds(F&& function)
+    {
+      using Clock = std::chrono::steady_clock;
+
+      function();
+      size_t repeatCount = 0;
+      const Clock::time_point begin = Clock::now();
+      Clock::duration duration{};
+      do
+      {
+        function();
+        ++repeatCount;
+        duration = Clock::now() - begin;
+      } while ((repeatCount < MIN_REPEAT_COUNT) || (duration < MIN_DURATION));
+      return std::chrono::duration<double, std::milli>{ duration }.count() / repeatCount;
+    }
+  }
+}
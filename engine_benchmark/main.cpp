@@ -0,0 +1,32 @@
+#include "FourierBenchmark.hpp"
+#include "FusedTileBenchmark.hpp"
+#include "HalfFloatBenchmark.hpp"
+#include "SparsityBenchmark.hpp"
+
+#include <cstdlib>
+#include <iostream>
+
+int main()
+{
+  try
+  {
+    cnn::engine_benchmark::FourierBenchmark::Run(std::cout);
+    std::cout << std::endl;
+    cnn::engine_benchmark::FusedTileBenchmark::Run(std::cout);
+    std::cout << std::endl;
+    cnn::engine_benchmark::HalfFloatBenchmark::Run(std::cout);
+    std::cout << std::endl;
+    cnn::engine_benchmark::SparsityBenchmark::Run(std::cout);
+  }
+  catch (const std::exception& e)
+  {
+    std::cout << e.what() << std::endl;
+    return EXIT_FAILURE;
+  }
+  catch (...)
+  {
+    std::cout << "Unknown exception has been caught." << std::endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
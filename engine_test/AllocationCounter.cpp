@@ -0,0 +1,117 @@
+#include "AllocationCounter.hpp"
+
+#include <cstdlib>
+#include <atomic>
+#include <new>
+
+namespace
+{
+  std::atomic<size_t> allocationCount{ 0 };
+
+  void* Allocate(const size_t size)
+  {
+    ++allocationCount;
+    void* const pointer = std::malloc(size != 0 ? size : 1);
+    if (pointer == nullptr)
+    {
+      throw std::bad_alloc{};
+    }
+    return pointer;
+  }
+
+  void* AllocateAligned(const size_t size, const std::align_val_t alignment)
+  {
+    ++allocationCount;
+    const size_t alignmentValue = static_cast<size_t>(alignment);
+#if defined(_MSC_VER)
+    void* const pointer = _aligned_malloc(size != 0 ? size : 1, alignmentValue);
+#else
+    void* const pointer = std::aligned_alloc(alignmentValue, (size + alignmentValue - 1) / alignmentValue * alignmentValue + (size == 0 ? alignmentValue : 0));
+#endif
+    if (pointer == nullptr)
+    {
+      throw std::bad_alloc{};
+    }
+    return pointer;
+  }
+
+  void DeallocateAligned(void* const pointer) noexcept
+  {
+#if defined(_MSC_VER)
+    _aligned_free(pointer);
+#else
+    std::free(pointer);
+#endif
+  }
+}
+
+void* operator new(const size_t size)
+{
+  return Allocate(size);
+}
+
+void* operator new[](const size_t size)
+{
+  return Allocate(size);
+}
+
+void* operator new(const size_t size, const std::align_val_t alignment)
+{
+  return AllocateAligned(size, alignment);
+}
+
+void* operator new[](const size_t size, const std::align_val_t alignment)
+{
+  return AllocateAligned(size, alignment);
+}
+
+void operator delete(void* const pointer) noexcept
+{
+  std::free(pointer);
+}
+
+void operator delete[](void* const pointer) noexcept
+{
+  std::free(pointer);
+}
+
+void operator delete(void* const pointer, const size_t) noexcept
+{
+  std::free(pointer);
+}
+
+void operator delete[](void* const pointer, const size_t) noexcept
+{
+  std::free(pointer);
+}
+
+void operator delete(void* const pointer, const std::align_val_t) noexcept
+{
+  DeallocateAligned(pointer);
+}
+
+void operator delete[](void* const pointer, const std::align_val_t) noexcept
+{
+  DeallocateAligned(pointer);
+}
+
+void operator delete(void* const pointer, const size_t, const std::align_val_t) noexcept
+{
+  DeallocateAligned(pointer);
+}
+
+void operator delete[](void* const pointer, const size_t, const std::align_val_t) noexcept
+{
+  DeallocateAligned(pointer);
+}
+
+namespace cnn
+{
+  namespace engine_test
+  {
+    size_t AllocationCounter::GetCount() noexcept
+    {
+      return allocationCount.load();
+    }
+  }
+}
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <cstddef>
+
+namespace cnn
+{
+  namespace engine_test
+  {
+    // AllocationCounter counts calls of the global operator new, which is replaced by the test executable,
+    // so a test can assert that a piece of code doesn't allocate memory.
+    class AllocationCounter
+    {
+    public:
+
+      // It returns the count of allocations since the start of the executable.
+      static size_t GetCount() noexcept;
+
+    private:
+
+      ~AllocationCounter() = delete;
+
+    };
+  }
+}
@@ -0,0 +1,19 @@
+#pragma once
+
+#include <stdexcept>
+#include <string>
+
+namespace cnn
+{
+  namespace engine_test
+  {
+    // It fails the running test, if the condition is false.
+    inline void Check(const bool condition, const std::string& message)
+    {
+      if (condition == false)
+      {
+        throw std::logic_error(message);
+      }
+    }
+  }
+}
@@ -0,0 +1,107 @@
+#include "GeneticAlgorithm2DTest.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "../engine/common/Mutagen.hpp"
+#include "../engine/complex/GeneticAlgorithm2D.hpp"
+
+#include "AllocationCounter.hpp"
+#include "Check.hpp"
+#include "TestData.hpp"
+
+namespace cnn
+{
+  namespace engine_test
+  {
+    void GeneticAlgorithm2DTest::TestAllocationFreeIterations()
+    {
+      const engine::complex::Lesson2DLibrary<float> lessonLibrary = TestData::GetLessonLibrary();
+      const engine::complex::Network2D<float> network = TestData::GetNetwork();
+
+      // The first run initializes statics of the engine and the standard library once, so it isn't measured.
+      GetRunAllocationCount(lessonLibrary, network, SHORT_ITERATION_COUNT, SPARSE_MUTATION_COUNT);
+      for (const size_t sparseMutationCount : { size_t{}, SPARSE_MUTATION_COUNT })
+      {
+        const size_t shortRunCount = GetRunAllocationCount(lessonLibrary, network, SHORT_ITERATION_COUNT, sparseMutationCount);
+        const size_t longRunCount = GetRunAllocationCount(lessonLibrary, network, LONG_ITERATION_COUNT, sparseMutationCount);
+        Check(shortRunCount == longRunCount,
+              "sparse mutation count " + std::to_string(sparseMutationCount) + ": " +
+              std::to_string(SHORT_ITERATION_COUNT) + " iterations allocate " + std::to_string(shortRunCount) + " blocks, " +
+              std::to_string(LONG_ITERATION_COUNT) + " iterations allocate " + std::to_string(longRunCount) + " blocks.");
+      }
+    }
+
+    void GeneticAlgorithm2DTest::TestSparseRollback()
+    {
+      engine::complex::Lesson2DLibrary<float> lessonLibrary = TestData::GetLessonLibrary();
+      lessonLibrary.GetOutputs(0)[0] = std::numeric_limits<float>::quiet_NaN();
+      const engine::complex::Network2D<float> sourceNetwork = TestData::GetNetwork();
+
+      engine::common::Mutagen<float> mutagen;
+      mutagen.SetMaxResult(1.f);
+      mutagen.SetMinResult(-1.f);
+      mutagen.SetVariabilityForce(0.5f);
+
+      // The mutation itself changes weights, and the rollback restores them.
+      engine::complex::Network2D<float> network = sourceNetwork;
+      std::vector<std::pair<size_t, float>> oldWeights;
+      network.Mutate(mutagen, SPARSE_MUTATION_COUNT, oldWeights);
+      Check(oldWeights.size() == SPARSE_MUTATION_COUNT, "Mutate() doesn't record every mutated weight.");
+      Check(HaveSameWeights(network, sourceNetwork) == false, "Mutate() doesn't change weights.");
+      network.RestoreWeights(oldWeights);
+      Check(HaveSameWeights(network, sourceNetwork), "RestoreWeights() doesn't restore the weights.");
+
+      engine::complex::GeneticAlgorithm2D<float> algorithm{ THREAD_COUNT, SHORT_ITERATION_COUNT };
+      algorithm.SetMutagen(mutagen);
+      algorithm.SetSparseMutationCount(SPARSE_MUTATION_COUNT);
+      const engine::complex::Network2D<float> result = algorithm.Run(lessonLibrary, sourceNetwork);
+      Check(HaveSameWeights(result, sourceNetwork), "The run, which rejects every mutant, changes the weights.");
+    }
+
+    size_t GeneticAlgorithm2DTest::GetRunAllocationCount(const engine::complex::Lesson2DLibrary<float>& lessonLibrary,
+                                                         const engine::complex::Network2D<float>& network,
+                                                         const size_t iterationCount,
+                                                         const size_t sparseMutationCount)
+    {
+      engine::common::Mutagen<float> mutagen;
+      mutagen.SetMaxResult(1.f);
+      mutagen.SetMinResult(-1.f);
+      mutagen.SetVariabilityForce(0.05f);
+
+      engine::complex::GeneticAlgorithm2D<float> algorithm{ THREAD_COUNT, iterationCount };
+      algorithm.SetMutagen(mutagen);
+      algorithm.SetSparseMutationCount(sparseMutationCount);
+
+      const size_t countBefore = AllocationCounter::GetCount();
+      const engine::complex::Network2D<float> result = algorithm.Run(lessonLibrary, network);
+      return AllocationCounter::GetCount() - countBefore;
+    }
+
+    bool GeneticAlgorithm2DTest::HaveSameWeights(const engine::complex::Network2D<float>& network, const engine::complex::Network2D<float>& otherNetwork)
+    {
+      if (network.GetWeightCount() != otherNetwork.GetWeightCount())
+      {
+        return false;
+      }
+      for (size_t i = 0; i < network.GetWeightCount(); ++i)
+      {
+        const float weight = network.GetWeight(i);
+        const float otherWeight = otherNetwork.GetWeight(i);
+        uint32_t bits;
+        uint32_t otherBits;
+        std::memcpy(&bits, &weight, sizeof(bits));
+        std::memcpy(&otherBits, &otherWeight, sizeof(otherBits));
+        if (bits != otherBits)
+        {
+          return false;
+        }
+      }
+      return true;
+    }
+  }
+}
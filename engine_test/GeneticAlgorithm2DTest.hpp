@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstddef>
+
+#include "../engine/complex/Lesson2DLibrary.hpp"
+#include "../engine/complex/Network2D.hpp"
+
+namespace cnn
+{
+  namespace engine_test
+  {
+    class GeneticAlgorithm2DTest
+    {
+    public:
+
+      // Iterations of the algorithm reuse their buffers, so a run allocates as many blocks for a few iterations
+      // as it allocates for many iterations. It is checked for dense and sparse mutations.
+      static void TestAllocationFreeIterations();
+
+      // A sparse iteration, which isn't better, restores the mutated weights, so a run, which rejects every mutant,
+      // returns the weights of the source network bit for bit. Every mutant is rejected, because a NaN output of a lesson
+      // makes every error NaN, which is never less than the best error.
+      static void TestSparseRollback();
+
+    private:
+
+      constexpr static size_t THREAD_COUNT = 2;
+      constexpr static size_t SHORT_ITERATION_COUNT = 10;
+      constexpr static size_t LONG_ITERATION_COUNT = 40;
+      constexpr static size_t SPARSE_MUTATION_COUNT = 16;
+
+      // It returns the count of blocks, which are allocated by the run.
+      static size_t GetRunAllocationCount(const engine::complex::Lesson2DLibrary<float>& lessonLibrary,
+                                          const engine::complex::Network2D<float>& network,
+                                          const size_t iterationCount,
+                                          const size_t sparseMutationCount);
+
+      // It returns true, if the weights of the networks have the same bits.
+      static bool HaveSameWeights(const engine::complex::Network2D<float>& network, const engine::complex::Network2D<float>& otherNetwork);
+
+      ~GeneticAlgorithm2DTest() = delete;
+
+    };
+  }
+}
@@ -0,0 +1,215 @@
+#include "HalfFloatTest.hpp"
+
+#include <cmath>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "../engine/common/HalfFloat.hpp"
+#include "../engine/common/ValueGenerator.hpp"
+
+#include "Check.hpp"
+
+namespace cnn
+{
+  namespace engine_test
+  {
+    void HalfFloatTest::TestFloat16Conversions()
+    {
+      for (uint32_t bits = 0; bits <= 0xFFFFu; ++bits)
+      {
+        const uint16_t halfBits = static_cast<uint16_t>(bits);
+        const engine::common::Float16 half = GetHalf<engine::common::Float16>(halfBits);
+        const uint32_t floatBits = GetBits(static_cast<float>(half));
+        Check(floatBits == GetFloatBitsOfFloat16(halfBits), "Float16 " + std::to_string(bits) + " is widened wrong.");
+
+        // Every value is kept by the round trip, and NaNs are made quiet.
+        const bool nan = ((bits & 0x7C00u) == 0x7C00u) && ((bits & 0x03FFu) != 0);
+        const uint16_t roundTripBits = engine::common::Float16{ static_cast<float>(half) }.GetBits();
+        Check(roundTripBits == (nan ? (halfBits | 0x0200u) : halfBits), "Float16 " + std::to_string(bits) + " is changed by the round trip.");
+
+        // Ties between neighbouring finite values and the floats next to them test rounding to nearest even.
+        if (((bits & 0x7FFFu) < 0x7BFFu) && ((bits & 0x8000u) == 0))
+        {
+          const engine::common::Float16 nextHalf = GetHalf<engine::common::Float16>(static_cast<uint16_t>(bits + 1));
+          const float tie = static_cast<float>((static_cast<double>(static_cast<float>(half)) + static_cast<float>(nextHalf)) / 2);
+          for (const float value : { tie, std::nextafter(tie, 0.f), std::nextafter(tie, 1e9f), -tie })
+          {
+            Check(engine::common::Float16{ value }.GetBits() == GetFloat16Bits(value),
+                  "Float16 of " + std::to_string(value) + " isn't rounded to nearest even.");
+          }
+        }
+      }
+
+      for (uint64_t bits = 0; bits <= 0xFFFFFFFFu; bits += FLOAT_SAMPLE_STEP)
+      {
+        const float value = GetFloat(static_cast<uint32_t>(bits));
+        Check(engine::common::Float16{ value }.GetBits() == GetFloat16Bits(value), "Float16 of float " + std::to_string(bits) + " is wrong.");
+      }
+      const float specialValues[] = { 65504.f, 65519.99f, 65520.f, 1e9f, std::ldexp(1.f, -24), std::ldexp(1.f, -25), std::ldexp(1.5f, -25),
+                                      std::ldexp(1.f, -26), std::ldexp(1023.5f, -24), std::ldexp(1.f, -14), INFINITY, -INFINITY, 0.f, -0.f,
+                                      NAN, GetFloat(0x7F800001u), GetFloat(0xFFC12345u) };
+      for (const float value : specialValues)
+      {
+        Check(engine::common::Float16{ value }.GetBits() == GetFloat16Bits(value), "Float16 of " + std::to_string(value) + " is wrong.");
+      }
+
+#if defined(__AVX2__) && (defined(__F16C__) || defined(_MSC_VER))
+      for (uint32_t bits = 0; bits <= 0xFFFFu; ++bits)
+      {
+        const uint16_t halfBits = static_cast<uint16_t>(bits);
+        const engine::common::Float16 half = GetHalf<engine::common::Float16>(halfBits);
+        Check(GetBits(static_cast<float>(half)) == GetBits(_cvtsh_ss(halfBits)), "Float16 " + std::to_string(bits) + " isn't widened as by F16C.");
+      }
+      for (uint64_t bits = 0; bits <= 0xFFFFFFFFu; bits += FLOAT_SAMPLE_STEP)
+      {
+        const float value = GetFloat(static_cast<uint32_t>(bits));
+        Check(engine::common::Float16{ value }.GetBits() == _cvtss_sh(value, _MM_FROUND_TO_NEAREST_INT),
+              "Float16 of float " + std::to_string(bits) + " isn't rounded as by F16C.");
+      }
+#endif
+    }
+
+    void HalfFloatTest::TestBFloat16Conversions()
+    {
+      for (uint32_t bits = 0; bits <= 0xFFFFu; ++bits)
+      {
+        const uint16_t halfBits = static_cast<uint16_t>(bits);
+        const engine::common::BFloat16 half = GetHalf<engine::common::BFloat16>(halfBits);
+        Check(GetBits(static_cast<float>(half)) == (bits << 16), "BFloat16 " + std::to_string(bits) + " is widened wrong.");
+
+        const bool nan = ((bits & 0x7F80u) == 0x7F80u) && ((bits & 0x007Fu) != 0);
+        const uint16_t roundTripBits = engine::common::BFloat16{ static_cast<float>(half) }.GetBits();
+        Check(roundTripBits == (nan ? (halfBits | 0x0040u) : halfBits), "BFloat16 " + std::to_string(bits) + " is changed by the round trip.");
+
+        // The tie, the floats next to it and a NaN, which payload is lost by truncation.
+        const uint32_t tieBits = (bits << 16) | 0x8000u;
+        for (const uint32_t valueBits : { tieBits, tieBits - 1, tieBits + 1, (bits << 16) | 0x0001u })
+        {
+          const float value = GetFloat(valueBits);
+          Check(engine::common::BFloat16{ value }.GetBits() == GetBFloat16Bits(value),
+                "BFloat16 of float " + std::to_string(valueBits) + " isn't rounded to nearest even.");
+        }
+      }
+    }
+
+    void HalfFloatTest::TestDotProduct()
+    {
+      engine::common::ValueGenerator<float> valueGenerator;
+      valueGenerator.SetMaxValue(1.f);
+      valueGenerator.SetMinValue(-1.f);
+      std::vector<float> values(MAX_DOT_PRODUCT_COUNT);
+      std::vector<float> weights(MAX_DOT_PRODUCT_COUNT);
+      for (size_t i = 0; i < MAX_DOT_PRODUCT_COUNT; ++i)
+      {
+        values[i] = valueGenerator.Generate();
+        weights[i] = valueGenerator.Generate();
+      }
+      std::vector<engine::common::Float16> float16Weights(MAX_DOT_PRODUCT_COUNT);
+      std::vector<engine::common::BFloat16> bfloat16Weights(MAX_DOT_PRODUCT_COUNT);
+      engine::common::HalfFloat::Convert(weights.data(), float16Weights.data(), MAX_DOT_PRODUCT_COUNT);
+      engine::common::HalfFloat::Convert(weights.data(), bfloat16Weights.data(), MAX_DOT_PRODUCT_COUNT);
+
+      // Counts cover empty products, tails only, and whole blocks of 16 values with tails.
+      for (size_t count = 0; count <= MAX_DOT_PRODUCT_COUNT; ++count)
+      {
+        double sum = 0.;
+        double float16Sum = 0.;
+        double bfloat16Sum = 0.;
+        for (size_t i = 0; i < count; ++i)
+        {
+          sum += static_cast<double>(values[i]) * weights[i];
+          float16Sum += static_cast<double>(values[i]) * static_cast<float>(float16Weights[i]);
+          bfloat16Sum += static_cast<double>(values[i]) * static_cast<float>(bfloat16Weights[i]);
+        }
+        const std::string name = " dot product of " + std::to_string(count) + " values deviates from the sum.";
+        Check(std::abs(engine::common::HalfFloat::DotProduct(values.data(), weights.data(), count) - sum) <= DOT_PRODUCT_TOLERANCE, "The native" + name);
+        Check(std::abs(engine::common::HalfFloat::DotProduct(values.data(), float16Weights.data(), count) - float16Sum) <= DOT_PRODUCT_TOLERANCE,
+              "The Float16" + name);
+        Check(std::abs(engine::common::HalfFloat::DotProduct(values.data(), bfloat16Weights.data(), count) - bfloat16Sum) <= DOT_PRODUCT_TOLERANCE,
+              "The BFloat16" + name);
+      }
+    }
+
+    uint16_t HalfFloatTest::GetFloat16Bits(const float value)
+    {
+      const uint32_t bits = GetBits(value);
+      const uint16_t sign = static_cast<uint16_t>((bits >> 16) & 0x8000u);
+      if (std::isnan(value))
+      {
+        // F16C makes NaNs quiet and keeps the upper bits of the payload.
+        return static_cast<uint16_t>(sign | 0x7E00u | ((bits >> 13) & 0x03FFu));
+      }
+
+      const double absValue = std::abs(static_cast<double>(value));
+      if (absValue >= 65520.)
+      {
+        return static_cast<uint16_t>(sign | 0x7C00u);
+      }
+      if (absValue < std::ldexp(1., -14))
+      {
+        // Subnormal values are multiples of 2^-24, and nearbyint() rounds to nearest even, so 2^-14 becomes the least normal value.
+        return static_cast<uint16_t>(sign | static_cast<uint16_t>(std::nearbyint(std::ldexp(absValue, 24))));
+      }
+      int exponent = 0;
+      const double mantissa = std::frexp(absValue, &exponent);
+      // The mantissa is in [0.5, 1), so it has 11 significant bits after the scaling by 2^11, and a carry increments the exponent.
+      const uint32_t significand = static_cast<uint32_t>(std::nearbyint(std::ldexp(mantissa, 11)));
+      return static_cast<uint16_t>(sign | (((static_cast<uint32_t>(exponent + 14) << 10) + significand - 0x0400u)));
+    }
+
+    uint32_t HalfFloatTest::GetFloatBitsOfFloat16(const uint16_t bits)
+    {
+      const uint32_t sign = static_cast<uint32_t>(bits & 0x8000u) << 16;
+      const uint32_t exponent = (bits >> 10) & 0x1Fu;
+      const uint32_t mantissa = bits & 0x03FFu;
+      if (exponent == 0x1Fu)
+      {
+        return sign | 0x7F800000u | (mantissa != 0 ? 0x00400000u | (mantissa << 13) : 0u);
+      }
+      const double absValue = exponent == 0 ? std::ldexp(static_cast<double>(mantissa), -24) :
+                                              std::ldexp(1. + mantissa / 1024., static_cast<int>(exponent) - 15);
+      return sign | GetBits(static_cast<float>(absValue));
+    }
+
+    uint16_t HalfFloatTest::GetBFloat16Bits(const float value)
+    {
+      const uint32_t bits = GetBits(value);
+      if (std::isnan(value))
+      {
+        return static_cast<uint16_t>((bits >> 16) | 0x0040u);
+      }
+
+      // The neighbours are the truncated value and the next one, which may be infinity, but 2^128 rounds the same way.
+      const uint32_t lowerBits = bits & 0xFFFF0000u;
+      const double lowerValue = std::abs(static_cast<double>(GetFloat(lowerBits)));
+      const double upperValue = ((bits & 0x7FFF0000u) == 0x7F7F0000u) ? std::ldexp(1., 128) : std::abs(static_cast<double>(GetFloat(lowerBits + 0x10000u)));
+      const double absValue = std::abs(static_cast<double>(value));
+      const bool up = (absValue - lowerValue > upperValue - absValue) ||
+                      ((absValue - lowerValue == upperValue - absValue) && (((lowerBits >> 16) & 1u) != 0));
+      return static_cast<uint16_t>((lowerBits >> 16) + (up ? 1u : 0u));
+    }
+
+    template <typename S>
+    S HalfFloatTest::GetHalf(const uint16_t bits)
+    {
+      S half;
+      std::memcpy(static_cast<void*>(&half), &bits, sizeof(half));
+      return half;
+    }
+
+    float HalfFloatTest::GetFloat(const uint32_t bits)
+    {
+      float value;
+      std::memcpy(&value, &bits, sizeof(value));
+      return value;
+    }
+
+    uint32_t HalfFloatTest::GetBits(const float value)
+    {
+      uint32_t bits;
+      std::memcpy(&bits, &value, sizeof(bits));
+      return bits;
+    }
+  }
+}
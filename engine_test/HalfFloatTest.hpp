@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace cnn
+{
+  namespace engine_test
+  {
+    class HalfFloatTest
+    {
+    public:
+
+      // Float16 conversions give the bits of IEEE 754 conversions with rounding to nearest even, which F16C instructions give,
+      // for all 16-bit values, for ties and their neighbours and for a sample of all floats, and NaNs stay quiet NaNs with their payloads.
+      // If the build has F16C, the conversions are compared with the instructions too.
+      static void TestFloat16Conversions();
+
+      // BFloat16 conversions round to nearest even and keep NaNs quiet, and widening is exact.
+      static void TestBFloat16Conversions();
+
+      // HalfFloat::DotProduct() gives the sums of converted weights for native, Float16 and BFloat16 weights of all tail lengths.
+      static void TestDotProduct();
+
+    private:
+
+      // Floats are sampled by this step over all bit patterns.
+      constexpr static uint32_t FLOAT_SAMPLE_STEP = 4099;
+
+      constexpr static size_t MAX_DOT_PRODUCT_COUNT = 70;
+      constexpr static float DOT_PRODUCT_TOLERANCE = 1e-5f;
+
+      // Reference conversions are computed in double by the definition of IEEE 754 rounding.
+      static uint16_t GetFloat16Bits(const float value);
+      static uint32_t GetFloatBitsOfFloat16(const uint16_t bits);
+      static uint16_t GetBFloat16Bits(const float value);
+
+      // The storage types are built from values only, so their bits are copied.
+      template <typename S>
+      static S GetHalf(const uint16_t bits);
+
+      static float GetFloat(const uint32_t bits);
+      static uint32_t GetBits(const float value);
+
+      ~HalfFloatTest() = delete;
+
+    };
+  }
+}
@@ -0,0 +1,440 @@
+#include "Layer2DTest.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <string>
+#include <utility>
+
+#include "../engine/common/Activation.hpp"
+#include "../engine/common/Mutagen.hpp"
+
+#include "Check.hpp"
+
+namespace cnn
+{
+  namespace engine_test
+  {
+    void Layer2DTest::TestBlockedMatchesMaps()
+    {
+      engine::common::ThreadPool threadPool{ THREAD_COUNT };
+      const engine::convolution::Layer2DType full = engine::convolution::Layer2DType::Full;
+      const engine::convolution::Layer2DTopology topologies[] = { GetTopology({ 11, 9 }, { 3, 3 }, 1, full),
+                                                                   GetTopology({ 40, 38 }, { 3, 3 }, 1, full, engine::common::ActivationType::Sigmoid),
+                                                                   GetTopology({ 21, 20 }, { 5, 2 }, 2, full, engine::common::ActivationType::ReLU),
+                                                                   GetTopology({ 13, 13 }, { 1, 1 }, 1, full),
+                                                                   GetTopology({ 30, 30 }, { 3, 3 }, 1, engine::convolution::Layer2DType::DepthwiseSeparable,
+                                                                               engine::common::ActivationType::Sigmoid) };
+      for (const engine::convolution::Layer2DTopology& topology : topologies)
+      {
+        CheckBlockedOutput<float>(topology, FLOAT_TOLERANCE, threadPool);
+        CheckBlockedOutput<double>(topology, DOUBLE_TOLERANCE, threadPool);
+      }
+    }
+
+    void Layer2DTest::TestDilatedMatchesDirect()
+    {
+      engine::common::ThreadPool threadPool{ THREAD_COUNT };
+      const engine::convolution::Layer2DType full = engine::convolution::Layer2DType::Full;
+      const engine::convolution::Layer2DTopology topologies[] = { GetTopology({ 12, 11 }, { 3, 3 }, 2, full),
+                                                                   GetTopology({ 48, 48 }, { 3, 3 }, 3, full, engine::common::ActivationType::ReLU),
+                                                                   GetTopology({ 30, 27 }, { 5, 5 }, 2, full, engine::common::ActivationType::Sigmoid),
+                                                                   GetTopology({ 25, 19 }, { 5, 3 }, 3, full) };
+      for (const engine::convolution::Layer2DTopology& topology : topologies)
+      {
+        CheckOutput<float>(topology, FLOAT_TOLERANCE, threadPool);
+        CheckOutput<double>(topology, DOUBLE_TOLERANCE, threadPool);
+      }
+    }
+
+    void Layer2DTest::TestFourierMatchesDirect()
+    {
+      const engine::convolution::Layer2DType full = engine::convolution::Layer2DType::Full;
+      const engine::convolution::Layer2DTopology topologies[] = { GetTopology({ 20, 20 }, { 5, 5 }, 1, full),
+                                                                   GetTopology({ 24, 17 }, { 7, 4 }, 1, full),
+                                                                   GetTopology({ 33, 30 }, { 3, 3 }, 3, full),
+                                                                   GetTopology({ 40, 40 }, { 11, 11 }, 1, full) };
+      for (const engine::convolution::Layer2DTopology& topology : topologies)
+      {
+        CheckFourierOutput<float>(topology, FLOAT_TOLERANCE);
+        CheckFourierOutput<double>(topology, DOUBLE_TOLERANCE);
+      }
+
+      engine::convolution::Layer2D<double> layer{ topologies[std::size(topologies) - 1] };
+      Check(layer.IsFourierUsed(), "The Fourier kernel isn't used for 11 x 11 cores of 40 x 40 inputs.");
+      engine::common::ValueGenerator<double> valueGenerator;
+      valueGenerator.SetMaxValue(1.);
+      valueGenerator.SetMinValue(-1.);
+      layer.FillWeights(valueGenerator);
+      FillInputs(layer, valueGenerator);
+      layer.GenerateOutput();
+      Check(GetMaxDeviation(layer) <= DOUBLE_TOLERANCE, "GenerateOutput() deviates from the direct sums by the Fourier kernel.");
+    }
+
+    void Layer2DTest::TestPointwiseMatchesDirect()
+    {
+      engine::common::ThreadPool threadPool{ THREAD_COUNT };
+      const engine::convolution::Layer2DType full = engine::convolution::Layer2DType::Full;
+      const engine::convolution::Layer2DTopology topologies[] = { GetTopology({ 13, 13 }, { 1, 1 }, 1, full),
+                                                                   GetTopology({ 7, 30 }, { 1, 1 }, 1, full, engine::common::ActivationType::ReLU),
+                                                                   GetTopology({ 65, 64 }, { 1, 1 }, 1, full, engine::common::ActivationType::Tanh) };
+      for (const engine::convolution::Layer2DTopology& topology : topologies)
+      {
+        CheckOutput<float>(topology, FLOAT_TOLERANCE, threadPool);
+        CheckOutput<double>(topology, DOUBLE_TOLERANCE, threadPool);
+      }
+    }
+
+    void Layer2DTest::TestSeparableMatchesDirect()
+    {
+      engine::common::ThreadPool threadPool{ THREAD_COUNT };
+      const engine::convolution::Layer2DType separable = engine::convolution::Layer2DType::DepthwiseSeparable;
+      const engine::convolution::Layer2DTopology topologies[] = { GetTopology({ 11, 9 }, { 3, 3 }, 1, separable, engine::common::ActivationType::ReLU),
+                                                                   GetTopology({ 64, 62 }, { 3, 3 }, 1, separable, engine::common::ActivationType::Sigmoid),
+                                                                   GetTopology({ 21, 20 }, { 5, 2 }, 2, separable, engine::common::ActivationType::LeakyReLU),
+                                                                   GetTopology({ 33, 30 }, { 3, 3 }, 3, separable) };
+      for (const engine::convolution::Layer2DTopology& topology : topologies)
+      {
+        CheckOutput<float>(topology, FLOAT_TOLERANCE, threadPool);
+        CheckOutput<double>(topology, DOUBLE_TOLERANCE, threadPool);
+      }
+    }
+
+    void Layer2DTest::TestWinogradMatchesDirect()
+    {
+      engine::common::ThreadPool threadPool{ THREAD_COUNT };
+      // The first sizes are applied by F(2 x 2, 3 x 3), the last ones by F(4 x 4, 3 x 3).
+      const engine::convolution::Size2D sizes[] = { { 6, 6 }, { 7, 9 }, { 12, 17 }, { 18, 18 }, { 19, 21 }, { 35, 40 } };
+      for (const engine::convolution::Size2D& size : sizes)
+      {
+        CheckWinogradOutput<float>(size.GetWidth(), size.GetHeight(), FLOAT_TOLERANCE, threadPool);
+        CheckWinogradOutput<double>(size.GetWidth(), size.GetHeight(), DOUBLE_TOLERANCE, threadPool);
+      }
+    }
+
+    engine::convolution::Layer2DTopology Layer2DTest::GetTopology(const engine::convolution::Size2D& inputSize,
+                                                                  const engine::convolution::Size2D& coreSize,
+                                                                  const size_t dilation,
+                                                                  const engine::convolution::Layer2DType type,
+                                                                  const engine::common::ActivationType activationType)
+    {
+      const engine::convolution::Size2D outputSize{ inputSize.GetWidth() - (coreSize.GetWidth() - 1) * dilation,
+                                                    inputSize.GetHeight() - (coreSize.GetHeight() - 1) * dilation };
+      return { inputSize, INPUT_COUNT, { coreSize, INPUT_COUNT, dilation }, FILTER_COUNT, outputSize, FILTER_COUNT,
+               type, activationType };
+    }
+
+    template <typename T>
+    void Layer2DTest::CheckBlockedOutput(const engine::convolution::Layer2DTopology& topology, const T tolerance, engine::common::ThreadPool& threadPool)
+    {
+      engine::convolution::Layer2D<T> layer{ topology };
+      engine::common::ValueGenerator<T> valueGenerator;
+      valueGenerator.SetMaxValue(static_cast<T>(1));
+      valueGenerator.SetMinValue(static_cast<T>(-1));
+      layer.FillWeights(valueGenerator);
+      FillInputs(layer, valueGenerator);
+      engine::convolution::BlockedTensor2D<T> inputs{ topology.GetInputSize(), topology.GetInputCount() };
+      for (size_t i = 0; i < topology.GetInputCount(); ++i)
+      {
+        inputs.Pack(i, std::as_const(layer).GetInput(i));
+      }
+
+      const engine::convolution::Size2D& coreSize = topology.GetFilterTopology().GetSize();
+      const std::string name = std::to_string(coreSize.GetWidth()) + " x " + std::to_string(coreSize.GetHeight()) + " cores of " +
+                               std::to_string(topology.GetInputSize().GetWidth()) + " x " + std::to_string(topology.GetInputSize().GetHeight()) +
+                               " inputs of " + (sizeof(T) == sizeof(float) ? "float" : "double");
+      for (size_t pass = 0; pass < 2; ++pass)
+      {
+        if (pass == 0)
+        {
+          layer.GenerateOutputFromBlocked(inputs);
+        }
+        else
+        {
+          layer.GenerateOutputFromBlocked(inputs, threadPool);
+        }
+        layer.UnpackBlockedOutputs();
+        const std::string kernel = pass == 0 ? " by the blocked kernel." : " by the blocked kernel in parallel.";
+        Check(GetMaxDeviation(layer) <= tolerance, name + " deviate from the direct sums" + kernel);
+
+        const engine::convolution::BlockedTensor2D<T>& outputs = layer.GetBlockedOutputs();
+        const T* const lastBlock = outputs.GetBlock(outputs.GetBlockCount() - 1);
+        const size_t laneCount = topology.GetOutputCount() - (outputs.GetBlockCount() - 1) * outputs.BLOCK_SIZE;
+        bool zeroLanes = true;
+        for (size_t p = 0; p < topology.GetOutputSize().GetArea(); ++p)
+        {
+          for (size_t lane = laneCount; lane < outputs.BLOCK_SIZE; ++lane)
+          {
+            zeroLanes = zeroLanes && (lastBlock[lane + outputs.BLOCK_SIZE * p] == 0);
+          }
+        }
+        Check(zeroLanes, name + " give nonzero missing lanes" + kernel);
+      }
+    }
+
+    template <typename T>
+    void Layer2DTest::CheckOutput(const engine::convolution::Layer2DTopology& topology, const T tolerance, engine::common::ThreadPool& threadPool)
+    {
+      engine::convolution::Layer2D<T> layer{ topology };
+      engine::common::ValueGenerator<T> valueGenerator;
+      valueGenerator.SetMaxValue(static_cast<T>(1));
+      valueGenerator.SetMinValue(static_cast<T>(-1));
+      layer.FillWeights(valueGenerator);
+
+      engine::common::Mutagen<T> mutagen;
+      mutagen.SetMaxResult(static_cast<T>(1));
+      mutagen.SetMinResult(static_cast<T>(-1));
+      mutagen.SetVariabilityForce(static_cast<T>(0.5));
+
+      const engine::convolution::Size2D& coreSize = topology.GetFilterTopology().GetSize();
+      const size_t outputHeight = topology.GetOutputSize().GetHeight();
+      const std::string name = std::to_string(coreSize.GetWidth()) + " x " + std::to_string(coreSize.GetHeight()) + " cores of " +
+                               std::to_string(topology.GetFilterTopology().GetDilation()) + " dilation of " +
+                               std::to_string(topology.GetInputSize().GetWidth()) + " x " + std::to_string(topology.GetInputSize().GetHeight()) +
+                               " inputs of " + (sizeof(T) == sizeof(float) ? "float" : "double");
+      for (size_t pass = 0; pass < 2; ++pass)
+      {
+        const std::string suffix = pass == 0 ? "." : " after Mutate().";
+        if (pass != 0)
+        {
+          layer.Mutate(mutagen);
+        }
+
+        // New inputs precede every kernel, so outputs of the previous one don't pass the check.
+        FillInputs(layer, valueGenerator);
+        layer.GenerateOutput();
+        Check(GetMaxDeviation(layer) <= tolerance, name + " deviate from the direct sums" + suffix);
+
+        FillInputs(layer, valueGenerator);
+        layer.GenerateOutput(threadPool);
+        Check(GetMaxDeviation(layer) <= tolerance, name + " deviate from the direct sums in parallel" + suffix);
+
+        FillInputs(layer, valueGenerator);
+        layer.GenerateOutputRows(0, outputHeight / 2);
+        layer.GenerateOutputRows(outputHeight / 2, outputHeight, threadPool);
+        Check(GetMaxDeviation(layer) <= tolerance, name + " deviate from the direct sums by rows" + suffix);
+      }
+    }
+
+    template <typename T>
+    void Layer2DTest::CheckFourierOutput(const engine::convolution::Layer2DTopology& topology, const T tolerance)
+    {
+      engine::convolution::Layer2D<T> layer{ topology };
+      engine::common::ValueGenerator<T> valueGenerator;
+      valueGenerator.SetMaxValue(static_cast<T>(1));
+      valueGenerator.SetMinValue(static_cast<T>(-1));
+      layer.FillWeights(valueGenerator);
+      FillInputs(layer, valueGenerator);
+
+      const engine::convolution::Size2D& coreSize = topology.GetFilterTopology().GetSize();
+      const std::string name = std::to_string(coreSize.GetWidth()) + " x " + std::to_string(coreSize.GetHeight()) + " cores of " +
+                               std::to_string(topology.GetFilterTopology().GetDilation()) + " dilation of " +
+                               (sizeof(T) == sizeof(float) ? "float" : "double");
+      layer.GenerateOutputByFourier();
+      Check(GetMaxDeviation(layer) <= tolerance, name + " deviate from the direct sums by the Fourier kernel.");
+
+      // The second pass reuses the spectra of cores.
+      FillInputs(layer, valueGenerator);
+      layer.GenerateOutputByFourier();
+      Check(GetMaxDeviation(layer) <= tolerance, name + " deviate from the direct sums by the Fourier kernel for new inputs.");
+    }
+
+    template <typename T>
+    void Layer2DTest::CheckWinogradOutput(const size_t width, const size_t height, const T tolerance, engine::common::ThreadPool& threadPool)
+    {
+      const engine::convolution::Size2D outputSize{ width - 2, height - 2 };
+      engine::convolution::Layer2D<T> layer{ { { width, height }, INPUT_COUNT, { { 3, 3 }, INPUT_COUNT }, FILTER_COUNT, outputSize, FILTER_COUNT,
+                                               engine::convolution::Layer2DType::Full, engine::common::ActivationType::Identity } };
+
+      engine::common::ValueGenerator<T> valueGenerator;
+      valueGenerator.SetMaxValue(static_cast<T>(1));
+      valueGenerator.SetMinValue(static_cast<T>(-1));
+      layer.FillWeights(valueGenerator);
+      FillInputs(layer, valueGenerator);
+
+      engine::common::Mutagen<T> mutagen;
+      mutagen.SetMaxResult(static_cast<T>(1));
+      mutagen.SetMinResult(static_cast<T>(-1));
+      mutagen.SetVariabilityForce(static_cast<T>(0.5));
+
+      const std::string name = std::to_string(width) + " x " + std::to_string(height) + " inputs of " + (sizeof(T) == sizeof(float) ? "float" : "double");
+      layer.GenerateOutput();
+      Check(GetMaxDeviation(layer) <= tolerance, name + " deviate from the direct kernel.");
+      layer.GenerateOutput(threadPool);
+      Check(GetMaxDeviation(layer) <= tolerance, name + " deviate from the direct kernel in parallel.");
+
+      layer.Mutate(mutagen);
+      layer.GenerateOutput();
+      Check(GetMaxDeviation(layer) <= tolerance, name + " deviate from the direct kernel after Mutate().");
+
+      layer.SetWeight(layer.GetWeightCount() / 2, static_cast<T>(0.75));
+      layer.GenerateOutput(threadPool);
+      Check(GetMaxDeviation(layer) <= tolerance, name + " deviate from the direct kernel after SetWeight().");
+    }
+
+    void Layer2DTest::TestReferenceWritesRenewTransforms()
+    {
+      // 18 x 18 inputs are applied by F(4 x 4, 3 x 3).
+      engine::convolution::Layer2D<double> layer{ { { 18, 18 }, INPUT_COUNT, { { 3, 3 }, INPUT_COUNT }, FILTER_COUNT, { 16, 16 }, FILTER_COUNT,
+                                                    engine::convolution::Layer2DType::Full, engine::common::ActivationType::Identity } };
+      engine::common::ValueGenerator<double> valueGenerator;
+      valueGenerator.SetMaxValue(1.);
+      valueGenerator.SetMinValue(-1.);
+      layer.FillWeights(valueGenerator);
+      FillInputs(layer, valueGenerator);
+
+      const engine::convolution::Filter2DProtectingReference<double> filter = layer.GetFilter(FILTER_COUNT - 1);
+      const engine::convolution::Core2DProtectingReference<double> core = filter.GetCore(1);
+      layer.GenerateOutput();
+      Check(GetMaxDeviation(layer) <= DOUBLE_TOLERANCE, "Outputs deviate from the direct kernel.");
+
+      core.SetWeight(1, 2, 0.75);
+      layer.GenerateOutput();
+      Check(GetMaxDeviation(layer) <= DOUBLE_TOLERANCE, "Outputs deviate from the direct kernel after SetWeight() of a core reference.");
+
+      engine::common::Mutagen<double> mutagen;
+      mutagen.SetMaxResult(1.);
+      mutagen.SetMinResult(-1.);
+      mutagen.SetVariabilityForce(0.5);
+      filter.Mutate(mutagen);
+      layer.GenerateOutput();
+      Check(GetMaxDeviation(layer) <= DOUBLE_TOLERANCE, "Outputs deviate from the direct kernel after Mutate() of a filter reference.");
+
+      filter.FillWeights(valueGenerator);
+      layer.GenerateOutput();
+      Check(GetMaxDeviation(layer) <= DOUBLE_TOLERANCE, "Outputs deviate from the direct kernel after FillWeights() of a filter reference.");
+
+      core.ClearWeights();
+      layer.GenerateOutput();
+      Check(GetMaxDeviation(layer) <= DOUBLE_TOLERANCE, "Outputs deviate from the direct kernel after ClearWeights() of a core reference.");
+    }
+
+    void Layer2DTest::TestSparseMatchesDense()
+    {
+      engine::common::ThreadPool threadPool{ THREAD_COUNT };
+      CheckSparseOutput<float>(FLOAT_TOLERANCE, threadPool);
+      CheckSparseOutput<double>(DOUBLE_TOLERANCE, threadPool);
+    }
+
+    template <typename T>
+    void Layer2DTest::CheckSparseOutput(const T tolerance, engine::common::ThreadPool& threadPool)
+    {
+      const engine::convolution::Layer2DTopology topology = GetTopology({ 40, 40 }, { 3, 3 }, 1, engine::convolution::Layer2DType::Full,
+                                                                        engine::common::ActivationType::ReLU);
+      engine::convolution::Layer2D<T> layer{ topology };
+      engine::common::ValueGenerator<T> valueGenerator;
+      valueGenerator.SetMaxValue(static_cast<T>(1));
+      valueGenerator.SetMinValue(static_cast<T>(-1));
+      layer.FillWeights(valueGenerator);
+      FillInputs(layer, valueGenerator);
+      for (size_t i = 0; i < layer.GetWeightCount(); ++i)
+      {
+        if (i % DENSITY_PERIOD != 0)
+        {
+          layer.SetWeight(i, static_cast<T>(0));
+        }
+      }
+
+      const std::string name = std::string{ "Sparse outputs of " } + (sizeof(T) == sizeof(float) ? "float" : "double");
+      Check((layer.IsSparse() == false) && (layer.IsSparseFaster()), "A pruned layer isn't dense by default or isn't estimated to be faster sparse.");
+      layer.GenerateOutput();
+      const engine::convolution::Layer2D<T> denseLayer{ layer };
+
+      layer.SetSparse(true);
+      layer.GenerateOutput();
+      double maxDifference = 0.;
+      const engine::convolution::Size2D& outputSize = topology.GetOutputSize();
+      for (size_t f = 0; f < topology.GetFilterCount(); ++f)
+      {
+        for (size_t y = 0; y < outputSize.GetHeight(); ++y)
+        {
+          for (size_t x = 0; x < outputSize.GetWidth(); ++x)
+          {
+            const double difference = static_cast<double>(layer.GetOutput(f).GetValue(x, y)) - denseLayer.GetOutput(f).GetValue(x, y);
+            maxDifference = std::max(maxDifference, std::abs(difference));
+          }
+        }
+      }
+      Check(maxDifference <= tolerance, name + " deviate from the dense ones by " + std::to_string(maxDifference) + ".");
+      Check(GetMaxDeviation(layer) <= tolerance, name + " deviate from the direct sums.");
+
+      layer.CopyWeights(denseLayer);
+      Check(layer.IsSparse() == false, "CopyWeights() doesn't take the sparsity state of the source.");
+      layer.SetSparse(true);
+      layer.GenerateOutput(threadPool);
+      Check(GetMaxDeviation(layer) <= tolerance, name + " deviate from the direct sums in parallel.");
+
+      const size_t middleY = outputSize.GetHeight() / 2;
+      layer.GenerateOutputRows(0, middleY);
+      layer.GenerateOutputRows(middleY, outputSize.GetHeight(), threadPool);
+      Check(GetMaxDeviation(layer) <= tolerance, name + " deviate from the direct sums by rows.");
+
+      layer.SetWeight(1, static_cast<T>(0.75));
+      layer.GenerateOutput();
+      Check(layer.IsSparse(), "SetWeight() makes a sparse layer dense.");
+      Check(GetMaxDeviation(layer) <= tolerance, name + " deviate from the direct sums after SetWeight().");
+
+      engine::common::Mutagen<T> mutagen;
+      mutagen.SetMaxResult(static_cast<T>(1));
+      mutagen.SetMinResult(static_cast<T>(-1));
+      mutagen.SetVariabilityForce(static_cast<T>(0.5));
+      layer.Mutate(mutagen);
+      Check(layer.IsSparse() == false, "Mutate() doesn't make a sparse layer dense.");
+      layer.GenerateOutput();
+      Check(GetMaxDeviation(layer) <= tolerance, name + " deviate from the direct sums after Mutate().");
+    }
+
+    template <typename T>
+    void Layer2DTest::FillInputs(engine::convolution::Layer2D<T>& layer, engine::common::ValueGenerator<T>& valueGenerator)
+    {
+      const engine::convolution::Size2D& size = layer.GetTopology().GetInputSize();
+      for (size_t i = 0; i < layer.GetTopology().GetInputCount(); ++i)
+      {
+        engine::convolution::Map2DProtectingReference<T> input = layer.GetInput(i);
+        for (size_t y = 0; y < size.GetHeight(); ++y)
+        {
+          for (size_t x = 0; x < size.GetWidth(); ++x)
+          {
+            input.SetValue(x, y, valueGenerator.Generate());
+          }
+        }
+      }
+    }
+
+    template <typename T>
+    double Layer2DTest::GetMaxDeviation(const engine::convolution::Layer2D<T>& layer)
+    {
+      const engine::convolution::Layer2DTopology& topology = layer.GetTopology();
+      const engine::convolution::Size2D& coreSize = topology.GetFilterTopology().GetSize();
+      const size_t dilation = topology.GetFilterTopology().GetDilation();
+      const bool separable = topology.GetType() == engine::convolution::Layer2DType::DepthwiseSeparable;
+      double maxDeviation = 0.;
+      for (size_t f = 0; f < topology.GetFilterCount(); ++f)
+      {
+        const engine::convolution::Filter2D<T>& filter = layer.GetFilter(f);
+        for (size_t oy = 0; oy < topology.GetOutputSize().GetHeight(); ++oy)
+        {
+          for (size_t ox = 0; ox < topology.GetOutputSize().GetWidth(); ++ox)
+          {
+            double sum = 0.;
+            for (size_t c = 0; c < topology.GetInputCount(); ++c)
+            {
+              const engine::convolution::Core2D<T>& core = separable ? layer.GetDepthwiseFilter().GetConstCore(c) : filter.GetConstCore(c);
+              const double scale = separable ? static_cast<double>(filter.GetConstCore(c).GetWeight(0, 0)) : 1.;
+              for (size_t cy = 0; cy < coreSize.GetHeight(); ++cy)
+              {
+                for (size_t cx = 0; cx < coreSize.GetWidth(); ++cx)
+                {
+                  sum += scale * core.GetWeight(cx, cy) * layer.GetInput(c).GetValue(ox + cx * dilation, oy + cy * dilation);
+                }
+              }
+            }
+            engine::common::Activation::Activate(topology.GetActivationType(), &sum, 1);
+            maxDeviation = std::max(maxDeviation, std::abs(sum - layer.GetOutput(f).GetValue(ox, oy)));
+          }
+        }
+      }
+      return maxDeviation;
+    }
+  }
+}
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <cstddef>
+
+#include "../engine/common/ThreadPool.hpp"
+#include "../engine/common/ValueGenerator.hpp"
+#include "../engine/convolution/BlockedTensor2D.hpp"
+#include "../engine/convolution/Layer2D.hpp"
+
+namespace cnn
+{
+  namespace engine_test
+  {
+    class Layer2DTest
+    {
+    public:
+
+      // The blocked kernel (NCHWc) gives the outputs of the direct sums within the tolerance of T for blocks, which are not full,
+      // output widths, which are not multiples of its pixel count, and activations, and it keeps missing lanes of its outputs zero.
+      static void TestBlockedMatchesMaps();
+
+      // Full layers of 1 x 1 cores, which are applied by the pointwise kernel, give the direct sums within the tolerance of T
+      // for filter counts, which are not multiples of its block of filters, and odd output widths, serially, in parallel, by rows and after Mutate().
+      static void TestPointwiseMatchesDirect();
+
+      // Depthwise separable layers give the direct sums of their depthwise cores scaled by the weights of filters within the tolerance of T
+      // serially, in parallel, by rows and after Mutate() for several core sizes, dilations and activations.
+      static void TestSeparableMatchesDirect();
+
+      // Full layers of dilated cores give the direct sums within the tolerance of T for dilations 2 and 3 of square and non-square cores,
+      // serially, in parallel, by rows and after Mutate().
+      static void TestDilatedMatchesDirect();
+
+      // The Fourier kernel gives the outputs of the direct sums within the tolerance of T for odd and even core sizes,
+      // dilated cores and input sizes, which are not powers of 2. The layers, which are estimated to be cheaper by it, use it.
+      static void TestFourierMatchesDirect();
+
+      // Winograd F(2 x 2, 3 x 3) and F(4 x 4, 3 x 3) give the outputs of the direct kernel within the tolerance of T
+      // for output sizes, which are not multiples of tiles, and after Mutate() and SetWeight() invalidate the transforms of cores.
+      static void TestWinogradMatchesDirect();
+
+      // Writes of weights through references to filters and cores, which were taken before the transforms of cores were built,
+      // invalidate the transforms, so the outputs still match the direct kernel.
+      static void TestReferenceWritesRenewTransforms();
+
+      // A sparse layer, which applies only nonzero weights, gives the outputs of the dense one (by Winograd tiles for 3 x 3 cores)
+      // within the tolerance of T serially, in parallel and by rows. SetWeight() keeps the layer sparse, and Mutate() makes it dense.
+      static void TestSparseMatchesDense();
+
+    private:
+
+      constexpr static size_t INPUT_COUNT = 3;
+      constexpr static size_t FILTER_COUNT = 5;
+      constexpr static size_t THREAD_COUNT = 4;
+
+      // The sparse test keeps every DENSITY_PERIOD-th weight and zeroes the rest.
+      constexpr static size_t DENSITY_PERIOD = 5;
+
+      constexpr static float FLOAT_TOLERANCE = 1e-4f;
+      constexpr static double DOUBLE_TOLERANCE = 1e-11;
+
+      // It returns the topology of the layer of INPUT_COUNT inputs and FILTER_COUNT filters, which outputs are as large as the cores allow.
+      static engine::convolution::Layer2DTopology GetTopology(const engine::convolution::Size2D& inputSize,
+                                                              const engine::convolution::Size2D& coreSize,
+                                                              const size_t dilation,
+                                                              const engine::convolution::Layer2DType type,
+                                                              const engine::common::ActivationType activationType = engine::common::ActivationType::Identity);
+
+      template <typename T>
+      static void CheckBlockedOutput(const engine::convolution::Layer2DTopology& topology, const T tolerance, engine::common::ThreadPool& threadPool);
+
+      // It checks the outputs of GenerateOutput(), its parallel version and GenerateOutputRows() against the direct sums
+      // for two sets of inputs, and for the second one after Mutate().
+      template <typename T>
+      static void CheckOutput(const engine::convolution::Layer2DTopology& topology, const T tolerance, engine::common::ThreadPool& threadPool);
+
+      template <typename T>
+      static void CheckFourierOutput(const engine::convolution::Layer2DTopology& topology, const T tolerance);
+
+      template <typename T>
+      static void CheckSparseOutput(const T tolerance, engine::common::ThreadPool& threadPool);
+
+      template <typename T>
+      static void CheckWinogradOutput(const size_t width, const size_t height, const T tolerance, engine::common::ThreadPool& threadPool);
+
+      template <typename T>
+      static void FillInputs(engine::convolution::Layer2D<T>& layer, engine::common::ValueGenerator<T>& valueGenerator);
+
+      // It returns the greatest deviation of the outputs of the layer from the activated sums of the direct correlation of its inputs,
+      // which are accumulated in double. The cores of a depthwise separable layer are the depthwise cores scaled by the weights of filters.
+      template <typename T>
+      static double GetMaxDeviation(const engine::convolution::Layer2D<T>& layer);
+
+      ~Layer2DTest() = delete;
+
+    };
+  }
+}
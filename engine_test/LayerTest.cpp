@@ -0,0 +1,73 @@
+#include "LayerTest.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include "../engine/common/HalfFloat.hpp"
+#include "../engine/common/Mutagen.hpp"
+#include "../engine/common/ValueGenerator.hpp"
+
+#include "Check.hpp"
+
+namespace cnn
+{
+  namespace engine_test
+  {
+    void LayerTest::TestReferenceWritesRenewCompactWeights()
+    {
+      engine::perceptron::Layer<double> layer{ { INPUT_COUNT, NEURON_COUNT, engine::common::ActivationType::Identity } };
+      layer.SetWeightFormat(engine::common::WeightFormat::Float16);
+
+      engine::common::ValueGenerator<double> valueGenerator;
+      valueGenerator.SetMaxValue(1.);
+      valueGenerator.SetMinValue(-1.);
+      layer.FillWeights(valueGenerator);
+      engine::common::MapProtectingReference<double> input = layer.GetInput();
+      for (size_t i = 0; i < INPUT_COUNT; ++i)
+      {
+        input.SetValue(i, valueGenerator.Generate());
+      }
+
+      const engine::common::NeuronProtectingReference<double> neuron = layer.GetNeuron(NEURON_COUNT - 1);
+      layer.GenerateOutput();
+      Check(GetMaxDeviation(layer) <= TOLERANCE, "Outputs deviate from the sums of Float16 weights.");
+
+      neuron.SetWeight(INPUT_COUNT / 2, 0.75);
+      layer.GenerateOutput();
+      Check(GetMaxDeviation(layer) <= TOLERANCE, "Outputs deviate from the sums of Float16 weights after SetWeight() of a neuron reference.");
+
+      engine::common::Mutagen<double> mutagen;
+      mutagen.SetMaxResult(1.);
+      mutagen.SetMinResult(-1.);
+      mutagen.SetVariabilityForce(0.5);
+      neuron.Mutate(mutagen);
+      layer.GenerateOutput();
+      Check(GetMaxDeviation(layer) <= TOLERANCE, "Outputs deviate from the sums of Float16 weights after Mutate() of a neuron reference.");
+
+      neuron.FillWeights(valueGenerator);
+      layer.GenerateOutput();
+      Check(GetMaxDeviation(layer) <= TOLERANCE, "Outputs deviate from the sums of Float16 weights after FillWeights() of a neuron reference.");
+
+      neuron.ClearWeights();
+      layer.GenerateOutput();
+      Check(GetMaxDeviation(layer) <= TOLERANCE, "Outputs deviate from the sums of Float16 weights after ClearWeights() of a neuron reference.");
+    }
+
+    double LayerTest::GetMaxDeviation(const engine::perceptron::Layer<double>& layer)
+    {
+      double maxDeviation = 0.;
+      for (size_t n = 0; n < layer.GetTopology().GetNeuronCount(); ++n)
+      {
+        const engine::common::Neuron<double>& neuron = layer.GetNeuron(n);
+        double sum = 0.;
+        for (size_t i = 0; i < layer.GetTopology().GetInputCount(); ++i)
+        {
+          const float weight = static_cast<float>(engine::common::Float16{ static_cast<float>(neuron.GetWeight(i)) });
+          sum += weight * layer.GetInput().GetValue(i);
+        }
+        maxDeviation = std::max(maxDeviation, std::abs(sum - layer.GetOutput().GetValue(n)));
+      }
+      return maxDeviation;
+    }
+  }
+}
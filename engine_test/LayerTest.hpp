@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstddef>
+
+#include "../engine/perceptron/Layer.hpp"
+
+namespace cnn
+{
+  namespace engine_test
+  {
+    class LayerTest
+    {
+    public:
+
+      // Writes of weights through references to neurons, which were taken before the 16-bit copy of weights was built,
+      // invalidate the copy, so the outputs still match the sums of the rounded weights.
+      static void TestReferenceWritesRenewCompactWeights();
+
+    private:
+
+      constexpr static size_t INPUT_COUNT = 70;
+      constexpr static size_t NEURON_COUNT = 6;
+
+      constexpr static double TOLERANCE = 1e-9;
+
+      // It returns the greatest deviation of the outputs of the layer from the sums of its weights, which are rounded to Float16.
+      static double GetMaxDeviation(const engine::perceptron::Layer<double>& layer);
+
+      ~LayerTest() = delete;
+
+    };
+  }
+}
@@ -0,0 +1,64 @@
+#include "MutagenTest.hpp"
+
+#include <string>
+
+#include "../engine/common/Mutagen.hpp"
+
+#include "Check.hpp"
+
+namespace cnn
+{
+  namespace engine_test
+  {
+    void MutagenTest::TestReproducibleStreams()
+    {
+      const std::vector<double> sequence = GetSequence(SEED, STREAM);
+      Check(GetSequence(SEED, STREAM) == sequence, "The same seed and stream give different sequences.");
+      Check(GetSequence(SEED, STREAM + 1) != sequence, "Different streams give the same sequence.");
+      Check(GetSequence(SEED + 1, STREAM) != sequence, "Different seeds give the same sequence.");
+
+      // Streams of the same seed are independent, so no value of the sequence is repeated at its position by the next stream.
+      const std::vector<double> nextSequence = GetSequence(SEED, STREAM + 1);
+      for (size_t i = 0; i < sequence.size(); ++i)
+      {
+        Check(sequence[i] != nextSequence[i], "The value " + std::to_string(i) + " is the same for different streams.");
+      }
+
+      engine::common::Mutagen<float> mutagen;
+      mutagen.SetSeed(SEED);
+      mutagen.SetStream(STREAM);
+      const float first = mutagen.Mutate(0.f);
+      mutagen.Mutate(0.f);
+      mutagen.SetStream(STREAM);
+      Check(mutagen.Mutate(0.f) == first, "SetStream() doesn't restart the sequence.");
+      mutagen.Mutate(0.f);
+      mutagen.SetSeed(SEED);
+      Check(mutagen.GetStream() == STREAM, "SetSeed() changes the stream.");
+      Check(mutagen.Mutate(0.f) == first, "SetSeed() doesn't restart the sequence.");
+    }
+
+    std::vector<double> MutagenTest::GetSequence(const unsigned int seed, const uint64_t stream)
+    {
+      engine::common::Mutagen<float> mutagen;
+      mutagen.SetMaxResult(2.f);
+      mutagen.SetMinResult(-2.f);
+      mutagen.SetVariabilityForce(1.f);
+      mutagen.SetSeed(seed);
+      mutagen.SetStream(stream);
+
+      std::vector<double> sequence;
+      for (size_t i = 0; i < SINGLE_COUNT; ++i)
+      {
+        sequence.push_back(mutagen.Mutate(0.f));
+      }
+      std::vector<float> values(BULK_COUNT, 0.f);
+      mutagen.Mutate(values.data(), values.size());
+      sequence.insert(sequence.end(), values.begin(), values.end());
+      for (size_t i = 0; i < INDEX_COUNT; ++i)
+      {
+        sequence.push_back(static_cast<double>(mutagen.GenerateIndex(INDEX_RANGE)));
+      }
+      return sequence;
+    }
+  }
+}
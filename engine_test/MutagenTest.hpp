@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace cnn
+{
+  namespace engine_test
+  {
+    class MutagenTest
+    {
+    public:
+
+      // Mutagens with the same seed and stream give the same sequence of single, bulk and index mutations,
+      // and SetSeed() and SetStream() restart it. Different streams or seeds give different sequences.
+      static void TestReproducibleStreams();
+
+    private:
+
+      constexpr static unsigned int SEED = 12345;
+      constexpr static uint64_t STREAM = 7;
+
+      // Single mutations use part of a block, and the bulk count covers batches, blocks and the tail.
+      constexpr static size_t SINGLE_COUNT = 5;
+      constexpr static size_t BULK_COUNT = 77;
+      constexpr static size_t INDEX_COUNT = 3;
+      constexpr static size_t INDEX_RANGE = 1000003;
+
+      // It returns the values, which a new mutagen of the seed and the stream gives.
+      static std::vector<double> GetSequence(const unsigned int seed, const uint64_t stream);
+
+      ~MutagenTest() = delete;
+
+    };
+  }
+}
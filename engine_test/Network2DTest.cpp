@@ -0,0 +1,158 @@
+#include "Network2DTest.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include "../engine/complex/Network2D.hpp"
+
+#include "Check.hpp"
+
+namespace cnn
+{
+  namespace engine_test
+  {
+    void Network2DTest::TestFusedMatchesWhole()
+    {
+      const engine::convolution::Network2DTopology topology = GetFusedTopology();
+      engine::common::ValueGenerator<float> valueGenerator;
+      valueGenerator.SetMaxValue(1.f);
+      valueGenerator.SetMinValue(-1.f);
+
+      engine::convolution::Network2D<float> wholeNetwork{ topology };
+      wholeNetwork.FillWeights(valueGenerator);
+      engine::convolution::Network2D<float> fusedNetwork{ topology };
+      fusedNetwork.CopyWeights(wholeNetwork);
+      fusedNetwork.SetFusedTileHeight(FUSED_TILE_HEIGHT);
+      engine::convolution::Network2D<float> newNetwork{ topology };
+      newNetwork.CopyWeights(wholeNetwork);
+      newNetwork.SetFusedTileHeight(FUSED_TILE_HEIGHT);
+
+      const std::vector<float> firstInputs = GenerateInputs(topology, valueGenerator, FIRST_SAMPLE_SCALE);
+      SetInputs(wholeNetwork, firstInputs);
+      wholeNetwork.GenerateOutput();
+      SetInputs(fusedNetwork, firstInputs);
+      fusedNetwork.GenerateOutput();
+      Check(GetMaxDifference(wholeNetwork, fusedNetwork) <= FUSED_TOLERANCE, "Fused outputs deviate from whole ones for the first sample.");
+
+      const std::vector<float> secondInputs = GenerateInputs(topology, valueGenerator, 1.f);
+      SetInputs(wholeNetwork, secondInputs);
+      wholeNetwork.GenerateOutput();
+      SetInputs(fusedNetwork, secondInputs);
+      fusedNetwork.GenerateOutput();
+      Check(GetMaxDifference(wholeNetwork, fusedNetwork) <= FUSED_TOLERANCE, "Fused outputs deviate from whole ones for the second sample.");
+
+      SetInputs(newNetwork, secondInputs);
+      newNetwork.GenerateOutput();
+      Check(GetMaxDifference(newNetwork, fusedNetwork) == 0.f, "Fused outputs of the second sample depend on the first one.");
+    }
+
+    void Network2DTest::TestLegacyFormatRoundTrip()
+    {
+      std::ifstream file{ LEGACY_NETWORK_PATH, std::ios::binary };
+      Check(file.is_open(), std::string{ LEGACY_NETWORK_PATH } + " isn't opened.");
+      engine::complex::Network2D<float> legacyNetwork;
+      legacyNetwork.Load(file);
+
+      const engine::convolution::Network2DTopology& convolutionTopology = legacyNetwork.GetTopology().GetConvolutionTopology();
+      Check(convolutionTopology.GetLayerCount() != 0, "The legacy network has no convolution layers.");
+      for (size_t i = 0; i < convolutionTopology.GetLayerCount(); ++i)
+      {
+        const engine::convolution::Layer2DTopology& layerTopology = convolutionTopology.GetLayerTopology(i);
+        Check(layerTopology.GetType() == engine::convolution::Layer2DType::Full, "A legacy convolution layer isn't full.");
+        Check(layerTopology.GetActivationType() == engine::common::ActivationType::Sigmoid, "A legacy convolution layer isn't activated by sigmoid.");
+        Check(layerTopology.GetFilterTopology().GetDilation() == 1, "A legacy filter is dilated.");
+      }
+      const engine::perceptron::NetworkTopology& perceptronTopology = legacyNetwork.GetTopology().GetPerceptronTopology();
+      Check(perceptronTopology.GetLayerCount() != 0, "The legacy network has no perceptron layers.");
+      for (size_t i = 0; i < perceptronTopology.GetLayerCount(); ++i)
+      {
+        Check(perceptronTopology.GetLayerTopology(i).GetActivationType() == engine::common::ActivationType::Sigmoid,
+              "A legacy perceptron layer isn't activated by sigmoid.");
+      }
+
+      std::stringstream stream;
+      legacyNetwork.Save(stream);
+      engine::complex::Network2D<float> network;
+      network.Load(stream);
+
+      Check(network.GetTopology().GetConvolutionTopology() == convolutionTopology, "The convolution topology is changed by the round trip.");
+      Check(network.GetTopology().GetPerceptronTopology() == perceptronTopology, "The perceptron topology is changed by the round trip.");
+      Check(network.GetWeightCount() == legacyNetwork.GetWeightCount(), "The weight count is changed by the round trip.");
+      for (size_t i = 0; i < network.GetWeightCount(); ++i)
+      {
+        Check(network.GetWeight(i) == legacyNetwork.GetWeight(i), "The weight " + std::to_string(i) + " is changed by the round trip.");
+      }
+
+      std::stringstream secondStream;
+      network.Save(secondStream);
+      Check(secondStream.str() == stream.str(), "The saved network differs from the loaded one.");
+    }
+
+    engine::convolution::Network2DTopology Network2DTest::GetFusedTopology()
+    {
+      using engine::convolution::Layer2DTopology;
+      using engine::convolution::Layer2DType;
+      using engine::common::ActivationType;
+
+      engine::convolution::Network2DTopology topology;
+      topology.PushBack(Layer2DTopology{ { 40, 40 }, 2, { { 3, 3 }, 2 }, 4, { 38, 38 }, 4, Layer2DType::Full, ActivationType::ReLU });
+      topology.PushBack(Layer2DTopology{ { 38, 38 }, 4, { { 3, 3 }, 4 }, 4, { 36, 36 }, 4, Layer2DType::Full, ActivationType::Identity });
+      topology.PushBack(Layer2DTopology{ { 36, 36 }, 4, { { 5, 5 }, 4 }, 3, { 32, 32 }, 3, Layer2DType::Full, ActivationType::ReLU });
+      topology.PushBack(Layer2DTopology{ { 32, 32 }, 3, { { 3, 3 }, 3 }, 2, { 30, 30 }, 2, Layer2DType::Full, ActivationType::Identity });
+      return topology;
+    }
+
+    std::vector<float> Network2DTest::GenerateInputs(const engine::convolution::Network2DTopology& topology,
+                                                     engine::common::ValueGenerator<float>& valueGenerator,
+                                                     const float scale)
+    {
+      const engine::convolution::Layer2DTopology& layerTopology = topology.GetFirstLayerTopology();
+      std::vector<float> inputs(layerTopology.GetInputCount() * layerTopology.GetInputSize().GetArea());
+      for (float& input : inputs)
+      {
+        input = scale * valueGenerator.Generate();
+      }
+      return inputs;
+    }
+
+    void Network2DTest::SetInputs(engine::convolution::Network2D<float>& network, const std::vector<float>& inputs)
+    {
+      const engine::convolution::Size2D& size = network.GetTopology().GetFirstLayerTopology().GetInputSize();
+      size_t index = 0;
+      for (size_t i = 0; i < network.GetTopology().GetFirstLayerTopology().GetInputCount(); ++i)
+      {
+        engine::convolution::Map2DProtectingReference<float> input = network.GetFirstLayer().GetInput(i);
+        for (size_t y = 0; y < size.GetHeight(); ++y)
+        {
+          for (size_t x = 0; x < size.GetWidth(); ++x)
+          {
+            input.SetValue(x, y, inputs[index++]);
+          }
+        }
+      }
+    }
+
+    float Network2DTest::GetMaxDifference(const engine::convolution::Network2D<float>& network, const engine::convolution::Network2D<float>& otherNetwork)
+    {
+      const engine::convolution::Layer2DTopology& topology = network.GetTopology().GetLastLayerTopology();
+      float maxDifference = 0.f;
+      float maxOutput = 0.f;
+      for (size_t i = 0; i < topology.GetOutputCount(); ++i)
+      {
+        for (size_t y = 0; y < topology.GetOutputSize().GetHeight(); ++y)
+        {
+          for (size_t x = 0; x < topology.GetOutputSize().GetWidth(); ++x)
+          {
+            const float output = network.GetLastLayer().GetOutput(i).GetValue(x, y);
+            maxDifference = std::max(maxDifference, std::abs(output - otherNetwork.GetLastLayer().GetOutput(i).GetValue(x, y)));
+            maxOutput = std::max(maxOutput, std::abs(output));
+          }
+        }
+      }
+      return maxDifference == 0.f ? 0.f : maxDifference / maxOutput;
+    }
+  }
+}
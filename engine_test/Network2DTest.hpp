@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "../engine/common/ValueGenerator.hpp"
+#include "../engine/convolution/Network2D.hpp"
+
+namespace cnn
+{
+  namespace engine_test
+  {
+    class Network2DTest
+    {
+    public:
+
+      // Bands of the depth-first execution give the outputs of layer by layer execution within the tolerance of float,
+      // and the outputs of a band don't depend on the rows, which are left in the layers by the previous sample,
+      // so the second sample gives the same outputs as a new network bit for bit.
+      static void TestFusedMatchesWhole();
+
+      // The network, which was saved before topologies were versioned, is loaded as full layers with sigmoid activation
+      // and without dilation, and it is saved and loaded again without changes of its topology and weights.
+      static void TestLegacyFormatRoundTrip();
+
+    private:
+
+      // The path is relative to the project directory, which the test is run from.
+      constexpr static const char* LEGACY_NETWORK_PATH = "../engine/ComplexNetwork2D.float";
+
+      // Bands of 5 rows end with partial Winograd tiles.
+      constexpr static size_t FUSED_TILE_HEIGHT = 5;
+      // The tolerance is relative to the greatest output.
+      constexpr static float FUSED_TOLERANCE = 1e-5f;
+
+      // Inputs of the first sample are this large, so stale rows, which are mixed into the next sample, change its outputs.
+      constexpr static float FIRST_SAMPLE_SCALE = 1e4f;
+
+      // Layers with 3 x 3 cores are applied by Winograd F(4 x 4, 3 x 3), and the layer with 5 x 5 cores by the direct kernel.
+      static engine::convolution::Network2DTopology GetFusedTopology();
+
+      static std::vector<float> GenerateInputs(const engine::convolution::Network2DTopology& topology,
+                                               engine::common::ValueGenerator<float>& valueGenerator,
+                                               const float scale);
+
+      static void SetInputs(engine::convolution::Network2D<float>& network, const std::vector<float>& inputs);
+
+      // It returns the greatest difference of the outputs of the last layers relative to the greatest output of the network.
+      static float GetMaxDifference(const engine::convolution::Network2D<float>& network, const engine::convolution::Network2D<float>& otherNetwork);
+
+      ~Network2DTest() = delete;
+
+    };
+  }
+}
@@ -0,0 +1,132 @@
+#include "NetworkTest.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <utility>
+
+#include "Check.hpp"
+
+namespace cnn
+{
+  namespace engine_test
+  {
+    void NetworkTest::TestFusedHeadMatchesLayers()
+    {
+      using engine::common::ActivationType;
+
+      engine::common::ThreadPool threadPool{ THREAD_COUNT };
+      // The head of the first network begins after its wide first layer, and the second network is a head as a whole.
+      engine::perceptron::NetworkTopology topologies[2];
+      topologies[0].PushBack({ 200, 32, ActivationType::ReLU });
+      topologies[0].PushBack({ 32, 24, ActivationType::Tanh });
+      topologies[0].PushBack({ 24, 10, ActivationType::Sigmoid });
+      topologies[0].PushBack({ 10, 3, ActivationType::Identity });
+      topologies[1].PushBack({ 20, 16, ActivationType::LeakyReLU });
+      topologies[1].PushBack({ 16, 4, ActivationType::Sigmoid });
+      for (const engine::perceptron::NetworkTopology& topology : topologies)
+      {
+        CheckFusedHead<float>(topology, FLOAT_TOLERANCE, threadPool);
+        CheckFusedHead<double>(topology, DOUBLE_TOLERANCE, threadPool);
+      }
+    }
+
+    template <typename T>
+    void NetworkTest::CheckFusedHead(const engine::perceptron::NetworkTopology& topology, const T tolerance, engine::common::ThreadPool& threadPool)
+    {
+      engine::perceptron::Network<T> network{ topology };
+      engine::common::ValueGenerator<T> valueGenerator;
+      valueGenerator.SetMaxValue(static_cast<T>(1));
+      valueGenerator.SetMinValue(static_cast<T>(-1));
+      network.FillWeights(valueGenerator);
+
+      // The fused network is new, so its last layer has no outputs of layer by layer execution.
+      engine::perceptron::Network<T> fusedNetwork{ topology };
+      fusedNetwork.CopyWeights(network);
+      fusedNetwork.SetFusedHead(true);
+
+      const size_t beginLayer = fusedNetwork.GetHeadBeginLayer();
+      const std::string name = "The head of " + std::to_string(topology.GetLayerCount() - beginLayer) + " of " +
+                               std::to_string(topology.GetLayerCount()) + " layers of " + (sizeof(T) == sizeof(float) ? "float" : "double");
+      Check(beginLayer < topology.GetLayerCount(), name + " is empty.");
+
+      FillInputs(network, valueGenerator);
+      fusedNetwork.GetFirstLayer().GetInput().FillFrom(std::as_const(network).GetFirstLayer().GetInput());
+      network.GenerateOutput();
+      fusedNetwork.GenerateOutput();
+      Check(GetMaxDifference(network, fusedNetwork) <= tolerance, name + " deviates from layer by layer execution.");
+
+      FillInputs(network, valueGenerator);
+      fusedNetwork.GetFirstLayer().GetInput().FillFrom(std::as_const(network).GetFirstLayer().GetInput());
+      network.GenerateOutput(threadPool);
+      fusedNetwork.GenerateOutput(threadPool);
+      Check(GetMaxDifference(network, fusedNetwork) <= tolerance, name + " deviates from layer by layer execution in parallel.");
+
+      // Two full blocks of samples and a partial one.
+      const size_t sampleCount = 2 * engine::perceptron::Network<T>::HEAD_SAMPLE_COUNT + 3;
+      const size_t inputCount = topology.GetLayerTopology(beginLayer).GetInputCount();
+      const size_t outputCount = topology.GetLastLayerTopology().GetNeuronCount();
+      std::vector<T> inputs(sampleCount * inputCount);
+      std::generate(inputs.begin(), inputs.end(), [&valueGenerator]() { return valueGenerator.Generate(); });
+      std::vector<T> outputs(sampleCount * outputCount);
+      fusedNetwork.GenerateHeadOutputs(inputs.data(), outputs.data(), sampleCount);
+      for (size_t s = 0; s < sampleCount; ++s)
+      {
+        const std::vector<T> layerOutputs = GetLayerOutputs(network, beginLayer, inputs.data() + s * inputCount);
+        double maxDifference = 0.;
+        for (size_t n = 0; n < outputCount; ++n)
+        {
+          maxDifference = std::max(maxDifference, std::abs(static_cast<double>(outputs[s * outputCount + n]) - layerOutputs[n]));
+        }
+        Check(maxDifference <= tolerance, name + " deviates from layer by layer execution for the sample " + std::to_string(s) + " of a block.");
+      }
+    }
+
+    template <typename T>
+    void NetworkTest::FillInputs(engine::perceptron::Network<T>& network, engine::common::ValueGenerator<T>& valueGenerator)
+    {
+      engine::common::MapProtectingReference<T> input = network.GetFirstLayer().GetInput();
+      for (size_t i = 0; i < input.GetValueCount(); ++i)
+      {
+        input.SetValue(i, valueGenerator.Generate());
+      }
+    }
+
+    template <typename T>
+    std::vector<T> NetworkTest::GetLayerOutputs(engine::perceptron::Network<T>& network, const size_t beginLayer, const T* const inputs)
+    {
+      for (size_t l = beginLayer; l < network.GetTopology().GetLayerCount(); ++l)
+      {
+        const engine::perceptron::LayerProtectingReference<T> layer = network.GetLayer(l);
+        if (l == beginLayer)
+        {
+          const engine::common::MapProtectingReference<T> input = layer.GetInput();
+          for (size_t i = 0; i < input.GetValueCount(); ++i)
+          {
+            input.SetValue(i, inputs[i]);
+          }
+        }
+        else
+        {
+          layer.GetInput().FillFrom(std::as_const(network).GetLayer(l - 1).GetOutput());
+        }
+        layer.GenerateOutput();
+      }
+      const engine::common::Map<T>& output = std::as_const(network).GetLastLayer().GetOutput();
+      return { output.GetValues(), output.GetValues() + output.GetValueCount() };
+    }
+
+    template <typename T>
+    double NetworkTest::GetMaxDifference(const engine::perceptron::Network<T>& network, const engine::perceptron::Network<T>& otherNetwork)
+    {
+      const engine::common::Map<T>& output = network.GetLastLayer().GetOutput();
+      const engine::common::Map<T>& otherOutput = otherNetwork.GetLastLayer().GetOutput();
+      double maxDifference = 0.;
+      for (size_t i = 0; i < output.GetValueCount(); ++i)
+      {
+        maxDifference = std::max(maxDifference, std::abs(static_cast<double>(output.GetValue(i)) - otherOutput.GetValue(i)));
+      }
+      return maxDifference;
+    }
+  }
+}
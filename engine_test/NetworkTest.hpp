@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "../engine/common/ThreadPool.hpp"
+#include "../engine/common/ValueGenerator.hpp"
+#include "../engine/perceptron/Network.hpp"
+
+namespace cnn
+{
+  namespace engine_test
+  {
+    class NetworkTest
+    {
+    public:
+
+      // The fused head gives the outputs of layer by layer execution within the tolerance of T serially and in parallel,
+      // and GenerateHeadOutputs() gives them for every sample of full and partial blocks of samples.
+      // It is checked for a head after a wide layer and for a network, which is a head as a whole.
+      static void TestFusedHeadMatchesLayers();
+
+    private:
+
+      constexpr static size_t THREAD_COUNT = 4;
+
+      constexpr static float FLOAT_TOLERANCE = 1e-4f;
+      constexpr static double DOUBLE_TOLERANCE = 1e-11;
+
+      template <typename T>
+      static void CheckFusedHead(const engine::perceptron::NetworkTopology& topology, const T tolerance, engine::common::ThreadPool& threadPool);
+
+      template <typename T>
+      static void FillInputs(engine::perceptron::Network<T>& network, engine::common::ValueGenerator<T>& valueGenerator);
+
+      // It generates the outputs of the last layer by the inputs of the layer beginLayer layer by layer.
+      template <typename T>
+      static std::vector<T> GetLayerOutputs(engine::perceptron::Network<T>& network, const size_t beginLayer, const T* const inputs);
+
+      // It returns the greatest difference of the outputs of the last layers of the networks.
+      template <typename T>
+      static double GetMaxDifference(const engine::perceptron::Network<T>& network, const engine::perceptron::Network<T>& otherNetwork);
+
+      ~NetworkTest() = delete;
+
+    };
+  }
+}
@@ -0,0 +1,109 @@
+#include "Pruning2DTest.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+#include <string>
+#include <utility>
+
+#include "../engine/common/Mutagen.hpp"
+#include "../engine/common/ValueGenerator.hpp"
+#include "../engine/complex/Pruning2D.hpp"
+
+#include "Check.hpp"
+#include "TestData.hpp"
+
+namespace cnn
+{
+  namespace engine_test
+  {
+    void Pruning2DTest::TestPruningSetsSparsity()
+    {
+      engine::complex::Network2D<float> network = TestData::GetNetwork();
+      const size_t layerCount = network.GetTopology().GetConvolutionTopology().GetLayerCount() +
+                                network.GetTopology().GetPerceptronTopology().GetLayerCount();
+      engine::complex::Pruning2D<float>::PruneByDensity(network, 1.f);
+      Check(GetSparseLayerCount(network) == 0, "Layers, which aren't pruned, are sparse.");
+
+      engine::complex::Pruning2D<float>::PruneByDensity(network, DENSITY);
+      Check(GetSparseLayerCount(network) == layerCount, "Pruned layers aren't sparse.");
+
+      const engine::convolution::Size2D& inputSize = network.GetTopology().GetConvolutionTopology().GetFirstLayerTopology().GetInputSize();
+      engine::convolution::Map2DProtectingReference<float> input = network.GetConvolutionNetwork().GetFirstLayer().GetInput(0);
+      engine::common::ValueGenerator<float> valueGenerator;
+      valueGenerator.SetMaxValue(1.f);
+      valueGenerator.SetMinValue(0.f);
+      for (size_t y = 0; y < inputSize.GetHeight(); ++y)
+      {
+        for (size_t x = 0; x < inputSize.GetWidth(); ++x)
+        {
+          input.SetValue(x, y, valueGenerator.Generate());
+        }
+      }
+
+      engine::complex::Network2D<float> denseNetwork{ network };
+      SetDense(denseNetwork);
+      Check(GetSparseLayerCount(denseNetwork) == 0, "SetSparse(false) doesn't make layers dense.");
+      network.GenerateOutput();
+      denseNetwork.GenerateOutput();
+      const float maxDifference = GetMaxDifference(network, denseNetwork);
+      Check(maxDifference <= TOLERANCE, "Sparse outputs deviate from the dense ones by " + std::to_string(maxDifference) + ".");
+
+      std::stringstream stream;
+      network.Save(stream);
+      denseNetwork.Load(stream);
+      Check(GetSparseLayerCount(denseNetwork) == 0, "A loaded network isn't dense.");
+      engine::complex::Pruning2D<float>::SetSparsity(denseNetwork);
+      Check(GetSparseLayerCount(denseNetwork) == layerCount, "SetSparsity() doesn't make a loaded pruned network sparse.");
+
+      engine::common::Mutagen<float> mutagen;
+      mutagen.SetMaxResult(1.f);
+      mutagen.SetMinResult(-1.f);
+      mutagen.SetVariabilityForce(0.5f);
+      network.Mutate(mutagen);
+      Check(GetSparseLayerCount(network) == 0, "Mutate() doesn't make layers dense.");
+    }
+
+    size_t Pruning2DTest::GetSparseLayerCount(const engine::complex::Network2D<float>& network)
+    {
+      const engine::convolution::Network2D<float>& convolutionNetwork = network.GetConvolutionNetwork();
+      const engine::perceptron::Network<float>& perceptronNetwork = network.GetPerceptronNetwork();
+      size_t sparseLayerCount = 0;
+      for (size_t i = 0; i < convolutionNetwork.GetTopology().GetLayerCount(); ++i)
+      {
+        sparseLayerCount += convolutionNetwork.GetLayer(i).IsSparse();
+      }
+      for (size_t i = 0; i < perceptronNetwork.GetTopology().GetLayerCount(); ++i)
+      {
+        sparseLayerCount += perceptronNetwork.GetLayer(i).IsSparse();
+      }
+      return sparseLayerCount;
+    }
+
+    void Pruning2DTest::SetDense(engine::complex::Network2D<float>& network)
+    {
+      const engine::convolution::Network2DProtectingReference<float> convolutionNetwork = network.GetConvolutionNetwork();
+      for (size_t i = 0; i < convolutionNetwork.GetTopology().GetLayerCount(); ++i)
+      {
+        convolutionNetwork.GetLayer(i).SetSparse(false);
+      }
+      const engine::perceptron::NetworkProtectingReference<float> perceptronNetwork = network.GetPerceptronNetwork();
+      for (size_t i = 0; i < perceptronNetwork.GetTopology().GetLayerCount(); ++i)
+      {
+        perceptronNetwork.GetLayer(i).SetSparse(false);
+      }
+    }
+
+    float Pruning2DTest::GetMaxDifference(const engine::complex::Network2D<float>& network, const engine::complex::Network2D<float>& otherNetwork)
+    {
+      const engine::common::Map<float>& output = network.GetPerceptronNetwork().GetLastLayer().GetOutput();
+      const engine::common::Map<float>& otherOutput = otherNetwork.GetPerceptronNetwork().GetLastLayer().GetOutput();
+      float maxDifference = 0.f;
+      for (size_t i = 0; i < output.GetValueCount(); ++i)
+      {
+        maxDifference = std::max(maxDifference, std::abs(output.GetValue(i) - otherOutput.GetValue(i)));
+      }
+      return maxDifference;
+    }
+  }
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstddef>
+
+#include "../engine/complex/Network2D.hpp"
+
+namespace cnn
+{
+  namespace engine_test
+  {
+    class Pruning2DTest
+    {
+    public:
+
+      // Pruning makes layers, which are sparse enough, sparse and keeps the others dense, and the sparse network gives the outputs
+      // of its dense copy within the tolerance. Mutate() makes the layers dense, and SetSparsity() restores the state after Load().
+      static void TestPruningSetsSparsity();
+
+    private:
+
+      constexpr static float DENSITY = 0.1f;
+      constexpr static float TOLERANCE = 1e-5f;
+
+      // It returns the count of sparse layers of both networks of the network.
+      static size_t GetSparseLayerCount(const engine::complex::Network2D<float>& network);
+
+      // It makes all layers of both networks of the network dense.
+      static void SetDense(engine::complex::Network2D<float>& network);
+
+      // It returns the greatest difference of the outputs of the perceptron networks of the networks.
+      static float GetMaxDifference(const engine::complex::Network2D<float>& network, const engine::complex::Network2D<float>& otherNetwork);
+
+      ~Pruning2DTest() = delete;
+
+    };
+  }
+}
@@ -0,0 +1,55 @@
+#include "QuantizedNetwork2DTest.hpp"
+
+#include <cmath>
+#include <string>
+
+#include "../engine/common/ValueGenerator.hpp"
+#include "../engine/complex/QuantizationReport2D.hpp"
+#include "../engine/complex/QuantizedNetwork2D.hpp"
+
+#include "Check.hpp"
+#include "TestData.hpp"
+
+namespace cnn
+{
+  namespace engine_test
+  {
+    void QuantizedNetwork2DTest::TestOutputsWithinBound()
+    {
+      const engine::complex::Lesson2DLibrary<float> lessonLibrary = TestData::GetLessonLibrary();
+      const engine::complex::Network2D<float> network = GetNetwork();
+      const engine::complex::QuantizedNetwork2D<float> quantizedNetwork{ network, lessonLibrary };
+      const engine::complex::QuantizationReport2D<float> report{ network, quantizedNetwork, lessonLibrary };
+
+      Check(report.GetLessonCount() == TestData::LESSON_COUNT, "Not all lessons are compared.");
+      Check(report.GetMaxOutputDifference() <= MAX_OUTPUT_DIFFERENCE,
+            "Quantized outputs deviate from float ones by " + std::to_string(report.GetMaxOutputDifference()) + ".");
+      Check(std::abs(report.GetQuantizedError() - report.GetFloatError()) <= MAX_ERROR_RATIO * report.GetFloatError(),
+            "The quantized error " + std::to_string(report.GetQuantizedError()) + " deviates from the float error " +
+            std::to_string(report.GetFloatError()) + ".");
+    }
+
+    engine::complex::Network2D<float> QuantizedNetwork2DTest::GetNetwork()
+    {
+      using engine::convolution::Layer2DTopology;
+      using engine::convolution::Layer2DType;
+      using engine::common::ActivationType;
+
+      engine::convolution::Network2DTopology convolutionTopology;
+      convolutionTopology.PushBack(Layer2DTopology{ { TestData::INPUT_WIDTH, TestData::INPUT_HEIGHT }, TestData::INPUT_COUNT,
+                                                    { { 3, 3 }, TestData::INPUT_COUNT }, 4, { 14, 14 }, 4, Layer2DType::Full, ActivationType::ReLU });
+      convolutionTopology.PushBack(Layer2DTopology{ { 14, 14 }, 4, { { 3, 3 }, 4, 2 }, 6, { 10, 10 }, 6, Layer2DType::DepthwiseSeparable, ActivationType::LeakyReLU });
+
+      engine::perceptron::NetworkTopology perceptronTopology;
+      perceptronTopology.PushBack({ 6 * 10 * 10, 16, ActivationType::Tanh });
+      perceptronTopology.PushBack({ 16, TestData::OUTPUT_COUNT, ActivationType::Sigmoid });
+
+      engine::complex::Network2D<float> network{ { convolutionTopology, perceptronTopology } };
+      engine::common::ValueGenerator<float> valueGenerator;
+      valueGenerator.SetMaxValue(MAX_WEIGHT);
+      valueGenerator.SetMinValue(-MAX_WEIGHT);
+      network.FillWeights(valueGenerator);
+      return network;
+    }
+  }
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+#include "../engine/complex/Network2D.hpp"
+
+namespace cnn
+{
+  namespace engine_test
+  {
+    class QuantizedNetwork2DTest
+    {
+    public:
+
+      // The outputs of the int8 copy of a network of full, depthwise separable and dilated convolution layers and perceptron layers
+      // deviate from the float outputs by at most MAX_OUTPUT_DIFFERENCE on the calibration lessons, so the errors differ little as well.
+      static void TestOutputsWithinBound();
+
+    private:
+
+      // Outputs are activated by sigmoid, so they are in [0, 1], and every tensor is quantized to 256 levels.
+      constexpr static float MAX_OUTPUT_DIFFERENCE = 0.01f;
+      constexpr static float MAX_ERROR_RATIO = 0.01f;
+
+      // Weights are large enough to spread the outputs, but they don't saturate the activations.
+      constexpr static float MAX_WEIGHT = 0.5f;
+
+      // It returns a network with weights in [-MAX_WEIGHT, MAX_WEIGHT], which fits the lessons of TestData.
+      static engine::complex::Network2D<float> GetNetwork();
+
+      ~QuantizedNetwork2DTest() = delete;
+
+    };
+  }
+}
@@ -0,0 +1,51 @@
+#include "TestData.hpp"
+
+#include "../engine/common/ValueGenerator.hpp"
+
+namespace cnn
+{
+  namespace engine_test
+  {
+    engine::complex::Lesson2DLibrary<float> TestData::GetLessonLibrary()
+    {
+      const engine::complex::Lesson2DTopology topology{ { INPUT_WIDTH, INPUT_HEIGHT }, INPUT_COUNT, OUTPUT_COUNT };
+      engine::complex::Lesson2DLibrary<float> library{ LESSON_COUNT, topology };
+
+      engine::common::ValueGenerator<float> valueGenerator;
+      valueGenerator.SetMaxValue(1.f);
+      valueGenerator.SetMinValue(0.f);
+      for (size_t l = 0; l < LESSON_COUNT; ++l)
+      {
+        float* const inputs = library.GetInputs(l);
+        for (size_t i = 0; i < INPUT_COUNT * INPUT_WIDTH * INPUT_HEIGHT; ++i)
+        {
+          inputs[i] = valueGenerator.Generate();
+        }
+        float* const outputs = library.GetOutputs(l);
+        for (size_t o = 0; o < OUTPUT_COUNT; ++o)
+        {
+          outputs[o] = valueGenerator.Generate();
+        }
+      }
+      return library;
+    }
+
+    engine::complex::Network2D<float> TestData::GetNetwork()
+    {
+      engine::convolution::Network2DTopology convolutionTopology;
+      convolutionTopology.PushBack({ { INPUT_WIDTH, INPUT_HEIGHT }, INPUT_COUNT, { { 3, 3 }, INPUT_COUNT }, 3, { 14, 14 }, 3 });
+      convolutionTopology.PushBack({ { 14, 14 }, 3, { { 3, 3 }, 3 }, 4, { 12, 12 }, 4 });
+
+      engine::perceptron::NetworkTopology perceptronTopology;
+      perceptronTopology.PushBack({ 4 * 12 * 12, 12 });
+      perceptronTopology.PushBack({ 12, OUTPUT_COUNT });
+
+      engine::complex::Network2D<float> network{ { convolutionTopology, perceptronTopology } };
+      engine::common::ValueGenerator<float> valueGenerator;
+      valueGenerator.SetMaxValue(0.1f);
+      valueGenerator.SetMinValue(-0.1f);
+      network.FillWeights(valueGenerator);
+      return network;
+    }
+  }
+}
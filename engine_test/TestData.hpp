@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstddef>
+
+#include "../engine/complex/Lesson2DLibrary.hpp"
+#include "../engine/complex/Network2D.hpp"
+
+namespace cnn
+{
+  namespace engine_test
+  {
+    // TestData builds small random lessons and networks, so tests don't depend on files.
+    class TestData
+    {
+    public:
+
+      constexpr static size_t INPUT_WIDTH = 16;
+      constexpr static size_t INPUT_HEIGHT = 16;
+      constexpr static size_t INPUT_COUNT = 1;
+      constexpr static size_t OUTPUT_COUNT = 4;
+      constexpr static size_t LESSON_COUNT = 24;
+
+      // It returns lessons of random inputs and random outputs.
+      static engine::complex::Lesson2DLibrary<float> GetLessonLibrary();
+
+      // It returns a network of two convolution layers and two perceptron layers with random weights, which fits the lessons.
+      static engine::complex::Network2D<float> GetNetwork();
+
+    private:
+
+      ~TestData() = delete;
+
+    };
+  }
+}
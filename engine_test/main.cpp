@@ -0,0 +1,79 @@
+#include <cstddef>
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+#include <iterator>
+
+#include "GeneticAlgorithm2DTest.hpp"
+#include "HalfFloatTest.hpp"
+#include "Layer2DTest.hpp"
+#include "LayerTest.hpp"
+#include "MutagenTest.hpp"
+#include "Network2DTest.hpp"
+#include "NetworkTest.hpp"
+#include "Pruning2DTest.hpp"
+#include "QuantizedNetwork2DTest.hpp"
+
+namespace
+{
+  using Test = void (*)();
+
+  bool Run(const char* const name, const Test test)
+  {
+    try
+    {
+      test();
+      std::cout << "passed: " << name << std::endl;
+      return true;
+    }
+    catch (const std::exception& e)
+    {
+      std::cout << "FAILED: " << name << ": " << e.what() << std::endl;
+    }
+    return false;
+  }
+}
+
+int main()
+{
+  using namespace cnn::engine_test;
+
+  const struct
+  {
+    const char* Name;
+    Test Function;
+  } tests[] =
+  {
+    { "GeneticAlgorithm2DTest::TestAllocationFreeIterations", GeneticAlgorithm2DTest::TestAllocationFreeIterations },
+    { "GeneticAlgorithm2DTest::TestSparseRollback", GeneticAlgorithm2DTest::TestSparseRollback },
+    { "HalfFloatTest::TestBFloat16Conversions", HalfFloatTest::TestBFloat16Conversions },
+    { "HalfFloatTest::TestDotProduct", HalfFloatTest::TestDotProduct },
+    { "HalfFloatTest::TestFloat16Conversions", HalfFloatTest::TestFloat16Conversions },
+    { "Layer2DTest::TestBlockedMatchesMaps", Layer2DTest::TestBlockedMatchesMaps },
+    { "Layer2DTest::TestDilatedMatchesDirect", Layer2DTest::TestDilatedMatchesDirect },
+    { "Layer2DTest::TestFourierMatchesDirect", Layer2DTest::TestFourierMatchesDirect },
+    { "Layer2DTest::TestPointwiseMatchesDirect", Layer2DTest::TestPointwiseMatchesDirect },
+    { "Layer2DTest::TestReferenceWritesRenewTransforms", Layer2DTest::TestReferenceWritesRenewTransforms },
+    { "Layer2DTest::TestSeparableMatchesDirect", Layer2DTest::TestSeparableMatchesDirect },
+    { "Layer2DTest::TestSparseMatchesDense", Layer2DTest::TestSparseMatchesDense },
+    { "Layer2DTest::TestWinogradMatchesDirect", Layer2DTest::TestWinogradMatchesDirect },
+    { "LayerTest::TestReferenceWritesRenewCompactWeights", LayerTest::TestReferenceWritesRenewCompactWeights },
+    { "MutagenTest::TestReproducibleStreams", MutagenTest::TestReproducibleStreams },
+    { "Network2DTest::TestFusedMatchesWhole", Network2DTest::TestFusedMatchesWhole },
+    { "Network2DTest::TestLegacyFormatRoundTrip", Network2DTest::TestLegacyFormatRoundTrip },
+    { "NetworkTest::TestFusedHeadMatchesLayers", NetworkTest::TestFusedHeadMatchesLayers },
+    { "Pruning2DTest::TestPruningSetsSparsity", Pruning2DTest::TestPruningSetsSparsity },
+    { "QuantizedNetwork2DTest::TestOutputsWithinBound", QuantizedNetwork2DTest::TestOutputsWithinBound },
+  };
+
+  size_t failedCount = 0;
+  for (const auto& test : tests)
+  {
+    if (!Run(test.Name, test.Function))
+    {
+      ++failedCount;
+    }
+  }
+  std::cout << failedCount << " of " << std::size(tests) << " tests failed." << std::endl;
+  return failedCount == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <stdexcept>
+
+#include "../engine/common/Map.hpp"
+#include "../engine/convolution/Map2D.hpp"
+
+#include "Socket.hpp"
+#include "Protocol.hpp"
+
+namespace cnn
+{
+  namespace inference_server
+  {
+    // Client is a blocking client of Server; one connection serves one request at a time.
+    template <typename T>
+    class Client
+    {
+
+      static_assert(std::is_floating_point<T>::value);
+
+    public:
+
+      Client(const std::string& socketPath);
+
+      engine::common::Map<T> Infer(const std::vector<engine::convolution::Map2D<T>>& inputs) const;
+
+      // The path is resolved by the server.
+      void LoadWeights(const std::string& path) const;
+
+      Statistics GetStatistics() const;
+
+    private:
+
+      Socket Connection;
+
+      std::string Request(const Command command, const std::string& payload) const;
+
+    };
+
+    template <typename T>
+    Client<T>::Client(const std::string& socketPath)
+      :
+      Connection{ Socket::Connect(socketPath) }
+    {
+    }
+
+    template <typename T>
+    engine::common::Map<T> Client<T>::Infer(const std::vector<engine::convolution::Map2D<T>>& inputs) const
+    {
+      std::ostringstream ostream{ std::ios::binary };
+      const uint64_t inputCount = inputs.size();
+      ostream.write(reinterpret_cast<const char*>(&inputCount), sizeof(inputCount));
+      for (const auto& input : inputs)
+      {
+        input.Save(ostream);
+      }
+
+      std::istringstream istream{ Request(Command::Infer, ostream.str()), std::ios::binary };
+      engine::common::Map<T> output;
+      output.Load(istream);
+      return output;
+    }
+
+    template <typename T>
+    void Client<T>::LoadWeights(const std::string& path) const
+    {
+      Request(Command::LoadWeights, path);
+    }
+
+    template <typename T>
+    Statistics Client<T>::GetStatistics() const
+    {
+      std::istringstream istream{ Request(Command::GetStatistics, {}), std::ios::binary };
+      Statistics statistics;
+      statistics.Load(istream);
+      return statistics;
+    }
+
+    template <typename T>
+    std::string Client<T>::Request(const Command command, const std::string& payload) const
+    {
+      Protocol::Send(Connection, static_cast<uint32_t>(command), payload);
+
+      uint32_t status{};
+      std::string response;
+      if (Protocol::Receive(Connection, status, response) == false)
+      {
+        throw std::runtime_error("cnn::inference_server::Client::Request(), the connection has been closed.");
+      }
+      if (static_cast<Status>(status) != Status::Ok)
+      {
+        throw std::runtime_error(response);
+      }
+      return response;
+    }
+  }
+}
@@ -0,0 +1,85 @@
+#include "Protocol.hpp"
+
+#include <cstring>
+#include <stdexcept>
+
+namespace cnn
+{
+  namespace inference_server
+  {
+    void Statistics::Save(std::ostream& ostream) const
+    {
+      if (ostream.good() == false)
+      {
+        throw std::invalid_argument("cnn::inference_server::Statistics::Save(), ostream.good() == false.");
+      }
+      ostream.write(reinterpret_cast<const char*>(&RequestCount), sizeof(RequestCount));
+      ostream.write(reinterpret_cast<const char*>(&BatchCount), sizeof(BatchCount));
+      ostream.write(reinterpret_cast<const char*>(&Throughput), sizeof(Throughput));
+      ostream.write(reinterpret_cast<const char*>(&Latency50), sizeof(Latency50));
+      ostream.write(reinterpret_cast<const char*>(&Latency99), sizeof(Latency99));
+      if (ostream.good() == false)
+      {
+        throw std::runtime_error("cnn::inference_server::Statistics::Save(), ostream.good() == false.");
+      }
+    }
+
+    void Statistics::Load(std::istream& istream)
+    {
+      if (istream.good() == false)
+      {
+        throw std::invalid_argument("cnn::inference_server::Statistics::Load(), istream.good() == false.");
+      }
+      Statistics statistics;
+      istream.read(reinterpret_cast<char*>(&statistics.RequestCount), sizeof(statistics.RequestCount));
+      istream.read(reinterpret_cast<char*>(&statistics.BatchCount), sizeof(statistics.BatchCount));
+      istream.read(reinterpret_cast<char*>(&statistics.Throughput), sizeof(statistics.Throughput));
+      istream.read(reinterpret_cast<char*>(&statistics.Latency50), sizeof(statistics.Latency50));
+      istream.read(reinterpret_cast<char*>(&statistics.Latency99), sizeof(statistics.Latency99));
+      if (istream.good() == false)
+      {
+        throw std::runtime_error("cnn::inference_server::Statistics::Load(), istream.good() == false.");
+      }
+      *this = statistics;
+    }
+
+    void Protocol::Send(const Socket& socket, const uint32_t code, const std::string& payload)
+    {
+      const uint64_t size = payload.size();
+      if (size > MAX_PAYLOAD_SIZE)
+      {
+        throw std::invalid_argument("cnn::inference_server::Protocol::Send(), size > MAX_PAYLOAD_SIZE.");
+      }
+
+      char header[sizeof(code) + sizeof(size)];
+      std::memcpy(header, &code, sizeof(code));
+      std::memcpy(header + sizeof(code), &size, sizeof(size));
+      socket.SendAll(header, sizeof(header));
+      socket.SendAll(payload.data(), payload.size());
+    }
+
+    bool Protocol::Receive(const Socket& socket, uint32_t& code, std::string& payload)
+    {
+      char header[sizeof(code) + sizeof(uint64_t)];
+      if (socket.ReceiveAll(header, sizeof(header)) == false)
+      {
+        return false;
+      }
+
+      uint64_t size{};
+      std::memcpy(&code, header, sizeof(code));
+      std::memcpy(&size, header + sizeof(code), sizeof(size));
+      if (size > MAX_PAYLOAD_SIZE)
+      {
+        throw std::runtime_error("cnn::inference_server::Protocol::Receive(), size > MAX_PAYLOAD_SIZE.");
+      }
+
+      payload.resize(static_cast<size_t>(size));
+      if ((size > 0) && (socket.ReceiveAll(payload.data(), payload.size()) == false))
+      {
+        throw std::runtime_error("cnn::inference_server::Protocol::Receive(), the connection has been closed.");
+      }
+      return true;
+    }
+  }
+}
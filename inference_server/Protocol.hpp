@@ -0,0 +1,74 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <istream>
+#include <ostream>
+
+#include "Socket.hpp"
+
+namespace cnn
+{
+  namespace inference_server
+  {
+    // Every message is a header (code and payload size) followed by the payload.
+    // A request carries a Command, a response carries a Status; an error response carries the message of the exception.
+    // Maps and networks are serialized by their own Save() and Load().
+    enum class Command : uint32_t
+    {
+      // Payload: input count and Map2D of every input. Response: Map of the network output.
+      Infer = 1,
+      // Payload: path to the weights file, which is loaded by the server. Response: empty.
+      LoadWeights = 2,
+      // Payload: empty. Response: Statistics.
+      GetStatistics = 3
+    };
+
+    enum class Status : uint32_t
+    {
+      Ok = 0,
+      Error = 1
+    };
+
+    class Statistics
+    {
+    public:
+
+      uint64_t RequestCount{};
+      uint64_t BatchCount{};
+      // Requests per second.
+      double Throughput{};
+      // Microseconds.
+      double Latency50{};
+      // Microseconds.
+      double Latency99{};
+
+      // Exception guarantee: base for ostream.
+      void Save(std::ostream& ostream) const;
+
+      // Exception guarantee: strong for this and base for istream.
+      void Load(std::istream& istream);
+
+    };
+
+    class Protocol
+    {
+    public:
+
+      constexpr static uint64_t MAX_PAYLOAD_SIZE = uint64_t{ 1 } << 26;
+
+      // Exception guarantee: base for socket.
+      static void Send(const Socket& socket, const uint32_t code, const std::string& payload);
+
+      // Exception guarantee: base for socket.
+      // It returns false, if the peer has closed the connection.
+      static bool Receive(const Socket& socket, uint32_t& code, std::string& payload);
+
+    private:
+
+      ~Protocol() = delete;
+
+    };
+  }
+}
@@ -0,0 +1,189 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <chrono>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <iostream>
+
+#include "../engine/complex/Network2D.hpp"
+#include "../engine/complex/InferenceBatcher2D.hpp"
+
+#include "Socket.hpp"
+#include "Protocol.hpp"
+
+namespace cnn
+{
+  namespace inference_server
+  {
+    // Server accepts connections on a Unix-domain socket and serves every connection by its own thread.
+    // Requests of all connections meet in InferenceBatcher2D, so they are evaluated in batches.
+    template <typename T>
+    class Server
+    {
+
+      static_assert(std::is_floating_point<T>::value);
+
+    public:
+
+      Server(const std::string& socketPath,
+             const engine::complex::Network2D<T>& network,
+             const size_t maxBatchSize,
+             const std::chrono::microseconds maxWait,
+             const size_t threadCount);
+
+      Server(const Server& server) = delete;
+
+      Server(Server&& server) noexcept = delete;
+
+      Server& operator=(const Server& server) = delete;
+
+      Server& operator=(Server&& server) noexcept = delete;
+
+      // It serves connections until accepting fails.
+      // Connection threads are detached, so the server must live until the process exits.
+      void Run();
+
+    private:
+
+      Socket Listener;
+      engine::complex::InferenceBatcher2D<T> Batcher;
+
+      void Serve(const Socket connection) noexcept;
+
+      std::string Infer(const std::string& payload);
+
+      std::string LoadWeights(const std::string& payload);
+
+      std::string GetStatistics() const;
+
+    };
+
+    template <typename T>
+    Server<T>::Server(const std::string& socketPath,
+                      const engine::complex::Network2D<T>& network,
+                      const size_t maxBatchSize,
+                      const std::chrono::microseconds maxWait,
+                      const size_t threadCount)
+      :
+      Listener{ Socket::Listen(socketPath) },
+      Batcher{ network, maxBatchSize, maxWait, threadCount }
+    {
+    }
+
+    template <typename T>
+    void Server<T>::Run()
+    {
+      while (true)
+      {
+        Socket connection = Listener.Accept();
+        std::thread{ &Server::Serve, this, std::move(connection) }.detach();
+      }
+    }
+
+    template <typename T>
+    void Server<T>::Serve(const Socket connection) noexcept
+    {
+      try
+      {
+        uint32_t code{};
+        std::string payload;
+        while (Protocol::Receive(connection, code, payload))
+        {
+          Status status = Status::Ok;
+          std::string response;
+          try
+          {
+            switch (static_cast<Command>(code))
+            {
+            case Command::Infer:
+              response = Infer(payload);
+              break;
+            case Command::LoadWeights:
+              response = LoadWeights(payload);
+              break;
+            case Command::GetStatistics:
+              response = GetStatistics();
+              break;
+            default:
+              throw std::invalid_argument("cnn::inference_server::Server::Serve(), unknown command.");
+            }
+          }
+          catch (const std::exception& e)
+          {
+            status = Status::Error;
+            response = e.what();
+          }
+          Protocol::Send(connection, static_cast<uint32_t>(status), response);
+        }
+      }
+      catch (const std::exception& e)
+      {
+        std::cerr << e.what() << std::endl;
+      }
+      catch (...)
+      {
+        std::cerr << "Unknown exception has been caught." << std::endl;
+      }
+    }
+
+    template <typename T>
+    std::string Server<T>::Infer(const std::string& payload)
+    {
+      std::istringstream istream{ payload, std::ios::binary };
+
+      uint64_t inputCount{};
+      istream.read(reinterpret_cast<char*>(&inputCount), sizeof(inputCount));
+      if (istream.good() == false)
+      {
+        throw std::runtime_error("cnn::inference_server::Server::Infer(), istream.good() == false.");
+      }
+      if (inputCount > Protocol::MAX_PAYLOAD_SIZE)
+      {
+        throw std::runtime_error("cnn::inference_server::Server::Infer(), inputCount > Protocol::MAX_PAYLOAD_SIZE.");
+      }
+
+      std::vector<engine::convolution::Map2D<T>> inputs(static_cast<size_t>(inputCount));
+      for (auto& input : inputs)
+      {
+        input.Load(istream);
+      }
+
+      const engine::common::Map<T> output = Batcher.Infer(inputs);
+
+      std::ostringstream ostream{ std::ios::binary };
+      output.Save(ostream);
+      return ostream.str();
+    }
+
+    template <typename T>
+    std::string Server<T>::LoadWeights(const std::string& payload)
+    {
+      std::ifstream istream{ payload, std::ios::binary };
+      engine::complex::Network2D<T> network;
+      network.Load(istream);
+      Batcher.SetNetwork(network);
+      return {};
+    }
+
+    template <typename T>
+    std::string Server<T>::GetStatistics() const
+    {
+      Statistics statistics;
+      statistics.RequestCount = Batcher.GetRequestCount();
+      statistics.BatchCount = Batcher.GetBatchCount();
+      statistics.Throughput = Batcher.GetThroughput();
+      statistics.Latency50 = Batcher.GetLatency(50);
+      statistics.Latency99 = Batcher.GetLatency(99);
+
+      std::ostringstream ostream{ std::ios::binary };
+      statistics.Save(ostream);
+      return ostream.str();
+    }
+  }
+}
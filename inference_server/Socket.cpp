@@ -0,0 +1,183 @@
+#include "Socket.hpp"
+
+#include <cstring>
+#include <filesystem>
+#include <stdexcept>
+#include <utility>
+
+namespace cnn
+{
+  namespace inference_server
+  {
+    Socket::Socket() noexcept
+      :
+      Handle_{ INVALID_HANDLE }
+    {
+    }
+
+    Socket::Socket(const Handle handle) noexcept
+      :
+      Handle_{ handle }
+    {
+    }
+
+    Socket::Socket(Socket&& socket) noexcept
+      :
+      Handle_{ socket.Handle_ }
+    {
+      socket.Handle_ = INVALID_HANDLE;
+    }
+
+    Socket& Socket::operator=(Socket&& socket) noexcept
+    {
+      if (this != &socket)
+      {
+        Close();
+        std::swap(Handle_, socket.Handle_);
+      }
+      return *this;
+    }
+
+    Socket::~Socket()
+    {
+      Close();
+    }
+
+    Socket Socket::Listen(const std::string& path)
+    {
+      Startup();
+
+      const sockaddr_un address = GetAddress(path);
+      std::error_code errorCode;
+      std::filesystem::remove(path, errorCode);
+
+      Socket socket{ ::socket(AF_UNIX, SOCK_STREAM, 0) };
+      if (socket.IsValid() == false)
+      {
+        throw std::runtime_error("cnn::inference_server::Socket::Listen(), socket.IsValid() == false.");
+      }
+      if (::bind(socket.Handle_, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0)
+      {
+        throw std::runtime_error("cnn::inference_server::Socket::Listen(), bind() != 0.");
+      }
+      if (::listen(socket.Handle_, SOMAXCONN) != 0)
+      {
+        throw std::runtime_error("cnn::inference_server::Socket::Listen(), listen() != 0.");
+      }
+      return socket;
+    }
+
+    Socket Socket::Connect(const std::string& path)
+    {
+      Startup();
+
+      const sockaddr_un address = GetAddress(path);
+
+      Socket socket{ ::socket(AF_UNIX, SOCK_STREAM, 0) };
+      if (socket.IsValid() == false)
+      {
+        throw std::runtime_error("cnn::inference_server::Socket::Connect(), socket.IsValid() == false.");
+      }
+      if (::connect(socket.Handle_, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0)
+      {
+        throw std::runtime_error("cnn::inference_server::Socket::Connect(), connect() != 0.");
+      }
+      return socket;
+    }
+
+    Socket Socket::Accept() const
+    {
+      Socket socket{ ::accept(Handle_, nullptr, nullptr) };
+      if (socket.IsValid() == false)
+      {
+        throw std::runtime_error("cnn::inference_server::Socket::Accept(), socket.IsValid() == false.");
+      }
+      return socket;
+    }
+
+    bool Socket::IsValid() const noexcept
+    {
+      return Handle_ != INVALID_HANDLE;
+    }
+
+    void Socket::SendAll(const void* data, const size_t size) const
+    {
+#ifdef MSG_NOSIGNAL
+      constexpr int flags = MSG_NOSIGNAL;
+#else
+      constexpr int flags = 0;
+#endif
+      const char* bytes = static_cast<const char*>(data);
+      size_t sent = 0;
+      while (sent < size)
+      {
+        const auto result = ::send(Handle_, bytes + sent, static_cast<int>(size - sent), flags);
+        if (result <= 0)
+        {
+          throw std::runtime_error("cnn::inference_server::Socket::SendAll(), send() <= 0.");
+        }
+        sent += static_cast<size_t>(result);
+      }
+    }
+
+    bool Socket::ReceiveAll(void* data, const size_t size) const
+    {
+      char* bytes = static_cast<char*>(data);
+      size_t received = 0;
+      while (received < size)
+      {
+        const auto result = ::recv(Handle_, bytes + received, static_cast<int>(size - received), 0);
+        if ((result == 0) && (received == 0))
+        {
+          return false;
+        }
+        if (result <= 0)
+        {
+          throw std::runtime_error("cnn::inference_server::Socket::ReceiveAll(), recv() <= 0.");
+        }
+        received += static_cast<size_t>(result);
+      }
+      return true;
+    }
+
+    void Socket::Close() noexcept
+    {
+      if (IsValid())
+      {
+#ifdef _WIN32
+        ::closesocket(Handle_);
+#else
+        ::close(Handle_);
+#endif
+        Handle_ = INVALID_HANDLE;
+      }
+    }
+
+    sockaddr_un Socket::GetAddress(const std::string& path)
+    {
+      sockaddr_un address{};
+      if (path.size() >= sizeof(address.sun_path))
+      {
+        throw std::invalid_argument("cnn::inference_server::Socket::GetAddress(), path.size() >= sizeof(address.sun_path).");
+      }
+      address.sun_family = AF_UNIX;
+      std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+      return address;
+    }
+
+    void Socket::Startup()
+    {
+#ifdef _WIN32
+      static const bool started = []()
+      {
+        WSADATA data;
+        return ::WSAStartup(MAKEWORD(2, 2), &data) == 0;
+      }();
+      if (started == false)
+      {
+        throw std::runtime_error("cnn::inference_server::Socket::Startup(), started == false.");
+      }
+#endif
+    }
+  }
+}
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#ifdef _WIN32
+#include <winsock2.h>
+#include <afunix.h>
+#else
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+namespace cnn
+{
+  namespace inference_server
+  {
+    // Socket is a thin RAII wrapper of a Unix-domain stream socket.
+    // Windows 10 (1803 and later) supports AF_UNIX too, so the same code serves both platforms.
+    class Socket
+    {
+    public:
+
+      Socket() noexcept;
+
+      Socket(const Socket& socket) = delete;
+
+      Socket(Socket&& socket) noexcept;
+
+      Socket& operator=(const Socket& socket) = delete;
+
+      Socket& operator=(Socket&& socket) noexcept;
+
+      ~Socket();
+
+      // It removes the file of the previous socket, if it exists.
+      static Socket Listen(const std::string& path);
+
+      static Socket Connect(const std::string& path);
+
+      Socket Accept() const;
+
+      bool IsValid() const noexcept;
+
+      void SendAll(const void* data, const size_t size) const;
+
+      // It returns false, if the peer has closed the connection before the first byte.
+      bool ReceiveAll(void* data, const size_t size) const;
+
+      void Close() noexcept;
+
+    private:
+
+#ifdef _WIN32
+      using Handle = SOCKET;
+      constexpr static Handle INVALID_HANDLE = INVALID_SOCKET;
+#else
+      using Handle = int;
+      constexpr static Handle INVALID_HANDLE = -1;
+#endif
+
+      Handle Handle_;
+
+      explicit Socket(const Handle handle) noexcept;
+
+      static sockaddr_un GetAddress(const std::string& path);
+
+      static void Startup();
+
+    };
+  }
+}
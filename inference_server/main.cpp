@@ -0,0 +1,167 @@
+#include "Server.hpp"
+#include "Client.hpp"
+
+#include <cstdlib>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include <algorithm>
+
+namespace
+{
+  using Value = float;
+
+  void PrintUsage()
+  {
+    std::cout << "Usage:" << std::endl;
+    std::cout << "  inference_server serve <socket> <weights> [maxBatchSize] [maxWaitUs] [threadCount]" << std::endl;
+    std::cout << "  inference_server load <socket> <weights>" << std::endl;
+    std::cout << "  inference_server statistics <socket>" << std::endl;
+    std::cout << "  inference_server benchmark <socket> <width> <height> <inputCount> [requestCount] [connectionCount]" << std::endl;
+  }
+
+  size_t GetArgument(const std::vector<std::string>& arguments, const size_t index, const size_t defaultValue)
+  {
+    return (index < arguments.size()) ? static_cast<size_t>(std::stoull(arguments[index])) : defaultValue;
+  }
+
+  void PrintStatistics(const cnn::inference_server::Statistics& statistics)
+  {
+    std::cout << "Requests: " << statistics.RequestCount << std::endl;
+    std::cout << "Batches: " << statistics.BatchCount << std::endl;
+    std::cout << "Throughput: " << statistics.Throughput << " requests/s" << std::endl;
+    std::cout << "Latency p50: " << statistics.Latency50 << " us" << std::endl;
+    std::cout << "Latency p99: " << statistics.Latency99 << " us" << std::endl;
+  }
+
+  void Serve(const std::vector<std::string>& arguments)
+  {
+    std::ifstream istream{ arguments.at(3), std::ios::binary };
+    cnn::engine::complex::Network2D<Value> network;
+    network.Load(istream);
+
+    cnn::inference_server::Server<Value> server{ arguments.at(2),
+                                                 network,
+                                                 GetArgument(arguments, 4, 16),
+                                                 std::chrono::microseconds{ GetArgument(arguments, 5, 1000) },
+                                                 GetArgument(arguments, 6, 0) };
+    server.Run();
+  }
+
+  // It is the local client harness: several connections send random inputs and measure the latency.
+  void Benchmark(const std::vector<std::string>& arguments)
+  {
+    const std::string socketPath = arguments.at(2);
+    const cnn::engine::convolution::Size2D size{ GetArgument(arguments, 3, 0), GetArgument(arguments, 4, 0) };
+    const size_t inputCount = GetArgument(arguments, 5, 0);
+    const size_t requestCount = GetArgument(arguments, 6, 1000);
+    const size_t connectionCount = std::max<size_t>(GetArgument(arguments, 7, 8), 1);
+
+    std::vector<std::vector<double>> latencies(connectionCount);
+    std::vector<std::thread> threads;
+    const auto start = std::chrono::steady_clock::now();
+    for (size_t c = 0; c < connectionCount; ++c)
+    {
+      threads.emplace_back([&, c]()
+      {
+        try
+        {
+          cnn::inference_server::Client<Value> client{ socketPath };
+          std::mt19937 generator{ static_cast<unsigned int>(c) };
+          std::uniform_real_distribution<Value> distribution{ 0, 1 };
+          std::vector<cnn::engine::convolution::Map2D<Value>> inputs(inputCount, cnn::engine::convolution::Map2D<Value>{ size });
+
+          for (size_t r = c; r < requestCount; r += connectionCount)
+          {
+            for (auto& input : inputs)
+            {
+              for (size_t y = 0; y < size.GetHeight(); ++y)
+              {
+                Value* const row = input.GetValues() + y * input.GetStride();
+                std::generate(row, row + size.GetWidth(), [&]() { return distribution(generator); });
+              }
+            }
+            const auto requestStart = std::chrono::steady_clock::now();
+            client.Infer(inputs);
+            latencies[c].push_back(std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - requestStart).count());
+          }
+        }
+        catch (const std::exception& e)
+        {
+          std::cerr << e.what() << std::endl;
+        }
+      });
+    }
+    for (auto& thread : threads)
+    {
+      thread.join();
+    }
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::vector<double> allLatencies;
+    for (const auto& connectionLatencies : latencies)
+    {
+      allLatencies.insert(allLatencies.end(), connectionLatencies.begin(), connectionLatencies.end());
+    }
+    std::sort(allLatencies.begin(), allLatencies.end());
+    if (allLatencies.size() == 0)
+    {
+      throw std::runtime_error("Benchmark(), allLatencies.size() == 0.");
+    }
+
+    std::cout << "Client:" << std::endl;
+    std::cout << "Requests: " << allLatencies.size() << std::endl;
+    std::cout << "Throughput: " << allLatencies.size() / seconds << " requests/s" << std::endl;
+    std::cout << "Latency p50: " << allLatencies[(allLatencies.size() - 1) * 50 / 100] << " us" << std::endl;
+    std::cout << "Latency p99: " << allLatencies[(allLatencies.size() - 1) * 99 / 100] << " us" << std::endl;
+
+    std::cout << "Server:" << std::endl;
+    PrintStatistics(cnn::inference_server::Client<Value>{ socketPath }.GetStatistics());
+  }
+}
+
+int main(int argc, char* argv[])
+{
+  try
+  {
+    const std::vector<std::string> arguments(argv, argv + argc);
+    const std::string mode = (arguments.size() > 1) ? arguments[1] : std::string{};
+
+    if ((mode == "serve") && (arguments.size() >= 4))
+    {
+      Serve(arguments);
+    }
+    else if ((mode == "load") && (arguments.size() >= 4))
+    {
+      cnn::inference_server::Client<Value>{ arguments[2] }.LoadWeights(arguments[3]);
+    }
+    else if ((mode == "statistics") && (arguments.size() >= 3))
+    {
+      PrintStatistics(cnn::inference_server::Client<Value>{ arguments[2] }.GetStatistics());
+    }
+    else if ((mode == "benchmark") && (arguments.size() >= 6))
+    {
+      Benchmark(arguments);
+    }
+    else
+    {
+      PrintUsage();
+      return 1;
+    }
+  }
+  catch (const std::exception& e)
+  {
+    std::cout << e.what() << std::endl;
+    return 1;
+  }
+  catch (...)
+  {
+    std::cout << "Unknown exception has been caught." << std::endl;
+    return 1;
+  }
+  return 0;
+}
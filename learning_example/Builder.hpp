@@ -2,9 +2,13 @@
 
 #include <type_traits>
 #include <filesystem>
-#include <SFML/Graphics.hpp>
+#include <string>
+#include <vector>
 
+#include "../engine/common/ThreadPool.hpp"
 #include "../engine/complex/Lesson2DLibrary.hpp"
+#include "../engine/complex/Lesson2DLibraryLoader.hpp"
+#include "../engine/complex/Lesson2DLibraryCache.hpp"
 #include "../engine/complex/Network2D.hpp"
 #include "../engine/complex/GeneticAlgorithm2D.hpp"
 
@@ -34,7 +38,6 @@ namespace cnn
       ~Builder() = delete;
 
       static engine::complex::Lesson2DLibrary<T> LoadLessons();
-      static engine::complex::Lesson2D<T> LoadLesson(const std::string& fileName, const size_t number);
 
     };
 
@@ -137,71 +140,17 @@ namespace cnn
     template <typename T>
     engine::complex::Lesson2DLibrary<T> Builder<T>::LoadLessons()
     {
-      engine::complex::Lesson2DLibrary<T> lessonLibrary;
+      std::vector<std::filesystem::path> directories;
       for (size_t number = 0; number < OutputCount; ++number)
       {
-        const std::string path = "../data/numbers/" + std::to_string(number);
-        std::filesystem::directory_iterator di(path);
-
-        for (auto& d : di)
-        {
-          if (d.is_directory() == false)
-          {
-            const std::string extension = d.path().extension().string();
-            if (extension == ".bmp")
-            {
-              const std::string fileName = d.path().string();
-
-              // Standard allows us to do this.
-              const engine::complex::Lesson2D<T>& lesson = LoadLesson(fileName, number);
-
-              lessonLibrary.PushBack(lesson);
-            }
-          }
-        }
-      }
-      return lessonLibrary;
-    }
-
-    template <typename T>
-    engine::complex::Lesson2D<T> Builder<T>::LoadLesson(const std::string& fileName, const size_t number)
-    {
-      sf::Image image;
-      const bool imageWasLoaded = image.loadFromFile(fileName);
-
-      if (imageWasLoaded == false)
-      {
-        throw std::runtime_error("cnn::learning_example::Builder::LoadLesson(), imageWasLoaded == false.");
-      }
-
-      if (image.getSize().x != InputWidth)
-      {
-        throw std::runtime_error("cnn::learning_example::Builder::LoadLesson(), image.getSize().x != InputWidth.");
-      }
-
-      if (image.getSize().y != InputHeight)
-      {
-        throw std::runtime_error("cnn::learning_example::Builder::LoadLesson(), image.getSize().y != InputHeight.");
-      }
-
-      engine::complex::Lesson2D<T> lesson{ {{InputWidth, InputHeight}, InputCount, OutputCount} };
-      auto input = lesson.GetInput(0);
-      auto output = lesson.GetOutput();
-      for (unsigned int x = 0; x < InputWidth; ++x)
-      {
-        for (unsigned int y = 0; y < InputHeight; ++y)
-        {
-          T value{};
-          if ((image.getPixel(x, y).r == 0) && (image.getPixel(x, y).g == 0) && (image.getPixel(x, y).b == 0))
-          {
-            value = 1;
-          }
-          input.SetValue(x, y, value);
-        }
+        directories.push_back("../data/numbers/" + std::to_string(number));
       }
-      output.SetValue(number, 1);
 
-      return lesson;
+      engine::common::ThreadPool threadPool;
+      // Lessons are black and white, so inputs are bit-packed, and every lesson is one class of numbers.
+      const engine::complex::Lesson2DLibraryLoader<T> loader{ { { InputWidth, InputHeight }, InputCount, OutputCount, true, true } };
+      const engine::complex::Lesson2DLibraryCache<T> cache{ "../data/numbers.cache" };
+      return cache.Load(loader, directories, threadPool);
     }
   }
 }